@@ -0,0 +1,115 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// A JSON list of records, about size bytes long
+static std::string make_json_records(intptr_t size)
+{
+  std::string json = "[";
+  for (int i = 0; static_cast<intptr_t>(json.size()) < size; ++i) {
+    if (i != 0) {
+      json += ",\n";
+    }
+    json += "{\"id\": " + std::to_string(i) + ", \"name\": \"record \\\"" + std::to_string(i) +
+            "\\\"\", \"values\": [1.5, 2.25, 3e10], \"nested\": {\"flags\": [true, false, null], "
+            "\"description\": \"a longer string, which is skipped when the field isn't in the type\"}}";
+  }
+  json += "]";
+  return json;
+}
+
+static void BM_JSON_StructuralIndex(benchmark::State &state)
+{
+  std::string json = make_json_records(state.range_x());
+  json_structural_index index;
+  while (state.KeepRunning()) {
+    index.build(json.data(), json.data() + json.size());
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSON_StructuralIndex)->Arg(1 << 16)->Arg(1 << 26);
+
+static void BM_JSON_Parse(benchmark::State &state)
+{
+  std::string json = make_json_records(state.range_x());
+  ndt::type tp("var * {id: int64, name: string, values: var * float64, "
+               "nested: {flags: var * ?bool, description: string}}");
+  while (state.KeepRunning()) {
+    parse_json(tp, json.data(), json.data() + json.size(), &eval::default_eval_context);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSON_Parse)->Arg(1 << 16)->Arg(1 << 26);
+
+// Most of each record is in fields which are skipped
+static void BM_JSON_ParseSkipFields(benchmark::State &state)
+{
+  std::string json = make_json_records(state.range_x());
+  ndt::type tp("var * {id: int64}");
+  while (state.KeepRunning()) {
+    parse_json(tp, json.data(), json.data() + json.size(), &eval::default_eval_context);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSON_ParseSkipFields)->Arg(1 << 16)->Arg(1 << 26);
+
+static void BM_JSON_Discover(benchmark::State &state)
+{
+  std::string json = make_json_records(1 << 22);
+  eval::eval_context ectx;
+  ectx.nthreads = state.range_x();
+  while (state.KeepRunning()) {
+    ndt::type tp;
+    ndt::json::discover(tp, json.data(), json.data() + json.size(), -1, &ectx);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSON_Discover)->Arg(1)->Arg(4);
+
+static void BM_JSON_DiscoverSample(benchmark::State &state)
+{
+  std::string json = make_json_records(1 << 26);
+  while (state.KeepRunning()) {
+    ndt::type tp;
+    ndt::json::discover(tp, json.data(), json.data() + json.size(), state.range_x());
+  }
+}
+BENCHMARK(BM_JSON_DiscoverSample)->Arg(1000);
+
+// Records with state.range_x() integer fields, whose keys are in field order
+static void BM_JSON_ParseWideStruct(benchmark::State &state)
+{
+  intptr_t field_count = state.range_x();
+  std::string tp_str = "var * {", record = "{";
+  for (intptr_t i = 0; i < field_count; ++i) {
+    std::string sep = i == 0 ? "" : ", ";
+    tp_str += sep + "field" + std::to_string(i) + ": int32";
+    record += sep + "\"field" + std::to_string(i) + "\": " + std::to_string(i);
+  }
+  tp_str += "}";
+  record += "}";
+  std::string json = "[" + record;
+  while (json.size() < (1 << 22)) {
+    json += ",\n" + record;
+  }
+  json += "]";
+  ndt::type tp(tp_str);
+  while (state.KeepRunning()) {
+    parse_json(tp, json.data(), json.data() + json.size(), &eval::default_eval_context);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSON_ParseWideStruct)->Arg(10)->Arg(300);
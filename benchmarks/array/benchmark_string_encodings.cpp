@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/array.hpp>
+#include <dynd/string_encodings.hpp>
+#include <dynd/types/fixed_string_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// About size bytes of UTF-8 text, all ASCII, or with some two and three byte characters mixed in
+static std::string make_utf8_text(intptr_t size, bool ascii)
+{
+  std::string text;
+  while (static_cast<intptr_t>(text.size()) < size) {
+    text += ascii ? "The quick brown fox jumps over the lazy dog. " : "Na\xc3\xafve caf\xc3\xa9 costs \xe2\x82\xac" "3. ";
+  }
+  return text;
+}
+
+static std::string utf8_to_utf16(const std::string &text)
+{
+  std::string out(2 * text.size(), '\0');
+  const char *it = text.data(), *end = it + text.size();
+  char *dst = &out[0];
+  append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(string_encoding_utf_16, assign_error_nocheck);
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_8, assign_error_nocheck);
+  while (it < end) {
+    append_fn(next_fn(it, end), dst, &out[0] + out.size());
+  }
+  out.resize(dst - out.data());
+  return out;
+}
+
+// Converts UTF-16 to UTF-8 the old way, a code point at a time through function pointers
+static void BM_Transcode_Codepoints(benchmark::State &state)
+{
+  std::string src = utf8_to_utf16(make_utf8_text(1 << 16, state.range_x() != 0));
+  std::string dst(2 * src.size(), '\0');
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_16, assign_error_fractional);
+  append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(string_encoding_utf_8, assign_error_fractional);
+  while (state.KeepRunning()) {
+    const char *it = src.data(), *end = it + src.size();
+    char *out = &dst[0], *out_end = out + dst.size();
+    while (it < end) {
+      append_fn(next_fn(it, end), out, out_end);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_Transcode_Codepoints)->Arg(0)->Arg(1);
+
+static void BM_Transcode_Blocks(benchmark::State &state)
+{
+  std::string src = utf8_to_utf16(make_utf8_text(1 << 16, state.range_x() != 0));
+  std::string dst(2 * src.size(), '\0');
+  transcode_block_t block_fn = get_transcode_block_function(string_encoding_utf_8, string_encoding_utf_16);
+  while (state.KeepRunning()) {
+    const char *it = src.data(), *end = it + src.size();
+    char *out = &dst[0];
+    block_fn(it, end, out, out + dst.size());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_Transcode_Blocks)->Arg(0)->Arg(1);
+
+// Assigns an array of UTF-8 fixed strings to UTF-16 ones through the assignment kernel
+static void BM_Transcode_FixedStringAssign(benchmark::State &state)
+{
+  std::string text = make_utf8_text(60, state.range_x() != 0).substr(0, 60);
+  nd::array src = nd::empty(10000, ndt::fixed_string_type::make(64, string_encoding_utf_8));
+  src.vals() = text;
+  nd::array dst = nd::empty(10000, ndt::fixed_string_type::make(64, string_encoding_utf_16));
+  while (state.KeepRunning()) {
+    dst.vals() = src;
+  }
+  state.SetBytesProcessed(state.iterations() * 10000 * 64);
+}
+BENCHMARK(BM_Transcode_FixedStringAssign)->Arg(0)->Arg(1);
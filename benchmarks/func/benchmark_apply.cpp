@@ -61,3 +61,34 @@ static void BM_Func_Apply_Callable(benchmark::State &state)
 }
 
 BENCHMARK(BM_Func_Apply_Callable);
+
+static void BM_Func_Apply_Cached(benchmark::State &state)
+{
+  nd::callable af = nd::functional::apply(&func);
+  af.enable_cache();
+
+  nd::array a = 10;
+  nd::array b = 11;
+  nd::array c = nd::empty(af.get_type()->get_return_type());
+  while (state.KeepRunning()) {
+    af(a, b, kwds("dst", c));
+  }
+}
+
+BENCHMARK(BM_Func_Apply_Cached);
+
+static void BM_Func_Apply_Bound(benchmark::State &state)
+{
+  nd::callable af = nd::functional::apply(&func);
+
+  nd::array a = 10;
+  nd::array b = 11;
+  nd::array c = nd::empty(af.get_type()->get_return_type());
+  nd::bound_kernel k = af.bind(a, b, kwds("dst", c));
+  char *src[2] = {a.data(), b.data()};
+  while (state.KeepRunning()) {
+    k.single(c.data(), src);
+  }
+}
+
+BENCHMARK(BM_Func_Apply_Bound);
@@ -12,6 +12,7 @@
 
 #include <dynd/func/arithmetic.hpp>
 #include <dynd/func/random.hpp>
+#include <dynd/lazy_expr.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -30,6 +31,29 @@ static void BM_Func_Arithmetic_Add(benchmark::State &state)
 
 BENCHMARK(BM_Func_Arithmetic_Add);
 
+static void BM_Func_Arithmetic_Add_Contiguous(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(size, ndt::type::make<double>())));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(size, ndt::type::make<double>())));
+  nd::array c = nd::empty(ndt::make_fixed_dim(size, ndt::type::make<double>()));
+  while (state.KeepRunning()) {
+    nd::add(a, b, kwds("dst", c));
+  }
+}
+
+BENCHMARK(BM_Func_Arithmetic_Add_Contiguous);
+
+static void BM_Func_Arithmetic_Assign_Cast(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(size, ndt::type::make<float>())));
+  nd::array c = nd::empty(ndt::make_fixed_dim(size, ndt::type::make<double>()));
+  while (state.KeepRunning()) {
+    c.vals() = a;
+  }
+}
+
+BENCHMARK(BM_Func_Arithmetic_Assign_Cast);
+
 static void BM_Func_Arithmetic_Dispatch_time(benchmark::State &state){
   nd::array a = 5;
   nd::array b = (short)6;
@@ -72,6 +96,36 @@ static void BM_Func_Arithmetic_Dispatch_time_4(benchmark::State &state){
 
 BENCHMARK(BM_Func_Arithmetic_Dispatch_time_4);
 
+// a * b + c - a, with a temporary array for each operator
+static void BM_Func_Arithmetic_Expr_Eager(benchmark::State &state)
+{
+  intptr_t n = state.range_x();
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  while (state.KeepRunning()) {
+    a * b + c - a;
+  }
+  state.SetBytesProcessed(state.iterations() * n * 4 * sizeof(double));
+}
+
+BENCHMARK(BM_Func_Arithmetic_Expr_Eager)->Arg(size)->Arg(1 << 22);
+
+// a * b + c - a, a block at a time
+static void BM_Func_Arithmetic_Expr_Lazy(benchmark::State &state)
+{
+  intptr_t n = state.range_x();
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(n, ndt::type::make<double>())));
+  while (state.KeepRunning()) {
+    (nd::lazy(a) * b + c - a).eval();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 4 * sizeof(double));
+}
+
+BENCHMARK(BM_Func_Arithmetic_Expr_Lazy)->Arg(size)->Arg(1 << 22);
+
 /*
 
 #ifdef DYND_CUDA
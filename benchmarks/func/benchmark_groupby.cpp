@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/func/groupby.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// Keys spread at random over ``ngroups`` groups, and values to reduce
+static void make_groupby_data(intptr_t size, intptr_t ngroups, nd::array &keys, nd::array &values)
+{
+  keys = nd::empty(size, ndt::type::make<int64_t>());
+  values = nd::empty(size, ndt::type::make<double>());
+  int64_t *keysptr = reinterpret_cast<int64_t *>(keys.data());
+  double *valuesptr = reinterpret_cast<double *>(values.data());
+  uint64_t state = 1;
+  for (intptr_t i = 0; i < size; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    keysptr[i] = static_cast<int64_t>((state >> 20) % ngroups);
+    valuesptr[i] = static_cast<double>(i);
+  }
+}
+
+static void BM_Func_GroupBy_Sum(benchmark::State &state, intptr_t ngroups)
+{
+  nd::array keys, values;
+  make_groupby_data(state.range_x(), ngroups, keys, values);
+  while (state.KeepRunning()) {
+    nd::groupby(keys, values);
+  }
+}
+
+static void BM_Func_GroupBy_Sum_FewGroups(benchmark::State &state)
+{
+  BM_Func_GroupBy_Sum(state, 100);
+}
+
+static void BM_Func_GroupBy_Sum_ManyGroups(benchmark::State &state)
+{
+  BM_Func_GroupBy_Sum(state, 100000);
+}
+
+#define DYND_GROUPBY_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1000)->Arg(100000)->Arg(10000000)
+
+DYND_GROUPBY_BENCHMARK(BM_Func_GroupBy_Sum_FewGroups);
+DYND_GROUPBY_BENCHMARK(BM_Func_GroupBy_Sum_ManyGroups);
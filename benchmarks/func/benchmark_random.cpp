@@ -28,3 +28,31 @@ BENCHMARK_TEMPLATE(BM_Func_Random_Uniform, int32_t);
 BENCHMARK_TEMPLATE(BM_Func_Random_Uniform, int64_t);
 BENCHMARK_TEMPLATE(BM_Func_Random_Uniform, float);
 BENCHMARK_TEMPLATE(BM_Func_Random_Uniform, double);
+
+static void BM_Func_Random_Uniform_Engine(benchmark::State &state, const char *engine_name)
+{
+  ndt::type dst_tp = ndt::make_fixed_dim(1000000, ndt::type::make<double>());
+  nd::array engine = engine_name;
+  while (state.KeepRunning()) {
+    nd::random::uniform(kwds("engine", engine, "dst_tp", dst_tp));
+  }
+}
+
+static void BM_Func_Random_Uniform_Philox(benchmark::State &state)
+{
+  BM_Func_Random_Uniform_Engine(state, "philox");
+}
+
+static void BM_Func_Random_Uniform_PCG32(benchmark::State &state)
+{
+  BM_Func_Random_Uniform_Engine(state, "pcg32");
+}
+
+static void BM_Func_Random_Uniform_Xoshiro256StarStar(benchmark::State &state)
+{
+  BM_Func_Random_Uniform_Engine(state, "xoshiro256**");
+}
+
+BENCHMARK(BM_Func_Random_Uniform_Philox);
+BENCHMARK(BM_Func_Random_Uniform_PCG32);
+BENCHMARK(BM_Func_Random_Uniform_Xoshiro256StarStar);
@@ -0,0 +1,119 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/func/max.hpp>
+#include <dynd/func/mean.hpp>
+#include <dynd/func/min.hpp>
+#include <dynd/func/random.hpp>
+#include <dynd/func/sum.hpp>
+
+using namespace std;
+using namespace dynd;
+
+template <typename T>
+static nd::array make_reduction_input(intptr_t size)
+{
+  return nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(size, ndt::type::make<T>())));
+}
+
+template <typename T>
+static void BM_Func_Reduction_Sum(benchmark::State &state, eval::summation_t summation)
+{
+  nd::array a = make_reduction_input<T>(state.range_x());
+  eval::summation_t prev = eval::default_eval_context.summation;
+  eval::default_eval_context.summation = summation;
+  while (state.KeepRunning()) {
+    nd::sum(a);
+  }
+  eval::default_eval_context.summation = prev;
+}
+
+static void BM_Func_Reduction_Sum_Float32_Pairwise(benchmark::State &state)
+{
+  BM_Func_Reduction_Sum<float>(state, eval::summation_pairwise);
+}
+
+static void BM_Func_Reduction_Sum_Float32_Kahan(benchmark::State &state)
+{
+  BM_Func_Reduction_Sum<float>(state, eval::summation_kahan);
+}
+
+static void BM_Func_Reduction_Sum_Float32_Fast(benchmark::State &state)
+{
+  BM_Func_Reduction_Sum<float>(state, eval::summation_fast);
+}
+
+static void BM_Func_Reduction_Sum_Float64_Pairwise(benchmark::State &state)
+{
+  BM_Func_Reduction_Sum<double>(state, eval::summation_pairwise);
+}
+
+static void BM_Func_Reduction_Mean_Float64(benchmark::State &state)
+{
+  nd::array a = make_reduction_input<double>(state.range_x());
+  while (state.KeepRunning()) {
+    nd::mean(a);
+  }
+}
+
+static void BM_Func_Reduction_Max_Float64(benchmark::State &state)
+{
+  nd::array a = make_reduction_input<double>(state.range_x());
+  while (state.KeepRunning()) {
+    nd::max(a);
+  }
+}
+
+static void BM_Func_Reduction_Min_Int32(benchmark::State &state)
+{
+  nd::array a = make_reduction_input<double>(state.range_x()).ucast<int>().eval();
+  while (state.KeepRunning()) {
+    nd::min(a);
+  }
+}
+
+static void BM_Func_Reduction_Sum_Float64_Parallel(benchmark::State &state)
+{
+  nd::array a = make_reduction_input<double>(state.range_x());
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = static_cast<int>(std::thread::hardware_concurrency());
+  while (state.KeepRunning()) {
+    nd::sum(a);
+  }
+  eval::default_eval_context = prev;
+}
+
+static void BM_Func_Reduction_Sum_Float64_Axis0_Parallel(benchmark::State &state)
+{
+  ndt::type row_tp = ndt::make_fixed_dim(1000, ndt::type::make<double>());
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x() / 1000, row_tp)));
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = static_cast<int>(std::thread::hardware_concurrency());
+  while (state.KeepRunning()) {
+    nd::sum(a, kwds("axes", nd::array{0}));
+  }
+  eval::default_eval_context = prev;
+}
+
+// 1e6 to 1e9 elements; the largest size needs 4 to 8 GB of memory
+#define DYND_REDUCTION_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1000000)->Arg(10000000)->Arg(100000000)->Arg(1000000000)
+
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float32_Pairwise);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float32_Kahan);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float32_Fast);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float64_Pairwise);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Mean_Float64);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Max_Float64);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Min_Int32);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float64_Parallel);
+DYND_REDUCTION_BENCHMARK(BM_Func_Reduction_Sum_Float64_Axis0_Parallel);
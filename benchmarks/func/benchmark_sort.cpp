@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/func/random.hpp>
+#include <dynd/sort.hpp>
+
+using namespace std;
+using namespace dynd;
+
+template <typename T>
+static void BM_Func_Sort(benchmark::State &state)
+{
+  nd::array src = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>())));
+  nd::array a = nd::empty(src.get_type());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    a.vals() = src;
+    state.ResumeTiming();
+    nd::sort(a);
+  }
+}
+
+template <typename T>
+static void BM_Func_ArgSort(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>())));
+  while (state.KeepRunning()) {
+    nd::argsort(a);
+  }
+}
+
+template <typename T>
+static void BM_Func_Sort_Parallel(benchmark::State &state)
+{
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = static_cast<int>(std::thread::hardware_concurrency());
+  BM_Func_Sort<T>(state);
+  eval::default_eval_context = prev;
+}
+
+static void BM_Func_Sort_Int32(benchmark::State &state)
+{
+  BM_Func_Sort<int32>(state);
+}
+
+static void BM_Func_Sort_Float64(benchmark::State &state)
+{
+  BM_Func_Sort<double>(state);
+}
+
+static void BM_Func_Sort_Float64_Parallel(benchmark::State &state)
+{
+  BM_Func_Sort_Parallel<double>(state);
+}
+
+static void BM_Func_ArgSort_Float64(benchmark::State &state)
+{
+  BM_Func_ArgSort<double>(state);
+}
+
+#define DYND_SORT_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(100)->Arg(10000)->Arg(1000000)->Arg(10000000)
+
+DYND_SORT_BENCHMARK(BM_Func_Sort_Int32);
+DYND_SORT_BENCHMARK(BM_Func_Sort_Float64);
+DYND_SORT_BENCHMARK(BM_Func_Sort_Float64_Parallel);
+DYND_SORT_BENCHMARK(BM_Func_ArgSort_Float64);
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/func/random.hpp>
+#include <dynd/func/take.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// Random indices into an array of the same size
+static nd::array random_indices(intptr_t size)
+{
+  nd::array ix = nd::empty(size, ndt::type::make<intptr_t>());
+  intptr_t *ixptr = reinterpret_cast<intptr_t *>(ix.data());
+  uint64_t state = 1;
+  for (intptr_t i = 0; i < size; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    ixptr[i] = static_cast<intptr_t>((state >> 16) % size);
+  }
+  return ix;
+}
+
+template <typename T>
+static void BM_Func_Take_Indexed(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>())));
+  nd::array ix = random_indices(state.range_x());
+  while (state.KeepRunning()) {
+    nd::take(a, ix);
+  }
+}
+
+template <typename T>
+static void BM_Func_Take_Indexed_NoBoundscheck(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>())));
+  nd::array ix = random_indices(state.range_x());
+  while (state.KeepRunning()) {
+    nd::take(a, ix, kwds("boundscheck", false));
+  }
+}
+
+template <typename T>
+static void BM_Func_Take_Masked(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>())));
+  nd::array mask = nd::empty(state.range_x(), ndt::type::make<bool1>());
+  bool1 *maskptr = reinterpret_cast<bool1 *>(mask.data());
+  for (intptr_t i = 0; i < state.range_x(); ++i) {
+    maskptr[i] = bool1((i * 2654435761U) % 3 != 0);
+  }
+  while (state.KeepRunning()) {
+    nd::take(a, mask);
+  }
+}
+
+template <typename T>
+static void BM_Func_Put(benchmark::State &state)
+{
+  nd::array a = nd::empty(ndt::make_fixed_dim(state.range_x(), ndt::type::make<T>()));
+  nd::array values = nd::random::uniform(kwds("dst_tp", a.get_type()));
+  nd::array ix = random_indices(state.range_x());
+  while (state.KeepRunning()) {
+    nd::put(ix, values, kwds("dst", a));
+  }
+}
+
+static void BM_Func_Take_Indexed_Float64(benchmark::State &state)
+{
+  BM_Func_Take_Indexed<double>(state);
+}
+
+static void BM_Func_Take_Indexed_Float32(benchmark::State &state)
+{
+  BM_Func_Take_Indexed<float>(state);
+}
+
+static void BM_Func_Take_Indexed_NoBoundscheck_Float64(benchmark::State &state)
+{
+  BM_Func_Take_Indexed_NoBoundscheck<double>(state);
+}
+
+static void BM_Func_Take_Masked_Float64(benchmark::State &state)
+{
+  BM_Func_Take_Masked<double>(state);
+}
+
+static void BM_Func_Put_Float64(benchmark::State &state)
+{
+  BM_Func_Put<double>(state);
+}
+
+#define DYND_TAKE_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1000)->Arg(100000)->Arg(10000000)
+
+DYND_TAKE_BENCHMARK(BM_Func_Take_Indexed_Float64);
+DYND_TAKE_BENCHMARK(BM_Func_Take_Indexed_Float32);
+DYND_TAKE_BENCHMARK(BM_Func_Take_Indexed_NoBoundscheck_Float64);
+DYND_TAKE_BENCHMARK(BM_Func_Take_Masked_Float64);
+DYND_TAKE_BENCHMARK(BM_Func_Put_Float64);
@@ -16,6 +16,7 @@
 #include <dynd/shortvector.hpp>
 #include <dynd/irange.hpp>
 #include <dynd/memblock/array_memory_block.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
 #include <dynd/types/pointer_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
@@ -1713,6 +1714,36 @@ namespace nd {
   DYND_API array memmap(const std::string &filename, intptr_t begin = 0,
                         intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = default_access_flags);
 
+  /**
+   * Memory-maps a file as an array of type ``tp``, which refers to the
+   * mapped memory without copying it. The type must have a fixed layout
+   * without references to other memory, like ``64 * float32`` or a struct of
+   * POD fields. If its outermost dimension is symbolic, like in
+   * ``Fixed * 64 * float32`` or ``N * 64 * float32``, its size is the number
+   * of elements that fit in the rest of the file.
+   *
+   * \param filename  The name of the file to memory map.
+   * \param tp  The type of the array.
+   * \param offset  The position within the file where the array starts,
+   *                which must be aligned for ``tp``.
+   * \param access  The access permissions of the array. The file is only
+   *                opened for writing if write_access_flag is given.
+   */
+  DYND_API array memmap(const std::string &filename, const ndt::type &tp, intptr_t offset = 0,
+                        uint32_t access = read_access_flag);
+
+  /**
+   * Gives the operating system a hint about how the memory-mapped file that
+   * ``a`` refers to will be accessed.
+   */
+  DYND_API void memmap_advise(const array &a, memmap_advice_t advice);
+
+  /**
+   * Writes the changes to the memory-mapped file that ``a`` refers to back
+   * to the file.
+   */
+  DYND_API void memmap_flush(const array &a);
+
   DYND_API bool is_scalar_avail(const ndt::type &tp, const char *arrmeta, const char *data,
                                 const eval::eval_context *ectx);
 
@@ -18,19 +18,37 @@
 #include <atomic>
 namespace dynd {
     typedef std::atomic<int32_t> atomic_refcount;
+
+    /**
+     * Increments the count unless it is zero, which means the object is
+     * being destroyed, and returns whether it was incremented.
+     */
+    inline bool atomic_increment_if_nonzero(atomic_refcount &count)
+    {
+        int32_t value = count.load();
+        while (value != 0) {
+            if (count.compare_exchange_weak(value, value + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
 } // namespace dynd
 #elif defined(_MSC_VER)
 
 #if defined( __CLRCALL_PURE_OR_CDECL )
 extern "C" long __CLRCALL_PURE_OR_CDECL _InterlockedIncrement( long volatile * );
 extern "C" long __CLRCALL_PURE_OR_CDECL _InterlockedDecrement( long volatile * );
+extern "C" long __CLRCALL_PURE_OR_CDECL _InterlockedCompareExchange( long volatile *, long, long );
 #else
 extern "C" long __cdecl _InterlockedIncrement( long volatile * );
 extern "C" long __cdecl _InterlockedDecrement( long volatile * );
+extern "C" long __cdecl _InterlockedCompareExchange( long volatile *, long, long );
 #endif
 
 #pragma intrinsic(_InterlockedIncrement)
 #pragma intrinsic(_InterlockedDecrement)
+#pragma intrinsic(_InterlockedCompareExchange)
 
 namespace dynd {
     class DYND_API atomic_refcount {
@@ -66,7 +84,25 @@ namespace dynd {
         bool operator<=(int32_t rhs) const {
             return static_cast<const volatile int32_t&>(m_refcount) <= rhs;
         }
+
+        bool increment_if_nonzero()
+        {
+            long value = static_cast<const volatile int32_t&>(m_refcount);
+            while (value != 0) {
+                long previous = _InterlockedCompareExchange((long *)&m_refcount, value + 1, value);
+                if (previous == value) {
+                    return true;
+                }
+                value = previous;
+            }
+            return false;
+        }
     };
+
+    inline bool atomic_increment_if_nonzero(atomic_refcount &count)
+    {
+        return count.increment_if_nonzero();
+    }
 } // namespace dynd
 #else
 //  atomic_count for g++ on 486+/AMD64
@@ -97,6 +133,19 @@ namespace dynd {
         {
             return atomic_exchange_and_add((int32_t *)&m_refcount, 0);
         }
+
+        bool increment_if_nonzero()
+        {
+            int32_t value = *this;
+            while (value != 0) {
+                int32_t previous = __sync_val_compare_and_swap(&m_refcount, value, value + 1);
+                if (previous == value) {
+                    return true;
+                }
+                value = previous;
+            }
+            return false;
+        }
     private:
 
         static int atomic_exchange_and_add(int32_t * pw, int32_t dv)
@@ -119,5 +168,10 @@ namespace dynd {
             return r;
         }
     };
+
+    inline bool atomic_increment_if_nonzero(atomic_refcount &count)
+    {
+        return count.increment_if_nonzero();
+    }
 } // namespace dynd
 #endif
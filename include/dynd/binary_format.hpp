@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+
+#include <dynd/array.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Saves an array to a file in the dynd binary format. The file has a
+   * header with the datashape of the array, followed by the array data in the
+   * layout of its default arrmeta. Variable-sized parts, the elements of var
+   * dimensions and the bytes of strings, follow in a payload block, and the
+   * data refers to them by offsets into it.
+   *
+   * The types which can be saved are POD types, fixed and var dimensions,
+   * structs, tuples and strings. The file uses the native byte order and
+   * pointer size.
+   *
+   * \param a  The array to save.
+   * \param filename  The name of the file to write.
+   */
+  DYND_API void save_binary(const array &a, const std::string &filename);
+
+  /**
+   * Loads an array saved by ``save_binary``. The file is memory-mapped, and
+   * if the type is POD the array refers to the mapped data, so loading
+   * takes constant time. Otherwise the fixed parts of the array are copied.
+   * Elements of var dimensions with POD types are left in the mapped
+   * payload when the array is read-only, and copied otherwise, and strings
+   * are always copied.
+   *
+   * \param filename  The name of the file to load.
+   * \param access  The access permissions of the array. If the array is
+   *                writable and POD, writes go to the file.
+   */
+  DYND_API array load_binary(const std::string &filename, uint32_t access = read_access_flag);
+
+} // namespace dynd::nd
+} // namespace dynd
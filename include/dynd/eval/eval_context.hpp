@@ -17,6 +17,19 @@
 
 namespace dynd { namespace eval {
 
+/**
+ * How floating point sum reductions accumulate their values.
+ */
+enum summation_t {
+  // Blocks summed with several independent accumulators, combined pairwise,
+  // so the rounding error grows with log(n) rather than n
+  summation_pairwise,
+  // Compensated (Kahan-Babuska) summation, the most accurate and the slowest
+  summation_kahan,
+  // Several independent accumulators over the whole run, the fastest
+  summation_fast
+};
+
 /**
  * Metafunction that returns true when the type is eval::eval_context
  */
@@ -37,6 +50,17 @@ struct DYND_API eval_context {
     std::atomic<date_parse_order_t> date_parse_order;
     // Century selection for 2 digit years in date strings
     std::atomic<int> century_window;
+    // Accumulation used by floating point sums
+    std::atomic<summation_t> summation;
+    // Number of threads elementwise kernels, reductions and sorts may
+    // split their outer dimension across, 1 runs everything on the
+    // calling thread
+    std::atomic<int> nthreads;
+    // Minimum number of elements each of those threads processes
+    std::atomic<intptr_t> parallel_chunk_size;
+    // Whether parallel reductions combine their partial results in a fixed
+    // order, so the result doesn't depend on the order the threads finish
+    std::atomic<bool> deterministic_reduction;
 #else
     // Default error mode for computations
     assign_error_mode errmode;
@@ -46,12 +70,25 @@ struct DYND_API eval_context {
     date_parse_order_t date_parse_order;
     // Century selection for 2 digit years in date strings
     int century_window;
+    // Accumulation used by floating point sums
+    summation_t summation;
+    // Number of threads elementwise kernels, reductions and sorts may
+    // split their outer dimension across, 1 runs everything on the
+    // calling thread
+    int nthreads;
+    // Minimum number of elements each of those threads processes
+    intptr_t parallel_chunk_size;
+    // Whether parallel reductions combine their partial results in a fixed
+    // order, so the result doesn't depend on the order the threads finish
+    bool deterministic_reduction;
 #endif
 
     DYND_CONSTEXPR eval_context()
         : errmode(assign_error_fractional),
           cuda_device_errmode(assign_error_nocheck),
-          date_parse_order(date_parse_no_ambig), century_window(70)
+          date_parse_order(date_parse_no_ambig), century_window(70),
+          summation(summation_pairwise), nthreads(1),
+          parallel_chunk_size(65536), deterministic_reduction(true)
     {
     }
 
@@ -61,7 +98,11 @@ struct DYND_API eval_context {
         : errmode(rhs.errmode.load()),
           cuda_device_errmode(rhs.cuda_device_errmode.load()),
           date_parse_order(rhs.date_parse_order.load()),
-          century_window(rhs.century_window.load())
+          century_window(rhs.century_window.load()),
+          summation(rhs.summation.load()),
+          nthreads(rhs.nthreads.load()),
+          parallel_chunk_size(rhs.parallel_chunk_size.load()),
+          deterministic_reduction(rhs.deterministic_reduction.load())
     {
     }
 
@@ -70,6 +111,10 @@ struct DYND_API eval_context {
         cuda_device_errmode.store(rhs.cuda_device_errmode.load());
         date_parse_order.store(rhs.date_parse_order.load());
         century_window.store(rhs.century_window.load());
+        summation.store(rhs.summation.load());
+        nthreads.store(rhs.nthreads.load());
+        parallel_chunk_size.store(rhs.parallel_chunk_size.load());
+        deterministic_reduction.store(rhs.deterministic_reduction.load());
         return *this;
     }
 #endif
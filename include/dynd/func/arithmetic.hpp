@@ -30,7 +30,9 @@ namespace nd {
     {
       children = callable::make_all<KernelType, TypeIDSequence>(0);
 
-      const callable self = functional::call<FuncType>(ndt::type("(Any) -> Any"));
+      callable self = functional::call<FuncType>(ndt::type("(Any) -> Any"));
+      // The arithmetic kernels keep no state outside of their ckernel
+      self.set_thread_safe(true);
 
       for (type_id_t i0 : i2a<dim_type_ids>()) {
         const ndt::type child_tp = ndt::callable_type::make(self.get_type()->get_return_type(), ndt::type(i0));
@@ -91,6 +93,8 @@ namespace nd {
       children[{{option_type_id, option_type_id}}] = callable::make<option_arithmetic_kernel<FuncType, true, true>>();
 
       callable self = functional::call<FuncType>(ndt::type("(Any, Any) -> Any"));
+      // The arithmetic kernels keep no state outside of their ckernel
+      self.set_thread_safe(true);
       for (type_id_t i0 : i2a<TypeIDSequence>()) {
         for (type_id_t i1 : i2a<dim_type_ids>()) {
           children[{{i0, i1}}] = functional::elwise(self);
@@ -165,6 +169,8 @@ namespace nd {
       children = callable::make_all<KernelType, TypeIDSequence, TypeIDSequence>();
 
       callable self = functional::call<FuncType>(ndt::type("(Any, Any) -> Any"));
+      // The arithmetic kernels keep no state outside of their ckernel
+      self.set_thread_safe(true);
       for (type_id_t i0 : i2a<TypeIDSequence>()) {
         for (type_id_t i1 : i2a<dim_type_ids>()) {
           children[{{i0, i1}}] = functional::elwise(self);
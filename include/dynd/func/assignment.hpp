@@ -159,7 +159,7 @@ make_cuda_device_builtin_type_assignment_kernel(const arrfunc_type_data *self, c
                                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                                 const eval::eval_context *ectx, const nd::array &kwds,
-                                                const std::map<std::string, ndt::type> &tp_vars);
+                                                const small_map<std::string, ndt::type> &tp_vars);
 
 DYND_API intptr_t
 make_cuda_to_device_builtin_type_assignment_kernel(const arrfunc_type_data *self, const ndt::arrfunc_type *af_tp,
@@ -167,13 +167,13 @@ make_cuda_to_device_builtin_type_assignment_kernel(const arrfunc_type_data *self
                                                    const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                                    const char *const *src_arrmeta, kernel_request_t kernreq,
                                                    const eval::eval_context *ectx, const nd::array &kwds,
-                                                   const std::map<std::string, ndt::type> &tp_vars);
+                                                   const small_map<std::string, ndt::type> &tp_vars);
 
 DYND_API intptr_t make_cuda_from_device_builtin_type_assignment_kernel(
     const arrfunc_type_data *self, const ndt::arrfunc_type *af_tp, char *data, void *ckb, intptr_t ckb_offset,
     const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
     const char *const *src_arrmeta, kernel_request_t kernreq, const eval::eval_context *ectx, const nd::array &kwds,
-    const std::map<std::string, ndt::type> &tp_vars);
+    const small_map<std::string, ndt::type> &tp_vars);
 
 #endif // DYND_CUDA
 
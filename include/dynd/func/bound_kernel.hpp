@@ -0,0 +1,212 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dynd/arrmeta_holder.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/types/callable_type.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * Whether any of the types decays to a pointer to arrays, which marks
+     * the (nsrc, src) form of a call.
+     */
+    template <typename... A>
+    struct has_array_pointer {
+      static const bool value = false;
+    };
+
+    template <typename A0, typename... A>
+    struct has_array_pointer<A0, A...> {
+      static const bool value = std::is_convertible<const A0 &, const array *>::value || has_array_pointer<A...>::value;
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * A ckernel which has been instantiated from a callable for one fixed
+   * signature, i.e. one destination type, one set of source types and their
+   * arrmeta, and one set of keyword arguments. The finished ckernel is kept
+   * alive so that it can be executed any number of times without going
+   * through data_init, resolve_dst_type and instantiate again.
+   *
+   * The ckernel is instantiated against copies of the arrmeta owned by the
+   * bound_kernel, so only types whose arrmeta holds no memory block
+   * references (see ``is_bindable``) can be bound.
+   */
+  class DYND_API bound_kernel {
+    // The destination type as it was requested, possibly symbolic
+    ndt::type m_requested_dst_tp;
+    // The resolved destination type followed by its arrmeta
+    arrmeta_holder m_dst;
+    intptr_t m_nsrc;
+    // The source types followed by their arrmeta
+    std::unique_ptr<arrmeta_holder[]> m_src;
+    // The types, arrmeta and data of the keyword arguments, packed
+    std::vector<ndt::type> m_kwd_tp;
+    std::string m_kwd_bytes;
+    // The evaluation settings the ckernel was instantiated with
+    eval::eval_context m_ectx;
+    bool m_executable;
+    ckernel_builder<kernel_request_host> m_ckb;
+
+    static void pack_kwds(intptr_t nkwd, const nd::array *kwds, std::string &out_bytes);
+
+  public:
+    /**
+     * Instantiates a ckernel from ``self``. If ``dst_arrmeta`` is NULL, the
+     * destination type is resolved (when symbolic) and default arrmeta is
+     * constructed for it, exactly as ``nd::empty`` would.
+     */
+    bound_kernel(callable_type_data &self, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                 const ndt::type *src_tp, const char *const *src_arrmeta, intptr_t nkwd, const nd::array *kwds,
+                 const small_map<std::string, ndt::type> &tp_vars,
+                 const eval::eval_context *ectx = &eval::default_eval_context);
+
+    bound_kernel(bound_kernel &&rhs);
+
+    // non-copyable
+    bound_kernel(const bound_kernel &) = delete;
+    bound_kernel &operator=(const bound_kernel &) = delete;
+
+    /**
+     * Returns false if the resolved destination type turned out not to be
+     * bindable, in which case no ckernel is held.
+     */
+    bool is_executable() const
+    {
+      return m_executable;
+    }
+
+    const ndt::type &get_dst_type() const
+    {
+      return m_dst.get_type();
+    }
+
+    const char *get_dst_arrmeta() const
+    {
+      return const_cast<arrmeta_holder &>(m_dst).get();
+    }
+
+    intptr_t get_nsrc() const
+    {
+      return m_nsrc;
+    }
+
+    const ndt::type &get_src_type(intptr_t i) const
+    {
+      return m_src[i].get_type();
+    }
+
+    /**
+     * Returns true if the provided destination arrmeta is byte-for-byte the
+     * arrmeta the ckernel was instantiated with.
+     */
+    bool matches_dst_arrmeta(const char *dst_arrmeta) const;
+
+    /**
+     * Returns true if this ckernel was instantiated for exactly this call
+     * signature. A NULL ``dst_arrmeta`` means the destination will be
+     * allocated by the caller from ``get_dst_type()``.
+     */
+    bool matches(const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                 const char *const *src_arrmeta, intptr_t nkwd, const nd::array *kwds,
+                 const eval::eval_context &ectx) const;
+
+    /**
+     * Executes the ckernel directly. The arrmeta of the destination and
+     * sources must match the arrmeta the ckernel was bound with.
+     */
+    void single(char *dst, char *const *src) const
+    {
+      ckernel_prefix *ck = m_ckb.get();
+      ck->get_function<expr_single_t>()(ck, dst, src);
+    }
+
+    /**
+     * Executes the ckernel into a newly allocated destination array,
+     * validating that the arguments have the bound types and arrmeta.
+     */
+    array operator()(intptr_t nsrc, const array *src) const;
+
+    /**
+     * Executes the ckernel into ``dst``, validating that all arguments have
+     * the bound types and arrmeta.
+     */
+    void operator()(const array &dst, intptr_t nsrc, const array *src) const;
+
+    /**
+     * Executes the ckernel into a newly allocated destination array, with
+     * the arguments given directly (and converted to arrays if needed).
+     */
+    template <typename... A>
+    typename std::enable_if<!detail::has_array_pointer<A...>::value, array>::type operator()(const A &... a) const
+    {
+      array src[sizeof...(A) == 0 ? 1 : sizeof...(A)] = {array(a)...};
+      return (*this)(static_cast<intptr_t>(sizeof...(A)), src);
+    }
+
+    /**
+     * Returns true if a ckernel for these types can be bound, which requires
+     * concrete types whose arrmeta can be compared with a memcmp, and scalar
+     * keyword values that can be compared the same way.
+     */
+    static bool is_bindable(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
+                            const nd::array *kwds);
+  };
+
+  /**
+   * A cache of bound kernels attached to a single callable, enabled with
+   * ``nd::callable::enable_cache``. Entries are checked out while they
+   * execute, so concurrent calls with the same signature never share a
+   * ckernel; a miss simply instantiates another one.
+   */
+  class DYND_API kernel_cache {
+    mutable std::mutex m_mutex;
+    std::size_t m_capacity;
+    // Least recently used first
+    std::vector<std::unique_ptr<bound_kernel>> m_entries;
+    std::size_t m_hits;
+    std::size_t m_misses;
+
+  public:
+    kernel_cache(std::size_t capacity) : m_capacity(capacity), m_hits(0), m_misses(0)
+    {
+    }
+
+    /**
+     * Removes and returns the entry matching the signature, or returns NULL
+     * and counts a miss.
+     */
+    std::unique_ptr<bound_kernel> acquire(const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                          const ndt::type *src_tp, const char *const *src_arrmeta, intptr_t nkwd,
+                                          const nd::array *kwds, const eval::eval_context &ectx);
+
+    /** Returns an entry to the cache, evicting the least recently used one if full */
+    void release(std::unique_ptr<bound_kernel> &&entry);
+
+    void clear();
+
+    std::size_t get_capacity() const
+    {
+      return m_capacity;
+    }
+
+    std::size_t size() const;
+    std::size_t hits() const;
+    std::size_t misses() const;
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -8,9 +8,11 @@
 #include <memory>
 
 #include <dynd/config.hpp>
+#include <dynd/small_vector.hpp>
 #include <dynd/eval/eval_context.hpp>
 #include <dynd/types/base_type.hpp>
 #include <dynd/types/callable_type.hpp>
+#include <dynd/func/bound_kernel.hpp>
 #include <dynd/kernels/ckernel_builder.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/types/struct_type.hpp>
@@ -59,7 +61,7 @@ namespace nd {
      */
     template <typename T>
     bool is_special_kwd(const ndt::callable_type *DYND_UNUSED(self_tp), const std::string &DYND_UNUSED(name),
-                        const T &DYND_UNUSED(value), std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                        const T &DYND_UNUSED(value), small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       return false;
     }
@@ -91,7 +93,7 @@ namespace nd {
 
     template <typename T>
     void check_name(const ndt::callable_type *af_tp, array &dst, const std::string &name, const T &value,
-                    bool &has_dst_tp, ndt::type *kwd_tp, std::vector<intptr_t> &available)
+                    bool &has_dst_tp, ndt::type *kwd_tp, small_vector<intptr_t> &available)
     {
       intptr_t j = af_tp->get_kwd_index(name);
       if (j == -1) {
@@ -114,22 +116,20 @@ namespace nd {
       available.push_back(j);
     }
 
-    DYND_API void fill_missing_values(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                                      const uintptr_t *data_offsets,
-                                      std::vector<nd::array> &DYND_UNUSED(kwds_as_vector),
-                                      const std::vector<intptr_t> &missing);
+    DYND_API void fill_missing_values(const ndt::type *tp, small_vector<nd::array> &kwds_as_vector,
+                                      const small_vector<intptr_t> &missing);
 
     DYND_API void check_narg(const ndt::callable_type *af_tp, intptr_t npos);
 
     DYND_API void check_arg(const ndt::callable_type *af_tp, intptr_t i, const ndt::type &actual_tp,
-                            const char *actual_arrmeta, std::map<std::string, ndt::type> &tp_vars);
+                            const char *actual_arrmeta, small_map<std::string, ndt::type> &tp_vars);
 
-    DYND_API void check_nkwd(const ndt::callable_type *af_tp, const std::vector<intptr_t> &available,
-                             const std::vector<intptr_t> &missing);
+    DYND_API void check_nkwd(const ndt::callable_type *af_tp, const small_vector<intptr_t> &available,
+                             const small_vector<intptr_t> &missing);
 
-    DYND_API void validate_kwd_types(const ndt::callable_type *af_tp, std::vector<ndt::type> &kwd_tp,
-                                     const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing,
-                                     std::map<std::string, ndt::type> &tp_vars);
+    DYND_API void validate_kwd_types(const ndt::callable_type *af_tp, small_vector<ndt::type> &kwd_tp,
+                                     const small_vector<intptr_t> &available, const small_vector<intptr_t> &missing,
+                                     small_map<std::string, ndt::type> &tp_vars);
 
     inline void set_data(char *&data, array &value)
     {
@@ -158,17 +158,10 @@ namespace nd {
     /** The case of no keyword arguments being provided */
     template <>
     class kwds<> {
-      void fill_values(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                       const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                       const std::vector<intptr_t> &DYND_UNUSED(available), const std::vector<intptr_t> &missing) const
-      {
-        fill_missing_values(tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, missing);
-      }
-
     public:
       void validate_names(const ndt::callable_type *af_tp, array &DYND_UNUSED(dst),
-                          std::vector<ndt::type> &DYND_UNUSED(tp), std::vector<intptr_t> &available,
-                          std::vector<intptr_t> &missing) const
+                          small_vector<ndt::type> &DYND_UNUSED(tp), small_vector<intptr_t> &available,
+                          small_vector<intptr_t> &missing) const
       {
         // No keywords provided, so all are missing
         for (intptr_t j : af_tp->get_option_kwd_indices()) {
@@ -178,25 +171,11 @@ namespace nd {
         check_nkwd(af_tp, available, missing);
       }
 
-      /** Converts the keyword args + filled in defaults into an nd::array */
-      array as_array(const ndt::type &tp, std::vector<nd::array> &kwds_as_vector,
-                     const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing) const
+      /** Places the keyword args + filled in defaults in one array per keyword */
+      void fill_values(const ndt::type *tp, small_vector<nd::array> &kwds_as_vector,
+                       const small_vector<intptr_t> &DYND_UNUSED(available), const small_vector<intptr_t> &missing) const
       {
-        array res = empty_shell(tp);
-        ndt::struct_type::fill_default_data_offsets(res.get_dim_size(),
-                                                    tp.extended<ndt::base_struct_type>()->get_field_types_raw(),
-                                                    reinterpret_cast<uintptr_t *>(res.get()->metadata()));
-
-        char *arrmeta = res.get()->metadata();
-        const uintptr_t *arrmeta_offsets = res.get_type().extended<ndt::base_struct_type>()->get_arrmeta_offsets_raw();
-        char *data = res.data();
-        const uintptr_t *data_offsets =
-            res.get_type().extended<ndt::base_struct_type>()->get_data_offsets(res.get()->metadata());
-
-        fill_values(tp.extended<ndt::base_struct_type>()->get_field_types_raw(), arrmeta, arrmeta_offsets, data,
-                    data_offsets, kwds_as_vector, available, missing);
-
-        return res;
+        fill_missing_values(tp, kwds_as_vector, missing);
       }
     };
 
@@ -225,35 +204,21 @@ namespace nd {
         kwds *self;
 
         template <size_t I>
-        void on_each(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                     const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                     const std::vector<intptr_t> &available) const
+        void on_each(small_vector<nd::array> &kwds_as_vector, const small_vector<intptr_t> &available) const
         {
           intptr_t j = available[I];
           if (j != -1) {
-            nd::forward_as_array(tp[j], arrmeta + arrmeta_offsets[j], data + data_offsets[j],
-                                 std::get<I>(self->m_values));
             kwds_as_vector[j] = nd::array(std::get<I>(self->m_values));
           }
         }
 
-        void operator()(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                        const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                        const std::vector<intptr_t> &available) const
+        void operator()(small_vector<nd::array> &kwds_as_vector, const small_vector<intptr_t> &available) const
         {
           typedef make_index_sequence<sizeof...(K)> I;
-          for_each<I>(*this, tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, available);
+          for_each<I>(*this, kwds_as_vector, available);
         }
       } fill_available_values;
 
-      void fill_values(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                       const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                       const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing) const
-      {
-        fill_available_values(tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, available);
-        fill_missing_values(tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, missing);
-      }
-
     public:
       kwds(typename as_<K, const char *>::type... names, K &&... values) : m_values(std::forward<K>(values)...)
       {
@@ -268,14 +233,14 @@ namespace nd {
         kwds *self;
 
         template <size_t I>
-        void on_each(const ndt::callable_type *af_tp, array &dst, bool &has_dst_tp, std::vector<ndt::type> &kwd_tp,
-                     std::vector<intptr_t> &available) const
+        void on_each(const ndt::callable_type *af_tp, array &dst, bool &has_dst_tp, small_vector<ndt::type> &kwd_tp,
+                     small_vector<intptr_t> &available) const
         {
           check_name(af_tp, dst, self->m_names[I], std::get<I>(self->m_values), has_dst_tp, kwd_tp.data(), available);
         }
 
-        void operator()(const ndt::callable_type *af_tp, array &dst, std::vector<ndt::type> &tp,
-                        std::vector<intptr_t> &available, std::vector<intptr_t> &missing) const
+        void operator()(const ndt::callable_type *af_tp, array &dst, small_vector<ndt::type> &tp,
+                        small_vector<intptr_t> &available, small_vector<intptr_t> &missing) const
         {
           bool has_dst_tp = false;
 
@@ -297,20 +262,11 @@ namespace nd {
         }
       } validate_names;
 
-      array as_array(const ndt::type &tp, std::vector<nd::array> &kwds_as_vector,
-                     const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing) const
+      void fill_values(const ndt::type *tp, small_vector<nd::array> &kwds_as_vector,
+                       const small_vector<intptr_t> &available, const small_vector<intptr_t> &missing) const
       {
-        array res = empty_shell(tp);
-        ndt::struct_type::fill_default_data_offsets(res.get_dim_size(),
-                                                    tp.extended<ndt::base_struct_type>()->get_field_types_raw(),
-                                                    reinterpret_cast<uintptr_t *>(res.get()->metadata()));
-
-        fill_values(tp.extended<ndt::base_struct_type>()->get_field_types_raw(), res.get()->metadata(),
-                    res.get_type().extended<ndt::base_struct_type>()->get_arrmeta_offsets_raw(), res.data(),
-                    res.get_type().extended<ndt::base_struct_type>()->get_data_offsets(res.get()->metadata()),
-                    kwds_as_vector, available, missing);
-
-        return res;
+        fill_available_values(kwds_as_vector, available);
+        fill_missing_values(tp, kwds_as_vector, missing);
       }
     };
 
@@ -320,34 +276,24 @@ namespace nd {
       const char *const *m_names;
       array *m_values;
 
-      void fill_available_values(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                                 const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                                 const std::vector<intptr_t> &available) const
+      void fill_available_values(small_vector<nd::array> &kwds_as_vector,
+                                 const small_vector<intptr_t> &available) const
       {
         for (intptr_t i = 0; i < m_size; ++i) {
           intptr_t j = available[i];
           if (j != -1) {
-            nd::forward_as_array(tp[j], arrmeta + arrmeta_offsets[j], data + data_offsets[j], this->m_values[i]);
             kwds_as_vector[j] = this->m_values[i];
           }
         }
       }
 
-      void fill_values(const ndt::type *tp, char *arrmeta, const uintptr_t *arrmeta_offsets, char *data,
-                       const uintptr_t *data_offsets, std::vector<nd::array> &kwds_as_vector,
-                       const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing) const
-      {
-        fill_available_values(tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, available);
-        fill_missing_values(tp, arrmeta, arrmeta_offsets, data, data_offsets, kwds_as_vector, missing);
-      }
-
     public:
       kwds(intptr_t size, const char *const *names, array *values) : m_size(size), m_names(names), m_values(values)
       {
       }
 
-      void validate_names(const ndt::callable_type *af_tp, array &dst, std::vector<ndt::type> &kwd_tp,
-                          std::vector<intptr_t> &available, std::vector<intptr_t> &missing) const
+      void validate_names(const ndt::callable_type *af_tp, array &dst, small_vector<ndt::type> &kwd_tp,
+                          small_vector<intptr_t> &available, small_vector<intptr_t> &missing) const
       {
         bool has_dst_tp = false;
 
@@ -369,21 +315,11 @@ namespace nd {
         check_nkwd(af_tp, available, missing);
       }
 
-      array as_array(const ndt::type &tp, std::vector<nd::array> &kwds_as_vector,
-                     const std::vector<intptr_t> &available, const std::vector<intptr_t> &missing) const
+      void fill_values(const ndt::type *tp, small_vector<nd::array> &kwds_as_vector,
+                       const small_vector<intptr_t> &available, const small_vector<intptr_t> &missing) const
       {
-        array res = empty_shell(tp);
-        auto field_count = tp.extended<ndt::base_struct_type>()->get_field_count();
-        auto field_types = tp.extended<ndt::base_struct_type>()->get_field_types_raw();
-        ndt::struct_type::fill_default_data_offsets(field_count, field_types,
-                                                    reinterpret_cast<uintptr_t *>(res.get()->metadata()));
-
-        fill_values(field_types, res.get()->metadata(),
-                    res.get_type().extended<ndt::base_struct_type>()->get_arrmeta_offsets_raw(), res.data(),
-                    res.get_type().extended<ndt::base_struct_type>()->get_data_offsets(res.get()->metadata()),
-                    kwds_as_vector, available, missing);
-
-        return res;
+        fill_available_values(kwds_as_vector, available);
+        fill_missing_values(tp, kwds_as_vector, missing);
       }
     };
 
@@ -509,7 +445,7 @@ namespace nd {
       return [](char *static_data, size_t data_size, char *data, void *ckb, intptr_t ckb_offset,
                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                 const char *const *src_arrmeta, kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+                const array *kwds, const small_map<std::string, ndt::type> &tp_vars) {
         typedef instantiate_traits<decltype(&KernelType::instantiate)> traits;
         intptr_t res_ckb_offset =
             KernelType::instantiate(reinterpret_cast<typename traits::static_data_type *>(static_data), data_size,
@@ -543,7 +479,7 @@ namespace nd {
     {
       return [](char *static_data, size_t data_size, char *data, const ndt::type &dst_tp, intptr_t nsrc,
                 const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                const std::map<std::string, ndt::type> &tp_vars) {
+                const small_map<std::string, ndt::type> &tp_vars) {
         typedef data_init_traits<decltype(&KernelType::data_init)> traits;
         KernelType::data_init(reinterpret_cast<typename traits::static_data_type *>(static_data), data_size,
                               reinterpret_cast<typename traits::data_type *>(data), dst_tp, nsrc, src_tp, nkwd, kwds,
@@ -576,7 +512,7 @@ namespace nd {
     {
       return [](char *static_data, size_t data_size, char *data, ndt::type &dst_tp, intptr_t nsrc,
                 const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                const std::map<std::string, ndt::type> &tp_vars) {
+                const small_map<std::string, ndt::type> &tp_vars) {
         typedef resolve_dst_type_traits<decltype(&KernelType::resolve_dst_type)> traits;
         KernelType::resolve_dst_type(reinterpret_cast<typename traits::static_data_type *>(static_data), data_size,
                                      reinterpret_cast<typename traits::data_type *>(data), dst_tp, nsrc, src_tp, nkwd,
@@ -719,17 +655,58 @@ namespace nd {
       m_value.swap(rhs.m_value);
     }
 
-    /** Implements the general call operator which returns an array */
-    template <typename ArgsType, typename KwdsType>
-    array call(const ArgsType &args, const KwdsType &kwds, std::map<std::string, ndt::type> &tp_vars)
+    /**
+     * Turns on a cache of bound ckernels for this callable, so that repeated
+     * calls with the same argument types, arrmeta and keyword values reuse
+     * the ckernel instantiated by the first one.
+     */
+    void enable_cache(std::size_t capacity = 16)
     {
-      const ndt::callable_type *self_tp = get_type();
+      get()->set_cache_capacity(capacity);
+    }
 
-      array dst;
+    void disable_cache()
+    {
+      get()->set_cache_capacity(0);
+    }
+
+    /**
+     * Declares whether ckernels instantiated from this callable may execute
+     * at the same time on different threads, each thread with its own
+     * ckernel. Kernels sharing mutable state, like a random number
+     * generator, must not be declared thread safe. Only thread safe
+     * callables are split across threads by a parallel elwise.
+     */
+    void set_thread_safe(bool thread_safe)
+    {
+      get()->thread_safe = thread_safe;
+    }
+
+    bool is_thread_safe() const
+    {
+      return get()->thread_safe;
+    }
+
+    /** Returns the kernel cache, or NULL if it is not enabled */
+    const kernel_cache *get_cache() const
+    {
+      return get()->cache;
+    }
+
+    /**
+     * Validates the keyword arguments, fills in the missing ones, and
+     * provides them as one array per keyword in ``kwds_as_vector``. The
+     * special "dst" and "dst_tp" keywords are placed in ``dst``.
+     */
+    template <typename KwdsType>
+    void resolve_kwds(const KwdsType &kwds, array &dst, small_vector<nd::array> &kwds_as_vector,
+                      small_map<std::string, ndt::type> &tp_vars)
+    {
+      const ndt::callable_type *self_tp = get_type();
 
       // ...
-      std::vector<ndt::type> kwd_tp(self_tp->get_nkwd());
-      std::vector<intptr_t> available, missing;
+      small_vector<ndt::type> kwd_tp(self_tp->get_nkwd());
+      small_vector<intptr_t> available, missing;
       kwds.validate_names(self_tp, dst, kwd_tp, available, missing);
 
       // Validate the destination type, if it was provided
@@ -747,30 +724,55 @@ namespace nd {
       detail::validate_kwd_types(self_tp, kwd_tp, available, missing, tp_vars);
 
       // ...
-      std::vector<nd::array> kwds_as_vector(available.size() + missing.size());
-      array kwds_as_array =
-          kwds.as_array(ndt::struct_type::make(self_tp->get_kwd_names(), kwd_tp), kwds_as_vector, available, missing);
+      kwds_as_vector.resize(available.size() + missing.size());
+      kwds.fill_values(kwd_tp.data(), kwds_as_vector, available, missing);
+    }
+
+    /** Implements the general call operator which returns an array */
+    template <typename ArgsType, typename KwdsType>
+    array call(const ArgsType &args, const KwdsType &kwds, small_map<std::string, ndt::type> &tp_vars,
+               const eval::eval_context *ectx = &eval::default_eval_context)
+    {
+      const ndt::callable_type *self_tp = get_type();
+
+      array dst;
+      small_vector<nd::array> kwds_as_vector;
+      resolve_kwds(kwds, dst, kwds_as_vector, tp_vars);
 
       ndt::type dst_tp;
       if (dst.is_null()) {
         dst_tp = self_tp->get_return_type();
         return (*get())(dst_tp, args.size(), args.types(), args.arrmeta(), args.data(), kwds_as_vector.size(),
-                        kwds_as_vector.data(), tp_vars);
+                        kwds_as_vector.data(), tp_vars, ectx);
       }
 
       dst_tp = dst.get_type();
       (*get())(dst_tp, dst.get()->metadata(), dst.data(), args.size(), args.types(), args.arrmeta(), args.data(),
-               kwds_as_vector.size(), kwds_as_vector.data(), tp_vars);
+               kwds_as_vector.size(), kwds_as_vector.data(), tp_vars, ectx);
       return dst;
     }
 
+    /**
+     * call_with_ectx(ectx, a0, a1, ..., an, kwds<...>(...))
+     */
+    template <typename AT0, typename... T>
+    array _call_with_ectx(const eval::eval_context *ectx, T &&... a)
+    {
+      small_map<std::string, ndt::type> tp_vars;
+
+      typedef typename instantiate<args, typename to<type_sequence<AT0, T...>, sizeof...(T)>::type>::type args_type;
+      typedef make_index_sequence<sizeof...(T) + 1> I;
+      return call(make_with<I, args_type>(tp_vars, get_type(), std::forward<T>(a)...),
+                  dynd::get<sizeof...(T) - 1>(std::forward<T>(a)...), tp_vars, ectx);
+    }
+
     /**
     * operator()(kwds<...>(...))
     */
     template <template <typename...> class ArgsType, typename AT0, typename... K>
     array _call(detail::kwds<K...> &&k)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      small_map<std::string, ndt::type> tp_vars;
       return call(ArgsType<AT0>(tp_vars, get_type()), std::forward<detail::kwds<K...>>(k), tp_vars);
     }
 
@@ -780,7 +782,7 @@ namespace nd {
     template <template <typename...> class ArgsType, typename AT0, typename... T>
     typename std::enable_if<sizeof...(T) != 3, array>::type _call(T &&... a)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      small_map<std::string, ndt::type> tp_vars;
 
       typedef typename instantiate<ArgsType, typename to<type_sequence<AT0, T...>, sizeof...(T)>::type>::type args_type;
       typedef make_index_sequence<sizeof...(T) + 1> I;
@@ -793,7 +795,7 @@ namespace nd {
                             array>::type
     _call(A0 &&a0, A1 &&a1, const detail::kwds<K...> &kwds)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      small_map<std::string, ndt::type> tp_vars;
       return call(
           ArgsType<AT0, array, array>(tp_vars, get_type(), array(std::forward<A0>(a0)), array(std::forward<A1>(a1))),
           kwds, tp_vars);
@@ -804,11 +806,72 @@ namespace nd {
                             array>::type
     _call(A0 &&a0, A1 &&a1, const detail::kwds<K...> &kwds)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      small_map<std::string, ndt::type> tp_vars;
       return call(ArgsType<AT0, size_t, array *>(tp_vars, get_type(), std::forward<A0>(a0), std::forward<A1>(a1)), kwds,
                   tp_vars);
     }
 
+    /** Implements bind, instantiating the ckernel once for these arguments */
+    template <typename ArgsType, typename KwdsType>
+    bound_kernel bind_args(const ArgsType &args, const KwdsType &kwds, small_map<std::string, ndt::type> &tp_vars)
+    {
+      array dst;
+      small_vector<nd::array> kwds_as_vector;
+      resolve_kwds(kwds, dst, kwds_as_vector, tp_vars);
+
+      ndt::type dst_tp = dst.is_null() ? get_type()->get_return_type() : dst.get_type();
+      const char *dst_arrmeta = dst.is_null() ? NULL : dst.get()->metadata();
+      if (!bound_kernel::is_bindable(dst_tp, args.size(), args.types(), kwds_as_vector.size(),
+                                     kwds_as_vector.data())) {
+        throw std::invalid_argument("cannot bind a callable to arguments whose arrmeta holds references");
+      }
+
+      bound_kernel k(*get(), dst_tp, dst_arrmeta, args.size(), args.types(), args.arrmeta(), kwds_as_vector.size(),
+                     kwds_as_vector.data(), tp_vars);
+      if (!k.is_executable()) {
+        std::stringstream ss;
+        ss << "cannot bind a callable with return type " << k.get_dst_type() << ", its arrmeta holds references";
+        throw std::invalid_argument(ss.str());
+      }
+
+      return k;
+    }
+
+    /**
+     * bind(a0, a1, ..., an, kwds<...>(...))
+     */
+    template <typename... T>
+    bound_kernel _bind(T &&... a)
+    {
+      small_map<std::string, ndt::type> tp_vars;
+
+      typedef typename instantiate<args, typename to<type_sequence<char *, T...>, sizeof...(T)>::type>::type args_type;
+      typedef make_index_sequence<sizeof...(T) + 1> I;
+      return bind_args(make_with<I, args_type>(tp_vars, get_type(), std::forward<T>(a)...),
+                       dynd::get<sizeof...(T) - 1>(std::forward<T>(a)...), tp_vars);
+    }
+
+    /**
+     * Instantiates the ckernel this callable would use for arguments with
+     * the types and arrmeta of ``a0, ..., an`` (and the given keywords),
+     * returning it as a bound_kernel that can be executed repeatedly.
+     */
+    template <typename... A>
+    typename std::enable_if<has_kwds<A...>::value, bound_kernel>::type bind(A &&... a)
+    {
+      if (get()->kernreq != kernel_request_single) {
+        throw std::invalid_argument("only callables with single kernels can be bound");
+      }
+
+      return _bind(std::forward<A>(a)...);
+    }
+
+    template <typename... A>
+    typename std::enable_if<!has_kwds<A...>::value, bound_kernel>::type bind(A &&... a)
+    {
+      return bind(std::forward<A>(a)..., kwds());
+    }
+
     template <typename... A>
     typename std::enable_if<has_kwds<A...>::value, array>::type operator()(A &&... a)
     {
@@ -825,6 +888,28 @@ namespace nd {
       return (*this)(std::forward<A>(a)..., kwds());
     }
 
+    /**
+     * Calls the callable like the call operator, with the evaluation
+     * settings of ``ectx`` instead of the default eval context.
+     */
+    template <typename... A>
+    typename std::enable_if<has_kwds<A...>::value, array>::type call_with_ectx(const eval::eval_context *ectx,
+                                                                               A &&... a)
+    {
+      if (get()->kernreq == kernel_request_single) {
+        return _call_with_ectx<char *>(ectx, std::forward<A>(a)...);
+      }
+
+      return _call_with_ectx<array *>(ectx, std::forward<A>(a)...);
+    }
+
+    template <typename... A>
+    typename std::enable_if<!has_kwds<A...>::value, array>::type call_with_ectx(const eval::eval_context *ectx,
+                                                                                A &&... a)
+    {
+      return call_with_ectx(ectx, std::forward<A>(a)..., kwds());
+    }
+
     template <typename KernelType>
     static typename std::enable_if<
         ndt::type::has_equivalent<KernelType>::value &&detail::has_data_size<KernelType>::value, callable>::type
@@ -956,7 +1041,7 @@ namespace nd {
   template <typename DataType>
   class callable::args<DataType> {
   public:
-    args(std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars), const ndt::callable_type *self_tp)
+    args(small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars), const ndt::callable_type *self_tp)
     {
       detail::check_narg(self_tp, 0);
     }
@@ -988,7 +1073,7 @@ namespace nd {
     struct init {
       template <size_t I>
       void on_each(const args *self, const ndt::callable_type *af_tp, ndt::type *src_tp, const char **src_arrmeta,
-                   DataType *src_data, std::map<std::string, ndt::type> &tp_vars) const
+                   DataType *src_data, small_map<std::string, ndt::type> &tp_vars) const
       {
         auto &value = std::get<I>(self->m_values);
         const ndt::type &tp = ndt::type::make<decltype(value)>(value);
@@ -1008,7 +1093,7 @@ namespace nd {
     DataType m_data[sizeof...(A)];
 
   public:
-    args(std::map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, A &&... a)
+    args(small_map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, A &&... a)
         : m_values(std::forward<A>(a)...)
     {
       detail::check_narg(self_tp, sizeof...(A));
@@ -1047,7 +1132,7 @@ namespace nd {
     std::vector<DataType> m_data;
 
   public:
-    args(std::map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, size_t size, array *values)
+    args(small_map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, size_t size, array *values)
         : m_size(size), m_tp(m_size), m_arrmeta(m_size), m_data(m_size)
     {
       detail::check_narg(self_tp, m_size);
@@ -1156,6 +1241,12 @@ namespace nd {
       return get()(std::forward<A>(a)...);
     }
 
+    template <typename... A>
+    array call_with_ectx(const eval::eval_context *ectx, A &&... a)
+    {
+      return get().call_with_ectx(ectx, std::forward<A>(a)...);
+    }
+
     static callable &get()
     {
       static callable self = FuncType::make();
@@ -5,26 +5,43 @@
 
 #pragma once
 
+#include <map>
+#include <vector>
+
 #include <dynd/func/callable.hpp>
 
 namespace dynd {
 namespace func {
 
   /**
-   * Returns a reference to the map of registered callables.
+   * Returns a snapshot of the registered callables, by name. This
+   * constructs every callable which hasn't been constructed yet.
    * NOTE: The internal representation will change, this
    *       function will change.
    */
-  DYND_API std::map<std::string, nd::callable> &get_regfunctions();
+  DYND_API std::map<std::string, nd::callable> get_regfunctions();
+
+  /**
+   * Returns the names of the registered callables, in sorted order,
+   * without constructing them.
+   */
+  DYND_API std::vector<std::string> get_regfunction_names();
 
   /**
-    * Looks up a named callable from the registry.
+    * Looks up a named callable from the registry. Lookups don't take a lock,
+    * and may run concurrently with each other and with registrations.
     */
+  DYND_API nd::callable get_regfunction(const char *name);
   DYND_API nd::callable get_regfunction(const std::string &name);
   /**
     * Sets a named callable in the registry.
     */
   DYND_API void set_regfunction(const std::string &name, const nd::callable &af);
+  /**
+    * Sets a named callable in the registry, which ``make`` constructs the
+    * first time it is looked up.
+    */
+  DYND_API void set_lazy_regfunction(const std::string &name, nd::callable (*make)());
 
 } // namespace func
 } // namespace dynd
@@ -35,6 +35,8 @@ namespace nd {
           callable::make_all<K, numeric_type_ids, numeric_type_ids>(0);
 
       callable self = functional::call<F>(ndt::type("(Any, Any) -> Any"));
+      // The comparison kernels keep no state outside of their ckernel
+      self.set_thread_safe(true);
 
       for (type_id_t i0 : i2a<numeric_type_ids>()) {
         for (type_id_t i1 : i2a<dim_type_ids>()) {
@@ -148,6 +150,10 @@ namespace nd {
           callable::make<total_order_kernel<string_type_id, string_type_id>>();
       children[{{int32_type_id, int32_type_id}}] = callable::make<total_order_kernel<int32_type_id, int32_type_id>>();
       children[{{bool_type_id, bool_type_id}}] = callable::make<total_order_kernel<bool_type_id, bool_type_id>>();
+      children[{{float32_type_id, float32_type_id}}] =
+          callable::make<total_order_kernel<float32_type_id, float32_type_id>>();
+      children[{{float64_type_id, float64_type_id}}] =
+          callable::make<total_order_kernel<float64_type_id, float64_type_id>>();
 
       return functional::multidispatch(
           ndt::type("(Any, Any) -> Any"),
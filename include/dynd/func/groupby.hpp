@@ -0,0 +1,32 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/func/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * An callable which groups values by key and reduces each group, as in
+   *
+   *   nd::groupby(keys, values, kwds("func", "mean"))
+   *
+   * The keys may be integers, strings, categoricals, or structs of those to
+   * group by several columns. The values are a builtin type, or a struct of
+   * builtin types to reduce several columns. The ``func`` keyword is "sum"
+   * (the default), "min", "max" or "mean", which reduce each group with the
+   * element kernels of ``nd::sum``, ``nd::min`` and ``nd::max``.
+   *
+   * The result is a ``var * {key: K, value: V}`` with one element per
+   * distinct key, in the order the keys first appear.
+   */
+  extern DYND_API struct groupby : declfunc<groupby> {
+    static DYND_API callable make();
+  } groupby;
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -82,7 +82,7 @@ namespace nd {
             continue;
           }
 
-          std::map<std::string, ndt::type> tp_vars;
+          small_map<std::string, ndt::type> tp_vars;
           if (!tp.match(child.get_array_type(), tp_vars)) {
           }
 
@@ -58,7 +58,7 @@ namespace kernels {
                 const ndt::type *src_tp, const char *const *src_arrmeta,
                 kernel_request_t kernreq, const eval::eval_context *ectx,
                 intptr_t nkwd, const nd::array *kwds,
-                const std::map<std::string, ndt::type> &tp_vars)
+                const small_map<std::string, ndt::type> &tp_vars)
     {
       const std::pair<nd::callable, std::vector<intptr_t>> *data =
           reinterpret_cast<std::pair<nd::callable, std::vector<intptr_t>> *>(
@@ -151,7 +151,7 @@ namespace kernels {
                 const ndt::type *src_tp, const char *const *src_arrmeta,
                 kernel_request_t kernreq, const eval::eval_context *ectx,
                 intptr_t nkwd, const nd::array *kwds,
-                const std::map<std::string, ndt::type> &tp_vars)
+                const small_map<std::string, ndt::type> &tp_vars)
     {
       const std::pair<nd::callable, std::vector<intptr_t>> *data =
           reinterpret_cast<std::pair<nd::callable, std::vector<intptr_t>> *>(
@@ -13,10 +13,24 @@ namespace nd {
   /**
    * An callable which applies either a boolean masked or
    * an indexed take/"fancy indexing" operation.
+   *
+   * An indexed take accepts ``boundscheck=false`` when the indices are
+   * known to be in range, skipping the checks and the wrapping of negative
+   * indices.
    */
   extern DYND_API struct take : declfunc<take> {
     static DYND_API callable make();
   } take;
 
+  /**
+   * An callable which assigns values to the elements of an array at
+   * indices, the reverse of an indexed take. The target is the destination,
+   * so ``nd::put(ix, v, kwds("dst", a))`` does ``a[ix[i]] = v[i]`` in place,
+   * and it also accepts ``boundscheck=false``.
+   */
+  extern DYND_API struct put : declfunc<put> {
+    static DYND_API callable make();
+  } put;
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/config.hpp>
+#include <dynd/kernels/ckernel_prefix.hpp>
+
+#ifdef DYND_LLVM
+
+namespace dynd {
+namespace jit {
+
+  /**
+   * Registers the LLVM IR of a ckernel's single function. When libdynd is
+   * built with clang and the dynd plugin, the base_kernel wrappers embed the
+   * IR of their functions, and register it the first time a kernel of their
+   * type is made. The IR is a whole module, in which the function is the
+   * only definition.
+   *
+   * Returns true, so it can initialize a static.
+   */
+  DYND_API bool register_kernel_ir(void *single_func, const char *ir);
+
+  /** Returns the registered IR of a single function, or NULL */
+  DYND_API const char *get_kernel_ir(void *single_func);
+
+  /**
+   * One ckernel in a fused chain, called through its single function. Each
+   * source is either an argument of the fused function, if less than its
+   * number of sources, or the result of an earlier node, ``nsrc + i`` for
+   * node ``i``. The result of the last node is the result of the chain, and
+   * the others go in temporaries of ``dst_size`` bytes.
+   */
+  struct fused_node {
+    expr_single_t func;
+    std::vector<intptr_t> src;
+    size_t dst_size;
+    size_t dst_alignment;
+  };
+
+  /**
+   * The type of a JIT compiled chain. ``children`` are the ckernels of the
+   * nodes, in the same order, and the rest is like a strided ckernel.
+   */
+  typedef void (*fused_strided_t)(ckernel_prefix *const *children, char *dst, intptr_t dst_stride, char *const *src,
+                                  const intptr_t *src_stride, size_t count);
+
+  /**
+   * Compiles a strided loop which calls the nodes one element at a time,
+   * keeping the temporaries in registers or on the stack instead of in
+   * buffers. The single functions whose IR is registered are inlined, which
+   * lets LLVM optimize and vectorize across the whole chain, and the others
+   * are called by address.
+   *
+   * The compiled loops are cached by the functions, sizes and sources of the
+   * nodes, so instantiating a kernel tree of the same shape again only looks
+   * it up. Returns NULL if LLVM can't compile it.
+   */
+  DYND_API fused_strided_t compile_fused(intptr_t nsrc, const std::vector<fused_node> &nodes);
+
+} // namespace dynd::jit
+} // namespace dynd
+
+#endif // DYND_LLVM
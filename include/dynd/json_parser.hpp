@@ -8,11 +8,35 @@
 #include <dynd/array.hpp>
 
 namespace dynd {
+
+class json_structural_index;
+
 namespace ndt {
   namespace json {
 
     DYND_API void discover(ndt::type &res, const char *begin, const char *end);
 
+    /**
+     * Discovers the type of JSON which may be too large to look at all of.
+     * If it is an array, its elements are discovered in chunks, which are
+     * spread across ``ectx->nthreads`` threads, and the types of the chunks
+     * are combined with ``ndt::common_type`` in the same way as the
+     * elements are in the version above.
+     *
+     * If ``sample_limit`` is positive, only that many elements of the array
+     * are looked at. When the array has more, the rest of the JSON isn't
+     * read, and the array's dimension is var because its size isn't known.
+     *
+     * \param res  The discovered type.
+     * \param begin  The beginning of the UTF-8 buffer containing the JSON.
+     * \param end  One past the end of the UTF-8 buffer containing the JSON.
+     * \param sample_limit  The number of array elements to look at, or
+     *                      negative to look at all of them.
+     * \param ectx  An evaluation context.
+     */
+    DYND_API void discover(ndt::type &res, const char *begin, const char *end, intptr_t sample_limit,
+                           const eval::eval_context *ectx = &eval::default_eval_context);
+
     inline void discover(ndt::type &res, const std::string &str)
     {
       discover(res, str.data(), str.data() + str.size());
@@ -55,6 +79,11 @@ DYND_API void validate_json(const char *json_begin, const char *json_end);
  * The type must have a fixed data size, so every dimension must be
  * either variable-sized or fixed-sized, not a free variable.
  *
+ * The parse first builds a ``json_structural_index`` of the JSON. Fields of
+ * JSON objects which aren't in a struct type are skipped with it, so
+ * they are checked only for balanced brackets and terminated strings. Use
+ * ``validate_json`` to check them fully.
+ *
  * \param tp  The type to interpret the JSON data.
  * \param json_begin  The beginning of the UTF-8 buffer containing the JSON.
  * \param json_end  One past the end of the UTF-8 buffer containing the JSON.
@@ -69,6 +98,24 @@ DYND_API nd::array parse_json(const ndt::type &tp, const char *json_begin, const
  */
 DYND_API void parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx);
 
+/**
+ * Parses the JSON into data of type ``tp`` whose arrmeta has already been
+ * constructed, as when filling the elements of a buffer one after another.
+ * If ``index`` isn't NULL, it is rebuilt for this JSON and used as described
+ * for the version given a type, so one index can be reused across many
+ * calls without allocating.
+ *
+ * \param tp  The type of the data.
+ * \param arrmeta  The arrmeta of the data.
+ * \param data  The data to parse into.
+ * \param json_begin  The beginning of the UTF-8 buffer containing the JSON.
+ * \param json_end  One past the end of the UTF-8 buffer containing the JSON.
+ * \param index  A structural index to build and use, or NULL.
+ * \param ectx  An evaluation context.
+ */
+DYND_API void parse_json(const ndt::type &tp, const char *arrmeta, char *data, const char *json_begin,
+                         const char *json_end, json_structural_index *index, const eval::eval_context *ectx);
+
 /**
  * Parses the input json as the requested type. The input can be a string or a
  * bytes array. If the input is bytes, the parser assumes it is UTF-8 data.
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * An index of the structural characters of a JSON document, built in one
+ * vectorized pass over the text before the type-directed parse. The
+ * entries are the positions, in order, of every '{', '}', '[', ']', ':'
+ * and ',' outside of strings, and of every opening quote of a string.
+ *
+ * Each entry also has a match:
+ *
+ *  - for '{' and '[', the number of the entry of the matching '}' or ']'
+ *  - for an opening quote, the position of the closing quote
+ *  - for the others, ``no_match``
+ *
+ * With the matches, the parser can step over a whole object, array or
+ * string without looking at its contents, which is how fields of a JSON
+ * object that aren't in the struct type being parsed are skipped.
+ *
+ * Building checks only that the brackets are balanced and the strings are
+ * terminated. If they are not, or the text is 4 GiB or larger, the index is
+ * not valid and is empty, and the parser falls back to reading the text a
+ * character at a time.
+ */
+class DYND_API json_structural_index {
+  // Both arrays have m_capacity elements, of which m_size are used. They
+  // are grown with realloc, without initializing the new elements.
+  uint32 *m_positions;
+  uint32 *m_matches;
+  size_t m_size, m_capacity;
+  bool m_valid;
+
+  /** Non-copyable */
+  json_structural_index(const json_structural_index &);
+  json_structural_index &operator=(const json_structural_index &);
+
+public:
+  static const uint32 no_match = 0xffffffffu;
+
+  json_structural_index() : m_positions(NULL), m_matches(NULL), m_size(0), m_capacity(0), m_valid(false)
+  {
+  }
+
+  json_structural_index(const char *begin, const char *end)
+      : m_positions(NULL), m_matches(NULL), m_size(0), m_capacity(0), m_valid(false)
+  {
+    build(begin, end);
+  }
+
+  ~json_structural_index();
+
+  /** Replaces the index with the index of the text [begin, end) */
+  void build(const char *begin, const char *end);
+
+  bool is_valid() const
+  {
+    return m_valid;
+  }
+
+  size_t size() const
+  {
+    return m_size;
+  }
+
+  /** The offset of entry ``i`` from the beginning of the text */
+  uint32 position(size_t i) const
+  {
+    return m_positions[i];
+  }
+
+  /** The match of entry ``i``, as described in the class comment */
+  uint32 match(size_t i) const
+  {
+    return m_matches[i];
+  }
+};
+
+} // namespace dynd
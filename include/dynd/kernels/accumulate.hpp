@@ -0,0 +1,339 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include <dynd/config.hpp>
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/kernels/simd.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * The number of independent accumulators the reduction loops keep. Each
+   * one carries its own dependency chain, so the additions (or comparisons)
+   * can overlap in the pipeline and be packed into vector registers.
+   */
+  static const std::size_t accumulator_count = 8;
+
+  /**
+   * The run length below which a pairwise sum stops splitting and sums the
+   * block directly with the independent accumulators.
+   */
+  static const std::size_t pairwise_block_size = 128;
+
+  template <typename T>
+  DYND_SIMD_INLINE T sum_contiguous_body(const T *src, std::size_t count)
+  {
+    T acc[accumulator_count] = {};
+    std::size_t i = 0;
+    for (; i + accumulator_count <= count; i += accumulator_count) {
+      for (std::size_t j = 0; j < accumulator_count; ++j) {
+        acc[j] += src[i + j];
+      }
+    }
+    for (; i < count; ++i) {
+      acc[0] += src[i];
+    }
+
+    // Combine the accumulators pairwise as well
+    for (std::size_t n = accumulator_count / 2; n > 0; n /= 2) {
+      for (std::size_t j = 0; j < n; ++j) {
+        acc[j] += acc[j + n];
+      }
+    }
+
+    return acc[0];
+  }
+
+  template <typename T>
+  DYND_SIMD_INLINE void max_contiguous_body(T *acc, const T *src, std::size_t count)
+  {
+    for (std::size_t i = 0; i + accumulator_count <= count; i += accumulator_count) {
+      for (std::size_t j = 0; j < accumulator_count; ++j) {
+        acc[j] = (src[i + j] > acc[j]) ? src[i + j] : acc[j];
+      }
+    }
+  }
+
+  template <typename T>
+  DYND_SIMD_INLINE void min_contiguous_body(T *acc, const T *src, std::size_t count)
+  {
+    for (std::size_t i = 0; i + accumulator_count <= count; i += accumulator_count) {
+      for (std::size_t j = 0; j < accumulator_count; ++j) {
+        acc[j] = (src[i + j] < acc[j]) ? src[i + j] : acc[j];
+      }
+    }
+  }
+
+  /**
+   * The contiguous loops of the builtin reductions, each compiled once per
+   * instruction set and selected for the running CPU the first time it is
+   * used. ``max`` and ``min`` only process whole groups of
+   * ``accumulator_count`` elements, leaving the tail to the caller.
+   */
+  template <typename T>
+  struct contiguous_reduce {
+    typedef T (*sum_type)(const T *src, std::size_t count);
+    typedef void (*compare_type)(T *acc, const T *src, std::size_t count);
+
+    static T sum_generic(const T *src, std::size_t count)
+    {
+      return sum_contiguous_body(src, count);
+    }
+
+    static void max_generic(T *acc, const T *src, std::size_t count)
+    {
+      max_contiguous_body(acc, src, count);
+    }
+
+    static void min_generic(T *acc, const T *src, std::size_t count)
+    {
+      min_contiguous_body(acc, src, count);
+    }
+
+#ifdef DYND_SIMD_DISPATCH
+    DYND_TARGET_AVX2 static T sum_avx2(const T *src, std::size_t count)
+    {
+      return sum_contiguous_body(src, count);
+    }
+
+    DYND_TARGET_AVX2 static void max_avx2(T *acc, const T *src, std::size_t count)
+    {
+      max_contiguous_body(acc, src, count);
+    }
+
+    DYND_TARGET_AVX2 static void min_avx2(T *acc, const T *src, std::size_t count)
+    {
+      min_contiguous_body(acc, src, count);
+    }
+#endif
+
+    static T sum(const T *src, std::size_t count)
+    {
+#ifdef DYND_SIMD_DISPATCH
+      static const sum_type loop = (get_simd_isa() == simd_isa_avx2) ? &sum_avx2 : &sum_generic;
+#else
+      static const sum_type loop = &sum_generic;
+#endif
+      return loop(src, count);
+    }
+
+    static void max(T *acc, const T *src, std::size_t count)
+    {
+#ifdef DYND_SIMD_DISPATCH
+      static const compare_type loop = (get_simd_isa() == simd_isa_avx2) ? &max_avx2 : &max_generic;
+#else
+      static const compare_type loop = &max_generic;
+#endif
+      loop(acc, src, count);
+    }
+
+    static void min(T *acc, const T *src, std::size_t count)
+    {
+#ifdef DYND_SIMD_DISPATCH
+      static const compare_type loop = (get_simd_isa() == simd_isa_avx2) ? &min_avx2 : &min_generic;
+#else
+      static const compare_type loop = &min_generic;
+#endif
+      loop(acc, src, count);
+    }
+  };
+
+  /**
+   * Sums ``count`` elements of builtin arithmetic type with independent
+   * accumulators, using the vectorized loop when the elements are
+   * contiguous.
+   */
+  template <typename T>
+  T sum_block(const char *src, intptr_t src_stride, std::size_t count)
+  {
+    if (src_stride == static_cast<intptr_t>(sizeof(T))) {
+      return contiguous_reduce<T>::sum(reinterpret_cast<const T *>(src), count);
+    }
+
+    T acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      acc[0] += *reinterpret_cast<const T *>(src);
+      acc[1] += *reinterpret_cast<const T *>(src + src_stride);
+      acc[2] += *reinterpret_cast<const T *>(src + 2 * src_stride);
+      acc[3] += *reinterpret_cast<const T *>(src + 3 * src_stride);
+      src += 4 * src_stride;
+    }
+    for (; i < count; ++i) {
+      acc[0] += *reinterpret_cast<const T *>(src);
+      src += src_stride;
+    }
+
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+
+  /**
+   * Sums by splitting the run in half until the halves are short enough for
+   * ``sum_block``, which bounds the rounding error by O(log n) at close to
+   * the speed of the plain loop.
+   */
+  template <typename T>
+  T pairwise_sum(const char *src, intptr_t src_stride, std::size_t count)
+  {
+    if (count <= pairwise_block_size) {
+      return sum_block<T>(src, src_stride, count);
+    }
+
+    // Keep the first half a whole number of accumulator groups
+    std::size_t half = count / 2;
+    half -= half % accumulator_count;
+    return pairwise_sum<T>(src, src_stride, half) + pairwise_sum<T>(src + half * src_stride, src_stride, count - half);
+  }
+
+  /** One step of Neumaier's compensated addition, returning the rounding error */
+  template <typename T>
+  T add_compensated(T &sum, T value)
+  {
+    T t = sum + value;
+    T error = (std::abs(sum) >= std::abs(value)) ? (sum - t) + value : (value - t) + sum;
+    sum = t;
+    return error;
+  }
+
+  /**
+   * Compensated summation in the second order Kahan-Babuska (Klein) form.
+   * The rounding errors are themselves summed with compensation, which keeps
+   * the result accurate both when an addend is larger than the running sum
+   * and when the errors add up over very long runs.
+   */
+  template <typename T>
+  T kahan_sum(T init, const char *src, intptr_t src_stride, std::size_t count)
+  {
+    T sum = init;
+    T compensation = 0;
+    T second_compensation = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      second_compensation += add_compensated(compensation, add_compensated(sum, *reinterpret_cast<const T *>(src)));
+      src += src_stride;
+    }
+
+    return sum + (compensation + second_compensation);
+  }
+
+  template <typename T, bool Arithmetic = std::is_arithmetic<T>::value,
+            bool FloatingPoint = std::is_floating_point<T>::value>
+  struct accumulate;
+
+  /** Sums, minimums and maximums of a type without a vectorized loop */
+  template <typename T>
+  struct accumulate<T, false, false> {
+    static T sum(eval::summation_t DYND_UNUSED(summation), T init, const char *src, intptr_t src_stride,
+                 std::size_t count)
+    {
+      T acc = init;
+      for (std::size_t i = 0; i < count; ++i) {
+        acc = acc + *reinterpret_cast<const T *>(src);
+        src += src_stride;
+      }
+
+      return acc;
+    }
+
+    static T max(T init, const char *src, intptr_t src_stride, std::size_t count)
+    {
+      T acc = init;
+      for (std::size_t i = 0; i < count; ++i) {
+        if (*reinterpret_cast<const T *>(src) > acc) {
+          acc = *reinterpret_cast<const T *>(src);
+        }
+        src += src_stride;
+      }
+
+      return acc;
+    }
+
+    static T min(T init, const char *src, intptr_t src_stride, std::size_t count)
+    {
+      T acc = init;
+      for (std::size_t i = 0; i < count; ++i) {
+        if (*reinterpret_cast<const T *>(src) < acc) {
+          acc = *reinterpret_cast<const T *>(src);
+        }
+        src += src_stride;
+      }
+
+      return acc;
+    }
+  };
+
+  /** Sums, minimums and maximums of the builtin integer types */
+  template <typename T>
+  struct accumulate<T, true, false> : accumulate<T, false, false> {
+    // Integer sums are exact, so every summation mode uses the fast loop
+    static T sum(eval::summation_t DYND_UNUSED(summation), T init, const char *src, intptr_t src_stride,
+                 std::size_t count)
+    {
+      return init + sum_block<T>(src, src_stride, count);
+    }
+
+    static T max(T init, const char *src, intptr_t src_stride, std::size_t count)
+    {
+      if (src_stride != static_cast<intptr_t>(sizeof(T)) || count < accumulator_count) {
+        return accumulate<T, false, false>::max(init, src, src_stride, count);
+      }
+
+      T acc[accumulator_count];
+      for (std::size_t j = 0; j < accumulator_count; ++j) {
+        acc[j] = init;
+      }
+      contiguous_reduce<T>::max(acc, reinterpret_cast<const T *>(src), count);
+
+      // The accumulators are combined in order, so a NaN ``init`` stays
+      // the result exactly as it would with the sequential loop
+      std::size_t tail = count - count % accumulator_count;
+      return accumulate<T, false, false>::max(accumulate<T, false, false>::max(acc[0], reinterpret_cast<char *>(acc + 1),
+                                                                               sizeof(T), accumulator_count - 1),
+                                              src + tail * sizeof(T), sizeof(T), count - tail);
+    }
+
+    static T min(T init, const char *src, intptr_t src_stride, std::size_t count)
+    {
+      if (src_stride != static_cast<intptr_t>(sizeof(T)) || count < accumulator_count) {
+        return accumulate<T, false, false>::min(init, src, src_stride, count);
+      }
+
+      T acc[accumulator_count];
+      for (std::size_t j = 0; j < accumulator_count; ++j) {
+        acc[j] = init;
+      }
+      contiguous_reduce<T>::min(acc, reinterpret_cast<const T *>(src), count);
+
+      std::size_t tail = count - count % accumulator_count;
+      return accumulate<T, false, false>::min(accumulate<T, false, false>::min(acc[0], reinterpret_cast<char *>(acc + 1),
+                                                                               sizeof(T), accumulator_count - 1),
+                                              src + tail * sizeof(T), sizeof(T), count - tail);
+    }
+  };
+
+  /** Sums, minimums and maximums of the builtin floating point types */
+  template <typename T>
+  struct accumulate<T, true, true> : accumulate<T, true, false> {
+    static T sum(eval::summation_t summation, T init, const char *src, intptr_t src_stride, std::size_t count)
+    {
+      switch (summation) {
+      case eval::summation_kahan:
+        return kahan_sum<T>(init, src, src_stride, count);
+      case eval::summation_fast:
+        return init + sum_block<T>(src, src_stride, count);
+      default:
+        return init + pairwise_sum<T>(src, src_stride, count);
+      }
+    }
+  };
+
+} // namespace dynd::detail
+} // namespace dynd
@@ -8,6 +8,7 @@
 #include <dynd/strided_vals.hpp>
 #include <dynd/kernels/cuda_launch.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/gfunc/call_gcallable.hpp>
 
 namespace dynd {
@@ -153,6 +154,13 @@ namespace nd {
     __VA_ARGS__ void strided(char *dst, intptr_t dst_stride, char *const *DYND_IGNORE_UNUSED(src_copy),                \
                              const intptr_t *DYND_IGNORE_UNUSED(src_stride), size_t count)                             \
     {                                                                                                                  \
+      /* Contiguous operands of builtin types take a loop vectorized for the CPU */                                    \
+      if (dynd::detail::contiguous_apply<func_type, func, R, type_sequence<A...>,                                      \
+                                         std::is_arithmetic<R>::value && sizeof...(K) == 0>::run(                      \
+              dst, dst_stride, src_copy, src_stride, count)) {                                                         \
+        return;                                                                                                        \
+      }                                                                                                                \
+                                                                                                                       \
       dynd::detail::array_wrapper<char *, sizeof...(A)> src;                                                           \
                                                                                                                        \
       dst += DYND_THREAD_ID(0) * dst_stride;                                                                           \
@@ -174,7 +182,7 @@ namespace nd {
                                 const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),            \
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,   \
                                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,  \
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))   \
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))   \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -226,7 +234,7 @@ namespace nd {
                                 const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),            \
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,   \
                                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,  \
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))   \
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))   \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -299,7 +307,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, reinterpret_cast<data_type *>(static_data)->first,                     \
                       dynd::detail::make_value_wrapper(reinterpret_cast<data_type *>(static_data)->second),            \
@@ -312,7 +320,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename T, typename mem_func_type, typename... A, size_t... I, typename... K, size_t... J>                \
@@ -366,7 +374,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, reinterpret_cast<data_type *>(static_data)->first,                     \
                       dynd::detail::make_value_wrapper(reinterpret_cast<data_type *>(static_data)->second),            \
@@ -379,7 +387,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   }
 
     APPLY_MEMBER_FUNCTION_CK();
@@ -395,7 +403,7 @@ namespace nd {
                                                                 kernel_request_t kernreq,
                                                                 const eval::eval_context *ectx, intptr_t nkwd,
                                                                 const nd::array *kwds,
-                                                                const std::map<std::string, ndt::type> &tp_vars)
+                                                                const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -412,7 +420,7 @@ namespace nd {
                                                                 kernel_request_t kernreq,
                                                                 const eval::eval_context *ectx, intptr_t nkwd,
                                                                 const nd::array *kwds,
-                                                                const std::map<std::string, ndt::type> &tp_vars)
+                                                                const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -480,7 +488,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset,                                                                        \
                       dynd::detail::make_value_wrapper(*reinterpret_cast<func_type *>(static_data)),                   \
@@ -493,7 +501,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -545,7 +553,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset,                                                                        \
                       dynd::detail::make_value_wrapper(*reinterpret_cast<func_type *>(static_data)),                   \
@@ -557,7 +565,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   }
 
     APPLY_CALLABLE_CK();
@@ -572,7 +580,7 @@ namespace nd {
                                                          const char *const *src_arrmeta, kernel_request_t kernreq,
                                                          const eval::eval_context *ectx, intptr_t nkwd,
                                                          const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -630,7 +638,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
                                                                                                                        \
       self_type::make(ckb, kernreq, ckb_offset, *reinterpret_cast<func_type **>(static_data),                          \
@@ -643,7 +651,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -695,7 +703,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
                                                                                                                        \
       self_type::make(ckb, kernreq, ckb_offset, *reinterpret_cast<func_type **>(static_data),                          \
@@ -708,7 +716,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   }
 
     APPLY_CALLABLE_CK();
@@ -723,7 +731,7 @@ namespace nd {
                                                          const char *const *src_arrmeta, kernel_request_t kernreq,
                                                          const eval::eval_context *ectx, intptr_t nkwd,
                                                          const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -739,7 +747,7 @@ namespace nd {
                                                          const char *const *src_arrmeta, kernel_request_t kernreq,
                                                          const eval::eval_context *ectx, intptr_t nkwd,
                                                          const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -805,7 +813,7 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),               \
         intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
         const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds,                             \
-        const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                                                  \
+        const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                                                  \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -816,7 +824,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -866,7 +874,7 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),               \
         intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
         const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds,                             \
-        const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                                                  \
+        const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                                                  \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -877,7 +885,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,                       \
                                 const char *const *src_arrmeta, kernel_request_t kernreq,                              \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const small_map<std::string, ndt::type> &tp_vars);                                      \
   }
 
     CONSTRUCT_THEN_APPLY_CALLABLE_CK();
@@ -890,7 +898,7 @@ namespace nd {
                                            const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                            const char *const *src_arrmeta, kernel_request_t kernreq,
                                            const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                           const std::map<std::string, ndt::type> &tp_vars)
+                                           const small_map<std::string, ndt::type> &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
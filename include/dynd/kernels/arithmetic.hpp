@@ -94,7 +94,7 @@ namespace detail{
     resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
                      char *data, ndt::type &dst_tp, intptr_t nsrc,
                      const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars)
+                     const small_map<std::string, ndt::type> &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {src_tp[0].extended<ndt::option_type>()->get_value_type(),
@@ -119,7 +119,7 @@ namespace detail{
                                 const eval::eval_context *ectx,
                                 intptr_t nkwd,
                                 const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
@@ -204,7 +204,7 @@ namespace detail{
     resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
                      char *data, ndt::type &dst_tp, intptr_t nsrc,
                      const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars)
+                     const small_map<std::string, ndt::type> &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {
@@ -230,7 +230,7 @@ namespace detail{
                                 const eval::eval_context *ectx,
                                 intptr_t nkwd,
                                 const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
@@ -320,7 +320,7 @@ namespace detail{
     resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
                      char *data, ndt::type &dst_tp, intptr_t nsrc,
                      const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars)
+                     const small_map<std::string, ndt::type> &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {
@@ -347,7 +347,7 @@ namespace detail{
                                 const eval::eval_context *ectx,
                                 intptr_t nkwd,
                                 const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
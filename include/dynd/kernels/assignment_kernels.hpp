@@ -14,6 +14,7 @@
 #include <dynd/kernels/cuda_launch.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/eval/eval_context.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/type_id.hpp>
@@ -110,7 +111,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         switch (ectx->errmode) {
         case assign_error_nocheck:
@@ -151,6 +152,19 @@ namespace nd {
 
         *reinterpret_cast<dst_type *>(dst) = static_cast<dst_type>(*reinterpret_cast<src_type *>(src[0]));
       }
+
+#if !DYND_ASSIGNMENT_TRACING
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        typedef dynd::detail::cast_as<dst_type, src_type> cast_type;
+
+        // Contiguous builtin values take a loop vectorized for the CPU
+        if (!dynd::detail::contiguous_apply<decltype(&cast_type::f), &cast_type::f, dst_type,
+                                            type_sequence<src_type>>::run(dst, dst_stride, src, src_stride, count)) {
+          base_kernel<assignment_kernel, 1>::strided(dst, dst_stride, src, src_stride, count);
+        }
+      }
+#endif
     };
 
     /*
@@ -1604,7 +1618,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], src_arrmeta[0], ectx->errmode,
                                 ectx->date_parse_order, ectx->century_window);
@@ -1644,7 +1658,7 @@ namespace nd {
                                   const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, ectx);
         return ckb_offset;
@@ -1691,7 +1705,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, src_tp[0], src_arrmeta[0], ectx->date_parse_order,
                                 ectx->century_window);
@@ -1735,7 +1749,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], ectx);
         return ckb_offset;
@@ -1778,7 +1792,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], src_arrmeta[0], ectx->errmode);
         return ckb_offset;
@@ -1817,7 +1831,7 @@ namespace nd {
                                   const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, ectx);
         return ckb_offset;
@@ -1926,7 +1940,7 @@ namespace nd {
                                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         intptr_t root_ckb_offset = ckb_offset;
         typedef assignment_kernel self_type;
@@ -2015,7 +2029,7 @@ namespace nd {
                                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         // Deal with some float32 to option[T] conversions where any NaN is
         // interpreted
@@ -2034,7 +2048,7 @@ namespace nd {
                                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         // Deal with some string to option[T] conversions where string values
         // might mean NA
@@ -2155,7 +2169,7 @@ namespace nd {
                                 void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
                                 intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t root_ckb_offset = ckb_offset;
       typedef dynd::nd::option_to_value_ck self_type;
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <dynd/jit.hpp>
 #include <dynd/kernels/ckernel_builder.hpp>
 #include <dynd/types/callable_type.hpp>
 
@@ -104,7 +105,7 @@ namespace nd {
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       SelfType::make(ckb, kernreq, ckb_offset);
       return ckb_offset;
@@ -139,6 +140,20 @@ namespace nd {
   template <typename SelfType, int... N>
   struct base_kernel;
 
+/**
+ * With LLVM, the first kernel of each type which is made registers the IR of
+ * its single function, if the dynd plugin embedded it, so the JIT can inline
+ * it into fused chains.
+ */
+#ifdef DYND_LLVM
+#define DYND_REGISTER_KERNEL_IR                                                                                        \
+  static const bool ir_registered = jit::register_kernel_ir(reinterpret_cast<void *>(single_wrapper::func),          \
+                                                            const_cast<const char *>(single_wrapper::ir));            \
+  (void)ir_registered
+#else
+#define DYND_REGISTER_KERNEL_IR
+#endif
+
 /**
  * This is a helper macro for this header file. It's the memory kernel requests
  * (kernel_request_host is the only one without CUDA enabled) to appropriate
@@ -158,6 +173,7 @@ namespace nd {
     static SelfType *init(ckernel_prefix *rawself, kernel_request_t kernreq, A &&... args)                             \
     {                                                                                                                  \
       SelfType *self = parent_type::init(rawself, kernreq, std::forward<A>(args)...);                                  \
+      DYND_REGISTER_KERNEL_IR;                                                                                         \
       switch (kernreq) {                                                                                               \
       case kernel_request_single:                                                                                      \
       case kernel_request_array:                                                                                       \
@@ -238,6 +254,7 @@ namespace nd {
   BASE_KERNEL(kernel_request_host);
 
 #undef BASE_KERNEL
+#undef DYND_REGISTER_KERNEL_IR
 
 } // namespace dynd::nd
 
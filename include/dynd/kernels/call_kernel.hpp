@@ -11,7 +11,7 @@ namespace nd {
                           char *data, const ndt::type &dst_tp, intptr_t nsrc,
                           const ndt::type *src_tp, intptr_t nkwd,
                           const nd::array *kwds,
-                          const std::map<std::string, ndt::type> &tp_vars)
+                          const small_map<std::string, ndt::type> &tp_vars)
     {
       CallableType::get().get()->data_init(
           CallableType::get().get()->static_data, data_size, data, dst_tp, nsrc,
@@ -22,7 +22,7 @@ namespace nd {
     resolve_dst_type(char *DYND_UNUSED(static_data), size_t data_size,
                      char *data, ndt::type &dst_tp, intptr_t nsrc,
                      const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars)
+                     const small_map<std::string, ndt::type> &tp_vars)
     {
       CallableType::get().get()->resolve_dst_type(
           CallableType::get().get()->static_data, data_size, data, dst_tp, nsrc,
@@ -34,7 +34,7 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+        const array *kwds, const small_map<std::string, ndt::type> &tp_vars)
     {
       return CallableType::get().get()->instantiate(
           CallableType::get().get()->static_data, data_size, data, ckb,
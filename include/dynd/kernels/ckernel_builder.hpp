@@ -425,7 +425,7 @@ inline intptr_t ckernel_prefix::instantiate(
     const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
     const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
     const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   void *func;
   switch (kernreq) {
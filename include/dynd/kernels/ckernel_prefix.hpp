@@ -11,6 +11,7 @@
 
 #include <dynd/config.hpp>
 #include <dynd/diagnostics.hpp>
+#include <dynd/small_map.hpp>
 #include <dynd/typed_data_assign.hpp>
 
 namespace dynd {
@@ -145,7 +146,7 @@ struct DYND_API ckernel_prefix {
                               const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                               kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
                               intptr_t DYND_UNUSED(nkwds), const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                              const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
 };
 
 template <template <kernel_request_t, typename...> class F, kernel_request_t kernreq, typename T, bool flatten = false>
@@ -146,7 +146,7 @@ namespace nd {
                                 const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t DYND_UNUSED(kernreq), const eval::eval_context *ectx,
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                                const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
   };
 
   template <type_id_t I0, type_id_t I1>
@@ -224,7 +224,7 @@ namespace nd {
                                 const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t DYND_UNUSED(kernreq), const eval::eval_context *ectx,
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                                const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
   };
 
   template <type_id_t I0, type_id_t I1>
@@ -299,7 +299,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
@@ -350,7 +350,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
@@ -405,7 +405,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
@@ -8,6 +8,7 @@
 #include <dynd/arrmeta_holder.hpp>
 #include <dynd/buffer_storage.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/jit.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 
 namespace dynd {
@@ -17,6 +18,11 @@ namespace nd {
     /**
      * A kernel for chaining two other kernels, using temporary buffers
      * dynamically allocated on the heap.
+     *
+     * With LLVM, when the intermediate type is POD without arrmeta, a strided
+     * request instead makes single child kernels and JIT compiles a loop
+     * which runs both for each element, with the intermediate value on the
+     * stack.
      */
     // All methods are inlined, so this does not need to be declared DYND_API.
     struct compose_kernel : base_kernel<compose_kernel, 1> {
@@ -35,9 +41,18 @@ namespace nd {
       ndt::type buffer_tp;
       arrmeta_holder buffer_arrmeta;
       std::vector<intptr_t> buffer_shape;
+#ifdef DYND_LLVM
+      // Whether the children are single kernels, for a fused loop
+      bool fused_children;
+      jit::fused_strided_t fused_func;
+#endif
 
       compose_kernel(const ndt::type &buffer_tp) : buffer_tp(buffer_tp)
       {
+#ifdef DYND_LLVM
+        fused_children = false;
+        fused_func = NULL;
+#endif
         arrmeta_holder(this->buffer_tp).swap(buffer_arrmeta);
         buffer_arrmeta.arrmeta_default_construct(true);
         buffer_shape.push_back(DYND_BUFFER_CHUNK_SIZE);
@@ -67,8 +82,39 @@ namespace nd {
         second_func(second, dst, &buffer_data);
       }
 
+#ifdef DYND_LLVM
+      void fused_strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        ckernel_prefix *children[2] = {get_child(), get_child(second_offset)};
+        if (fused_func != NULL) {
+          fused_func(children, dst, dst_stride, src, src_stride, count);
+          return;
+        }
+
+        // LLVM couldn't compile the loop, so call the single kernels directly
+        expr_single_t first_func = children[0]->get_function<expr_single_t>();
+        expr_single_t second_func = children[1]->get_function<expr_single_t>();
+        std::vector<char> buffer(buffer_tp.get_data_size());
+        char *buffer_data = buffer.data();
+        char *src0 = src[0];
+        for (size_t i = 0; i != count; ++i) {
+          first_func(children[0], buffer_data, &src0);
+          second_func(children[1], dst, &buffer_data);
+          src0 += src_stride[0];
+          dst += dst_stride;
+        }
+      }
+#endif
+
       void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
       {
+#ifdef DYND_LLVM
+        if (fused_children) {
+          fused_strided(dst, dst_stride, src, src_stride, count);
+          return;
+        }
+#endif
+
         // Allocate a temporary buffer on the heap
         array buffer = empty(buffer_shape[0], buffer_tp);
         char *buffer_data = buffer.data();
@@ -101,7 +147,7 @@ namespace nd {
       static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
                                    char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
                                    const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
-                                   const array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &tp_vars)
+                                   const array *DYND_UNUSED(kwds), const small_map<std::string, ndt::type> &tp_vars)
       {
         dst_tp = ndt::substitute(dst_tp, tp_vars, true);
       }
@@ -116,7 +162,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         const struct static_data *static_data_x = reinterpret_cast<struct static_data *>(static_data);
 
@@ -127,6 +173,34 @@ namespace nd {
 
         intptr_t root_ckb_offset = ckb_offset;
         compose_kernel *self = make(ckb, kernreq, ckb_offset, static_data_x->buffer_tp);
+#ifdef DYND_LLVM
+        if ((kernreq & kernel_request_memory) == kernel_request_host &&
+            (kernreq & ~kernel_request_memory) == kernel_request_strided && buffer_tp.is_pod() &&
+            buffer_tp.get_arrmeta_size() == 0) {
+          self->fused_children = true;
+          ckb_offset = first->instantiate(first->static_data, data_size, data, ckb, ckb_offset, buffer_tp, NULL, 1,
+                                          src_tp, src_arrmeta, kernel_request_single, ectx, nkwd, kwds, tp_vars);
+          self = get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+          self->second_offset = ckb_offset - root_ckb_offset;
+          const char *buffer_arrmeta = NULL;
+          ckb_offset = second->instantiate(second->static_data, data_size - first->data_size, data + first->data_size,
+                                           ckb, ckb_offset, dst_tp, dst_arrmeta, 1, &buffer_tp, &buffer_arrmeta,
+                                           kernel_request_single, ectx, nkwd, kwds, tp_vars);
+          self = get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+
+          std::vector<jit::fused_node> nodes(2);
+          nodes[0].func = self->get_child()->get_function<expr_single_t>();
+          nodes[0].src.push_back(0);
+          nodes[0].dst_size = buffer_tp.get_data_size();
+          nodes[0].dst_alignment = buffer_tp.get_data_alignment();
+          nodes[1].func = self->get_child(self->second_offset)->get_function<expr_single_t>();
+          nodes[1].src.push_back(1);
+          nodes[1].dst_size = dst_tp.get_data_size();
+          nodes[1].dst_alignment = dst_tp.get_data_alignment();
+          self->fused_func = jit::compile_fused(1, nodes);
+          return ckb_offset;
+        }
+#endif
         ckb_offset =
             first->instantiate(first->static_data, data_size, data, ckb, ckb_offset, buffer_tp,
                                self->buffer_arrmeta.get(), 1, src_tp, src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -15,14 +15,14 @@ namespace nd {
     resolve_dst_type(char *static_data, size_t data_size, char *data,
                      ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                      intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars);
+                     const small_map<std::string, ndt::type> &tp_vars);
 
     static intptr_t instantiate(
         char *static_data, size_t data_size, char *data, void *ckb,
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
   };
 
 } // namespace dynd::nd
@@ -12,6 +12,7 @@
 #include <dynd/types/dim_fragment_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -34,7 +35,7 @@ namespace nd {
     struct elwise_virtual_ck : base_virtual_kernel<elwise_virtual_ck<N>> {
       static void resolve_dst_type(char *static_data, size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
                                    ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-                                   const dynd::nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                   const dynd::nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         const callable_type_data *child_af = reinterpret_cast<callable *>(static_data)->get();
         const ndt::callable_type *child_af_tp = reinterpret_cast<callable *>(static_data)->get_type();
@@ -127,7 +128,7 @@ namespace nd {
                                   intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta,
                                   dynd::kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                  const dynd::nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                  const dynd::nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
 
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
@@ -224,6 +225,80 @@ namespace nd {
       }
     };
 
+    /**
+     * Returns the number of chunks, one per thread, the outer dimension of
+     * an elwise ckernel should be split into, or 1 to run it on the calling
+     * thread. Only a top level ckernel (a single request on the host) of a
+     * callable declared thread safe is split, and then only as far as each
+     * chunk keeps at least ``parallel_chunk_size`` elements. A destination
+     * element which refers to other memory, like a var dim, is not split,
+     * since the chunks would all allocate from the one unlocked blockref.
+     */
+    inline intptr_t elwise_parallel_nchunks(const callable &child, kernel_request_t kernreq,
+                                            const eval::eval_context *ectx, intptr_t size,
+                                            const ndt::type &child_dst_tp)
+    {
+      intptr_t nthreads = ectx->nthreads;
+      if (nthreads <= 1 || kernreq != (kernel_request_host | kernel_request_single) || !child.is_thread_safe() ||
+          (child_dst_tp.get_flags() & type_flag_blockref) != 0) {
+        return 1;
+      }
+
+      // The elements below the outer dimension, counted when they are fixed
+      intptr_t inner_size = 1;
+      const ndt::type &child_dtp = child_dst_tp.get_dtype();
+      if (child_dst_tp.get_data_size() > 0 && child_dtp.get_data_size() > 0) {
+        inner_size = child_dst_tp.get_data_size() / child_dtp.get_data_size();
+      }
+
+      intptr_t chunk_size = ectx->parallel_chunk_size;
+      intptr_t nchunks = (chunk_size > 0) ? size * inner_size / chunk_size : size;
+      return std::max<intptr_t>(1, std::min(std::min(nchunks, nthreads), size));
+    }
+
+    /**
+     * Runs the outermost fixed dimension of an elwise ckernel on the thread
+     * pool. The dimension is split into contiguous chunks, and each chunk
+     * runs a separate copy of the child ckernel, instantiated into its own
+     * ckernel builder, so no ckernel state is shared between threads.
+     */
+    template <int N>
+    struct parallel_elwise_ck : base_kernel<parallel_elwise_ck<N>, N> {
+      intptr_t m_size;
+      intptr_t m_dst_stride, m_src_stride[N];
+      intptr_t m_nchunks;
+      ckernel_builder<kernel_request_host> *m_children;
+
+      parallel_elwise_ck(intptr_t size, intptr_t dst_stride, const intptr_t *src_stride, intptr_t nchunks)
+          : m_size(size), m_dst_stride(dst_stride), m_nchunks(nchunks),
+            m_children(new ckernel_builder<kernel_request_host>[nchunks])
+      {
+        memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
+      }
+
+      ~parallel_elwise_ck()
+      {
+        delete[] m_children;
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        thread_pool::get().run(m_nchunks, [this, dst, src](intptr_t i) {
+          intptr_t begin = i * m_size / m_nchunks;
+          intptr_t end = (i + 1) * m_size / m_nchunks;
+
+          char *child_src[N];
+          for (int j = 0; j != N; ++j) {
+            child_src[j] = src[j] + begin * m_src_stride[j];
+          }
+
+          ckernel_prefix *child = m_children[i].get();
+          child->get_function<expr_strided_t>()(child, dst + begin * m_dst_stride, m_dst_stride, child_src,
+                                                m_src_stride, end - begin);
+        });
+      }
+    };
+
     template <int N>
     struct elwise_ck<fixed_dim_type_id, fixed_dim_type_id,
                      N> : base_kernel<elwise_ck<fixed_dim_type_id, fixed_dim_type_id, N>, N> {
@@ -275,7 +350,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -324,6 +399,26 @@ namespace nd {
           }
         }
 
+        intptr_t nchunks = elwise_parallel_nchunks(child, kernreq, ectx, size, child_dst_tp);
+        if (nchunks > 1) {
+          parallel_elwise_ck<N> *self = parallel_elwise_ck<N>::make(ckb, kernreq, ckb_offset, size, dst_stride,
+                                                                     src_stride, nchunks);
+          for (intptr_t i = 0; i < nchunks; ++i) {
+            if (finished) {
+              child.get()->instantiate(child.get()->static_data, 0, NULL, &self->m_children[i], 0, child_dst_tp,
+                                       child_dst_arrmeta, nsrc, child_src_tp, child_src_arrmeta, kernel_request_strided,
+                                       ectx, nkwd, kwds, tp_vars);
+            } else {
+              nd::functional::elwise_virtual_ck<N>::instantiate(static_data, 0, data, &self->m_children[i], 0,
+                                                                child_dst_tp, child_dst_arrmeta, nsrc, child_src_tp,
+                                                                child_src_arrmeta, kernel_request_strided, ectx, nkwd,
+                                                                kwds, tp_vars);
+            }
+          }
+
+          return ckb_offset;
+        }
+
         self_type::make(ckb, kernreq, ckb_offset, size, dst_stride, dynd::detail::make_array_wrapper<N>(src_stride));
         kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
 
@@ -383,7 +478,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -499,7 +594,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -613,7 +708,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -798,7 +893,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -939,7 +1034,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -155,7 +155,7 @@ namespace nd {
                   intptr_t DYND_UNUSED(nsrc), const ndt::type
        *DYND_UNUSED(src_tp),
                   nd::array &kwds,
-                  const std::map<std::string, ndt::type>
+                  const small_map<std::string, ndt::type>
        &DYND_UNUSED(tp_vars))
         {
         }
@@ -166,7 +166,7 @@ namespace nd {
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       int flags;
       if (kwds[2].is_missing()) {
@@ -230,7 +230,7 @@ namespace nd {
     resolve_dst_type_(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
                       ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                      const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       nd::array shape = kwds[0];
 
@@ -246,7 +246,7 @@ namespace nd {
     resolve_dst_type_(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
                       ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                      const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       nd::array shape = kwds[0];
       if (shape.is_missing()) {
@@ -262,7 +262,7 @@ namespace nd {
 
     static void resolve_dst_type(char *static_data, size_t data_size, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const small_map<std::string, ndt::type> &tp_vars)
     {
       resolve_dst_type_<std::is_same<fftw_src_type, double>::value>(static_data, data_size, data, dst_tp, nsrc, src_tp,
                                                                     nkwd, kwds, tp_vars);
@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/kernels/base_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * CKernel which groups the values of its second source by the keys of its
+   * first source, and reduces the values of each group. Its destination is
+   * a ``var * {key: K, value: V}`` with one element per distinct key, in the
+   * order the keys first appear.
+   *
+   * Each chunk of the rows is grouped through an open addressing hash table,
+   * its rows sorted by group, and the values of each group reduced in one
+   * strided call of the reduction's element ckernel. With more than one
+   * thread in the eval context, the chunks are reduced in parallel into
+   * partial tables, which are merged in chunk order at the end.
+   */
+  struct DYND_API groupby_kernel : base_kernel<groupby_kernel, 2> {
+    enum reduction_t { sum_reduction, min_reduction, max_reduction, mean_reduction };
+
+    /** One value column, either a field of the values or the whole value */
+    struct column {
+      ndt::type tp;
+      intptr_t src_offset, dst_offset;
+      // For a mean, the child dividing the sum by the count
+      intptr_t div_child;
+    };
+
+    ndt::type m_dst_tp;
+    const char *m_dst_arrmeta;
+    ndt::type m_key_tp;
+    const char *m_key_arrmeta;
+    intptr_t m_size, m_key_stride, m_value_stride;
+    // The offsets of the key and value in a destination element
+    intptr_t m_dst_key_offset, m_dst_value_offset;
+    std::vector<column> m_columns;
+    reduction_t m_reduction;
+    intptr_t m_nchunks;
+    intptr_t m_key_child;
+    // The reduction child of each column for each chunk, chunk by chunk
+    std::vector<intptr_t> m_reduce_children;
+
+    groupby_kernel(reduction_t reduction) : m_reduction(reduction), m_nchunks(1), m_key_child(0)
+    {
+    }
+
+    ~groupby_kernel();
+
+    void single(char *dst, char *const *src);
+
+    static void resolve_dst_type(char *static_data, size_t data_size, char *data, ndt::type &dst_tp, intptr_t nsrc,
+                                 const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
+                                 const small_map<std::string, ndt::type> &tp_vars);
+
+    static intptr_t instantiate(char *static_data, size_t data_size, char *data, void *ckb, intptr_t ckb_offset,
+                                const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+                                const small_map<std::string, ndt::type> &tp_vars);
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -265,7 +265,7 @@ namespace nd {
                   intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
                   kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                  const nd::array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                  const nd::array *DYND_UNUSED(kwds), const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         switch (src_tp->get_dtype().get_type_id()) {
         case bool_type_id:
@@ -0,0 +1,256 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/func/callable.hpp>
+#include <dynd/jit.hpp>
+#include <dynd/kernels/base_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A kernel which evaluates an elementwise expression through a chain of
+   * child kernels, one per operation. The strided function works through
+   * its elements a block at a time, with each operation's results for the
+   * block in a scratch buffer, so the intermediate values stay in the cache.
+   *
+   * With LLVM, when the intermediate types are POD without arrmeta, a strided
+   * request instead makes single child kernels and JIT compiles one loop
+   * which runs the whole chain for each element.
+   */
+  // All methods are inlined, so this does not need to be declared DYND_API.
+  struct lazy_expr_kernel : base_kernel<lazy_expr_kernel> {
+    // The most bytes of intermediate values per block
+    static const size_t scratch_size = 16384;
+
+    struct static_data {
+      /**
+       * One operation. Each source is either a source of the kernel, if it's
+       * less than ``nsrc``, or the result of an earlier operation, ``nsrc + i``
+       * for operation ``i``. The last operation's result is the kernel's.
+       */
+      struct op {
+        callable func;
+        std::vector<intptr_t> src;
+        ndt::type tp;
+      };
+
+      intptr_t nsrc;
+      std::vector<op> ops;
+    };
+
+    intptr_t nsrc;
+    std::vector<std::vector<intptr_t>> op_src;
+    std::vector<intptr_t> child_offsets;
+    // Where each intermediate value goes in the scratch buffer, and its size
+    std::vector<intptr_t> scratch_offsets, scratch_strides;
+    std::vector<char> scratch;
+    size_t block_size;
+#ifdef DYND_LLVM
+    // Whether the children are single kernels, for a fused loop
+    bool fused_children;
+    jit::fused_strided_t fused_func;
+#endif
+
+    lazy_expr_kernel(const struct static_data &data) : nsrc(data.nsrc), block_size(0)
+    {
+#ifdef DYND_LLVM
+      fused_children = false;
+      fused_func = NULL;
+#endif
+      size_t block_bytes = 0;
+      for (size_t i = 0; i < data.ops.size(); ++i) {
+        op_src.push_back(data.ops[i].src);
+        scratch_strides.push_back(data.ops[i].tp.get_data_size());
+        block_bytes += data.ops[i].tp.get_data_size();
+      }
+      block_size = std::max<size_t>(scratch_size / std::max<size_t>(block_bytes, 1), 16);
+
+      // Each operation's block of values, aligned to 16 bytes
+      intptr_t offset = 0;
+      for (size_t i = 0; i < data.ops.size(); ++i) {
+        scratch_offsets.push_back(offset);
+        offset += (scratch_strides[i] * block_size + 15) & ~15;
+      }
+      scratch.resize(offset);
+    }
+
+    ~lazy_expr_kernel()
+    {
+      for (size_t i = 0; i < child_offsets.size(); ++i) {
+        get_child(child_offsets[i])->destroy();
+      }
+    }
+
+    void single(char *dst, char *const *src)
+    {
+      shortvector<intptr_t> src_stride(nsrc);
+      for (intptr_t j = 0; j < nsrc; ++j) {
+        src_stride[j] = 0;
+      }
+      strided(dst, 0, src, src_stride.get(), 1);
+    }
+
+#ifdef DYND_LLVM
+    void fused_strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+    {
+      size_t nops = child_offsets.size();
+      shortvector<ckernel_prefix *> children(nops);
+      for (size_t i = 0; i < nops; ++i) {
+        children[i] = get_child(child_offsets[i]);
+      }
+      if (fused_func != NULL) {
+        fused_func(children.get(), dst, dst_stride, src, src_stride, count);
+        return;
+      }
+
+      // LLVM couldn't compile the loop, so call the single kernels directly,
+      // with each intermediate value in the first element of its block
+      shortvector<char *> op_src_data(nsrc + nops);
+      shortvector<char *> child_src(nsrc + nops);
+      for (intptr_t j = 0; j < nsrc; ++j) {
+        op_src_data[j] = src[j];
+      }
+      for (size_t i = 0; i < nops; ++i) {
+        op_src_data[nsrc + i] = scratch.data() + scratch_offsets[i];
+      }
+      for (size_t k = 0; k != count; ++k) {
+        for (size_t i = 0; i < nops; ++i) {
+          const std::vector<intptr_t> &s = op_src[i];
+          for (size_t j = 0; j < s.size(); ++j) {
+            child_src[j] = op_src_data[s[j]];
+          }
+          children[i]->get_function<expr_single_t>()(children[i], i + 1 < nops ? op_src_data[nsrc + i] : dst,
+                                                     child_src.get());
+        }
+        dst += dst_stride;
+        for (intptr_t j = 0; j < nsrc; ++j) {
+          op_src_data[j] += src_stride[j];
+        }
+      }
+    }
+#endif
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+    {
+#ifdef DYND_LLVM
+      if (fused_children) {
+        fused_strided(dst, dst_stride, src, src_stride, count);
+        return;
+      }
+#endif
+
+      size_t nops = child_offsets.size();
+      shortvector<char *> op_src_data(nsrc + nops);
+      shortvector<intptr_t> op_src_stride(nsrc + nops);
+      shortvector<char *> child_src(nsrc + nops);
+      shortvector<intptr_t> child_src_stride(nsrc + nops);
+      for (intptr_t j = 0; j < nsrc; ++j) {
+        op_src_data[j] = src[j];
+        op_src_stride[j] = src_stride[j];
+      }
+      for (size_t i = 0; i < nops; ++i) {
+        op_src_data[nsrc + i] = scratch.data() + scratch_offsets[i];
+        op_src_stride[nsrc + i] = scratch_strides[i];
+      }
+
+      while (count > 0) {
+        size_t n = std::min(count, block_size);
+        for (size_t i = 0; i < nops; ++i) {
+          const std::vector<intptr_t> &s = op_src[i];
+          for (size_t j = 0; j < s.size(); ++j) {
+            child_src[j] = op_src_data[s[j]];
+            child_src_stride[j] = op_src_stride[s[j]];
+          }
+          ckernel_prefix *child = get_child(child_offsets[i]);
+          if (i + 1 < nops) {
+            child->get_function<expr_strided_t>()(child, op_src_data[nsrc + i], scratch_strides[i], child_src.get(),
+                                                  child_src_stride.get(), n);
+          } else {
+            child->get_function<expr_strided_t>()(child, dst, dst_stride, child_src.get(), child_src_stride.get(), n);
+          }
+        }
+
+        dst += n * dst_stride;
+        for (intptr_t j = 0; j < nsrc; ++j) {
+          op_src_data[j] += n * src_stride[j];
+        }
+        count -= n;
+      }
+    }
+
+    static intptr_t instantiate(char *static_data, size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data), void *ckb,
+                                intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+                                intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
+                                kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
+    {
+      const struct static_data *static_data_x = reinterpret_cast<struct static_data *>(static_data);
+
+      intptr_t root_ckb_offset = ckb_offset;
+      make(ckb, kernreq, ckb_offset, *static_data_x);
+      kernel_request_t child_kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
+#ifdef DYND_LLVM
+      bool fused = (kernreq & kernel_request_memory) == kernel_request_host &&
+                   (kernreq & ~kernel_request_memory) == kernel_request_strided;
+      for (size_t i = 0; fused && i + 1 < static_data_x->ops.size(); ++i) {
+        const ndt::type &tp = static_data_x->ops[i].tp;
+        fused = tp.is_pod() && tp.get_arrmeta_size() == 0;
+      }
+      if (fused) {
+        get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset)->fused_children =
+            true;
+        child_kernreq = kernel_request_single;
+      }
+#endif
+      for (size_t i = 0; i < static_data_x->ops.size(); ++i) {
+        const static_data::op &op = static_data_x->ops[i];
+        shortvector<ndt::type> child_src_tp(op.src.size());
+        shortvector<const char *> child_src_arrmeta(op.src.size());
+        for (size_t j = 0; j < op.src.size(); ++j) {
+          if (op.src[j] < static_data_x->nsrc) {
+            child_src_tp[j] = src_tp[op.src[j]];
+            child_src_arrmeta[j] = src_arrmeta[op.src[j]];
+          } else {
+            child_src_tp[j] = static_data_x->ops[op.src[j] - static_data_x->nsrc].tp;
+            child_src_arrmeta[j] = NULL;
+          }
+        }
+
+        get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset)
+            ->child_offsets.push_back(ckb_offset - root_ckb_offset);
+        bool last = i + 1 == static_data_x->ops.size();
+        callable_type_data *child = const_cast<callable_type_data *>(op.func.get());
+        ckb_offset = child->instantiate(child->static_data, 0, NULL, ckb, ckb_offset, last ? dst_tp : op.tp,
+                                        last ? dst_arrmeta : NULL, op.src.size(), child_src_tp.get(),
+                                        child_src_arrmeta.get(), child_kernreq, ectx, nkwd, kwds, tp_vars);
+      }
+
+#ifdef DYND_LLVM
+      if (fused) {
+        lazy_expr_kernel *self =
+            get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+        std::vector<jit::fused_node> nodes(static_data_x->ops.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+          const ndt::type &tp = i + 1 < nodes.size() ? static_data_x->ops[i].tp : dst_tp;
+          nodes[i].func = self->get_child(self->child_offsets[i])->get_function<expr_single_t>();
+          nodes[i].src = static_data_x->ops[i].src;
+          nodes[i].dst_size = tp.get_data_size();
+          nodes[i].dst_alignment = tp.get_data_alignment();
+        }
+        self->fused_func = jit::compile_fused(static_data_x->nsrc, nodes);
+      }
+#endif
+
+      return ckb_offset;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
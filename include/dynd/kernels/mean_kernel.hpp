@@ -39,7 +39,7 @@ namespace nd {
                           char *data, const ndt::type &dst_tp, intptr_t nsrc,
                           const ndt::type *src_tp, intptr_t nkwd,
                           const nd::array *kwds,
-                          const std::map<std::string, ndt::type> &tp_vars)
+                          const small_map<std::string, ndt::type> &tp_vars)
     {
       std::size_t sum_data_size = nd::sum::get().get()->data_size;
       if (sum_data_size > 0) {
@@ -63,7 +63,7 @@ namespace nd {
                      std::size_t DYND_UNUSED(data_size), char *data,
                      ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                      intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars)
+                     const small_map<std::string, ndt::type> &tp_vars)
     {
       nd::sum::get().get()->resolve_dst_type(
           nd::sum::get().get()->static_data, nd::sum::get().get()->data_size,
@@ -75,7 +75,7 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+        const array *kwds, const small_map<std::string, ndt::type> &tp_vars)
     {
       intptr_t mean_offset = ckb_offset;
       make(ckb, kernreq, ckb_offset, src_tp[0].get_size(src_arrmeta[0]));
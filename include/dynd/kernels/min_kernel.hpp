@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <dynd/kernels/accumulate.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 
 namespace dynd {
@@ -26,9 +27,15 @@ namespace nd {
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
     {
-
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (dst_stride == 0) {
+        // Everything accumulates into one value, which is kept in registers
+        *reinterpret_cast<dst_type *>(dst) =
+            dynd::detail::accumulate<src0_type>::min(*reinterpret_cast<dst_type *>(dst), src0, src0_stride, count);
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         if (*reinterpret_cast<src0_type *>(src0) < *reinterpret_cast<dst_type *>(dst)) {
           *reinterpret_cast<dst_type *>(dst) = *reinterpret_cast<src0_type *>(src0);
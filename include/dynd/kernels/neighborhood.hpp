@@ -142,7 +142,7 @@ namespace nd {
       static void data_init(char *static_data, size_t DYND_UNUSED(data_size), char *data,
                             const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                             intptr_t DYND_UNUSED(nkwd), const array *kwds,
-                            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                            const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         new (data) data_type(src_tp, kwds[0].get_dim_size(), reinterpret_cast<int *>(kwds[0].data()),
                              kwds[1].is_missing() ? NULL : reinterpret_cast<int *>(kwds[1].data()));
@@ -155,7 +155,7 @@ namespace nd {
       static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
                                    char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
                                    const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                   const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         // swap in the input dimension values for the Fixed**N
         intptr_t ndim = src_tp[0].get_ndim();
@@ -168,7 +168,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         intptr_t neighborhood_offset = ckb_offset;
         neighborhood_kernel::make(
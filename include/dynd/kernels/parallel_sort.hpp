@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <dynd/kernels/typed_sort.hpp>
+#include <dynd/thread_pool.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * Sorts ``count`` values with ``nchunks`` chunks run on the thread pool.
+   * Each chunk of ``values`` is sorted in place by ``sort_chunk(i, begin,
+   * size)``. The sorted chunks are then cut at splitters sampled from them,
+   * and each thread merges one range of every chunk into ``buffer``, which
+   * holds the result. ``less[i]`` is the order the i-th thread compares
+   * with, and must be the one ``sort_chunk`` sorts in.
+   *
+   * Merging takes the earliest chunk when values are equal, so the result
+   * is stable if ``sort_chunk`` is.
+   */
+  template <typename T, typename SortChunk, typename Less>
+  void parallel_merge_sort(T *values, T *buffer, std::size_t count, intptr_t nchunks, SortChunk sort_chunk,
+                           const std::vector<Less> &less)
+  {
+    // Every chunk needs a value to sample
+    nchunks = std::max<intptr_t>(std::min<intptr_t>(nchunks, count), 1);
+
+    std::vector<std::size_t> bounds(nchunks + 1);
+    for (intptr_t i = 0; i <= nchunks; ++i) {
+      bounds[i] = count * i / nchunks;
+    }
+
+    thread_pool::get().run(nchunks, [&](intptr_t i) { sort_chunk(i, values + bounds[i], bounds[i + 1] - bounds[i]); });
+
+    // Regularly spaced samples of every sorted chunk, the splitters are
+    // regularly spaced in the sorted samples
+    std::vector<T> samples;
+    for (intptr_t c = 0; c < nchunks; ++c) {
+      for (intptr_t j = 1; j < nchunks; ++j) {
+        samples.push_back(values[bounds[c] + (bounds[c + 1] - bounds[c]) * j / nchunks]);
+      }
+    }
+    std::sort(samples.begin(), samples.end(), less[0]);
+
+    // cuts[c * (nchunks + 1) + j] is the start of the j-th range of chunk c,
+    // which holds the values from the (j - 1)-th splitter up to the j-th one
+    std::vector<std::size_t> cuts(nchunks * (nchunks + 1));
+    for (intptr_t c = 0; c < nchunks; ++c) {
+      std::size_t *chunk_cuts = cuts.data() + c * (nchunks + 1);
+      chunk_cuts[0] = bounds[c];
+      for (intptr_t j = 1; j < nchunks; ++j) {
+        const T &splitter = samples[j * (nchunks - 1)];
+        chunk_cuts[j] = std::lower_bound(values + chunk_cuts[j - 1], values + bounds[c + 1], splitter, less[0]) - values;
+      }
+      chunk_cuts[nchunks] = bounds[c + 1];
+    }
+
+    std::vector<std::size_t> offsets(nchunks + 1, 0);
+    for (intptr_t j = 0; j < nchunks; ++j) {
+      offsets[j + 1] = offsets[j];
+      for (intptr_t c = 0; c < nchunks; ++c) {
+        offsets[j + 1] += cuts[c * (nchunks + 1) + j + 1] - cuts[c * (nchunks + 1) + j];
+      }
+    }
+
+    thread_pool::get().run(nchunks, [&](intptr_t j) {
+      std::vector<std::size_t> heads(nchunks), ends(nchunks);
+      for (intptr_t c = 0; c < nchunks; ++c) {
+        heads[c] = cuts[c * (nchunks + 1) + j];
+        ends[c] = cuts[c * (nchunks + 1) + j + 1];
+      }
+
+      // There are as many ranges as threads, so a linear scan for the
+      // smallest head is cheaper than keeping a heap
+      const Less &merge_less = less[j];
+      for (std::size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+        intptr_t smallest = -1;
+        for (intptr_t c = 0; c < nchunks; ++c) {
+          if (heads[c] < ends[c] && (smallest < 0 || merge_less(values[heads[c]], values[heads[smallest]]))) {
+            smallest = c;
+          }
+        }
+        buffer[k] = values[heads[smallest]++];
+      }
+    });
+  }
+
+  /**
+   * Sorts like ``typed_sort`` with ``nchunks`` threads. The chunks are sorted
+   * in place when the values are contiguous, otherwise in a gathered copy,
+   * and the merged result is scattered back.
+   */
+  template <typename T>
+  void parallel_typed_sort(char *data, intptr_t stride, std::size_t count, intptr_t nchunks, bool stable)
+  {
+    std::unique_ptr<T[]> gathered;
+    T *values = reinterpret_cast<T *>(data);
+    if (stride != static_cast<intptr_t>(sizeof(T))) {
+      gathered.reset(new T[count]);
+      values = gathered.get();
+      for (std::size_t i = 0; i < count; ++i) {
+        values[i] = load_element<T>(data + i * stride);
+      }
+    }
+    std::unique_ptr<T[]> buffer(new T[count]);
+
+    auto less = [](T lhs, T rhs) { return sort_key<T>::less(lhs, rhs); };
+    parallel_merge_sort(values, buffer.get(), count, nchunks,
+                        [stable](intptr_t DYND_UNUSED(i), T *begin, std::size_t size) {
+                          typed_sort<T>(reinterpret_cast<char *>(begin), sizeof(T), size, stable);
+                        },
+                        std::vector<decltype(less)>(nchunks, less));
+
+    for (std::size_t i = 0; i < count; ++i) {
+      store_element<T>(data + i * stride, buffer[i]);
+    }
+  }
+
+} // namespace dynd::detail
+} // namespace dynd
@@ -5,12 +5,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 #include <dynd/func/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/func/assignment.hpp>
 #include <dynd/gfunc/call_gcallable.hpp>
 #include <dynd/func/constant.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
+#include <dynd/thread_pool.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
@@ -95,7 +102,7 @@ namespace nd {
 
       static void data_init(static_data_type *static_data, std::size_t DYND_UNUSED(data_size), data_type *data,
                             const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-                            const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                            const array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         new (data) data_type();
 
@@ -133,7 +140,7 @@ namespace nd {
 
       static void resolve_dst_type(static_data_type *static_data, std::size_t DYND_UNUSED(data_size), data_type *data,
                                    ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-                                   const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                   const array *kwds, const small_map<std::string, ndt::type> &tp_vars)
       {
         ndt::type child_dst_tp = static_data->child.get_type()->get_return_type();
         if (child_dst_tp.is_symbolic()) {
@@ -165,7 +172,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars);
+                                  const small_map<std::string, ndt::type> &tp_vars);
     };
 
     template <typename SelfType>
@@ -319,7 +326,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -446,7 +453,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -573,7 +580,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::var_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(var_dim_type_arrmeta);
@@ -687,7 +694,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         intptr_t src_size = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
         intptr_t src_stride = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_stride(src_arrmeta[0]);
@@ -816,7 +823,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const small_map<std::string, ndt::type> &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -860,12 +867,266 @@ namespace nd {
       }
     };
 
-    intptr_t reduction_virtual_kernel::instantiate(char *static_data, std::size_t data_size, char *data, void *ckb,
-                                                   intptr_t ckb_offset, const ndt::type &dst_tp,
-                                                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
-                                                   const char *const *src_arrmeta, kernel_request_t kernreq,
-                                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                                   const std::map<std::string, ndt::type> &tp_vars)
+    /**
+     * PARALLEL OUTERMOST DIMENSION
+     * This ckernel splits the outermost dimension of a reduction into chunks
+     * that are processed on the thread pool, each by a serial reduction
+     * ckernel of its own, where:
+     *  - If the dimension is reduced, every chunk but the first reduces
+     *    into a private accumulator, and the accumulators are then combined
+     *    into dst by the followup function of a reduction without reduced
+     *    dimensions. Only the first chunk starts from the identity, the
+     *    others start from their first elements, so it is applied once.
+     *  - If the dimension is broadcast, the chunks write disjoint parts of
+     *    dst and there is nothing to combine.
+     *
+     * With ``eval_context::deterministic_reduction`` the accumulators are
+     * combined as a binary tree in a fixed order, so the result only depends
+     * on the number of chunks. Otherwise each chunk combines its accumulator
+     * as soon as it is done, in the order the chunks finish.
+     *
+     * Requirements:
+     *  - The source and destination are fixed dimensions of a builtin type.
+     *  - The child callable is thread safe and has no data.
+     *
+     */
+    struct parallel_reduction_kernel : base_kernel<parallel_reduction_kernel, 1> {
+      typedef reduction_virtual_kernel::data_type data_type;
+
+      intptr_t m_size;
+      intptr_t m_dst_stride, m_src_stride;
+      intptr_t m_nchunks;
+      bool m_reduce;
+      bool m_deterministic;
+      // Whether the combining kernels are reduction layers, rather than the
+      // child called directly on scalars
+      bool m_combine_followup;
+      // The serial reduction of each chunk
+      ckernel_builder<kernel_request_host> *m_chunks;
+      // For each chunk, the kernel combining an accumulator into its result
+      ckernel_builder<kernel_request_host> *m_combines;
+      // The accumulators of the chunks, the first chunk reduces into dst
+      std::vector<array> m_partials;
+      // The arrmeta of the chunks' source (and broadcast destination) types
+      std::vector<char> m_arrmeta;
+
+      parallel_reduction_kernel(intptr_t size, intptr_t dst_stride, intptr_t src_stride, intptr_t nchunks, bool reduce,
+                                bool deterministic, bool combine_followup)
+          : m_size(size), m_dst_stride(dst_stride), m_src_stride(src_stride), m_nchunks(nchunks), m_reduce(reduce),
+            m_deterministic(deterministic), m_combine_followup(combine_followup),
+            m_chunks(new ckernel_builder<kernel_request_host>[nchunks]),
+            m_combines(reduce ? new ckernel_builder<kernel_request_host>[nchunks] : NULL)
+      {
+      }
+
+      ~parallel_reduction_kernel()
+      {
+        delete[] m_chunks;
+        delete[] m_combines;
+      }
+
+      char *get_result(char *dst, intptr_t i)
+      {
+        return (i == 0) ? dst : m_partials[i].data();
+      }
+
+      void combine(intptr_t i, char *dst, char *src)
+      {
+        ckernel_prefix *ck = m_combines[i].get();
+        if (m_combine_followup) {
+          intptr_t src_stride = 0;
+          reinterpret_cast<reduction_kernel_prefix *>(ck)->strided_followup(dst, 0, &src, &src_stride, 1);
+        } else {
+          ck->single(dst, &src);
+        }
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        std::mutex combine_mutex;
+        // The chunk the others combine into when the order doesn't matter
+        intptr_t combined = 0;
+
+        thread_pool::get().run(m_nchunks, [&](intptr_t i) {
+          intptr_t begin = i * m_size / m_nchunks;
+          char *chunk_src = src[0] + begin * m_src_stride;
+          char *chunk_dst = m_reduce ? get_result(dst, i) : (dst + begin * m_dst_stride);
+          m_chunks[i].get()->single(chunk_dst, &chunk_src);
+
+          if (m_reduce && !m_deterministic && i != 0) {
+            std::lock_guard<std::mutex> lock(combine_mutex);
+            if (combined == 0) {
+              combined = i;
+            } else {
+              combine(combined, m_partials[combined].data(), m_partials[i].data());
+            }
+          }
+        });
+
+        if (!m_reduce) {
+          return;
+        }
+
+        if (m_deterministic) {
+          // Each level of the tree combines pairs of results independently
+          for (intptr_t step = 1; step < m_nchunks; step *= 2) {
+            thread_pool::get().run((m_nchunks + 2 * step - 1) / (2 * step), [&](intptr_t j) {
+              intptr_t i = 2 * step * j;
+              if (i + step < m_nchunks) {
+                combine(i, get_result(dst, i), m_partials[i + step].data());
+              }
+            });
+          }
+        } else {
+          combine(0, dst, m_partials[combined].data());
+        }
+      }
+
+      /**
+       * Returns the number of chunks a top level reduction should be split
+       * into, or 1 if it should stay serial.
+       */
+      static intptr_t get_nchunks(char *static_data, const ndt::type &dst_tp, const ndt::type &src0_tp,
+                                  const eval::eval_context *ectx)
+      {
+        const callable &child = reinterpret_cast<reduction_virtual_kernel::static_data_type *>(static_data)->child;
+        if (ectx->nthreads <= 1 || !child.is_thread_safe() || child.get()->data_size != 0 ||
+            src0_tp.get_type_id() != fixed_dim_type_id || get_fixed_builtin_count(dst_tp) < 0) {
+          return 1;
+        }
+
+        intptr_t count = get_fixed_builtin_count(src0_tp);
+        if (count < 0) {
+          return 1;
+        }
+
+        intptr_t size = src0_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+        intptr_t chunk_size = ectx->parallel_chunk_size;
+        intptr_t nchunks = (chunk_size > 0) ? count / chunk_size : count;
+
+        return std::max<intptr_t>(std::min<intptr_t>({static_cast<intptr_t>(ectx->nthreads), size, nchunks}), 1);
+      }
+
+      /**
+       * Returns the number of elements of a type made of fixed dimensions of
+       * a builtin type, or -1 for any other type.
+       */
+      static intptr_t get_fixed_builtin_count(ndt::type tp)
+      {
+        intptr_t count = 1;
+        while (tp.get_type_id() == fixed_dim_type_id) {
+          count *= tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+          tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+        }
+
+        return tp.is_builtin() ? count : -1;
+      }
+
+      static intptr_t instantiate(char *static_data, std::size_t data_size, char *data, void *ckb, intptr_t ckb_offset,
+                                  const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                  const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                  const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
+                                  const small_map<std::string, ndt::type> &tp_vars, intptr_t nchunks)
+      {
+        typedef std::aligned_storage<sizeof(data_type), alignof(data_type)>::type data_storage;
+
+        data_type *reduction_data = reinterpret_cast<data_type *>(data);
+        bool reduce = !reduction_data->is_broadcast();
+
+        intptr_t size = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+        intptr_t src_stride = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_stride(src_arrmeta[0]);
+        const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+        intptr_t src_arrmeta_size = src_tp[0].get_arrmeta_size();
+
+        intptr_t dst_stride = 0;
+        intptr_t dst_arrmeta_size = 0;
+        ndt::type dst_element_tp;
+        if (!reduce) {
+          dst_stride = dst_tp.extended<ndt::fixed_dim_type>()->get_fixed_stride(dst_arrmeta);
+          dst_element_tp = dst_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+          dst_arrmeta_size = dst_tp.get_arrmeta_size();
+        }
+
+        parallel_reduction_kernel *self = make(ckb, kernreq, ckb_offset, size, dst_stride, src_stride, nchunks, reduce,
+                                               ectx->deterministic_reduction, dst_tp.get_ndim() > 0);
+        self->m_arrmeta.resize(nchunks * (src_arrmeta_size + dst_arrmeta_size));
+        if (reduce) {
+          self->m_partials.resize(nchunks);
+        }
+
+        // The chunks are reduced serially, each with its own copy of the data
+        eval::eval_context chunk_ectx(*ectx);
+        chunk_ectx.nthreads = 1;
+
+        for (intptr_t i = 0; i < nchunks; ++i) {
+          intptr_t chunk_size = (i + 1) * size / nchunks - i * size / nchunks;
+
+          // Both arrmeta are plain size_stride_t, so a copy with the outer size
+          // changed describes the chunk
+          char *chunk_src_arrmeta = self->m_arrmeta.data() + i * (src_arrmeta_size + dst_arrmeta_size);
+          memcpy(chunk_src_arrmeta, src_arrmeta[0], src_arrmeta_size);
+          reinterpret_cast<fixed_dim_type_arrmeta *>(chunk_src_arrmeta)->dim_size = chunk_size;
+          ndt::type chunk_src_tp = ndt::make_fixed_dim(chunk_size, src0_element_tp);
+
+          ndt::type chunk_dst_tp = dst_tp;
+          const char *chunk_dst_arrmeta = dst_arrmeta;
+          if (!reduce) {
+            char *arrmeta = chunk_src_arrmeta + src_arrmeta_size;
+            memcpy(arrmeta, dst_arrmeta, dst_arrmeta_size);
+            reinterpret_cast<fixed_dim_type_arrmeta *>(arrmeta)->dim_size = chunk_size;
+            chunk_dst_tp = ndt::make_fixed_dim(chunk_size, dst_element_tp);
+            chunk_dst_arrmeta = arrmeta;
+          } else if (i != 0) {
+            self->m_partials[i] = empty(dst_tp);
+            chunk_dst_arrmeta = self->m_partials[i].get()->metadata();
+          }
+
+          // The reduction layers destroy the data they are given
+          data_storage chunk_data;
+          data_type *chunk_reduction_data = new (&chunk_data) data_type(*reduction_data);
+          if (reduce && i != 0) {
+            chunk_reduction_data->identity = array();
+          }
+          const char *chunk_src_arrmeta_ptr = chunk_src_arrmeta;
+          reduction_virtual_kernel::instantiate(static_data, data_size, reinterpret_cast<char *>(&chunk_data),
+                                                &self->m_chunks[i], 0, chunk_dst_tp, chunk_dst_arrmeta, nsrc,
+                                                &chunk_src_tp, &chunk_src_arrmeta_ptr, kernel_request_single,
+                                                &chunk_ectx, nkwd, kwds, tp_vars);
+        }
+
+        if (reduce) {
+          // Combining is a reduction of an accumulator with no reduced
+          // dimensions, whose followup function applies the child to each
+          // element
+          const int32 no_axes[1] = {0};
+          const char *partial_arrmeta = self->m_partials[1].get()->metadata();
+          for (intptr_t i = 0; i < nchunks; ++i) {
+            data_storage combine_data;
+            data_type *combine = new (&combine_data) data_type();
+            combine->ndim = dst_tp.get_ndim();
+            combine->stored_ndim = combine->ndim;
+            combine->axes = no_axes;
+
+            reduction_virtual_kernel::instantiate(
+                static_data, data_size, reinterpret_cast<char *>(&combine_data), &self->m_combines[i], 0, dst_tp,
+                (i == 0) ? dst_arrmeta : self->m_partials[i].get()->metadata(), nsrc, &dst_tp, &partial_arrmeta,
+                kernel_request_single, &chunk_ectx, nkwd, kwds, tp_vars);
+          }
+        }
+
+        // The data isn't passed on to a reduction layer, so it ends here
+        reduction_data->~data_type();
+        return ckb_offset;
+      }
+    };
+
+    inline intptr_t reduction_virtual_kernel::instantiate(char *static_data, std::size_t data_size, char *data,
+                                                          void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
+                                                          const char *dst_arrmeta, intptr_t nsrc,
+                                                          const ndt::type *src_tp, const char *const *src_arrmeta,
+                                                          kernel_request_t kernreq, const eval::eval_context *ectx,
+                                                          intptr_t nkwd, const array *kwds,
+                                                          const small_map<std::string, ndt::type> &tp_vars)
     {
       static const callable_instantiate_t table[2][2][2] = {
           {{reduction_kernel<fixed_dim_type_id, false, false>::instantiate,
@@ -891,6 +1152,17 @@ namespace nd {
             ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
       }
 
+      // A top level reduction may split its outermost dimension across threads
+      if (reinterpret_cast<data_type *>(data)->stored_ndim == reinterpret_cast<data_type *>(data)->ndim &&
+          kernreq == kernel_request_single) {
+        intptr_t nchunks = parallel_reduction_kernel::get_nchunks(static_data, dst_tp, src_tp[0], ectx);
+        if (nchunks > 1) {
+          return parallel_reduction_kernel::instantiate(static_data, data_size, data, ckb, ckb_offset, dst_tp,
+                                                        dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq, ectx, nkwd,
+                                                        kwds, tp_vars, nchunks);
+        }
+      }
+
       return table[src_tp[0].get_type_id() - fixed_dim_type_id][reinterpret_cast<data_type *>(data)->is_broadcast()]
                   [reinterpret_cast<data_type *>(data)->is_inner()](static_data, data_size, data, ckb, ckb_offset,
                                                                     dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta,
@@ -59,7 +59,7 @@ namespace nd {
                             char *data, const ndt::type &dst_tp, intptr_t nsrc,
                             const ndt::type *src_tp, intptr_t nkwd,
                             const array *kwds,
-                            const std::map<std::string, ndt::type> &tp_vars)
+                            const small_map<std::string, ndt::type> &tp_vars)
       {
         static_data_type *static_data =
             *reinterpret_cast<static_data_type **>(_static_data);
@@ -72,7 +72,7 @@ namespace nd {
       static void resolve_dst_type(
           char *static_data, size_t data_size, char *data, ndt::type &dst_tp,
           intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-          const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+          const array *kwds, const small_map<std::string, ndt::type> &tp_vars);
 
       static intptr_t
       instantiate(char *static_data, size_t data_size, char *data, void *ckb,
@@ -81,7 +81,7 @@ namespace nd {
                   const ndt::type *src_tp, const char *const *src_arrmeta,
                   kernel_request_t kernreq, const eval::eval_context *ectx,
                   intptr_t nkwd, const nd::array *kwds,
-                  const std::map<std::string, ndt::type> &tp_vars);
+                  const small_map<std::string, ndt::type> &tp_vars);
     };
 
     typedef rolling_ck::static_data_type rolling_callable_data;
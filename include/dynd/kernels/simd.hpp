@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <type_traits>
+
+#include <dynd/config.hpp>
+
+// Contiguous loops are compiled once per instruction set when the compiler
+// can target one without the whole library requiring it
+#if defined(__GNUC__) && !defined(__CUDACC__) && (defined(__x86_64__) || defined(__i386__))
+#define DYND_SIMD_DISPATCH
+#define DYND_TARGET_AVX2 __attribute__((target("avx2")))
+// Loop bodies shared by the per instruction set variants must be inlined
+// into each one to be compiled for its instruction set
+#define DYND_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define DYND_SIMD_INLINE inline
+#endif
+
+namespace dynd {
+
+/**
+ * The instruction sets the contiguous kernel loops are built for. SSE2 is
+ * the x86-64 baseline, so it is what the generic loops use there.
+ */
+enum simd_isa_t { simd_isa_generic, simd_isa_avx2 };
+
+/**
+ * Returns the widest instruction set the contiguous kernel loops may use on
+ * the running CPU. This is detected once.
+ */
+DYND_API simd_isa_t get_simd_isa();
+
+namespace detail {
+
+  template <typename... T>
+  struct all_arithmetic;
+
+  template <>
+  struct all_arithmetic<> {
+    static const bool value = true;
+  };
+
+  template <typename T0, typename... T>
+  struct all_arithmetic<T0, T...> {
+    static const bool value = std::is_arithmetic<T0>::value && all_arithmetic<T...>::value;
+  };
+
+  /** A static_cast as a function, for building assignment loops */
+  template <typename DstType, typename SrcType>
+  struct cast_as {
+    static DstType f(SrcType value)
+    {
+      return static_cast<DstType>(value);
+    }
+  };
+
+  /**
+   * Runs ``func`` over arrays whose elements are contiguous, with a loop simple
+   * enough for the compiler to vectorize. Only instantiated (through
+   * ``contiguous_apply``) when the return and argument types are builtin
+   * arithmetic types.
+   */
+  template <typename func_type, func_type func, typename R, typename A, typename I>
+  struct contiguous_apply_loop;
+
+  template <typename func_type, func_type func, typename R, typename... A, size_t... I>
+  struct contiguous_apply_loop<func_type, func, R, type_sequence<A...>, index_sequence<I...>> {
+    typedef void (*loop_type)(char *dst, char *const *src, size_t count);
+
+    static void generic(char *dst, char *const *src, size_t count)
+    {
+      R *d = reinterpret_cast<R *>(dst);
+      for (size_t i = 0; i < count; ++i) {
+        d[i] = func(reinterpret_cast<const A *>(src[I])[i]...);
+      }
+    }
+
+#ifdef DYND_SIMD_DISPATCH
+    DYND_TARGET_AVX2 static void avx2(char *dst, char *const *src, size_t count)
+    {
+      R *d = reinterpret_cast<R *>(dst);
+      for (size_t i = 0; i < count; ++i) {
+        d[i] = func(reinterpret_cast<const A *>(src[I])[i]...);
+      }
+    }
+#endif
+
+    static loop_type select()
+    {
+#ifdef DYND_SIMD_DISPATCH
+      if (get_simd_isa() == simd_isa_avx2) {
+        return &avx2;
+      }
+#endif
+
+      return &generic;
+    }
+
+    static bool run(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+    {
+      static const loop_type loop = select();
+
+      bool contiguous[sizeof...(A) + 1] = {dst_stride == static_cast<intptr_t>(sizeof(R)),
+                                           (src_stride[I] == static_cast<intptr_t>(sizeof(A)))...};
+      for (bool c : contiguous) {
+        if (!c) {
+          return false;
+        }
+      }
+
+      loop(dst, src, count);
+      return true;
+    }
+  };
+
+  /**
+   * Provides ``run(dst, dst_stride, src, src_stride, count)``, which applies
+   * ``func`` with the vectorized loop for the CPU and returns true if every
+   * operand is contiguous, and otherwise does nothing and returns false so
+   * the caller falls back to its strided loop.
+   */
+  template <typename func_type, func_type func, typename R, typename A,
+            bool Vectorizable = std::is_arithmetic<R>::value>
+  struct contiguous_apply;
+
+  template <typename func_type, func_type func, typename R, typename... A>
+  struct contiguous_apply<func_type, func, R, type_sequence<A...>, true>
+      : std::conditional<all_arithmetic<A...>::value && (sizeof...(A) > 0),
+                         contiguous_apply_loop<func_type, func, R, type_sequence<A...>,
+                                               make_index_sequence<sizeof...(A)>>,
+                         contiguous_apply<func_type, func, R, type_sequence<A...>, false>>::type {
+  };
+
+  template <typename func_type, func_type func, typename R, typename... A>
+  struct contiguous_apply<func_type, func, R, type_sequence<A...>, false> {
+    static bool run(char *DYND_UNUSED(dst), intptr_t DYND_UNUSED(dst_stride), char *const *DYND_UNUSED(src),
+                    const intptr_t *DYND_UNUSED(src_stride), size_t DYND_UNUSED(count))
+    {
+      return false;
+    }
+  };
+
+} // namespace dynd::detail
+} // namespace dynd
@@ -5,12 +5,225 @@
 
 #pragma once
 
+#include <memory>
+#include <numeric>
+#include <vector>
+
 #include <dynd/bytes.hpp>
 #include <dynd/func/comparison.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/kernels/parallel_sort.hpp>
+#include <dynd/types/substitute_typevars.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /** Whether the ``stable`` keyword of a sort was given as true */
+    inline bool is_stable_sort(intptr_t nkwd, const array *kwds)
+    {
+      return nkwd > 0 && !kwds[0].is_missing() && kwds[0].as<bool>();
+    }
+
+    /**
+     * Returns how many threads a sort of ``size`` elements is split across,
+     * each with at least ``ectx->parallel_chunk_size`` elements.
+     */
+    inline intptr_t get_sort_nchunks(intptr_t size, const eval::eval_context *ectx)
+    {
+      if (ectx->nthreads <= 1) {
+        return 1;
+      }
+
+      intptr_t chunk_size = std::max<intptr_t>(ectx->parallel_chunk_size, 1);
+      return std::max<intptr_t>(std::min<intptr_t>(ectx->nthreads, size / chunk_size), 1);
+    }
+
+    /** Calls a ``bool1`` valued ckernel, such as ``nd::less``, as a comparison */
+    struct ckernel_less {
+      ckernel_prefix *child;
+
+      bool operator()(char *lhs, char *rhs) const
+      {
+        bool1 dst;
+        char *src[2] = {lhs, rhs};
+        child->single(reinterpret_cast<char *>(&dst), src);
+        return dst;
+      }
+    };
+
+    /**
+     * Sorts a dimension of a builtin type in place, with the order of
+     * ``dynd::detail::sort_key``, instead of calling a comparison ckernel.
+     */
+    template <typename T>
+    struct typed_sort_kernel : base_kernel<typed_sort_kernel<T>, 1> {
+      intptr_t src0_size;
+      intptr_t src0_stride;
+      bool stable;
+
+      typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride, bool stable)
+          : src0_size(src0_size), src0_stride(src0_stride), stable(stable)
+      {
+      }
+
+      void single(char *DYND_UNUSED(dst), char *const *src)
+      {
+        dynd::detail::typed_sort<T>(src[0], src0_stride, src0_size, stable);
+      }
+    };
+
+    template <typename T>
+    struct parallel_typed_sort_kernel : base_kernel<parallel_typed_sort_kernel<T>, 1> {
+      intptr_t src0_size;
+      intptr_t src0_stride;
+      intptr_t nchunks;
+      bool stable;
+
+      parallel_typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t nchunks, bool stable)
+          : src0_size(src0_size), src0_stride(src0_stride), nchunks(nchunks), stable(stable)
+      {
+      }
+
+      void single(char *DYND_UNUSED(dst), char *const *src)
+      {
+        dynd::detail::parallel_typed_sort<T>(src[0], src0_stride, src0_size, nchunks, stable);
+      }
+    };
+
+    /** Writes the indices that sort a dimension of a builtin type */
+    template <typename T>
+    struct typed_argsort_kernel : base_kernel<typed_argsort_kernel<T>, 1> {
+      intptr_t src0_size;
+      intptr_t src0_stride;
+      intptr_t dst_stride;
+      bool stable;
+
+      typed_argsort_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t dst_stride, bool stable)
+          : src0_size(src0_size), src0_stride(src0_stride), dst_stride(dst_stride), stable(stable)
+      {
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        if (dst_stride == static_cast<intptr_t>(sizeof(int64))) {
+          dynd::detail::typed_argsort<T>(src[0], src0_stride, src0_size, reinterpret_cast<int64 *>(dst), stable);
+          return;
+        }
+
+        std::unique_ptr<int64[]> index(new int64[src0_size]);
+        dynd::detail::typed_argsort<T>(src[0], src0_stride, src0_size, index.get(), stable);
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          *reinterpret_cast<int64 *>(dst + i * dst_stride) = index[i];
+        }
+      }
+    };
+
+    /**
+     * Makes ``K<T>`` for the builtin type ``T`` with the given type id, and
+     * returns false without making anything if the type has no typed sort.
+     */
+    template <template <typename> class K, typename... A>
+    bool make_typed_sort_kernel(type_id_t tp_id, void *ckb, kernel_request_t kernreq, intptr_t &ckb_offset,
+                                A &&... args)
+    {
+      switch (tp_id) {
+      case int8_type_id:
+        K<int8>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case int16_type_id:
+        K<int16>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case int32_type_id:
+        K<int32>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case int64_type_id:
+        K<int64>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case uint8_type_id:
+        K<uint8>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case uint16_type_id:
+        K<uint16>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case uint32_type_id:
+        K<uint32>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case uint64_type_id:
+        K<uint64>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case float32_type_id:
+        K<float32>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      case float64_type_id:
+        K<float64>::make(ckb, kernreq, ckb_offset, std::forward<A>(args)...);
+        return true;
+      default:
+        return false;
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Sorts a dimension of a non-builtin type, such as strings or structs,
+   * with several threads. Pointers to the elements are sorted, each thread
+   * comparing with its own ``nd::less`` ckernel, and then the element bytes
+   * are moved into the sorted order.
+   */
+  struct parallel_sort_kernel : base_kernel<parallel_sort_kernel, 1> {
+    intptr_t m_size;
+    intptr_t m_stride;
+    intptr_t m_element_data_size;
+    intptr_t m_nchunks;
+    bool m_stable;
+    // The comparison of each thread
+    ckernel_builder<kernel_request_host> *m_less;
+
+    parallel_sort_kernel(intptr_t size, intptr_t stride, intptr_t element_data_size, intptr_t nchunks, bool stable)
+        : m_size(size), m_stride(stride), m_element_data_size(element_data_size), m_nchunks(nchunks),
+          m_stable(stable), m_less(new ckernel_builder<kernel_request_host>[nchunks])
+    {
+    }
+
+    ~parallel_sort_kernel()
+    {
+      delete[] m_less;
+    }
+
+    void single(char *DYND_UNUSED(dst), char *const *src)
+    {
+      std::vector<char *> order(m_size), merged(m_size);
+      for (intptr_t i = 0; i < m_size; ++i) {
+        order[i] = src[0] + i * m_stride;
+      }
+
+      std::vector<detail::ckernel_less> less(m_nchunks);
+      for (intptr_t i = 0; i < m_nchunks; ++i) {
+        less[i].child = m_less[i].get();
+      }
+
+      bool stable = m_stable;
+      dynd::detail::parallel_merge_sort(order.data(), merged.data(), m_size, m_nchunks,
+                                        [stable, &less](intptr_t i, char **begin, size_t size) {
+                                          if (stable) {
+                                            std::stable_sort(begin, begin + size, less[i]);
+                                          } else {
+                                            std::sort(begin, begin + size, less[i]);
+                                          }
+                                        },
+                                        less);
+
+      std::vector<char> sorted(m_size * m_element_data_size);
+      for (intptr_t i = 0; i < m_size; ++i) {
+        memcpy(sorted.data() + i * m_element_data_size, merged[i], m_element_data_size);
+      }
+      for (intptr_t i = 0; i < m_size; ++i) {
+        memcpy(src[0] + i * m_stride, sorted.data() + i * m_element_data_size, m_element_data_size);
+      }
+    }
+  };
 
   struct sort_kernel : base_kernel<sort_kernel, 1> {
     static const size_t data_size = 0;
@@ -18,9 +231,11 @@ namespace nd {
     const intptr_t src0_size;
     const intptr_t src0_stride;
     const intptr_t src0_element_data_size;
+    const bool stable;
 
-    sort_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size)
-        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size)
+    sort_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size, bool stable)
+        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size),
+          stable(stable)
     {
     }
 
@@ -32,14 +247,34 @@ namespace nd {
     void single(char *DYND_UNUSED(dst), char *const *src)
     {
       ckernel_prefix *child = get_child();
-      std::sort(strided_iterator(src[0], src0_element_data_size, src0_stride),
-                strided_iterator(src[0] + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                [child](char *lhs, char *rhs) {
+      auto less = [child](char *lhs, char *rhs) {
         bool1 dst;
         char *src[2] = {lhs, rhs};
         child->single(reinterpret_cast<char *>(&dst), src);
         return dst;
-      });
+      };
+
+      if (!stable) {
+        std::sort(strided_iterator(src[0], src0_element_data_size, src0_stride),
+                  strided_iterator(src[0] + src0_size * src0_stride, src0_element_data_size, src0_stride), less);
+        return;
+      }
+
+      // A stable sort needs a buffer of the elements, so it orders pointers
+      // to them, then moves the element bytes into that order
+      std::vector<char *> order(src0_size);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        order[i] = src[0] + i * src0_stride;
+      }
+      std::stable_sort(order.begin(), order.end(), less);
+
+      std::vector<char> sorted(src0_size * src0_element_data_size);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        memcpy(sorted.data() + i * src0_element_data_size, order[i], src0_element_data_size);
+      }
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        memcpy(src[0] + i * src0_stride, sorted.data() + i * src0_element_data_size, src0_element_data_size);
+      }
     }
 
     static intptr_t instantiate(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data, void *ckb,
@@ -47,17 +282,117 @@ namespace nd {
                                 const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const small_map<std::string, ndt::type> &tp_vars)
     {
       const ndt::type &src0_element_tp = src_tp[0].template extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t src0_size = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size;
+      intptr_t src0_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride;
+      bool stable = detail::is_stable_sort(nkwd, kwds);
+      const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
+
+      intptr_t nchunks = detail::get_sort_nchunks(src0_size, ectx);
+      if (nchunks > 1) {
+        if (detail::make_typed_sort_kernel<detail::parallel_typed_sort_kernel>(
+                src0_element_tp.get_type_id(), ckb, kernreq, ckb_offset, src0_size, src0_stride, nchunks, stable)) {
+          return ckb_offset;
+        }
+
+        parallel_sort_kernel *self = parallel_sort_kernel::make(ckb, kernreq, ckb_offset, src0_size, src0_stride,
+                                                                src0_element_tp.get_data_size(), nchunks, stable);
+        for (intptr_t i = 0; i < nchunks; ++i) {
+          nd::less::get().get()->instantiate(nd::less::get().get()->static_data, nd::less::get().get()->data_size, data,
+                                             &self->m_less[i], 0, ndt::type::make<bool1>(), NULL, 2, child_src_tp,
+                                             NULL, kernel_request_single, ectx, 0, NULL, tp_vars);
+        }
+        return ckb_offset;
+      }
+
+      if (detail::make_typed_sort_kernel<detail::typed_sort_kernel>(src0_element_tp.get_type_id(), ckb, kernreq,
+                                                                    ckb_offset, src0_size, src0_stride, stable)) {
+        return ckb_offset;
+      }
+
+      make(ckb, kernreq, ckb_offset, src0_size, src0_stride, src0_element_tp.get_data_size(), stable);
+      return nd::less::get().get()->instantiate(nd::less::get().get()->static_data, nd::less::get().get()->data_size,
+                                                data, ckb, ckb_offset, ndt::type::make<bool1>(), NULL, 2, child_src_tp,
+                                                NULL, kernel_request_single, ectx, 0, NULL, tp_vars);
+    }
+  };
 
-      make(ckb, kernreq, ckb_offset, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-           reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, src0_element_tp.get_data_size());
+  struct argsort_kernel : base_kernel<argsort_kernel, 1> {
+    static const size_t data_size = 0;
+
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const intptr_t dst_stride;
+    const bool stable;
+
+    argsort_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t dst_stride, bool stable)
+        : src0_size(src0_size), src0_stride(src0_stride), dst_stride(dst_stride), stable(stable)
+    {
+    }
+
+    ~argsort_kernel()
+    {
+      get_child()->destroy();
+    }
+
+    void single(char *dst, char *const *src)
+    {
+      ckernel_prefix *child = get_child();
+      char *src0 = src[0];
+      intptr_t stride = src0_stride;
+      auto less = [child, src0, stride](int64 lhs, int64 rhs) {
+        bool1 res;
+        char *child_src[2] = {src0 + lhs * stride, src0 + rhs * stride};
+        child->single(reinterpret_cast<char *>(&res), child_src);
+        return res;
+      };
+
+      std::vector<int64> index(src0_size);
+      std::iota(index.begin(), index.end(), 0);
+      if (stable) {
+        std::stable_sort(index.begin(), index.end(), less);
+      } else {
+        std::sort(index.begin(), index.end(), less);
+      }
+
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        *reinterpret_cast<int64 *>(dst + i * dst_stride) = index[i];
+      }
+    }
+
+    static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+                                 char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
+                                 const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
+                                 const array *DYND_UNUSED(kwds), const small_map<std::string, ndt::type> &tp_vars)
+    {
+      dst_tp = ndt::substitute(dst_tp, tp_vars, true);
+    }
+
+    static intptr_t instantiate(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data, void *ckb,
+                                intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *dst_arrmeta,
+                                intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
+                                kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+                                const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
+    {
+      const ndt::type &src0_element_tp = src_tp[0].template extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t src0_size = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size;
+      intptr_t src0_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride;
+      intptr_t dst_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride;
+      bool stable = detail::is_stable_sort(nkwd, kwds);
+
+      if (detail::make_typed_sort_kernel<detail::typed_argsort_kernel>(
+              src0_element_tp.get_type_id(), ckb, kernreq, ckb_offset, src0_size, src0_stride, dst_stride, stable)) {
+        return ckb_offset;
+      }
+
+      make(ckb, kernreq, ckb_offset, src0_size, src0_stride, dst_stride, stable);
 
       const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
       return nd::less::get().get()->instantiate(nd::less::get().get()->static_data, nd::less::get().get()->data_size,
                                                 data, ckb, ckb_offset, ndt::type::make<bool1>(), NULL, 2, child_src_tp,
-                                                NULL, kernel_request_single, ectx, nkwd, kwds, tp_vars);
+                                                NULL, kernel_request_single, ectx, 0, NULL, tp_vars);
     }
   };
 
@@ -69,7 +404,15 @@ namespace ndt {
   struct type::equivalent<nd::sort_kernel> {
     static type make()
     {
-      return callable_type::make(type::make<void>(), {type("Fixed * Scalar")});
+      return type("(Fixed * Scalar, stable: ?bool) -> void");
+    }
+  };
+
+  template <>
+  struct type::equivalent<nd::argsort_kernel> {
+    static type make()
+    {
+      return type("(N * Scalar, stable: ?bool) -> N * int64");
     }
   };
 
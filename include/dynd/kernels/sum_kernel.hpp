@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <dynd/kernels/accumulate.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 
 namespace dynd {
@@ -19,6 +20,12 @@ namespace nd {
 
     static const std::size_t data_size = 0;
 
+    eval::summation_t summation;
+
+    sum_kernel(eval::summation_t summation) : summation(summation)
+    {
+    }
+
     void single(char *dst, char *const *src)
     {
       *reinterpret_cast<dst_type *>(dst) =
@@ -31,6 +38,16 @@ namespace nd {
     {
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (dst_stride == 0) {
+        // Everything accumulates into one value, which is kept in registers
+        // and only written back at the end
+        *reinterpret_cast<dst_type *>(dst) =
+            dynd::detail::accumulate<src0_type>::sum(
+                summation, *reinterpret_cast<dst_type *>(dst), src0,
+                src0_stride, count);
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         *reinterpret_cast<dst_type *>(dst) =
             *reinterpret_cast<dst_type *>(dst) +
@@ -39,6 +56,21 @@ namespace nd {
         src0 += src0_stride;
       }
     }
+
+    static intptr_t
+    instantiate(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+                char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+                const ndt::type &DYND_UNUSED(dst_tp),
+                const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
+                const ndt::type *DYND_UNUSED(src_tp),
+                const char *const *DYND_UNUSED(src_arrmeta),
+                kernel_request_t kernreq, const eval::eval_context *ectx,
+                intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
+                const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    {
+      sum_kernel::make(ckb, kernreq, ckb_offset, ectx->summation);
+      return ckb_offset;
+    }
   };
 
 } // namespace dynd::nd
@@ -11,10 +11,18 @@
 namespace dynd {
 namespace nd {
 
+  /**
+   * CKernel which does a boolean masked take operation. When the elements
+   * are copied bytewise and the mask is contiguous, it compacts the
+   * elements directly, 16 mask values at a time, instead of through the
+   * child ckernel.
+   */
   struct DYND_API masked_take_ck : base_kernel<masked_take_ck, 2> {
     ndt::type m_dst_tp;
     const char *m_dst_meta;
     intptr_t m_dim_size, m_src0_stride, m_mask_stride;
+    // The element size if the elements are copied bytewise, otherwise 0
+    intptr_t m_elem_size;
 
     ~masked_take_ck()
     {
@@ -28,16 +36,24 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
   };
 
   /**
    * CKernel which does an indexed take operation. The child ckernel
-   * should be a single unary operation.
+   * should be a single unary operation. When the elements are copied
+   * bytewise, it gathers them directly instead of through the child.
+   *
+   * With the ``boundscheck`` keyword false, the indices must already be
+   * in the range [0, size) of the source dimension, and are neither checked
+   * nor wrapped like Python negative indices.
    */
   struct DYND_API indexed_take_ck : base_kernel<indexed_take_ck, 2> {
     intptr_t m_dst_dim_size, m_dst_stride, m_index_stride;
     intptr_t m_src0_dim_size, m_src0_stride;
+    // The element size if the elements are copied bytewise, otherwise 0
+    intptr_t m_elem_size;
+    bool m_boundscheck;
 
     ~indexed_take_ck()
     {
@@ -51,7 +67,36 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
+  };
+
+  /**
+   * CKernel which does an indexed put operation, the scatter which is the
+   * reverse of an indexed take, assigning the values of its second source
+   * to the elements of the destination at the indices of its first. The
+   * other elements of the destination are left as they are. With repeated
+   * indices, the last value wins.
+   */
+  struct DYND_API indexed_put_ck : base_kernel<indexed_put_ck, 2> {
+    intptr_t m_dst_dim_size, m_dst_stride, m_index_dim_size, m_index_stride;
+    intptr_t m_src_stride;
+    // The element size if the elements are copied bytewise, otherwise 0
+    intptr_t m_elem_size;
+    bool m_boundscheck;
+
+    ~indexed_put_ck()
+    {
+      get_child()->destroy();
+    }
+
+    void single(char *dst, char *const *src);
+
+    static intptr_t instantiate(
+        char *static_data, size_t data_size, char *data, void *ckb,
+        intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+        intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
+        kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
   };
 
   struct DYND_API take_ck : base_virtual_kernel<take_ck> {
@@ -59,14 +104,14 @@ namespace nd {
     resolve_dst_type(char *static_data, size_t data_size, char *data,
                      ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                      intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars);
+                     const small_map<std::string, ndt::type> &tp_vars);
 
     static intptr_t instantiate(
         char *static_data, size_t data_size, char *data, void *ckb,
         intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
         intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-        const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
   };
 
 } // namespace dynd::nd
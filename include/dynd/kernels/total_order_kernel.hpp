@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/kernels/typed_sort.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 
 namespace dynd {
@@ -41,6 +42,21 @@ namespace nd {
       }
     };
 
+    /** Orders -0.0 before +0.0 and NaNs after everything else, as the builtin sorts do */
+    template <type_id_t Src0TypeID>
+    struct total_order_kernel<Src0TypeID, real_kind, Src0TypeID, real_kind>
+        : base_kernel<total_order_kernel<Src0TypeID, real_kind, Src0TypeID, real_kind>, 2> {
+      typedef typename type_of<Src0TypeID>::type value_type;
+
+      static const size_t data_size = 0;
+
+      void single(char *dst, char *const *src)
+      {
+        *reinterpret_cast<int *>(dst) = dynd::detail::sort_key<value_type>::less(
+            *reinterpret_cast<value_type *>(src[0]), *reinterpret_cast<value_type *>(src[1]));
+      }
+    };
+
     template <>
     struct total_order_kernel<fixed_string_type_id, string_kind, fixed_string_type_id,
                               string_kind> : base_kernel<total_order_kernel<fixed_string_type_id, string_kind,
@@ -64,7 +80,7 @@ namespace nd {
                   intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
                   kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                  const nd::array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                  const nd::array *DYND_UNUSED(kwds), const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
       {
         total_order_kernel::make(ckb, kernreq, ckb_offset, src_tp[0].extended<ndt::fixed_string_type>()->get_size());
         return ckb_offset;
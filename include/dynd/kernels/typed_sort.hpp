@@ -0,0 +1,317 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * The run length at and above which the builtin sorts use a radix sort
+   * rather than a comparison sort.
+   */
+  static const std::size_t radix_sort_threshold = 1024;
+
+  template <std::size_t Size>
+  struct unsigned_of;
+
+  template <>
+  struct unsigned_of<1> {
+    typedef std::uint8_t type;
+  };
+
+  template <>
+  struct unsigned_of<2> {
+    typedef std::uint16_t type;
+  };
+
+  template <>
+  struct unsigned_of<4> {
+    typedef std::uint32_t type;
+  };
+
+  template <>
+  struct unsigned_of<8> {
+    typedef std::uint64_t type;
+  };
+
+  /**
+   * The order the builtin sorts put values of type ``T`` in, and a mapping of
+   * those values to unsigned keys with the same order for the radix sort.
+   *
+   * Floating point values are in the order of ``nd::total_order``: -0.0
+   * comes before +0.0, and NaNs come after everything else. NaNs don't have
+   * keys, the sorts move them to the end before sorting the keys.
+   */
+  template <typename T, bool FloatingPoint = std::is_floating_point<T>::value>
+  struct sort_key;
+
+  template <typename T>
+  struct sort_key<T, false> {
+    typedef typename unsigned_of<sizeof(T)>::type type;
+
+    // Flipping the sign bit orders signed values as unsigned ones
+    static const type flip = std::is_signed<T>::value ? (type(1) << (8 * sizeof(T) - 1)) : type(0);
+
+    static type to_key(T value)
+    {
+      return static_cast<type>(value) ^ flip;
+    }
+
+    static T from_key(type key)
+    {
+      return static_cast<T>(static_cast<type>(key ^ flip));
+    }
+
+    static bool is_nan(T DYND_UNUSED(value))
+    {
+      return false;
+    }
+
+    static bool less(T lhs, T rhs)
+    {
+      return lhs < rhs;
+    }
+  };
+
+  template <typename T>
+  struct sort_key<T, true> {
+    typedef typename unsigned_of<sizeof(T)>::type type;
+
+    static const type sign_bit = type(1) << (8 * sizeof(T) - 1);
+
+    // Negative values have all their bits flipped, so larger magnitudes come
+    // first, and positive values only their sign bit
+    static type to_key(T value)
+    {
+      type bits;
+      memcpy(&bits, &value, sizeof(T));
+      return bits ^ ((bits & sign_bit) ? ~type(0) : sign_bit);
+    }
+
+    static T from_key(type key)
+    {
+      type bits = key ^ ((key & sign_bit) ? sign_bit : ~type(0));
+      T value;
+      memcpy(&value, &bits, sizeof(T));
+      return value;
+    }
+
+    static bool is_nan(T value)
+    {
+      return value != value;
+    }
+
+    static bool less(T lhs, T rhs)
+    {
+      if (lhs < rhs) {
+        return true;
+      }
+      if (rhs < lhs || is_nan(lhs)) {
+        return false;
+      }
+      if (is_nan(rhs)) {
+        return true;
+      }
+
+      return std::signbit(lhs) && !std::signbit(rhs);
+    }
+  };
+
+  /**
+   * A least significant digit first radix sort of ``count`` keys, with a byte
+   * per pass, which is stable. If ``index`` is not NULL, the indices are
+   * permuted along with the keys. ``keys_buffer`` and ``index_buffer`` must
+   * have room for ``count`` elements, and are overwritten.
+   */
+  template <typename U>
+  void radix_sort(U *keys, U *keys_buffer, std::int64_t *index, std::int64_t *index_buffer, std::size_t count)
+  {
+    if (count == 0) {
+      return;
+    }
+
+    // Histogram every byte in one pass over the keys
+    std::size_t counts[sizeof(U)][256] = {};
+    for (std::size_t i = 0; i < count; ++i) {
+      U key = keys[i];
+      for (std::size_t b = 0; b < sizeof(U); ++b) {
+        ++counts[b][(key >> (8 * b)) & 0xff];
+      }
+    }
+
+    U *src = keys, *dst = keys_buffer;
+    std::int64_t *src_index = index, *dst_index = index_buffer;
+    for (std::size_t b = 0; b < sizeof(U); ++b) {
+      std::size_t *offsets = counts[b];
+      // A byte that is the same in every key doesn't reorder anything
+      if (offsets[(src[0] >> (8 * b)) & 0xff] == count) {
+        continue;
+      }
+
+      std::size_t total = 0;
+      for (std::size_t d = 0; d < 256; ++d) {
+        std::size_t n = offsets[d];
+        offsets[d] = total;
+        total += n;
+      }
+
+      if (src_index == NULL) {
+        for (std::size_t i = 0; i < count; ++i) {
+          dst[offsets[(src[i] >> (8 * b)) & 0xff]++] = src[i];
+        }
+      } else {
+        for (std::size_t i = 0; i < count; ++i) {
+          std::size_t j = offsets[(src[i] >> (8 * b)) & 0xff]++;
+          dst[j] = src[i];
+          dst_index[j] = src_index[i];
+        }
+        std::swap(src_index, dst_index);
+      }
+      std::swap(src, dst);
+    }
+
+    if (src != keys) {
+      memcpy(keys, src, count * sizeof(U));
+      if (index != NULL) {
+        memcpy(index, src_index, count * sizeof(std::int64_t));
+      }
+    }
+  }
+
+  template <typename T>
+  T load_element(const char *data)
+  {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  void store_element(char *data, T value)
+  {
+    memcpy(data, &value, sizeof(T));
+  }
+
+  /**
+   * Sorts ``count`` values of builtin type ``T`` in place, with a radix sort
+   * for long runs and a comparison sort on a contiguous copy otherwise. Values
+   * that are equal in the order of ``sort_key<T>`` keep their relative order
+   * if ``stable`` is true.
+   */
+  template <typename T>
+  void typed_sort(char *data, intptr_t stride, std::size_t count, bool stable)
+  {
+    typedef sort_key<T> key;
+    typedef typename key::type U;
+
+    if (count < radix_sort_threshold) {
+      std::unique_ptr<T[]> buffer;
+      T *values = reinterpret_cast<T *>(data);
+      if (stride != static_cast<intptr_t>(sizeof(T))) {
+        buffer.reset(new T[count]);
+        values = buffer.get();
+        for (std::size_t i = 0; i < count; ++i) {
+          values[i] = load_element<T>(data + i * stride);
+        }
+      }
+
+      // A lambda rather than a function pointer, so the comparison is inlined
+      auto less = [](T lhs, T rhs) { return key::less(lhs, rhs); };
+      if (stable) {
+        std::stable_sort(values, values + count, less);
+      } else {
+        std::sort(values, values + count, less);
+      }
+
+      if (buffer) {
+        for (std::size_t i = 0; i < count; ++i) {
+          store_element<T>(data + i * stride, values[i]);
+        }
+      }
+      return;
+    }
+
+    std::unique_ptr<U[]> keys(new U[count]);
+    std::vector<T> nans;
+    std::size_t nkeys = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      T value = load_element<T>(data + i * stride);
+      if (key::is_nan(value)) {
+        nans.push_back(value);
+      } else {
+        keys[nkeys++] = key::to_key(value);
+      }
+    }
+
+    std::unique_ptr<U[]> keys_buffer(new U[nkeys]);
+    radix_sort<U>(keys.get(), keys_buffer.get(), NULL, NULL, nkeys);
+
+    for (std::size_t i = 0; i < nkeys; ++i) {
+      store_element<T>(data + i * stride, key::from_key(keys[i]));
+    }
+    for (std::size_t i = 0; i < nans.size(); ++i) {
+      store_element<T>(data + (nkeys + i) * stride, nans[i]);
+    }
+  }
+
+  /**
+   * Writes the indices that would sort ``count`` values of builtin type
+   * ``T`` to ``index``, in the same order as ``typed_sort``.
+   */
+  template <typename T>
+  void typed_argsort(const char *data, intptr_t stride, std::size_t count, std::int64_t *index, bool stable)
+  {
+    typedef sort_key<T> key;
+    typedef typename key::type U;
+
+    if (count < radix_sort_threshold) {
+      for (std::size_t i = 0; i < count; ++i) {
+        index[i] = static_cast<std::int64_t>(i);
+      }
+
+      auto less = [data, stride](std::int64_t lhs, std::int64_t rhs) {
+        return key::less(load_element<T>(data + lhs * stride), load_element<T>(data + rhs * stride));
+      };
+      if (stable) {
+        std::stable_sort(index, index + count, less);
+      } else {
+        std::sort(index, index + count, less);
+      }
+      return;
+    }
+
+    std::unique_ptr<U[]> keys(new U[count]);
+    std::vector<std::int64_t> nans;
+    std::size_t nkeys = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      T value = load_element<T>(data + i * stride);
+      if (key::is_nan(value)) {
+        nans.push_back(static_cast<std::int64_t>(i));
+      } else {
+        keys[nkeys] = key::to_key(value);
+        index[nkeys++] = static_cast<std::int64_t>(i);
+      }
+    }
+
+    std::unique_ptr<U[]> keys_buffer(new U[nkeys]);
+    std::unique_ptr<std::int64_t[]> index_buffer(new std::int64_t[nkeys]);
+    radix_sort<U>(keys.get(), keys_buffer.get(), index, index_buffer.get(), nkeys);
+
+    std::copy(nans.begin(), nans.end(), index + nkeys);
+  }
+
+} // namespace dynd::detail
+} // namespace dynd
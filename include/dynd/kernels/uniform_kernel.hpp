@@ -5,288 +5,287 @@
 
 #pragma once
 
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/random_engines.hpp>
+#include <dynd/thread_pool.hpp>
 
 namespace dynd {
-
-inline std::shared_ptr<std::default_random_engine> &get_random_device()
-{
-  static std::random_device random_device;
-  static std::shared_ptr<std::default_random_engine> g(
-      new std::default_random_engine(random_device()));
-
-  return g;
-}
-
 namespace nd {
   namespace random {
     namespace detail {
 
-      template <type_id_t DstTypeID, type_kind_t DstTypeKind,
-                typename GeneratorType>
-      struct uniform_kernel;
-
-      template <type_id_t DstTypeID, typename GeneratorType>
-      struct uniform_kernel<
-          DstTypeID, sint_kind,
-          GeneratorType> : base_kernel<uniform_kernel<DstTypeID, sint_kind,
-                                                      GeneratorType>,
-                                       0> {
-        typedef typename type_of<DstTypeID>::type R;
-
-        GeneratorType &g;
-        std::uniform_int_distribution<R> d;
-
-        uniform_kernel(GeneratorType *g, R a, R b) : g(*g), d(a, b)
+      /** The high 64 bits of the 128 bit product */
+      inline uint64 mulhi64(uint64 a, uint64 b)
+      {
+        uint64 a_lo = static_cast<uint32>(a), a_hi = a >> 32;
+        uint64 b_lo = static_cast<uint32>(b), b_hi = b >> 32;
+        uint64 hi_lo = a_hi * b_lo;
+        uint64 cross = ((a_lo * b_lo) >> 32) + static_cast<uint32>(hi_lo) + a_lo * b_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+      }
+
+      /**
+       * Turns ``ndraws`` 64 bit draws into one uniformly distributed value.
+       * Every value takes the same number of draws, which is what lets a
+       * counter-based generator place each element's draws by its index.
+       */
+      template <typename R, type_kind_t Kind>
+      struct uniform_transform;
+
+      template <typename R>
+      struct uniform_transform<R, sint_kind> {
+        typedef typename std::make_unsigned<R>::type U;
+
+        static const int ndraws = 1;
+
+        R a;
+        // The number of values in [a, b], minus one
+        U range;
+
+        uniform_transform(R a, R b) : a(a), range(static_cast<U>(static_cast<U>(b) - static_cast<U>(a)))
         {
         }
 
-        void single(char *dst, char *const *DYND_UNUSED(src))
+        // Scales the draw into the range with a multiply, rather than
+        // rejecting draws, so the bias is at most range / 2^64
+        R operator()(const uint64 *draws) const
         {
-          *reinterpret_cast<R *>(dst) = d(g);
+          uint64 offset = (static_cast<uint64>(range) == std::numeric_limits<uint64>::max())
+                              ? draws[0]
+                              : mulhi64(draws[0], static_cast<uint64>(range) + 1);
+          return static_cast<R>(static_cast<U>(static_cast<U>(a) + static_cast<U>(offset)));
         }
+      };
 
-        /*
-            static void
-            data_init(const arrfunc_type_data *DYND_UNUSED(self),
-                      const ndt::arrfunc_type *DYND_UNUSED(self_tp),
-                      const char *DYND_UNUSED(static_data),
-                      size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
-                      intptr_t DYND_UNUSED(nsrc), const ndt::type
-           *DYND_UNUSED(src_tp),
-                      nd::array &kwds,
-                      const std::map<std::string, ndt::type>
-           &DYND_UNUSED(tp_vars))
-            {
-              nd::array a = kwds.p("a");
-              if (a.is_missing()) {
-                a.val_assign(0);
-              }
-
-              nd::array b = kwds.p("b");
-              if (b.is_missing()) {
-                b.val_assign(std::numeric_limits<R>::max());
-              }
-            }
-        */
-
-        static intptr_t instantiate(
-            char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
-            char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
-            const ndt::type &DYND_UNUSED(dst_tp),
-            const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-            const ndt::type *DYND_UNUSED(src_tp),
-            const char *const *DYND_UNUSED(src_arrmeta),
-            kernel_request_t kernreq,
-            const eval::eval_context *DYND_UNUSED(ectx),
-            intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
-        {
-          std::shared_ptr<GeneratorType> g = get_random_device();
+      template <typename R>
+      struct uniform_transform<R, uint_kind> : uniform_transform<R, sint_kind> {
+        using uniform_transform<R, sint_kind>::uniform_transform;
+      };
 
-          R a;
-          if (kwds[0].is_missing()) {
-            a = 0;
-          } else {
-            a = kwds[0].as<R>();
-          }
+      template <typename R>
+      struct uniform_transform<R, real_kind> {
+        static const int ndraws = 1;
 
-          R b;
-          if (kwds[1].is_missing()) {
-            b = std::numeric_limits<R>::max();
-          } else {
-            b = kwds[1].as<R>();
-          }
+        R a;
+        R width;
 
-          uniform_kernel::make(ckb, kernreq, ckb_offset, g.get(), a, b);
-          return ckb_offset;
+        uniform_transform(R a, R b) : a(a), width(b - a)
+        {
         }
-      };
 
-      template <type_id_t DstTypeID, typename GeneratorType>
-      struct uniform_kernel<
-          DstTypeID, uint_kind,
-          GeneratorType> : uniform_kernel<DstTypeID, sint_kind, GeneratorType> {
+        // The top bits of the draw, as many as the mantissa holds, give a
+        // value in [0, 1)
+        R operator()(const uint64 *draws) const
+        {
+          static const int digits = std::numeric_limits<R>::digits;
+          R unit = static_cast<R>(draws[0] >> (64 - digits)) * (R(1) / static_cast<R>(uint64(1) << digits));
+          return a + width * unit;
+        }
       };
 
-      template <type_id_t DstTypeID, typename GeneratorType>
-      struct uniform_kernel<
-          DstTypeID, real_kind,
-          GeneratorType> : base_kernel<uniform_kernel<DstTypeID, real_kind,
-                                                      GeneratorType>,
-                                       0> {
-        typedef typename type_of<DstTypeID>::type R;
+      template <typename R>
+      struct uniform_transform<R, complex_kind> {
+        typedef typename R::value_type T;
+
+        static const int ndraws = 2;
 
-        GeneratorType &g;
-        std::uniform_real_distribution<R> d;
+        uniform_transform<T, real_kind> real;
+        uniform_transform<T, real_kind> imag;
 
-        uniform_kernel(GeneratorType *g, R a, R b) : g(*g), d(a, b)
+        uniform_transform(R a, R b) : real(a.real(), b.real()), imag(a.imag(), b.imag())
         {
         }
 
-        void single(char *dst, char *const *DYND_UNUSED(src))
+        R operator()(const uint64 *draws) const
         {
-          *reinterpret_cast<R *>(dst) = d(g);
+          return R(real(draws), imag(draws + 1));
         }
+      };
 
-        /*
-            static void
-            data_init(const arrfunc_type_data *DYND_UNUSED(self),
-                      const ndt::arrfunc_type *DYND_UNUSED(self_tp),
-                      const char *DYND_UNUSED(static_data),
-                      size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
-                      intptr_t DYND_UNUSED(nsrc), const ndt::type
-           *DYND_UNUSED(src_tp),
-                      nd::array &kwds,
-                      const std::map<std::string, ndt::type>
-           &DYND_UNUSED(tp_vars))
-            {
-              nd::array a = kwds.p("a");
-              if (a.is_missing()) {
-                a.val_assign(0);
-              }
-
-              nd::array b = kwds.p("b");
-              if (b.is_missing()) {
-                b.val_assign(1);
-              }
-            }
-        */
-
-        static intptr_t instantiate(
-            char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
-            char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
-            const ndt::type &DYND_UNUSED(dst_tp),
-            const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-            const ndt::type *DYND_UNUSED(src_tp),
-            const char *const *DYND_UNUSED(src_arrmeta),
-            kernel_request_t kernreq,
-            const eval::eval_context *DYND_UNUSED(ectx),
-            intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+      template <typename R, type_kind_t Kind>
+      struct uniform_default_bounds {
+        static R a()
         {
-          std::shared_ptr<GeneratorType> g = get_random_device();
-
-          R a;
-          if (kwds[0].is_missing()) {
-            a = 0;
-          } else {
-            a = kwds[0].as<R>();
-          }
-
-          R b;
-          if (kwds[1].is_missing()) {
-            b = 1;
-          } else {
-            b = kwds[1].as<R>();
-          }
+          return 0;
+        }
 
-          uniform_kernel::make(ckb, kernreq, ckb_offset, g.get(), a, b);
-          return ckb_offset;
+        static R b()
+        {
+          return std::numeric_limits<R>::max();
         }
       };
 
-      template <type_id_t DstTypeID, typename GeneratorType>
-      struct uniform_kernel<
-          DstTypeID, complex_kind,
-          GeneratorType> : base_kernel<uniform_kernel<DstTypeID, complex_kind,
-                                                      GeneratorType>,
-                                       0> {
-        typedef typename type_of<DstTypeID>::type R;
-
-        GeneratorType &g;
-        std::uniform_real_distribution<typename R::value_type> d_real;
-        std::uniform_real_distribution<typename R::value_type> d_imag;
-
-        uniform_kernel(GeneratorType *g, R a, R b)
-            : g(*g), d_real(a.real(), b.real()), d_imag(a.imag(), b.imag())
+      template <typename R>
+      struct uniform_default_bounds<R, real_kind> {
+        static R a()
         {
+          return 0;
         }
 
-        void single(char *dst, char *const *DYND_UNUSED(src))
+        static R b()
         {
-          *reinterpret_cast<R *>(dst) = R(d_real(g), d_imag(g));
+          return 1;
         }
+      };
 
-        /*
-            static void
-            data_init(const arrfunc_type_data *DYND_UNUSED(self),
-                      const ndt::arrfunc_type *DYND_UNUSED(self_tp),
-                      const char *DYND_UNUSED(static_data),
-                      size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
-                      intptr_t DYND_UNUSED(nsrc), const ndt::type
-           *DYND_UNUSED(src_tp),
-                      nd::array &kwds,
-                      const std::map<std::string, ndt::type>
-           &DYND_UNUSED(tp_vars))
-            {
-              nd::array a = kwds.p("a");
-              if (a.is_missing()) {
-                a.val_assign(R(0, 0));
-              }
-
-              nd::array b = kwds.p("b");
-              if (b.is_missing()) {
-                b.val_assign(R(1, 1));
-              }
-            }
-        */
-
-        static intptr_t instantiate(
-            char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
-            char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
-            const ndt::type &DYND_UNUSED(dst_tp),
-            const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-            const ndt::type *DYND_UNUSED(src_tp),
-            const char *const *DYND_UNUSED(src_arrmeta),
-            kernel_request_t kernreq,
-            const eval::eval_context *DYND_UNUSED(ectx),
-            intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+      template <typename R>
+      struct uniform_default_bounds<R, complex_kind> {
+        static R a()
         {
-          std::shared_ptr<GeneratorType> g = get_random_device();
-
-          R a;
-          if (kwds[0].is_missing()) {
-            a = R(0, 0);
-          } else {
-            a = kwds[0].as<R>();
-          }
-
-          R b;
-          if (kwds[1].is_missing()) {
-            b = R(1, 1);
-          } else {
-            b = kwds[1].as<R>();
-          }
+          return R(0, 0);
+        }
 
-          uniform_kernel::make(ckb, kernreq, ckb_offset, g.get(), a, b);
-          return ckb_offset;
+        static R b()
+        {
+          return R(1, 1);
         }
       };
 
     } // namespace dynd::nd::random::detail
 
+    /**
+     * Fills its destination with uniformly distributed values from a
+     * generator owned by the ckernel, so separate ckernels never share
+     * generator state. Strided calls draw a block of values at a time, and
+     * with a counter-based generator, long runs are split across the thread
+     * pool, each thread seeking to the draws of its own elements. The values
+     * are then the same however many threads there are.
+     */
     template <type_id_t DstTypeID, typename GeneratorType>
-    using uniform_kernel = detail::uniform_kernel<
-        DstTypeID, type_kind_of<DstTypeID>::value, GeneratorType>;
+    struct uniform_kernel : base_kernel<uniform_kernel<DstTypeID, GeneratorType>, 0> {
+      typedef typename type_of<DstTypeID>::type R;
+      typedef detail::uniform_transform<R, type_kind_of<DstTypeID>::value> transform_type;
+
+      static const std::size_t block_size = 256;
+
+      GeneratorType g;
+      transform_type t;
+      intptr_t nthreads;
+      intptr_t parallel_chunk_size;
+
+      uniform_kernel(const GeneratorType &g, R a, R b, intptr_t nthreads, intptr_t parallel_chunk_size)
+          : g(g), t(a, b), nthreads(nthreads), parallel_chunk_size(parallel_chunk_size)
+      {
+      }
+
+      static void fill(GeneratorType &g, const transform_type &t, char *dst, intptr_t dst_stride, size_t count)
+      {
+        uint64 draws[block_size * transform_type::ndraws];
+        while (count > 0) {
+          size_t n = std::min(count, block_size);
+          g.fill(draws, n * transform_type::ndraws);
+          for (size_t i = 0; i < n; ++i) {
+            *reinterpret_cast<R *>(dst) = t(draws + i * transform_type::ndraws);
+            dst += dst_stride;
+          }
+          count -= n;
+        }
+      }
+
+      void single(char *dst, char *const *DYND_UNUSED(src))
+      {
+        fill(g, t, dst, 0, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *DYND_UNUSED(src),
+                   const intptr_t *DYND_UNUSED(src_stride), size_t count)
+      {
+        strided(dst, dst_stride, count, std::integral_constant<bool, GeneratorType::counter_based>());
+      }
+
+      void strided(char *dst, intptr_t dst_stride, size_t count, std::false_type)
+      {
+        fill(g, t, dst, dst_stride, count);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, size_t count, std::true_type)
+      {
+        intptr_t nchunks = 1;
+        if (nthreads > 1 && parallel_chunk_size > 0) {
+          nchunks = std::min(nthreads, static_cast<intptr_t>(count) / parallel_chunk_size);
+        }
+        if (nchunks <= 1) {
+          fill(g, t, dst, dst_stride, count);
+          return;
+        }
+
+        uint64 start = g.tell();
+        thread_pool::get().run(nchunks, [&](intptr_t i) {
+          size_t begin = i * count / nchunks;
+          size_t end = (i + 1) * count / nchunks;
+
+          GeneratorType chunk_g = g;
+          chunk_g.seek(start + begin * transform_type::ndraws);
+          fill(chunk_g, t, dst + begin * dst_stride, dst_stride, end - begin);
+        });
+        g.seek(start + count * transform_type::ndraws);
+      }
+    };
+
+    /**
+     * Instantiates ``uniform_kernel`` with the generator named by the
+     * ``engine`` keyword, "philox" (the default), "pcg32" or "xoshiro256**",
+     * seeded with the ``seed`` keyword if it is given.
+     */
+    template <type_id_t DstTypeID>
+    struct uniform_virtual_kernel : base_virtual_kernel<uniform_virtual_kernel<DstTypeID>> {
+      typedef typename type_of<DstTypeID>::type R;
+      typedef detail::uniform_default_bounds<R, type_kind_of<DstTypeID>::value> default_bounds;
+
+      static intptr_t instantiate(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+                                  char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+                                  const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
+                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                                  const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+                                  const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
+                                  const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+      {
+        R a = kwds[0].is_missing() ? default_bounds::a() : kwds[0].as<R>();
+        R b = kwds[1].is_missing() ? default_bounds::b() : kwds[1].as<R>();
+        uint64 seed = kwds[2].is_missing() ? make_seed() : kwds[2].as<uint64>();
+        std::string engine = kwds[3].is_missing() ? "philox" : kwds[3].as<std::string>();
+
+        if (engine == "philox") {
+          uniform_kernel<DstTypeID, philox4x32>::make(ckb, kernreq, ckb_offset, philox4x32(seed), a, b,
+                                                      ectx->nthreads, ectx->parallel_chunk_size);
+        } else if (engine == "pcg32") {
+          uniform_kernel<DstTypeID, pcg32>::make(ckb, kernreq, ckb_offset, pcg32(seed), a, b, ectx->nthreads,
+                                                 ectx->parallel_chunk_size);
+        } else if (engine == "xoshiro256**") {
+          uniform_kernel<DstTypeID, xoshiro256starstar>::make(ckb, kernreq, ckb_offset, xoshiro256starstar(seed), a,
+                                                              b, ectx->nthreads, ectx->parallel_chunk_size);
+        } else {
+          std::stringstream ss;
+          ss << "unknown random engine \"" << engine << "\", expected \"philox\", \"pcg32\" or \"xoshiro256**\"";
+          throw std::invalid_argument(ss.str());
+        }
+
+        return ckb_offset;
+      }
+    };
 
   } // namespace dynd::nd::random
 } // namespace dynd::nd
 
 namespace ndt {
 
-  template <type_id_t DstTypeID, typename GeneratorType>
-  struct type::equivalent<
-      nd::random::uniform_kernel<DstTypeID, GeneratorType>> {
+  template <type_id_t DstTypeID>
+  struct type::equivalent<nd::random::uniform_virtual_kernel<DstTypeID>> {
     typedef typename dynd::type_of<DstTypeID>::type R;
 
     static type make()
     {
-      std::map<std::string, ndt::type> tp_vars;
+      small_map<std::string, ndt::type> tp_vars;
       tp_vars["R"] = ndt::type::make<R>();
 
-      return ndt::substitute(ndt::type("(a: ?R, b: ?R) -> R"), tp_vars, true);
+      // The seed may be any integer type, so the signature isn't concrete
+      return ndt::substitute(ndt::type("(a: ?R, b: ?R, seed: ?Int, engine: ?string) -> R"), tp_vars, false);
     }
   };
 
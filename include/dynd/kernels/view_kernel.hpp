@@ -27,7 +27,7 @@ namespace nd {
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *DYND_UNUSED(data),
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                                  intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       dst_tp = src_tp[0];
     }
@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+
+#include <dynd/array.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A lazily evaluated elementwise arithmetic expression of arrays. The
+   * operators record the expression instead of computing it, so
+   *
+   *   nd::array r = (nd::lazy(a) * b + c - 1.0).eval();
+   *
+   * makes one pass over ``a``, ``b`` and ``c``, where ``a * b + c - 1.0``
+   * allocates a temporary the size of the whole result for each operator.
+   *
+   * Evaluating broadcasts the arrays together, and runs the operations on
+   * blocks of the innermost dimension, each through the ckernel of the
+   * arithmetic callable for its types. The intermediate results of a block
+   * stay in small scratch buffers which fit in the cache. A subexpression
+   * used more than once is computed once per block.
+   *
+   * The arrays must have fixed dimensions of builtin scalar types. The
+   * types of the operations are checked when the expression is built.
+   */
+  class DYND_API lazy_expr {
+  public:
+    struct node;
+
+  private:
+    std::shared_ptr<const node> m_node;
+
+    explicit lazy_expr(const std::shared_ptr<const node> &n) : m_node(n)
+    {
+    }
+
+  public:
+    /** An expression of just the array ``a`` */
+    explicit lazy_expr(const array &a);
+
+    /** The scalar type of the result */
+    const ndt::type &get_dtype() const;
+
+    /** Evaluates the expression into a new array */
+    array eval(const eval::eval_context *ectx = &eval::default_eval_context) const;
+
+    friend DYND_API lazy_expr operator-(const lazy_expr &a0);
+
+    friend DYND_API lazy_expr operator+(const lazy_expr &op0, const lazy_expr &op1);
+    friend DYND_API lazy_expr operator-(const lazy_expr &op0, const lazy_expr &op1);
+    friend DYND_API lazy_expr operator*(const lazy_expr &op0, const lazy_expr &op1);
+    friend DYND_API lazy_expr operator/(const lazy_expr &op0, const lazy_expr &op1);
+  };
+
+  /** Starts a lazy expression, as in ``nd::lazy(a) * b + c`` */
+  inline lazy_expr lazy(const array &a)
+  {
+    return lazy_expr(a);
+  }
+
+  DYND_API lazy_expr operator-(const lazy_expr &a0);
+
+  DYND_API lazy_expr operator+(const lazy_expr &op0, const lazy_expr &op1);
+  DYND_API lazy_expr operator-(const lazy_expr &op0, const lazy_expr &op1);
+  DYND_API lazy_expr operator*(const lazy_expr &op0, const lazy_expr &op1);
+  DYND_API lazy_expr operator/(const lazy_expr &op0, const lazy_expr &op1);
+
+  // Mixing expressions with arrays or scalars, like ``nd::lazy(a) * 2.0``
+  inline lazy_expr operator+(const lazy_expr &op0, const array &op1)
+  {
+    return op0 + lazy_expr(op1);
+  }
+
+  inline lazy_expr operator+(const array &op0, const lazy_expr &op1)
+  {
+    return lazy_expr(op0) + op1;
+  }
+
+  inline lazy_expr operator-(const lazy_expr &op0, const array &op1)
+  {
+    return op0 - lazy_expr(op1);
+  }
+
+  inline lazy_expr operator-(const array &op0, const lazy_expr &op1)
+  {
+    return lazy_expr(op0) - op1;
+  }
+
+  inline lazy_expr operator*(const lazy_expr &op0, const array &op1)
+  {
+    return op0 * lazy_expr(op1);
+  }
+
+  inline lazy_expr operator*(const array &op0, const lazy_expr &op1)
+  {
+    return lazy_expr(op0) * op1;
+  }
+
+  inline lazy_expr operator/(const lazy_expr &op0, const array &op1)
+  {
+    return op0 / lazy_expr(op1);
+  }
+
+  inline lazy_expr operator/(const array &op0, const lazy_expr &op1)
+  {
+    return lazy_expr(op0) / op1;
+  }
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -35,6 +35,30 @@ DYND_API intrusive_ptr<memory_block_data> make_memmap_memory_block(const std::st
                                                                    intptr_t begin = 0,
                                                                    intptr_t end = std::numeric_limits<intptr_t>::max());
 
+/**
+ * Hints for how a memory-mapped file will be accessed, which the
+ * operating system may use to read ahead or drop pages.
+ */
+enum memmap_advice_t {
+  memmap_advice_normal,
+  memmap_advice_sequential,
+  memmap_advice_random,
+  memmap_advice_willneed,
+  memmap_advice_dontneed
+};
+
+/**
+ * Gives the operating system a hint about how the memory of a memory-mapped
+ * file will be accessed. Hints the system doesn't support are ignored.
+ */
+DYND_API void memmap_memory_block_advise(memory_block_data *memblock, memmap_advice_t advice);
+
+/**
+ * Writes the changes to a memory-mapped file back to the file, returning
+ * when they have been written.
+ */
+DYND_API void memmap_memory_block_flush(memory_block_data *memblock);
+
 DYND_API void memmap_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                               const std::string &indent);
 
@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <dynd/array.hpp>
+
+namespace dynd {
+
+/**
+ * Reads newline-delimited JSON, one JSON value per line, in batches of
+ * records. Each batch is parsed into a buffer of ``batch_size`` elements
+ * which is reused for the following batches, so the elements of var
+ * dimensions go into memory blocks which are reset rather than allocated
+ * again for every batch.
+ *
+ * Lines which are empty or only whitespace are skipped. The lines are
+ * independent of each other, so if the evaluation context asks for more
+ * than one thread, that many batches are read at a time and parsed in
+ * parallel, each into its own buffer.
+ *
+ * Example:
+ *
+ *   ndjson_reader reader(ndt::type("var * {ts: datetime, user: string, value: ?float64}"), fin);
+ *   nd::array batch;
+ *   while (reader.next(batch)) {
+ *     ...
+ *   }
+ */
+class DYND_API ndjson_reader {
+  // One batch, its buffer, and the lines of text parsed into it
+  struct batch;
+
+  ndt::type m_element_tp;
+  intptr_t m_batch_size;
+  const eval::eval_context *m_ectx;
+  // The input, either a stream or a file descriptor
+  std::istream *m_stream;
+  int m_fd;
+  bool m_eof;
+  // The text which has been read, of which the bytes from m_text_begin to
+  // m_text_end haven't been split into lines yet
+  std::vector<char> m_text;
+  size_t m_text_begin, m_text_end;
+  // The number of the next line to be split off
+  int64 m_line;
+  std::vector<batch *> m_batches;
+  // The number of batches read by the last fill, and the next one to hand out
+  size_t m_batch_count, m_batch_next;
+
+  void init(const ndt::type &tp, intptr_t batch_size);
+  size_t read_some(char *out, size_t size);
+  bool read_lines(batch &b);
+  void fill();
+
+public:
+  /**
+   * Creates a reader of the NDJSON text in ``in``.
+   *
+   * \param tp  The type of the whole input, a var dimension of the records,
+   *            as in ``var * {x: int32, y: string}``.
+   * \param in  The stream to read from.
+   * \param batch_size  The largest number of records in a batch.
+   * \param ectx  An evaluation context, whose ``nthreads`` is the number of
+   *              batches parsed at the same time.
+   */
+  ndjson_reader(const ndt::type &tp, std::istream &in, intptr_t batch_size = 4096,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+  /**
+   * Creates a reader of the NDJSON text in the file descriptor ``fd``,
+   * which is read from its current position and not closed.
+   */
+  ndjson_reader(const ndt::type &tp, int fd, intptr_t batch_size = 4096,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+  ~ndjson_reader();
+
+  ndjson_reader(const ndjson_reader &) = delete;
+  ndjson_reader &operator=(const ndjson_reader &) = delete;
+
+  /** The type of the records */
+  const ndt::type &get_element_type() const
+  {
+    return m_element_tp;
+  }
+
+  intptr_t get_batch_size() const
+  {
+    return m_batch_size;
+  }
+
+  /**
+   * Reads the next batch of records, setting ``out`` to a one dimensional
+   * array of them, and returns false once the input is exhausted. Every
+   * batch has ``batch_size`` records except possibly the last.
+   *
+   * The array is a view of the reader's buffer, whose contents are
+   * overwritten by later calls, so copy it with ``eval_copy`` to keep it.
+   *
+   * If a record doesn't parse as the type, this throws std::invalid_argument
+   * with its line number, and its batch is dropped. Reading can
+   * continue with the following batch.
+   */
+  bool next(nd::array &out);
+};
+
+} // namespace dynd
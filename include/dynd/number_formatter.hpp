@@ -0,0 +1,57 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/config.hpp>
+#include <dynd/types/type_id.hpp>
+
+namespace dynd {
+
+/**
+ * The largest number of characters written by the number formatting
+ * functions below.
+ */
+static const size_t max_number_format_size = 32;
+
+/**
+ * Writes the decimal digits of ``value`` to ``out``, which must have room
+ * for ``max_number_format_size`` characters, and returns the end of the
+ * digits. No NUL terminator is written.
+ */
+DYND_API char *format_uint64(uint64 value, char *out);
+
+/**
+ * Writes ``value`` in decimal, with a leading '-' if it is negative. See
+ * ``format_uint64``.
+ */
+DYND_API char *format_int64(int64 value, char *out);
+
+/**
+ * Writes a decimal string which parses back to ``value``, using the Grisu2
+ * algorithm. It is the shortest such string except in a small fraction of
+ * cases, which get one more digit. Numbers with a decimal exponent in
+ * [-4, 15] are written positionally, "0.001" or "1250", and others in
+ * scientific notation, "1.5e+20", matching the printf %g style. The
+ * infinities and NaN are written as "inf", "-inf" and "nan". See
+ * ``format_uint64``.
+ */
+DYND_API char *format_float64(double value, char *out);
+
+/**
+ * Writes a short decimal string which parses back to the float32 ``value``.
+ * See ``format_float64``.
+ */
+DYND_API char *format_float32(float value, char *out);
+
+/**
+ * Formats a builtin bool, integer or real value with the functions above,
+ * in the same style as ``print_builtin_scalar``. Returns the end of the
+ * output, or NULL if the type isn't one handled here, which is the case
+ * for 128 bit and complex types.
+ */
+DYND_API char *format_builtin_number(type_id_t type_id, const char *data, char *out);
+
+} // namespace dynd
@@ -0,0 +1,255 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace random {
+
+    namespace detail {
+
+      inline uint64 rotl(uint64 x, int k)
+      {
+        return (x << k) | (x >> (64 - k));
+      }
+
+      /** The SplitMix64 step, which spreads a seed over the state of the engines */
+      inline uint64 splitmix64(uint64 &state)
+      {
+        uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+      }
+
+    } // namespace dynd::nd::random::detail
+
+    /**
+     * O'Neill's PCG32 (XSH-RR), with 64 bits of state and a stream selector.
+     * Two of its 32 bit outputs make each 64 bit draw, high word first.
+     */
+    class pcg32 {
+      uint64 m_state;
+      uint64 m_inc;
+
+    public:
+      typedef uint64 result_type;
+
+      static const bool counter_based = false;
+
+      explicit pcg32(uint64 seed, uint64 stream = 0xDA3E39CB94B95BDBULL) : m_state(0), m_inc((stream << 1) | 1)
+      {
+        next32();
+        m_state += seed;
+        next32();
+      }
+
+      static DYND_CONSTEXPR result_type min()
+      {
+        return 0;
+      }
+
+      static DYND_CONSTEXPR result_type max()
+      {
+        return std::numeric_limits<uint64>::max();
+      }
+
+      uint32 next32()
+      {
+        uint64 old = m_state;
+        m_state = old * 6364136223846793005ULL + m_inc;
+        uint32 xorshifted = static_cast<uint32>(((old >> 18) ^ old) >> 27);
+        uint32 rot = static_cast<uint32>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+      }
+
+      result_type operator()()
+      {
+        uint64 hi = next32();
+        return (hi << 32) | next32();
+      }
+
+      void fill(uint64 *dst, std::size_t count)
+      {
+        for (std::size_t i = 0; i < count; ++i) {
+          dst[i] = (*this)();
+        }
+      }
+    };
+
+    /** Blackman and Vigna's xoshiro256**, seeded through SplitMix64 */
+    class xoshiro256starstar {
+      uint64 m_s[4];
+
+    public:
+      typedef uint64 result_type;
+
+      static const bool counter_based = false;
+
+      explicit xoshiro256starstar(uint64 seed)
+      {
+        for (int i = 0; i < 4; ++i) {
+          m_s[i] = detail::splitmix64(seed);
+        }
+      }
+
+      static DYND_CONSTEXPR result_type min()
+      {
+        return 0;
+      }
+
+      static DYND_CONSTEXPR result_type max()
+      {
+        return std::numeric_limits<uint64>::max();
+      }
+
+      result_type operator()()
+      {
+        uint64 result = detail::rotl(m_s[1] * 5, 7) * 9;
+        uint64 t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = detail::rotl(m_s[3], 45);
+        return result;
+      }
+
+      void fill(uint64 *dst, std::size_t count)
+      {
+        for (std::size_t i = 0; i < count; ++i) {
+          dst[i] = (*this)();
+        }
+      }
+    };
+
+    /**
+     * The Philox4x32-10 counter-based generator of Salmon et al. Each 128 bit
+     * block is a function of the key (the seed) and the block's counter
+     * alone, giving two 64 bit draws. The position of the next draw can be
+     * set with ``seek``, so separate copies can fill separate ranges of one
+     * stream in parallel.
+     */
+    class philox4x32 {
+      uint32 m_key[2];
+      // The index of the next draw
+      uint64 m_position;
+      // The current block, valid when m_position is odd
+      uint32 m_block[4];
+
+    public:
+      typedef uint64 result_type;
+
+      static const bool counter_based = true;
+
+      explicit philox4x32(uint64 seed) : m_position(0)
+      {
+        m_key[0] = static_cast<uint32>(seed);
+        m_key[1] = static_cast<uint32>(seed >> 32);
+      }
+
+      static DYND_CONSTEXPR result_type min()
+      {
+        return 0;
+      }
+
+      static DYND_CONSTEXPR result_type max()
+      {
+        return std::numeric_limits<uint64>::max();
+      }
+
+      /** Computes the block for a counter with ten rounds */
+      static void block(const uint32 *counter, const uint32 *key, uint32 *out)
+      {
+        uint32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32 k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+          uint64 p0 = static_cast<uint64>(0xD2511F53U) * c0;
+          uint64 p1 = static_cast<uint64>(0xCD9E8D57U) * c2;
+          uint32 n0 = static_cast<uint32>(p1 >> 32) ^ c1 ^ k0;
+          uint32 n2 = static_cast<uint32>(p0 >> 32) ^ c3 ^ k1;
+          c0 = n0;
+          c1 = static_cast<uint32>(p1);
+          c2 = n2;
+          c3 = static_cast<uint32>(p0);
+          k0 += 0x9E3779B9U;
+          k1 += 0xBB67AE85U;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+      }
+
+      uint64 tell() const
+      {
+        return m_position;
+      }
+
+      void seek(uint64 position)
+      {
+        m_position = position;
+        if (position & 1) {
+          compute_block(position >> 1);
+        }
+      }
+
+      result_type operator()()
+      {
+        if ((m_position & 1) == 0) {
+          compute_block(m_position >> 1);
+          ++m_position;
+          return (static_cast<uint64>(m_block[1]) << 32) | m_block[0];
+        }
+
+        ++m_position;
+        return (static_cast<uint64>(m_block[3]) << 32) | m_block[2];
+      }
+
+      void fill(uint64 *dst, std::size_t count)
+      {
+        std::size_t i = 0;
+        if (count > 0 && (m_position & 1)) {
+          dst[i++] = (*this)();
+        }
+        // Whole blocks, without going through m_block
+        for (; i + 2 <= count; i += 2) {
+          uint32 counter[4] = {static_cast<uint32>(m_position >> 1), static_cast<uint32>(m_position >> 33), 0, 0};
+          uint32 out[4];
+          block(counter, m_key, out);
+          dst[i] = (static_cast<uint64>(out[1]) << 32) | out[0];
+          dst[i + 1] = (static_cast<uint64>(out[3]) << 32) | out[2];
+          m_position += 2;
+        }
+        if (i < count) {
+          dst[i] = (*this)();
+        }
+      }
+
+    private:
+      void compute_block(uint64 index)
+      {
+        uint32 counter[4] = {static_cast<uint32>(index), static_cast<uint32>(index >> 32), 0, 0};
+        block(counter, m_key, m_block);
+      }
+    };
+
+    /**
+     * Returns a seed for a generator which was not given one. Each thread
+     * draws from its own generator, seeded from ``std::random_device``, so
+     * seeding never contends on shared state.
+     */
+    DYND_API uint64 make_seed();
+
+  } // namespace dynd::nd::random
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,247 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * A flat map for the handful of entries that are typical of type variable
+ * bindings. The first staticN entries live inside the object and are found by
+ * a linear search, so a map that stays small never touches the heap. Further
+ * entries are allocated individually, which keeps references to the values
+ * valid across insertions, the same as with std::map.
+ *
+ * The entries are kept in insertion order, not sorted by key.
+ */
+template <typename Key, typename T, std::size_t staticN = 4>
+class small_map {
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<Key, T> value_type;
+
+private:
+  value_type m_static[staticN];
+  std::vector<std::unique_ptr<value_type>> m_dynamic;
+  std::size_t m_size;
+
+  value_type &entry(std::size_t i)
+  {
+    return (i < staticN) ? m_static[i] : *m_dynamic[i - staticN];
+  }
+
+  const value_type &entry(std::size_t i) const
+  {
+    return (i < staticN) ? m_static[i] : *m_dynamic[i - staticN];
+  }
+
+  std::size_t index_of(const Key &key) const
+  {
+    for (std::size_t i = 0; i < m_size; ++i) {
+      if (entry(i).first == key) {
+        return i;
+      }
+    }
+
+    return m_size;
+  }
+
+  template <typename MapType, typename ValueType>
+  class iterator_base {
+    MapType *m_map;
+    std::size_t m_i;
+
+    template <typename OtherMapType, typename OtherValueType>
+    friend class iterator_base;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef ValueType value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef ValueType *pointer;
+    typedef ValueType &reference;
+
+    iterator_base(MapType *map, std::size_t i) : m_map(map), m_i(i)
+    {
+    }
+
+    template <typename OtherMapType, typename OtherValueType>
+    iterator_base(const iterator_base<OtherMapType, OtherValueType> &other)
+        : m_map(other.m_map), m_i(other.m_i)
+    {
+    }
+
+    ValueType &operator*() const
+    {
+      return m_map->entry(m_i);
+    }
+
+    ValueType *operator->() const
+    {
+      return &m_map->entry(m_i);
+    }
+
+    iterator_base &operator++()
+    {
+      ++m_i;
+      return *this;
+    }
+
+    iterator_base operator++(int)
+    {
+      iterator_base tmp(*this);
+      ++m_i;
+      return tmp;
+    }
+
+    bool operator==(const iterator_base &rhs) const
+    {
+      return m_i == rhs.m_i;
+    }
+
+    bool operator!=(const iterator_base &rhs) const
+    {
+      return m_i != rhs.m_i;
+    }
+  };
+
+public:
+  typedef iterator_base<small_map, value_type> iterator;
+  typedef iterator_base<const small_map, const value_type> const_iterator;
+
+  small_map() : m_size(0)
+  {
+  }
+
+  small_map(const small_map &rhs) : m_size(0)
+  {
+    *this = rhs;
+  }
+
+  small_map(small_map &&rhs) : m_dynamic(std::move(rhs.m_dynamic)), m_size(rhs.m_size)
+  {
+    for (std::size_t i = 0; i < staticN && i < m_size; ++i) {
+      m_static[i] = std::move(rhs.m_static[i]);
+    }
+    rhs.clear();
+  }
+
+  small_map &operator=(const small_map &rhs)
+  {
+    if (this != &rhs) {
+      clear();
+      for (std::size_t i = 0; i < rhs.m_size; ++i) {
+        const value_type &value = rhs.entry(i);
+        (*this)[value.first] = value.second;
+      }
+    }
+
+    return *this;
+  }
+
+  std::size_t size() const
+  {
+    return m_size;
+  }
+
+  bool empty() const
+  {
+    return m_size == 0;
+  }
+
+  iterator begin()
+  {
+    return iterator(this, 0);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  iterator end()
+  {
+    return iterator(this, m_size);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, m_size);
+  }
+
+  iterator find(const Key &key)
+  {
+    return iterator(this, index_of(key));
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    return const_iterator(this, index_of(key));
+  }
+
+  std::size_t count(const Key &key) const
+  {
+    return (index_of(key) == m_size) ? 0 : 1;
+  }
+
+  T &at(const Key &key)
+  {
+    std::size_t i = index_of(key);
+    if (i == m_size) {
+      throw std::out_of_range("small_map::at: key not found");
+    }
+
+    return entry(i).second;
+  }
+
+  const T &at(const Key &key) const
+  {
+    std::size_t i = index_of(key);
+    if (i == m_size) {
+      throw std::out_of_range("small_map::at: key not found");
+    }
+
+    return entry(i).second;
+  }
+
+  /** Returns the value for ``key``, inserting a value initialized one if it is absent */
+  T &operator[](const Key &key)
+  {
+    std::size_t i = index_of(key);
+    if (i != m_size) {
+      return entry(i).second;
+    }
+
+    if (m_size < staticN) {
+      m_static[m_size].first = key;
+    } else {
+      m_dynamic.emplace_back(new value_type(key, T()));
+    }
+
+    return entry(m_size++).second;
+  }
+
+  /** Removes all the entries */
+  void clear()
+  {
+    for (std::size_t i = 0; i < staticN && i < m_size; ++i) {
+      m_static[i] = value_type();
+    }
+    m_dynamic.clear();
+    m_size = 0;
+  }
+};
+
+} // namespace dynd
@@ -0,0 +1,174 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * A vector which keeps its first staticN elements inside the object, and only
+ * moves to the heap once it grows beyond that. Unlike shortvector, it knows
+ * its own size and can grow with push_back, so it is a drop-in replacement for
+ * the short std::vector temporaries created on each callable invocation.
+ */
+template <typename T, std::size_t staticN = 4>
+class small_vector {
+  T m_static[staticN];
+  std::vector<T> m_dynamic;
+  T *m_data;
+  std::size_t m_size;
+
+  bool is_static() const
+  {
+    return m_data == m_static;
+  }
+
+  /** Moves the elements to the heap, with room for at least ``capacity`` */
+  void grow(std::size_t capacity)
+  {
+    m_dynamic.reserve(capacity > 2 * staticN ? capacity : 2 * staticN);
+    for (std::size_t i = 0; i < m_size; ++i) {
+      m_dynamic.push_back(std::move(m_static[i]));
+      m_static[i] = T();
+    }
+    m_data = m_dynamic.data();
+  }
+
+public:
+  typedef T value_type;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+
+  small_vector() : m_data(m_static), m_size(0)
+  {
+  }
+
+  explicit small_vector(std::size_t size) : m_data(m_static), m_size(0)
+  {
+    resize(size);
+  }
+
+  small_vector(const small_vector &rhs) : m_data(m_static), m_size(0)
+  {
+    *this = rhs;
+  }
+
+  small_vector &operator=(const small_vector &rhs)
+  {
+    if (this != &rhs) {
+      clear();
+      for (std::size_t i = 0; i < rhs.m_size; ++i) {
+        push_back(rhs.m_data[i]);
+      }
+    }
+
+    return *this;
+  }
+
+  std::size_t size() const
+  {
+    return m_size;
+  }
+
+  bool empty() const
+  {
+    return m_size == 0;
+  }
+
+  T *data()
+  {
+    return m_data;
+  }
+
+  const T *data() const
+  {
+    return m_data;
+  }
+
+  T &operator[](std::size_t i)
+  {
+    return m_data[i];
+  }
+
+  const T &operator[](std::size_t i) const
+  {
+    return m_data[i];
+  }
+
+  iterator begin()
+  {
+    return m_data;
+  }
+
+  const_iterator begin() const
+  {
+    return m_data;
+  }
+
+  iterator end()
+  {
+    return m_data + m_size;
+  }
+
+  const_iterator end() const
+  {
+    return m_data + m_size;
+  }
+
+  void push_back(const T &value)
+  {
+    if (is_static()) {
+      if (m_size < staticN) {
+        m_static[m_size++] = value;
+        return;
+      }
+      grow(m_size + 1);
+    }
+
+    m_dynamic.push_back(value);
+    m_data = m_dynamic.data();
+    ++m_size;
+  }
+
+  /** Resizes the vector, with new elements value initialized */
+  void resize(std::size_t size)
+  {
+    if (is_static()) {
+      if (size <= staticN) {
+        for (std::size_t i = size; i < m_size; ++i) {
+          m_static[i] = T();
+        }
+        m_size = size;
+        return;
+      }
+      grow(size);
+    }
+
+    m_dynamic.resize(size);
+    m_data = m_dynamic.data();
+    m_size = size;
+  }
+
+  /** Removes all the elements, returning to the inline storage */
+  void clear()
+  {
+    if (is_static()) {
+      for (std::size_t i = 0; i < m_size; ++i) {
+        m_static[i] = T();
+      }
+    }
+    m_dynamic.clear();
+    m_data = m_static;
+    m_size = 0;
+  }
+};
+
+} // namespace dynd
@@ -14,5 +14,9 @@ namespace nd {
     static DYND_API callable make();
   } sort;
 
+  extern DYND_API struct argsort : declfunc<argsort> {
+    static DYND_API callable make();
+  } argsort;
+
 } // namespace dynd::nd
 } // namespace dynd
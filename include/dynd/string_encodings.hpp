@@ -97,6 +97,26 @@ typedef void (*append_unicode_codepoint_t)(uint32_t cp, char *&it, char *end);
 DYND_API next_unicode_codepoint_t get_next_unicode_codepoint_function(string_encoding_t encoding, assign_error_mode errmode);
 DYND_API append_unicode_codepoint_t get_append_unicode_codepoint_function(string_encoding_t encoding, assign_error_mode errmode);
 
+/**
+ * Typedef for converting a string from one encoding to another a block at a
+ * time, which is much faster than a code point at a time through the
+ * functions above. Runs of ASCII are checked and converted with SIMD
+ * instructions where they are available.
+ *
+ * On entry, this function assumes that the iterators are appropriately
+ * aligned. It converts code points from 'src' to 'dst', updating both
+ * in-place, and stops at 'src_end' or before the first code point which is
+ * zero, is invalid in the source encoding, can't be represented in the
+ * destination encoding, or doesn't fit before 'dst_end'. Since it never
+ * converts those, its result doesn't depend on the error mode. The caller
+ * handles the code point where it stopped with the functions above, and may
+ * then call it again.
+ */
+typedef void (*transcode_block_t)(const char *&src, const char *src_end, char *&dst, char *dst_end);
+
+DYND_API transcode_block_t get_transcode_block_function(string_encoding_t dst_encoding,
+                                                        string_encoding_t src_encoding);
+
 /**
  * Converts a string buffer provided as a range of bytes into a std::string as UTF8.
  */
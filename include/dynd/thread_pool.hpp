@@ -0,0 +1,65 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * A pool of worker threads which parallel kernels hand their chunks to. The
+ * workers are started the first time they are needed and are kept until the
+ * process exits, so a parallel kernel execution doesn't pay for creating
+ * threads.
+ */
+class DYND_API thread_pool {
+  struct job;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  // The chunks waiting for a worker, as a job and a chunk index
+  std::deque<std::pair<job *, intptr_t>> m_queue;
+  std::vector<std::thread> m_workers;
+  bool m_stopping;
+
+  void work();
+  static void run_chunk(job *j, intptr_t i);
+
+  thread_pool();
+
+  // non-copyable
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+public:
+  ~thread_pool();
+
+  /** Returns the process wide pool */
+  static thread_pool &get();
+
+  /**
+   * Calls ``func(i)`` for each ``i`` in [0, nchunks), with ``func(0)`` on the
+   * calling thread and the others on workers, and returns once all of them
+   * have finished. If any of the calls throw, the first exception is
+   * rethrown here.
+   *
+   * A call made from inside a worker runs all of its chunks on that worker,
+   * which rules out deadlocks between nested parallel kernels.
+   */
+  void run(intptr_t nchunks, const std::function<void(intptr_t)> &func);
+
+  /** The number of worker threads which have been started */
+  intptr_t get_nworkers();
+};
+
+} // namespace dynd
@@ -194,12 +194,18 @@ namespace ndt {
     }
     /**
      * Constructor from a base_type. This claims ownership of the 'extended'
-     * reference if incref is false, be careful!
+     * reference if incref is false, be careful! A newly constructed
+     * base_type is replaced by the interned instance of its type, see
+     * ``intern_type``.
      */
     explicit type(const base_type *extended, bool incref) : m_extended(extended)
     {
-      if (incref && !is_builtin_type(extended)) {
-        base_type_incref(m_extended);
+      if (!is_builtin_type(extended)) {
+        if (incref) {
+          base_type_incref(m_extended);
+        } else if (!m_extended->is_interned()) {
+          m_extended = intern_type(m_extended);
+        }
       }
     }
     /** Copy constructor (should be "= default" in C++11) */
@@ -278,9 +284,15 @@ namespace ndt {
       std::swap(m_extended, rhs);
     }
 
+    /**
+     * Compares the types. Two different interned instances are never equal,
+     * so this only compares the structure of types which aren't interned.
+     */
     bool operator==(const type &rhs) const
     {
-      return m_extended == rhs.m_extended || (!is_builtin() && !rhs.is_builtin() && *m_extended == *rhs.m_extended);
+      return m_extended == rhs.m_extended ||
+             (!is_builtin() && !rhs.is_builtin() && !(m_extended->is_interned() && rhs.m_extended->is_interned()) &&
+              *m_extended == *rhs.m_extended);
     }
     bool operator!=(const type &rhs) const
     {
@@ -292,6 +304,15 @@ namespace ndt {
       return m_extended == NULL;
     }
 
+    /** A hash of the type, which is the same for types that compare equal */
+    size_t get_hash() const
+    {
+      if (is_builtin()) {
+        return static_cast<size_t>(reinterpret_cast<uintptr_t>(m_extended));
+      }
+      return m_extended->get_hash();
+    }
+
     /**
      * Returns true if this type is built in, which
      * means the type id is encoded directly in the m_extended
@@ -395,11 +416,11 @@ namespace ndt {
      * \param tp_vars     A map of names to matched type vars.
      */
     bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, ndt::type> &tp_vars) const;
+               small_map<std::string, ndt::type> &tp_vars) const;
 
     bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta) const;
 
-    bool match(const ndt::type &candidate_tp, std::map<std::string, ndt::type> &tp_vars) const;
+    bool match(const ndt::type &candidate_tp, small_map<std::string, ndt::type> &tp_vars) const;
 
     bool match(const ndt::type &candidate_tp) const;
 
@@ -1330,3 +1351,15 @@ DYND_API void print_indented(std::ostream &o, const std::string &indent, const s
                              bool skipfirstline = false);
 
 } // namespace dynd
+
+namespace std {
+
+template <>
+struct hash<dynd::ndt::type> {
+  size_t operator()(const dynd::ndt::type &tp) const
+  {
+    return tp.get_hash();
+  }
+};
+
+} // namespace std
@@ -69,7 +69,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     static type make() { return type(new any_kind_type(), false); }
   };
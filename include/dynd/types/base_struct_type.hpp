@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <dynd/types/base_type.hpp>
 #include <dynd/types/base_tuple_type.hpp>
 #include <dynd/types/string_type.hpp>
@@ -21,6 +23,16 @@ namespace ndt {
    * of the field types, and adds field names to that.
    */
   class DYND_API base_struct_type : public base_tuple_type {
+    // An open addressing hash table of the field names, built at
+    // construction, whose slots hold a field index or -1 if empty. Its
+    // size is a power of two at least twice the field count.
+    std::vector<intptr_t> m_field_name_index;
+    // Whether a field name repeats, in which case only the index is used,
+    // so a name always finds its first field
+    bool m_duplicate_field_names;
+
+    intptr_t find_field_index(const char *field_name_begin, size_t size) const;
+
   protected:
     nd::array m_field_names;
 
@@ -60,6 +72,27 @@ namespace ndt {
     }
     intptr_t get_field_index(const char *field_name_begin, const char *field_name_end) const;
 
+    /**
+     * Gets the field index for the given name like the other overload,
+     * checking first whether it is the name of field ``predicted_index``.
+     * When names arrive mostly in field order, as the keys of JSON objects
+     * usually do, passing one past the previous field found avoids hashing
+     * the name. Like the other overload, a repeated name finds its first
+     * field.
+     */
+    inline intptr_t get_field_index(const char *field_name_begin, const char *field_name_end,
+                                    intptr_t predicted_index) const
+    {
+      size_t size = field_name_end - field_name_begin;
+      if (!m_duplicate_field_names && 0 <= predicted_index && predicted_index < m_field_count) {
+        const string &fn = get_field_name_raw(predicted_index);
+        if (fn.size() == size && size > 0 && memcmp(fn.begin(), field_name_begin, size) == 0) {
+          return predicted_index;
+        }
+      }
+      return find_field_index(field_name_begin, size);
+    }
+
     type apply_linear_index(intptr_t nindices, const irange *indices, size_t current_i, const type &root_tp,
                             bool leading_dimension) const;
     intptr_t apply_linear_index(intptr_t nindices, const irange *indices, const char *arrmeta, const type &result_tp,
@@ -68,7 +101,7 @@ namespace ndt {
                                 intrusive_ptr<memory_block_data> &inout_dataref) const;
 
     virtual bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       small_map<std::string, type> &tp_vars) const;
 
     size_t get_elwise_property_index(const std::string &property_name) const;
     type get_elwise_property_type(size_t elwise_property_index, bool &out_readable, bool &out_writable) const;
@@ -124,7 +124,7 @@ namespace ndt {
     void foreach_leading(const char *arrmeta, char *data, foreach_fn_t callback, void *callback_data) const;
 
     virtual bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       small_map<std::string, type> &tp_vars) const;
 
     /**
      * Fills in the array of default data offsets based on the data sizes
@@ -12,6 +12,7 @@
 #include <dynd/types/type_id.hpp>
 #include <dynd/atomic_refcount.hpp>
 #include <dynd/irange.hpp>
+#include <dynd/small_map.hpp>
 #include <dynd/memblock/memory_block.hpp>
 #include <dynd/kernels/comparison_kernels.hpp>
 #include <dynd/typed_data_assign.hpp>
@@ -85,6 +86,29 @@ struct DYND_API iterdata_common {
 
 namespace ndt {
 
+  class base_type;
+
+  /**
+   * Takes ownership of a reference to ``bd``, and returns a reference to
+   * the interned type which is equal to it. This is ``bd`` itself unless an
+   * equal type was interned already, in which case ``bd`` is released.
+   *
+   * Every type which ``ndt::type`` takes ownership of is interned, so
+   * equal types share one instance, and their equality is a pointer
+   * comparison. The table of interned types doesn't keep them alive.
+   */
+  DYND_API const base_type *intern_type(const base_type *bd);
+
+  namespace detail {
+    /** Removes an interned type whose use count has reached zero from the table, and deletes it */
+    DYND_API void release_interned_type(const base_type *bd);
+
+    inline size_t hash_combine(size_t seed, size_t value)
+    {
+      return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    }
+  } // namespace dynd::ndt::detail
+
   struct DYND_API base_type_members {
     typedef uint32_t flags_type;
 
@@ -132,6 +156,9 @@ namespace ndt {
   class DYND_API base_type {
     /** Embedded reference counting */
     mutable atomic_refcount m_use_count;
+    /** The hash of the type, set when it is interned */
+    size_t m_hash;
+    bool m_interned;
 
   protected:
     /// Standard dynd type data
@@ -148,7 +175,7 @@ namespace ndt {
     /** Starts off the extended type instance with a use count of 1. */
     inline base_type(type_id_t type_id, type_kind_t kind, size_t data_size, size_t alignment, flags_type flags,
                      size_t arrmeta_size, size_t ndim, size_t strided_ndim)
-        : m_use_count(1),
+        : m_use_count(1), m_hash(0), m_interned(false),
           m_members(static_cast<uint16_t>(type_id), static_cast<uint8_t>(kind), static_cast<uint8_t>(alignment), flags,
                     data_size, arrmeta_size, static_cast<uint8_t>(ndim), static_cast<uint8_t>(strided_ndim))
     {
@@ -447,6 +474,28 @@ namespace ndt {
 
     virtual bool operator==(const base_type &rhs) const = 0;
 
+    /** Whether this instance is the interned one for its type, see ``intern_type`` */
+    inline bool is_interned() const
+    {
+      return m_interned;
+    }
+
+    /**
+     * A hash of the type, which is the same for types that compare equal.
+     * Interned types compute it once.
+     */
+    inline size_t get_hash() const
+    {
+      return m_interned ? m_hash : compute_hash();
+    }
+
+    /**
+     * Computes the hash returned by ``get_hash``. The default combines the
+     * type id, kind and data size, and types with parameters override it to
+     * include them.
+     */
+    virtual size_t compute_hash() const;
+
     /** The size of the nd::array arrmeta for this type */
     inline size_t get_arrmeta_size() const
     {
@@ -564,7 +613,7 @@ namespace ndt {
                                           comparison_type_t comptype, const eval::eval_context *ectx) const;
 
     virtual bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, ndt::type> &tp_vars) const;
+                       small_map<std::string, ndt::type> &tp_vars) const;
 
     /**
      * Call the callback on each element of the array with given data/arrmeta
@@ -706,6 +755,7 @@ namespace ndt {
 
     friend void base_type_incref(const base_type *ed);
     friend void base_type_decref(const base_type *ed);
+    friend const base_type *intern_type(const base_type *bd);
     friend type make_dynamic_type(type_id_t tp_id);
   };
 
@@ -740,7 +790,11 @@ namespace ndt {
   inline void base_type_decref(const base_type *bd)
   {
     if (--bd->m_use_count == 0) {
-      delete bd;
+      if (bd->m_interned) {
+        detail::release_interned_type(bd);
+      } else {
+        delete bd;
+      }
     }
   }
 
@@ -50,7 +50,7 @@ namespace ndt {
     virtual void arrmeta_destruct(char *arrmeta) const;
 
     virtual bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       small_map<std::string, type> &tp_vars) const;
 
     static type make(const type &child_tp)
     {
@@ -18,6 +18,9 @@
 #include <dynd/types/typevar_constructed_type.hpp>
 
 namespace dynd {
+namespace nd {
+  class kernel_cache;
+} // namespace dynd::nd
 
 /**
  * Resolves any missing keyword arguments for this callable based on
@@ -31,7 +34,7 @@ namespace dynd {
  */
 typedef void (*callable_data_init_t)(char *static_data, size_t data_size, char *data, const ndt::type &dst_tp,
                                      intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                                     const std::map<std::string, ndt::type> &tp_vars);
+                                     const small_map<std::string, ndt::type> &tp_vars);
 
 template <typename DataInitType>
 struct data_init_traits;
@@ -39,7 +42,7 @@ struct data_init_traits;
 template <typename StaticDataType, typename DataType>
 struct data_init_traits<void (*)(StaticDataType *static_data, size_t data_size, DataType *data, const ndt::type &dst_tp,
                                  intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)> {
+                                 const small_map<std::string, ndt::type> &tp_vars)> {
   typedef StaticDataType static_data_type;
   typedef DataType data_type;
 };
@@ -56,7 +59,7 @@ struct data_init_traits<void (*)(StaticDataType *static_data, size_t data_size,
  */
 typedef void (*callable_resolve_dst_type_t)(char *static_data, size_t data_size, char *data, ndt::type &dst_tp,
                                             intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-                                            const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                                            const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
 
 template <typename DataInitType>
 struct resolve_dst_type_traits;
@@ -64,7 +67,7 @@ struct resolve_dst_type_traits;
 template <typename StaticDataType, typename DataType>
 struct resolve_dst_type_traits<void (*)(StaticDataType *static_data, size_t data_size, DataType *data,
                                         ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
-                                        const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)> {
+                                        const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)> {
   typedef StaticDataType static_data_type;
   typedef DataType data_type;
 };
@@ -105,7 +108,7 @@ typedef intptr_t (*callable_instantiate_t)(char *static_data, size_t data_size,
                                            intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
                                            intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                                            kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                           const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                                           const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars);
 
 template <typename InstantiateType>
 struct instantiate_traits;
@@ -115,7 +118,7 @@ struct instantiate_traits<intptr_t (*)(StaticDataType *static_data, size_t data_
                                        intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
                                        intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                                        kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                       const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)> {
+                                       const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)> {
   typedef StaticDataType static_data_type;
   typedef DataType data_type;
 };
@@ -171,16 +174,20 @@ struct DYND_API callable_type_data {
   callable_resolve_dst_type_t resolve_dst_type;
   callable_instantiate_t instantiate;
   callable_static_data_free_t static_data_free;
+  // Bound ckernels reused across calls, NULL unless enabled
+  nd::kernel_cache *cache;
+  // Whether separate ckernels from this callable may run concurrently
+  bool thread_safe;
 
   callable_type_data()
       : static_data(NULL), data_size(0), data_init(NULL), resolve_dst_type(NULL), instantiate(NULL),
-        static_data_free(NULL)
+        static_data_free(NULL), cache(NULL), thread_safe(false)
   {
   }
 
   callable_type_data(expr_single_t single, expr_strided_t strided)
       : kernreq(kernel_request_single), data_size(0), data_init(NULL), resolve_dst_type(NULL),
-        instantiate(&ckernel_prefix::instantiate), static_data_free(NULL)
+        instantiate(&ckernel_prefix::instantiate), static_data_free(NULL), cache(NULL), thread_safe(false)
   {
     typedef void *static_data_type[2];
     static_assert(scalar_align_of<static_data_type>::value <= scalar_align_of<std::uint64_t>::value,
@@ -193,7 +200,8 @@ struct DYND_API callable_type_data {
   callable_type_data(kernel_request_t kernreq, single_t single, std::size_t data_size, callable_data_init_t data_init,
                      callable_resolve_dst_type_t resolve_dst_type, callable_instantiate_t instantiate)
       : kernreq(kernreq), single(single), static_data(NULL), data_size(data_size), data_init(data_init),
-        resolve_dst_type(resolve_dst_type), instantiate(instantiate), static_data_free(NULL)
+        resolve_dst_type(resolve_dst_type), instantiate(instantiate), static_data_free(NULL), cache(NULL),
+        thread_safe(false)
   {
   }
 
@@ -203,7 +211,8 @@ struct DYND_API callable_type_data {
                      callable_instantiate_t instantiate)
       : kernreq(kernreq), single(single), data_size(data_size), data_init(data_init),
         resolve_dst_type(resolve_dst_type), instantiate(instantiate),
-        static_data_free(&static_data_destroy<typename std::remove_reference<T>::type>)
+        static_data_free(&static_data_destroy<typename std::remove_reference<T>::type>), cache(NULL),
+        thread_safe(false)
   {
     typedef typename std::remove_reference<T>::type static_data_type;
     static_assert(scalar_align_of<static_data_type>::value <= scalar_align_of<std::uint64_t>::value,
@@ -216,30 +225,33 @@ struct DYND_API callable_type_data {
   // non-copyable
   callable_type_data(const callable_type_data &) = delete;
 
-  ~callable_type_data()
-  {
-    // Call the static_data_free function, if it exists
-    if (static_data_free != NULL) {
-      static_data_free(static_data);
-    }
-    delete[] static_data;
-  }
+  ~callable_type_data();
+
+  /**
+   * Turns on the bound kernel cache with the given number of entries, or
+   * turns it off if ``capacity`` is 0.
+   */
+  void set_cache_capacity(std::size_t capacity);
 
   nd::array operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                        char *const *src_data, intptr_t nkwd, const nd::array *kwds,
-                       const std::map<std::string, ndt::type> &tp_vars);
+                       const small_map<std::string, ndt::type> &tp_vars,
+                       const eval::eval_context *ectx = &eval::default_eval_context);
 
   nd::array operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                        nd::array *const *src_data, intptr_t nkwd, const nd::array *kwds,
-                       const std::map<std::string, ndt::type> &tp_vars);
+                       const small_map<std::string, ndt::type> &tp_vars,
+                       const eval::eval_context *ectx = &eval::default_eval_context);
 
   void operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                   const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data, intptr_t nkwd,
-                  const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                  const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars,
+                  const eval::eval_context *ectx = &eval::default_eval_context);
 
   void operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                   const ndt::type *src_tp, const char *const *src_arrmeta, nd::array *const *src_data, intptr_t nkwd,
-                  const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                  const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars,
+                  const eval::eval_context *ectx = &eval::default_eval_context);
 
   template <typename StaticDataType>
   static void static_data_destroy(char *static_data)
@@ -395,6 +407,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
     void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
                                 const intrusive_ptr<memory_block_data> &embedded_reference) const;
@@ -410,7 +424,7 @@ namespace ndt {
                                     const eval::eval_context *ectx) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     void get_dynamic_type_properties(const std::pair<std::string, nd::callable> **out_properties,
                                      size_t *out_count) const;
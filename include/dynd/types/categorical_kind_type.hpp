@@ -46,7 +46,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     static type make() { return type(new categorical_kind_type(), false); }
   };
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <dynd/type.hpp>
 #include <dynd/array.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -19,6 +21,11 @@ struct assign_to_same_category_type;
 
 namespace dynd {
 namespace ndt {
+  namespace detail {
+
+    class category_hash_table;
+
+  } // namespace dynd::ndt::detail
 
   class DYND_API categorical_type : public base_type {
     // The data type of the category
@@ -31,6 +38,9 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // hash table of the categories, numbered by value, if the category type
+    // can be hashed
+    std::shared_ptr<const detail::category_hash_table> m_hash_table;
 
   public:
     categorical_type(const nd::array &categories, bool presorted = false);
@@ -70,6 +80,15 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Returns the hash table mapping category data to values, or NULL if the
+     * category type can't be hashed.
+     */
+    const detail::category_hash_table *get_hash_table() const
+    {
+      return m_hash_table.get();
+    }
+
     const char *get_category_data_from_value(uint32_t value) const
     {
       if (value >= get_category_count()) {
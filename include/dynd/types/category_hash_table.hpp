@@ -0,0 +1,403 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <dynd/string.hpp>
+#include <dynd/type.hpp>
+#include <dynd/types/base_tuple_type.hpp>
+
+namespace dynd {
+namespace ndt {
+  namespace detail {
+
+    /**
+     * An open addressing hash table of category values, which are referred
+     * to by pointers to their data and numbered in the order they were
+     * inserted. The hash and equality are specialized for the kinds of
+     * category types that support them:
+     *
+     *  - builtin integers, bool and fixed_string compare their bytes
+     *  - float32 and float64 compare as numbers, so -0.0 finds +0.0, except
+     *    that all NaNs are equal
+     *  - string compares the bytes of the string
+     *
+     * A table made with arrmeta also takes categorical values, which compare
+     * their storage, and structs and tuples of any of these, which compare
+     * field by field, for use as the keys of a group by.
+     *
+     * The table doesn't own the values, they must outlive it.
+     */
+    class category_hash_table {
+    public:
+      enum key_kind_t { bytes_key, float32_key, float64_key, string_key };
+
+    private:
+      // One field of a value, or a run of bytes fields with no padding
+      // between them
+      struct key_field {
+        key_kind_t kind;
+        size_t offset;
+        size_t size;
+      };
+
+      std::vector<key_field> m_fields;
+      // For a key of one bytes field of 1, 2, 4 or 8 bytes, its size. The
+      // keys are then also kept as words, which probing compares directly.
+      size_t m_word_size;
+      std::vector<uint64> m_words;
+      // The inserted values, in insertion order
+      std::vector<const char *> m_keys;
+      // For each slot, one more than the index of the value in it, or 0
+      std::vector<uint32> m_slots;
+
+      static uint64 mix(uint64 h)
+      {
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+      }
+
+      static uint64 hash_bytes(const char *data, size_t size)
+      {
+        uint64 h = 0x9E3779B97F4A7C15ULL ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+          uint64 word;
+          memcpy(&word, data + i, 8);
+          h = mix(h ^ word);
+        }
+        if (i < size) {
+          uint64 word = 0;
+          memcpy(&word, data + i, size - i);
+          h = mix(h ^ word);
+        }
+        return mix(h);
+      }
+
+      template <typename T>
+      static uint64 hash_float(const char *data)
+      {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        // Values which compare equal must hash the same, -0.0 and all NaNs
+        if (value == 0) {
+          value = 0;
+        } else if (value != value) {
+          value = std::numeric_limits<T>::quiet_NaN();
+        }
+        return hash_bytes(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+      template <typename T>
+      static bool equal_float(const char *lhs, const char *rhs)
+      {
+        T lhs_value, rhs_value;
+        memcpy(&lhs_value, lhs, sizeof(T));
+        memcpy(&rhs_value, rhs, sizeof(T));
+        return lhs_value == rhs_value || (lhs_value != lhs_value && rhs_value != rhs_value);
+      }
+
+      static uint64 hash_field(const key_field &field, const char *data)
+      {
+        data += field.offset;
+        switch (field.kind) {
+        case float32_key:
+          return hash_float<float>(data);
+        case float64_key:
+          return hash_float<double>(data);
+        case string_key: {
+          const string *s = reinterpret_cast<const string *>(data);
+          return hash_bytes(s->begin(), s->size());
+        }
+        default:
+          return hash_bytes(data, field.size);
+        }
+      }
+
+      static bool equal_field(const key_field &field, const char *lhs, const char *rhs)
+      {
+        lhs += field.offset;
+        rhs += field.offset;
+        switch (field.kind) {
+        case float32_key:
+          return equal_float<float>(lhs, rhs);
+        case float64_key:
+          return equal_float<double>(lhs, rhs);
+        case string_key: {
+          const string *lhs_s = reinterpret_cast<const string *>(lhs);
+          const string *rhs_s = reinterpret_cast<const string *>(rhs);
+          return lhs_s->size() == rhs_s->size() && memcmp(lhs_s->begin(), rhs_s->begin(), lhs_s->size()) == 0;
+        }
+        default:
+          return memcmp(lhs, rhs, field.size) == 0;
+        }
+      }
+
+      void add_field(key_kind_t kind, size_t offset, size_t size)
+      {
+        if (kind == bytes_key && !m_fields.empty()) {
+          key_field &last = m_fields.back();
+          if (last.kind == bytes_key && last.offset + last.size == offset) {
+            last.size += size;
+            return;
+          }
+        }
+        key_field field = {kind, offset, size};
+        m_fields.push_back(field);
+      }
+
+      void add_fields(const type &tp, const char *arrmeta, size_t offset)
+      {
+        switch (tp.get_type_id()) {
+        case float32_type_id:
+          add_field(float32_key, offset, 4);
+          break;
+        case float64_type_id:
+          add_field(float64_key, offset, 8);
+          break;
+        case string_type_id:
+          add_field(string_key, offset, sizeof(string));
+          break;
+        case struct_type_id:
+        case tuple_type_id: {
+          const base_tuple_type *bt = tp.extended<base_tuple_type>();
+          const uintptr_t *data_offsets = bt->get_data_offsets(arrmeta);
+          const uintptr_t *arrmeta_offsets = bt->get_arrmeta_offsets_raw();
+          for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+            add_fields(bt->get_field_type(i), arrmeta + arrmeta_offsets[i], offset + data_offsets[i]);
+          }
+          break;
+        }
+        default:
+          add_field(bytes_key, offset, tp.get_data_size());
+          break;
+        }
+      }
+
+      uint64 load_word(const char *data) const
+      {
+        data += m_fields[0].offset;
+        switch (m_word_size) {
+        case 1:
+          return static_cast<uint8>(*data);
+        case 2: {
+          uint16 word;
+          memcpy(&word, data, 2);
+          return word;
+        }
+        case 4: {
+          uint32 word;
+          memcpy(&word, data, 4);
+          return word;
+        }
+        default: {
+          uint64 word;
+          memcpy(&word, data, 8);
+          return word;
+        }
+        }
+      }
+
+      static uint64 hash_word(uint64 word)
+      {
+        return mix(word ^ 0x9E3779B97F4A7C15ULL);
+      }
+
+      size_t find_word_slot(uint64 word) const
+      {
+        size_t mask = m_slots.size() - 1;
+        size_t slot = static_cast<size_t>(hash_word(word)) & mask;
+        while (m_slots[slot] != 0 && m_words[m_slots[slot] - 1] != word) {
+          slot = (slot + 1) & mask;
+        }
+        return slot;
+      }
+
+      void init_slots(size_t expected_count)
+      {
+        m_word_size = 0;
+        if (m_fields.size() == 1 && m_fields[0].kind == bytes_key) {
+          size_t size = m_fields[0].size;
+          if (size == 1 || size == 2 || size == 4 || size == 8) {
+            m_word_size = size;
+          }
+        }
+
+        size_t nslots = 16;
+        while (nslots < 2 * expected_count) {
+          nslots *= 2;
+        }
+        m_slots.assign(nslots, 0);
+        m_keys.reserve(expected_count);
+      }
+
+      size_t find_slot(const char *data, uint64 h) const
+      {
+        size_t mask = m_slots.size() - 1;
+        size_t slot = static_cast<size_t>(h) & mask;
+        while (m_slots[slot] != 0 && !equal(m_keys[m_slots[slot] - 1], data)) {
+          slot = (slot + 1) & mask;
+        }
+        return slot;
+      }
+
+      void rehash(size_t nslots)
+      {
+        m_slots.assign(nslots, 0);
+        for (size_t i = 0; i < m_keys.size(); ++i) {
+          size_t slot = m_word_size != 0 ? find_word_slot(m_words[i]) : find_slot(m_keys[i], hash(m_keys[i]));
+          m_slots[slot] = static_cast<uint32>(i + 1);
+        }
+      }
+
+    public:
+      /**
+       * Whether values of type ``tp`` can be hashed, which is when
+       * ``tp`` is a builtin integer, bool, float32, float64, string or
+       * fixed_string type.
+       */
+      static bool is_hashable(const type &tp)
+      {
+        switch (tp.get_type_id()) {
+        case bool_type_id:
+        case int8_type_id:
+        case int16_type_id:
+        case int32_type_id:
+        case int64_type_id:
+        case int128_type_id:
+        case uint8_type_id:
+        case uint16_type_id:
+        case uint32_type_id:
+        case uint64_type_id:
+        case uint128_type_id:
+        case float32_type_id:
+        case float64_type_id:
+        case string_type_id:
+        case fixed_string_type_id:
+          return true;
+        default:
+          return false;
+        }
+      }
+
+      /**
+       * Whether values of type ``tp`` can be hashed by a table made with
+       * their arrmeta, which is when ``tp`` is hashable, categorical, or a
+       * struct or tuple of such types.
+       */
+      static bool is_hashable_key(const type &tp)
+      {
+        switch (tp.get_type_id()) {
+        case categorical_type_id:
+          return true;
+        case struct_type_id:
+        case tuple_type_id: {
+          const base_tuple_type *bt = tp.extended<base_tuple_type>();
+          for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+            if (!is_hashable_key(bt->get_field_type(i))) {
+              return false;
+            }
+          }
+          return true;
+        }
+        default:
+          return is_hashable(tp);
+        }
+      }
+
+      /** Makes an empty table for values of type ``tp``, which must be hashable */
+      category_hash_table(const type &tp, size_t expected_count = 0)
+      {
+        add_fields(tp, NULL, 0);
+        init_slots(expected_count);
+      }
+
+      /**
+       * Makes an empty table for values of type ``tp`` with arrmeta
+       * ``arrmeta``, which must satisfy ``is_hashable_key``.
+       */
+      category_hash_table(const type &tp, const char *arrmeta, size_t expected_count)
+      {
+        add_fields(tp, arrmeta, 0);
+        init_slots(expected_count);
+      }
+
+      uint64 hash(const char *data) const
+      {
+        if (m_word_size != 0) {
+          return hash_word(load_word(data));
+        } else if (m_fields.size() == 1) {
+          return hash_field(m_fields[0], data);
+        }
+
+        uint64 h = 0;
+        for (size_t i = 0; i < m_fields.size(); ++i) {
+          h = mix(h ^ hash_field(m_fields[i], data));
+        }
+        return h;
+      }
+
+      bool equal(const char *lhs, const char *rhs) const
+      {
+        for (size_t i = 0; i < m_fields.size(); ++i) {
+          if (!equal_field(m_fields[i], lhs, rhs)) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /** Returns the index of the value equal to ``data``, or -1 if there is none */
+      intptr_t find(const char *data) const
+      {
+        uint32 slot = m_slots[m_word_size != 0 ? find_word_slot(load_word(data)) : find_slot(data, hash(data))];
+        return static_cast<intptr_t>(slot) - 1;
+      }
+
+      /**
+       * Inserts ``data`` if no equal value is in the table, and returns the
+       * index of the value in the table.
+       */
+      intptr_t insert(const char *data)
+      {
+        uint64 word = 0;
+        size_t slot;
+        if (m_word_size != 0) {
+          word = load_word(data);
+          slot = find_word_slot(word);
+        } else {
+          slot = find_slot(data, hash(data));
+        }
+        if (m_slots[slot] != 0) {
+          return m_slots[slot] - 1;
+        }
+
+        if (m_word_size != 0) {
+          m_words.push_back(word);
+        }
+        m_keys.push_back(data);
+        m_slots[slot] = static_cast<uint32>(m_keys.size());
+        // Keep the load factor at most a half
+        if (2 * m_keys.size() > m_slots.size()) {
+          rehash(2 * m_slots.size());
+        }
+        return m_keys.size() - 1;
+      }
+
+      /** The inserted values, in insertion order */
+      const std::vector<const char *> &keys() const
+      {
+        return m_keys;
+      }
+    };
+
+  } // namespace dynd::ndt::detail
+} // namespace dynd::ndt
+} // namespace dynd
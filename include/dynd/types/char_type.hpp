@@ -51,6 +51,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     void arrmeta_default_construct(char *DYND_UNUSED(arrmeta),
                                    bool DYND_UNUSED(blockref_alloc)) const
     {
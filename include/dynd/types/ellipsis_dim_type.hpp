@@ -46,6 +46,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     type get_type_at_dimension(char **inout_arrmeta, intptr_t i,
                                intptr_t total_ndim = 0) const;
 
@@ -59,7 +61,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     void get_dynamic_type_properties(
         const std::pair<std::string, nd::callable> **out_properties,
@@ -198,6 +198,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
     void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
                                 const intrusive_ptr<memory_block_data> &embedded_reference) const;
@@ -239,7 +241,7 @@ namespace ndt {
     void reorder_default_constructed_strides(char *dst_arrmeta, const type &src_tp, const char *src_arrmeta) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     void get_dynamic_type_properties(const std::pair<std::string, nd::callable> **out_properties,
                                      size_t *out_count) const;
@@ -90,6 +90,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     type with_replaced_storage_type(const type &replacement_type) const;
 
     void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
@@ -116,7 +118,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               small_map<std::string, type> &tp_vars) const;
 
     void get_dynamic_type_properties(
         const std::pair<std::string, nd::callable> **out_properties,
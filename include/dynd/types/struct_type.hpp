@@ -54,6 +54,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     void arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const;
 
     virtual intptr_t make_assignment_kernel(void *ckb, intptr_t ckb_offset, const type &dst_tp, const char *dst_arrmeta,
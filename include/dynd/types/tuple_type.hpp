@@ -52,6 +52,8 @@ namespace ndt {
 
     bool operator==(const base_type &rhs) const;
 
+    size_t compute_hash() const;
+
     void arrmeta_debug_print(const char *arrmeta, std::ostream &o,
                              const std::string &indent) const;
 
@@ -9,6 +9,7 @@
 #include <llvm/Support/Regex.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 
 using namespace std;
 using namespace llvm;
@@ -40,19 +41,63 @@ public:
     return true;
   }
 
+  // Whether F uses a function or variable which is local to its module, and
+  // so can't be resolved when its IR is linked into another one
+  static bool usesLocals(const Function &F)
+  {
+    for (const BasicBlock &BB : F) {
+      for (const Instruction &I : BB) {
+        for (const Value *Op : I.operands()) {
+          const GlobalValue *G = dyn_cast<GlobalValue>(Op->stripPointerCasts());
+          if (G != NULL && G != &F && G->hasLocalLinkage()) {
+            const GlobalVariable *V = dyn_cast<GlobalVariable>(G);
+            if (V == NULL || !V->isConstant()) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // Prints a module in which F is the only function definition, with the
+  // declarations, types and attributes it needs
+  static string printFunctionModule(Function &F)
+  {
+    ValueToValueMapTy VMap;
+    unique_ptr<Module> Clone = CloneModule(*F.getParent(), VMap, [&F](const GlobalValue *G) {
+      const GlobalVariable *V = dyn_cast<GlobalVariable>(G);
+      return G == &F || (V != NULL && V->isConstant() && V->hasLocalLinkage());
+    });
+    vector<GlobalVariable *> Special;
+    for (GlobalVariable &V : Clone->globals()) {
+      if (V.getName().startswith("llvm.")) {
+        Special.push_back(&V);
+      }
+    }
+    for (GlobalVariable *V : Special) {
+      V->eraseFromParent();
+    }
+
+    string S;
+    raw_string_ostream SO(S);
+    Clone->print(SO, NULL);
+    return SO.str();
+  }
+
   bool runOnFunction(Function &F) override
   {
-    if (F.hasFnAttribute("emit_llvm")) {
+    if (F.hasFnAttribute("emit_llvm") && !usesLocals(F)) {
       Module *M = F.getParent();
 
       static Regex R("4func.*$");
       GlobalVariable *GV = M->getGlobalVariable(R.sub("2irE", F.getName()), true);
       if (GV != NULL) {
-        string S;
-        raw_string_ostream SO(S);
-        F.print(SO);
+        string S = printFunctionModule(F);
 
-        Constant *CDA = ConstantDataArray::getString(M->getContext(), SO.str());
+        Constant *CDA = ConstantDataArray::getString(M->getContext(), S);
         GV->setInitializer(ConstantExpr::getBitCast(new GlobalVariable(*M, CDA->getType(), true, GV->getLinkage(), CDA),
                                                     Type::getInt8PtrTy(M->getContext())));
 
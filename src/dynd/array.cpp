@@ -12,6 +12,7 @@
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/tuple_type.hpp>
+#include <dynd/types/struct_type.hpp>
 #include <dynd/types/type_alignment.hpp>
 #include <dynd/types/view_type.hpp>
 #include <dynd/types/string_type.hpp>
@@ -736,9 +737,14 @@ nd::array nd::array::p(const char *property_name) const
     } else {
       get_builtin_type_dynamic_array_properties(dt.get_type_id(), &properties, &count);
     }
-    // TODO: We probably want to make some kind of acceleration structure for
-    // the name lookup
-    if (count > 0) {
+    if (dt.get_type_id() == struct_type_id) {
+      // The properties of a struct are its fields, so use its name index
+      intptr_t i =
+          dt.extended<ndt::base_struct_type>()->get_field_index(property_name, property_name + strlen(property_name));
+      if (i >= 0 && static_cast<size_t>(i) < count) {
+        return properties[i].second.call(*this);
+      }
+    } else if (count > 0) {
       for (size_t i = 0; i < count; ++i) {
         if (properties[i].first == property_name) {
           return properties[i].second.call(*this);
@@ -763,9 +769,14 @@ nd::array nd::array::p(const std::string &property_name) const
     } else {
       get_builtin_type_dynamic_array_properties(dt.get_type_id(), &properties, &count);
     }
-    // TODO: We probably want to make some kind of acceleration structure for
-    // the name lookup
-    if (count > 0) {
+    if (dt.get_type_id() == struct_type_id) {
+      // The properties of a struct are its fields, so use its name index
+      intptr_t i = dt.extended<ndt::base_struct_type>()->get_field_index(property_name.data(),
+                                                                         property_name.data() + property_name.size());
+      if (i >= 0 && static_cast<size_t>(i) < count) {
+        return properties[i].second.call(*this);
+      }
+    } else if (count > 0) {
       for (size_t i = 0; i < count; ++i) {
         if (properties[i].first == property_name) {
           return properties[i].second.call(*this);
@@ -943,7 +954,7 @@ bool nd::array::equals_exact(const array &rhs) const
           const char *arrmeta[2] = {iter.arrmeta<0>(), iter.arrmeta<1>()};
           ndt::type dst_tp = ndt::type::make<bool1>();
           if ((*not_equal::get().get())(dst_tp, 2, tp, arrmeta, const_cast<char *const *>(src), 0, NULL,
-                                        std::map<std::string, ndt::type>()).as<bool>()) {
+                                        small_map<std::string, ndt::type>()).as<bool>()) {
             return false;
           }
         } while (iter.next());
@@ -1734,6 +1745,97 @@ nd::array nd::memmap(const std::string &DYND_UNUSED(filename), intptr_t DYND_UNU
   */
 }
 
+nd::array nd::memmap(const std::string &filename, const ndt::type &tp, intptr_t offset, uint32_t access)
+{
+  if (offset < 0) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" at negative offset " << offset;
+    throw invalid_argument(ss.str());
+  }
+
+  // A symbolic outermost dimension takes its size from the file
+  ndt::type el_tp = tp;
+  bool deduce_dim_size = false;
+  if (tp.get_type_id() == fixed_dim_type_id && tp.is_symbolic()) {
+    el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+    deduce_dim_size = true;
+  } else if (tp.get_type_id() == typevar_dim_type_id) {
+    el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+    deduce_dim_size = true;
+  }
+  if (el_tp.is_symbolic() || (el_tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp
+       << ", the type must have a fixed layout without references to other memory";
+    throw type_error(ss.str());
+  }
+  // Fixed dims and structs have a data size of zero, their layout is in the
+  // arrmeta, so the default data size is the one to check
+  if (el_tp.get_default_data_size() == 0) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp << ", the type has no data to map";
+    throw type_error(ss.str());
+  }
+  if (offset % el_tp.get_data_alignment() != 0) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp << " at offset " << offset
+       << ", which is not aligned for the type";
+    throw invalid_argument(ss.str());
+  }
+
+  intptr_t el_size = el_tp.get_default_data_size();
+  intptr_t end = deduce_dim_size ? std::numeric_limits<intptr_t>::max() : offset + el_size;
+  uint32_t flags = read_access_flag | (access & (write_access_flag | immutable_access_flag));
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, flags, &mm_ptr, &mm_size, offset, end);
+
+  ndt::type result_tp;
+  if (deduce_dim_size) {
+    result_tp = ndt::make_fixed_dim(mm_size / el_size, el_tp);
+  } else if (mm_size < el_size) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp << " at offset " << offset << ", it needs "
+       << el_size << " bytes but the file has " << mm_size;
+    throw invalid_argument(ss.str());
+  } else {
+    result_tp = el_tp;
+  }
+
+  intrusive_ptr<memory_block_data> result = make_array_memory_block(result_tp.get_arrmeta_size());
+  array_preamble *preamble = reinterpret_cast<array_preamble *>(result.get());
+  preamble->type = ndt::type(result_tp).release();
+  preamble->data = mm_ptr;
+  preamble->owner = mm;
+  preamble->flags = flags;
+  if (!result_tp.is_builtin() && result_tp.get_arrmeta_size() > 0) {
+    result_tp.extended()->arrmeta_default_construct(reinterpret_cast<char *>(preamble + 1), false);
+  }
+  return nd::array(std::move(result));
+}
+
+/**
+ * Returns the memory-mapped file an array refers to.
+ */
+static memory_block_data *get_memmap_owner(const nd::array &a)
+{
+  memory_block_data *owner = a.get()->owner.get();
+  if (owner == NULL || owner->m_type != memmap_memory_block_type) {
+    throw invalid_argument("the array does not refer to a memory-mapped file");
+  }
+  return owner;
+}
+
+void nd::memmap_advise(const array &a, memmap_advice_t advice)
+{
+  memmap_memory_block_advise(get_memmap_owner(a), advice);
+}
+
+void nd::memmap_flush(const array &a)
+{
+  memmap_memory_block_flush(get_memmap_owner(a));
+}
+
 bool nd::is_scalar_avail(const ndt::type &tp, const char *arrmeta, const char *data, const eval::eval_context *ectx)
 {
   if (tp.is_scalar()) {
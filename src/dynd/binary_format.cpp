@@ -0,0 +1,413 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#include <dynd/binary_format.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/types/base_tuple_type.hpp>
+#include <dynd/types/datashape_formatter.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+static const char binary_magic[8] = {'D', 'Y', 'N', 'D', 'B', 'I', 'N', '\0'};
+static const uint32_t binary_version = 1;
+// The data and payload blocks start on multiples of this
+static const uint64_t binary_block_alignment = 64;
+
+/**
+ * The header at the start of a file, followed by the datashape.
+ */
+struct binary_header {
+  char magic[8];
+  uint32_t version;
+  uint8_t pointer_size;
+  uint8_t little_endian;
+  uint8_t reserved[2];
+  uint64_t datashape_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint64_t payload_offset;
+  uint64_t payload_size;
+};
+
+/**
+ * In the file, var dim elements and strings are records of an offset into
+ * the payload and a size, the same size as their data in memory.
+ */
+struct binary_record {
+  uintptr_t offset;
+  size_t size;
+};
+
+static_assert(sizeof(binary_record) == sizeof(var_dim_type_data), "a record must be the size of var dim data");
+static_assert(sizeof(binary_record) == sizeof(dynd::string), "a record must be the size of string data");
+
+bool is_little_endian()
+{
+  uint16_t one = 1;
+  return *reinterpret_cast<const uint8_t *>(&one) == 1;
+}
+
+uint64_t align_up(uint64_t offset, uint64_t alignment)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Whether values of type ``tp`` are plain data without references to other
+ * memory, which the file holds as they are. This isn't ``is_pod``, which is
+ * false for fixed dims and structs because their layout is in the arrmeta.
+ */
+bool is_plain_data(const ndt::type &tp)
+{
+  return (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+}
+
+/**
+ * Raises an error if values of type ``tp`` can't be saved.
+ */
+void check_binary_type(const ndt::type &tp)
+{
+  if (is_plain_data(tp)) {
+    return;
+  }
+
+  switch (tp.get_type_id()) {
+  case fixed_dim_type_id:
+  case var_dim_type_id:
+    check_binary_type(tp.extended<ndt::base_dim_type>()->get_element_type());
+    return;
+  case struct_type_id:
+  case tuple_type_id: {
+    const ndt::base_tuple_type *bt = tp.extended<ndt::base_tuple_type>();
+    for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+      check_binary_type(bt->get_field_type(i));
+    }
+    return;
+  }
+  case string_type_id:
+    return;
+  default: {
+    stringstream ss;
+    ss << "cannot save dynd type " << tp << " in the binary format";
+    throw type_error(ss.str());
+  }
+  }
+}
+
+/**
+ * Builds the payload, and turns the pointers in the data of an array into
+ * offsets into it.
+ */
+struct binary_writer {
+  vector<char> payload;
+
+  uintptr_t append(const char *data, size_t size, size_t alignment)
+  {
+    size_t offset = static_cast<size_t>(align_up(payload.size(), alignment));
+    payload.resize(offset + size);
+    if (size > 0) {
+      memcpy(&payload[offset], data, size);
+    }
+    return offset;
+  }
+
+  /**
+   * Writes the records for the non-POD parts of ``src``, a value of type
+   * ``tp`` with default arrmeta, into ``out`` at ``out_offset``, where a copy
+   * of ``src`` is. Indices are used rather than pointers because appending
+   * to the payload moves it.
+   */
+  void encode(const ndt::type &tp, const char *arrmeta, const char *src, vector<char> &out, size_t out_offset)
+  {
+    if (is_plain_data(tp)) {
+      return;
+    }
+
+    switch (tp.get_type_id()) {
+    case fixed_dim_type_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < md->dim_size; ++i) {
+        encode(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), src + i * md->stride, out, out_offset + i * md->stride);
+      }
+      break;
+    }
+    case var_dim_type_id: {
+      const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
+      const var_dim_type_data *d = reinterpret_cast<const var_dim_type_data *>(src);
+      const ndt::type &el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+      const char *el_src = d->begin + md->offset;
+
+      binary_record record;
+      record.offset = append(el_src, d->size * md->stride, el_tp.get_data_alignment());
+      record.size = d->size;
+      memcpy(&out[out_offset], &record, sizeof(record));
+      for (size_t i = 0; i < d->size; ++i) {
+        encode(el_tp, arrmeta + sizeof(var_dim_type_arrmeta), el_src + i * md->stride, payload,
+               record.offset + i * md->stride);
+      }
+      break;
+    }
+    case struct_type_id:
+    case tuple_type_id: {
+      const ndt::base_tuple_type *bt = tp.extended<ndt::base_tuple_type>();
+      const uintptr_t *data_offsets = bt->get_data_offsets(arrmeta);
+      const uintptr_t *arrmeta_offsets = bt->get_arrmeta_offsets_raw();
+      for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+        encode(bt->get_field_type(i), arrmeta + arrmeta_offsets[i], src + data_offsets[i], out,
+               out_offset + data_offsets[i]);
+      }
+      break;
+    }
+    case string_type_id: {
+      const dynd::string *s = reinterpret_cast<const dynd::string *>(src);
+      binary_record record;
+      record.offset = append(s->begin(), s->size(), 1);
+      record.size = s->size();
+      memcpy(&out[out_offset], &record, sizeof(record));
+      break;
+    }
+    default:
+      check_binary_type(tp);
+    }
+  }
+};
+
+/**
+ * Fills an array from the data and payload of a file.
+ */
+struct binary_reader {
+  std::string filename;
+  const char *payload;
+  uint64_t payload_size;
+  // The memory-mapped file, which var dims with POD elements refer to
+  // instead of copying them, if not NULL
+  intrusive_ptr<memory_block_data> mapped;
+
+  const char *get_payload(const binary_record &record, size_t stride) const
+  {
+    if (record.offset > payload_size || record.size * stride > payload_size - record.offset) {
+      stringstream ss;
+      ss << "the dynd binary file \"" << filename << "\" is corrupt, it refers to data past its end";
+      throw runtime_error(ss.str());
+    }
+    return payload + record.offset;
+  }
+
+  /**
+   * Copies ``src``, a value of type ``tp`` with default arrmeta in the file,
+   * to ``dst``, a default-constructed value of the same type.
+   */
+  void decode(const ndt::type &tp, char *arrmeta, char *dst, const char *src)
+  {
+    if (is_plain_data(tp)) {
+      memcpy(dst, src, tp.get_default_data_size());
+      return;
+    }
+
+    switch (tp.get_type_id()) {
+    case fixed_dim_type_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < md->dim_size; ++i) {
+        decode(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), dst + i * md->stride, src + i * md->stride);
+      }
+      break;
+    }
+    case var_dim_type_id: {
+      var_dim_type_arrmeta *md = reinterpret_cast<var_dim_type_arrmeta *>(arrmeta);
+      var_dim_type_data *d = reinterpret_cast<var_dim_type_data *>(dst);
+      const ndt::type &el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+      binary_record record;
+      memcpy(&record, src, sizeof(record));
+      const char *el_src = get_payload(record, md->stride);
+
+      if (mapped && is_plain_data(el_tp)) {
+        // Point into the mapped payload
+        md->blockref = mapped;
+        d->begin = const_cast<char *>(el_src);
+        d->size = record.size;
+      } else if (is_plain_data(el_tp)) {
+        ndt::var_dim_element_initialize(tp, arrmeta, dst, record.size);
+        memcpy(d->begin, el_src, record.size * md->stride);
+      } else {
+        ndt::var_dim_element_initialize(tp, arrmeta, dst, record.size);
+        for (size_t i = 0; i < record.size; ++i) {
+          decode(el_tp, arrmeta + sizeof(var_dim_type_arrmeta), d->begin + i * md->stride, el_src + i * md->stride);
+        }
+      }
+      break;
+    }
+    case struct_type_id:
+    case tuple_type_id: {
+      const ndt::base_tuple_type *bt = tp.extended<ndt::base_tuple_type>();
+      const uintptr_t *data_offsets = bt->get_data_offsets(arrmeta);
+      const uintptr_t *arrmeta_offsets = bt->get_arrmeta_offsets_raw();
+      for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+        decode(bt->get_field_type(i), arrmeta + arrmeta_offsets[i], dst + data_offsets[i], src + data_offsets[i]);
+      }
+      break;
+    }
+    case string_type_id: {
+      binary_record record;
+      memcpy(&record, src, sizeof(record));
+      const char *begin = get_payload(record, 1);
+      reinterpret_cast<dynd::string *>(dst)->assign(begin, record.size);
+      break;
+    }
+    default:
+      check_binary_type(tp);
+    }
+  }
+};
+
+} // anonymous namespace
+
+void nd::save_binary(const array &a, const std::string &filename)
+{
+  ndt::type tp = a.get_type().get_canonical_type();
+  check_binary_type(tp);
+  if (tp.is_symbolic()) {
+    stringstream ss;
+    ss << "cannot save an array of symbolic type " << tp << " in the binary format";
+    throw type_error(ss.str());
+  }
+
+  // The data is written in the layout of the default arrmeta, so a copy
+  // is made unless the array already has it
+  array src = a;
+  if (a.get_type() != tp || !is_plain_data(tp) || !tp.is_c_contiguous(a.get()->metadata())) {
+    src = empty(tp);
+    src.val_assign(a);
+  }
+
+  uint64_t data_size = tp.get_default_data_size();
+  binary_writer writer;
+  vector<char> data;
+  const char *data_ptr = src.cdata();
+  if (!is_plain_data(tp)) {
+    data.assign(src.cdata(), src.cdata() + data_size);
+    writer.encode(tp, src.get()->metadata(), src.cdata(), data, 0);
+    data_ptr = data.data();
+  }
+
+  std::string datashape = format_datashape(tp, "", false);
+  binary_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, binary_magic, sizeof(binary_magic));
+  header.version = binary_version;
+  header.pointer_size = sizeof(void *);
+  header.little_endian = is_little_endian();
+  header.datashape_size = datashape.size();
+  header.data_offset = align_up(sizeof(header) + datashape.size(), binary_block_alignment);
+  header.data_size = data_size;
+  header.payload_offset = align_up(header.data_offset + data_size, binary_block_alignment);
+  header.payload_size = writer.payload.size();
+
+  ofstream out(filename.c_str(), ios::binary | ios::trunc);
+  if (!out) {
+    stringstream ss;
+    ss << "failed to open file \"" << filename << "\" for writing";
+    throw runtime_error(ss.str());
+  }
+  const char padding[binary_block_alignment] = {};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(datashape.data(), datashape.size());
+  out.write(padding, header.data_offset - sizeof(header) - datashape.size());
+  out.write(data_ptr, data_size);
+  out.write(padding, header.payload_offset - header.data_offset - data_size);
+  if (!writer.payload.empty()) {
+    out.write(writer.payload.data(), writer.payload.size());
+  }
+  out.close();
+  if (!out) {
+    stringstream ss;
+    ss << "failed to write file \"" << filename << "\"";
+    throw runtime_error(ss.str());
+  }
+}
+
+nd::array nd::load_binary(const std::string &filename, uint32_t access)
+{
+  ifstream in(filename.c_str(), ios::binary);
+  if (!in) {
+    stringstream ss;
+    ss << "failed to open file \"" << filename << "\" for reading";
+    throw runtime_error(ss.str());
+  }
+  binary_header header;
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0) {
+    stringstream ss;
+    ss << "the file \"" << filename << "\" is not a dynd binary file";
+    throw runtime_error(ss.str());
+  }
+  if (header.version != binary_version) {
+    stringstream ss;
+    ss << "the dynd binary file \"" << filename << "\" has version " << header.version << ", expected "
+       << binary_version;
+    throw runtime_error(ss.str());
+  }
+  if (header.pointer_size != sizeof(void *) || (header.little_endian != 0) != is_little_endian()) {
+    stringstream ss;
+    ss << "the dynd binary file \"" << filename << "\" was saved on a platform with a different "
+       << "pointer size or byte order";
+    throw runtime_error(ss.str());
+  }
+  std::string datashape(header.datashape_size, '\0');
+  in.read(&datashape[0], datashape.size());
+  if (!in) {
+    stringstream ss;
+    ss << "the dynd binary file \"" << filename << "\" is truncated";
+    throw runtime_error(ss.str());
+  }
+  in.close();
+
+  ndt::type tp(datashape);
+  if (tp.get_default_data_size() == 0) {
+    // Nothing to map or decode, and memmap rejects types without data
+    array result = empty(tp);
+    result.get()->flags = read_access_flag | (access & (write_access_flag | immutable_access_flag));
+    return result;
+  }
+  if (is_plain_data(tp)) {
+    return memmap(filename, tp, header.data_offset, access);
+  }
+
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, read_access_flag, &mm_ptr, &mm_size);
+  if (static_cast<uint64_t>(mm_size) < header.data_offset + header.data_size ||
+      static_cast<uint64_t>(mm_size) < header.payload_offset + header.payload_size) {
+    stringstream ss;
+    ss << "the dynd binary file \"" << filename << "\" is truncated";
+    throw runtime_error(ss.str());
+  }
+
+  bool writable = (access & write_access_flag) != 0;
+  binary_reader reader;
+  reader.filename = filename;
+  reader.payload = mm_ptr + header.payload_offset;
+  reader.payload_size = header.payload_size;
+  if (!writable) {
+    reader.mapped = mm;
+  }
+
+  array result = empty(tp);
+  reader.decode(tp, result.get()->metadata(), result.data(), mm_ptr + header.data_offset);
+  result.get()->flags = read_access_flag | (access & (write_access_flag | immutable_access_flag));
+  return result;
+}
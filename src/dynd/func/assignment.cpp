@@ -73,7 +73,7 @@ intptr_t dynd::make_assignment_kernel(void *ckb, intptr_t ckb_offset, const ndt:
     if (src_tp.is_builtin()) {
       nd::callable &child = nd::assign::overload(dst_tp, src_tp);
       return child.get()->instantiate(NULL, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, 1, &src_tp, &src_arrmeta,
-                                      kernreq, ectx, 0, NULL, std::map<std::string, ndt::type>());
+                                      kernreq, ectx, 0, NULL, small_map<std::string, ndt::type>());
     } else {
       return src_tp.extended()->make_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp, src_arrmeta,
                                                        kernreq, ectx);
@@ -137,7 +137,7 @@ intptr_t dynd::make_cuda_device_builtin_type_assignment_kernel(
     void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
     intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
     kernel_request_t kernreq, const eval::eval_context *ectx, const nd::array &kwds,
-    const std::map<std::string, ndt::type> &tp_vars)
+    const small_map<std::string, ndt::type> &tp_vars)
 {
   assign_error_mode errmode = ectx->cuda_device_errmode;
 
@@ -170,7 +170,7 @@ intptr_t dynd::make_cuda_to_device_builtin_type_assignment_kernel(
     void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
     intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
     kernel_request_t kernreq, const eval::eval_context *ectx, const nd::array &DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   assign_error_mode errmode = ectx->errmode;
 
@@ -194,7 +194,7 @@ intptr_t dynd::make_cuda_from_device_builtin_type_assignment_kernel(
     void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
     intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
     kernel_request_t kernreq, const eval::eval_context *ectx, const nd::array &DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   assign_error_mode errmode = ectx->errmode;
 
@@ -0,0 +1,306 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/func/bound_kernel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static void copy_arrmeta(arrmeta_holder &dst, const char *src_arrmeta)
+{
+  const ndt::type &tp = dst.get_type();
+  if (!tp.is_builtin() && tp.get_arrmeta_size() > 0) {
+    tp.extended()->arrmeta_copy_construct(dst.get(), src_arrmeta, intrusive_ptr<memory_block_data>());
+  }
+}
+
+static bool has_plain_arrmeta(const ndt::type &tp)
+{
+  return (tp.get_flags() & type_flag_blockref) == 0;
+}
+
+static bool equal_arrmeta(const ndt::type &tp, const char *lhs, const char *rhs)
+{
+  size_t size = tp.get_arrmeta_size();
+  return size == 0 || memcmp(lhs, rhs, size) == 0;
+}
+
+void nd::bound_kernel::pack_kwds(intptr_t nkwd, const nd::array *kwds, std::string &out_bytes)
+{
+  out_bytes.clear();
+  for (intptr_t i = 0; i < nkwd; ++i) {
+    if (kwds[i].is_null()) {
+      continue;
+    }
+
+    const ndt::type &tp = kwds[i].get_type();
+    out_bytes.append(kwds[i].get()->metadata(), tp.get_arrmeta_size());
+    out_bytes.append(kwds[i].cdata(), tp.get_data_size());
+  }
+}
+
+nd::bound_kernel::bound_kernel(callable_type_data &self, const ndt::type &dst_tp, const char *dst_arrmeta,
+                               intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta, intptr_t nkwd,
+                               const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars,
+                               const eval::eval_context *ectx)
+    : m_requested_dst_tp(dst_tp), m_nsrc(nsrc), m_src(new arrmeta_holder[nsrc > 0 ? nsrc : 1]), m_ectx(*ectx),
+      m_executable(false)
+{
+  vector<const char *> bound_src_arrmeta(nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    arrmeta_holder(src_tp[i]).swap(m_src[i]);
+    copy_arrmeta(m_src[i], src_arrmeta[i]);
+    bound_src_arrmeta[i] = m_src[i].get();
+  }
+
+  m_kwd_tp.reserve(nkwd);
+  for (intptr_t i = 0; i < nkwd; ++i) {
+    m_kwd_tp.push_back(kwds[i].is_null() ? ndt::type() : kwds[i].get_type());
+  }
+  pack_kwds(nkwd, kwds, m_kwd_bytes);
+
+  // Allocate, then initialize, the data
+  std::unique_ptr<char[]> data((self.data_size > 0) ? new char[self.data_size] : NULL);
+  if (self.data_size > 0) {
+    self.data_init(self.static_data, self.data_size, data.get(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  }
+
+  if (dst_arrmeta == NULL) {
+    // Resolve the destination type, then give it the arrmeta nd::empty would
+    ndt::type resolved_dst_tp = dst_tp;
+    if (resolved_dst_tp.is_symbolic()) {
+      if (self.resolve_dst_type == NULL) {
+        throw std::runtime_error("dst_tp is symbolic, but resolve_dst_type is NULL");
+      }
+
+      self.resolve_dst_type(self.static_data, self.data_size, data.get(), resolved_dst_tp, nsrc, src_tp, nkwd, kwds,
+                            tp_vars);
+    }
+    arrmeta_holder(resolved_dst_tp).swap(m_dst);
+    m_dst.arrmeta_default_construct(true);
+  } else {
+    arrmeta_holder(dst_tp).swap(m_dst);
+    copy_arrmeta(m_dst, dst_arrmeta);
+  }
+
+  self.instantiate(self.static_data, self.data_size, data.get(), &m_ckb, 0, m_dst.get_type(), m_dst.get(), nsrc,
+                   src_tp, bound_src_arrmeta.data(), kernel_request_single, &m_ectx, nkwd, kwds,
+                   tp_vars);
+
+  // A resolved destination with memory block references can't be written
+  // through the bound arrmeta, so only the signature is kept. A cache uses
+  // such an entry to remember not to bind this signature again.
+  m_executable = has_plain_arrmeta(m_dst.get_type());
+  if (!m_executable) {
+    m_ckb.reset();
+  }
+}
+
+nd::bound_kernel::bound_kernel(bound_kernel &&rhs)
+    : m_requested_dst_tp(std::move(rhs.m_requested_dst_tp)), m_nsrc(rhs.m_nsrc), m_src(std::move(rhs.m_src)),
+      m_kwd_tp(std::move(rhs.m_kwd_tp)), m_kwd_bytes(std::move(rhs.m_kwd_bytes)), m_ectx(rhs.m_ectx),
+      m_executable(rhs.m_executable)
+{
+  m_dst.swap(rhs.m_dst);
+  m_ckb.swap(rhs.m_ckb);
+}
+
+bool nd::bound_kernel::matches_dst_arrmeta(const char *dst_arrmeta) const
+{
+  return equal_arrmeta(get_dst_type(), get_dst_arrmeta(), dst_arrmeta);
+}
+
+bool nd::bound_kernel::matches(const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                               const ndt::type *src_tp, const char *const *src_arrmeta, intptr_t nkwd,
+                               const nd::array *kwds, const eval::eval_context &ectx) const
+{
+  // Only the settings instantiation depends on are compared
+  if (ectx.errmode != m_ectx.errmode || ectx.summation != m_ectx.summation || ectx.nthreads != m_ectx.nthreads ||
+      ectx.parallel_chunk_size != m_ectx.parallel_chunk_size ||
+      ectx.deterministic_reduction != m_ectx.deterministic_reduction || nsrc != m_nsrc ||
+      nkwd != static_cast<intptr_t>(m_kwd_tp.size()) || dst_tp != m_requested_dst_tp) {
+    return false;
+  }
+
+  if (dst_arrmeta != NULL && !matches_dst_arrmeta(dst_arrmeta)) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    if (src_tp[i] != m_src[i].get_type() ||
+        !equal_arrmeta(src_tp[i], const_cast<arrmeta_holder &>(m_src[i]).get(), src_arrmeta[i])) {
+      return false;
+    }
+  }
+
+  const char *kwd_bytes = m_kwd_bytes.data();
+  for (intptr_t i = 0; i < nkwd; ++i) {
+    if (kwds[i].is_null()) {
+      if (!m_kwd_tp[i].is_null()) {
+        return false;
+      }
+      continue;
+    }
+
+    const ndt::type &tp = kwds[i].get_type();
+    if (tp != m_kwd_tp[i]) {
+      return false;
+    }
+
+    size_t arrmeta_size = tp.get_arrmeta_size();
+    if (arrmeta_size > 0 && memcmp(kwd_bytes, kwds[i].get()->metadata(), arrmeta_size) != 0) {
+      return false;
+    }
+    kwd_bytes += arrmeta_size;
+
+    size_t data_size = tp.get_data_size();
+    if (data_size > 0 && memcmp(kwd_bytes, kwds[i].cdata(), data_size) != 0) {
+      return false;
+    }
+    kwd_bytes += data_size;
+  }
+
+  return true;
+}
+
+nd::array nd::bound_kernel::operator()(intptr_t nsrc, const array *src) const
+{
+  array dst = empty(get_dst_type());
+  (*this)(dst, nsrc, src);
+
+  return dst;
+}
+
+void nd::bound_kernel::operator()(const array &dst, intptr_t nsrc, const array *src) const
+{
+  if (!m_executable) {
+    stringstream ss;
+    ss << "cannot execute a bound kernel with destination type " << get_dst_type();
+    throw type_error(ss.str());
+  }
+
+  if (dst.get_type() != get_dst_type() || !matches_dst_arrmeta(dst.get()->metadata())) {
+    stringstream ss;
+    ss << "bound kernel expected a destination of type " << get_dst_type() << " with matching arrmeta, got "
+       << dst.get_type();
+    throw invalid_argument(ss.str());
+  }
+
+  if (nsrc != m_nsrc) {
+    stringstream ss;
+    ss << "bound kernel expected " << m_nsrc << " arguments, got " << nsrc;
+    throw invalid_argument(ss.str());
+  }
+
+  vector<char *> src_data(nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    const ndt::type &tp = src[i].get_type();
+    if (tp != get_src_type(i) ||
+        !equal_arrmeta(tp, const_cast<arrmeta_holder &>(m_src[i]).get(), src[i].get()->metadata())) {
+      stringstream ss;
+      ss << "bound kernel expected argument " << i << " to have type " << get_src_type(i)
+         << " with matching arrmeta, got " << tp;
+      throw invalid_argument(ss.str());
+    }
+    src_data[i] = const_cast<char *>(src[i].cdata());
+  }
+
+  single(const_cast<char *>(dst.cdata()), src_data.data());
+}
+
+bool nd::bound_kernel::is_bindable(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd,
+                                   const nd::array *kwds)
+{
+  // A symbolic destination type is resolved when binding, and is checked then
+  if (!dst_tp.is_symbolic() && !has_plain_arrmeta(dst_tp)) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    if (src_tp[i].is_symbolic() || !has_plain_arrmeta(src_tp[i])) {
+      return false;
+    }
+  }
+
+  // Keyword values are compared by their bytes, so they must be scalars
+  // without any references. The slot of a "dst" keyword is left null.
+  for (intptr_t i = 0; i < nkwd; ++i) {
+    if (kwds[i].is_null()) {
+      continue;
+    }
+
+    const ndt::type &tp = kwds[i].get_type();
+    if (tp.is_symbolic() || tp.get_ndim() != 0 ||
+        (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::unique_ptr<nd::bound_kernel> nd::kernel_cache::acquire(const ndt::type &dst_tp, const char *dst_arrmeta,
+                                                            intptr_t nsrc, const ndt::type *src_tp,
+                                                            const char *const *src_arrmeta, intptr_t nkwd,
+                                                            const nd::array *kwds, const eval::eval_context &ectx)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // Search from the most recently used entry
+  for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+    if ((*it)->matches(dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, nkwd, kwds, ectx)) {
+      std::unique_ptr<bound_kernel> res = std::move(*it);
+      m_entries.erase(std::next(it).base());
+      ++m_hits;
+      return res;
+    }
+  }
+
+  ++m_misses;
+  return std::unique_ptr<bound_kernel>();
+}
+
+void nd::kernel_cache::release(std::unique_ptr<bound_kernel> &&entry)
+{
+  std::unique_ptr<bound_kernel> evicted;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_capacity == 0) {
+    return;
+  }
+  if (m_entries.size() >= m_capacity) {
+    evicted = std::move(m_entries.front());
+    m_entries.erase(m_entries.begin());
+  }
+  m_entries.push_back(std::move(entry));
+}
+
+void nd::kernel_cache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+std::size_t nd::kernel_cache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+std::size_t nd::kernel_cache::hits() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_hits;
+}
+
+std::size_t nd::kernel_cache::misses() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_misses;
+}
@@ -3,6 +3,9 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <mutex>
+#include <unordered_map>
+
 #include <dynd/func/callable.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/ckernel_common_functions.hpp>
@@ -32,7 +35,7 @@ struct unary_assignment_ck : nd::base_virtual_kernel<unary_assignment_ck> {
               const char *const *src_arrmeta, kernel_request_t kernreq,
               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
               const nd::array *DYND_UNUSED(kwds),
-              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+              const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
   {
     assign_error_mode errmode =
       *reinterpret_cast<assign_error_mode *>(static_data);
@@ -61,7 +64,7 @@ struct property_kernel : nd::base_virtual_kernel<property_kernel> {
               const char *const *src_arrmeta, kernel_request_t kernreq,
               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
               const nd::array *DYND_UNUSED(kwds),
-              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+              const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
   {
     ndt::type prop_src_tp = *reinterpret_cast<ndt::type *>(static_data);
 
@@ -112,10 +115,10 @@ nd::callable dynd::make_callable_from_property(const ndt::type &tp,
 }
 
 void nd::detail::validate_kwd_types(const ndt::callable_type *af_tp,
-                                    std::vector<ndt::type> &kwd_tp,
-                                    const std::vector<intptr_t> &available,
-                                    const std::vector<intptr_t> &missing,
-                                    std::map<std::string, ndt::type> &tp_vars)
+                                    small_vector<ndt::type> &kwd_tp,
+                                    const small_vector<intptr_t> &available,
+                                    const small_vector<intptr_t> &missing,
+                                    small_map<std::string, ndt::type> &tp_vars)
 {
   for (intptr_t j : available) {
     if (j == -1) {
@@ -151,19 +154,34 @@ void nd::detail::validate_kwd_types(const ndt::callable_type *af_tp,
   }
 }
 
-void nd::detail::fill_missing_values(const ndt::type *tp, char *arrmeta,
-                                     const uintptr_t *arrmeta_offsets,
-                                     char *data, const uintptr_t *data_offsets,
-                                     std::vector<nd::array> &kwds_as_vector,
-                                     const std::vector<intptr_t> &missing)
+namespace {
+// The missing values of keywords by type, which are immutable so every call
+// can share them
+struct missing_value_cache {
+  std::mutex mutex;
+  std::unordered_map<ndt::type, nd::array> values;
+};
+} // anonymous namespace
+
+void nd::detail::fill_missing_values(const ndt::type *tp,
+                                     small_vector<nd::array> &kwds_as_vector,
+                                     const small_vector<intptr_t> &missing)
 {
+  if (missing.empty()) {
+    return;
+  }
+
+  static missing_value_cache *cache = new missing_value_cache();
+  std::lock_guard<std::mutex> lock(cache->mutex);
   for (intptr_t j : missing) {
-    tp[j].extended()->arrmeta_default_construct(arrmeta + arrmeta_offsets[j],
-                                                true);
-    assign_na(tp[j], arrmeta + arrmeta_offsets[j], data + data_offsets[j],
-              &eval::default_eval_context);
-    kwds_as_vector[j] = nd::empty(tp[j]);
-    kwds_as_vector[j].assign_na();
+    auto it = cache->values.find(tp[j]);
+    if (it == cache->values.end()) {
+      nd::array value = nd::empty(tp[j]);
+      value.assign_na();
+      value.flag_as_immutable();
+      it = cache->values.insert(std::make_pair(tp[j], value)).first;
+    }
+    kwds_as_vector[j] = it->second;
   }
 }
 
@@ -180,7 +198,7 @@ void nd::detail::check_narg(const ndt::callable_type *af_tp, intptr_t npos)
 void nd::detail::check_arg(const ndt::callable_type *af_tp, intptr_t i,
                            const ndt::type &actual_tp,
                            const char *actual_arrmeta,
-                           std::map<std::string, ndt::type> &tp_vars)
+                           small_map<std::string, ndt::type> &tp_vars)
 {
   if (af_tp->is_pos_variadic()) {
     return;
@@ -197,8 +215,8 @@ void nd::detail::check_arg(const ndt::callable_type *af_tp, intptr_t i,
 }
 
 void nd::detail::check_nkwd(const ndt::callable_type *af_tp,
-                            const std::vector<intptr_t> &available,
-                            const std::vector<intptr_t> &missing)
+                            const small_vector<intptr_t> &available,
+                            const small_vector<intptr_t> &missing)
 {
   if (intptr_t(available.size() + missing.size()) < af_tp->get_nkwd()) {
     std::stringstream ss;
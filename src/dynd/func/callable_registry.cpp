@@ -3,8 +3,12 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
-#include <map>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include <dynd/func/apply.hpp>
 #include <dynd/func/elwise.hpp>
@@ -170,93 +174,329 @@ struct logaddexp2 {
 #endif
 } // anonymous namespace
 
-std::map<std::string, nd::callable> &func::get_regfunctions()
+namespace {
+/**
+ * A named callable. The entry owns its name, so lookups compare against
+ * one interned copy. A lazily registered callable is constructed by the
+ * first lookup of it.
+ */
+struct registry_entry {
+  std::string name;
+  size_t hash;
+  nd::callable (*make)();
+  std::mutex make_mutex;
+  std::atomic<const nd::callable *> value;
+
+  registry_entry(const char *name, size_t size, size_t hash) : name(name, size), hash(hash), make(NULL), value(NULL)
+  {
+  }
+};
+
+/** An open addressing table of entries, with a power of two number of slots */
+struct registry_table {
+  size_t mask;
+  std::unique_ptr<std::atomic<registry_entry *>[]> slots;
+
+  registry_table(size_t nslots) : mask(nslots - 1), slots(new std::atomic<registry_entry *>[nslots])
+  {
+    for (size_t i = 0; i < nslots; ++i) {
+      slots[i].store(NULL, std::memory_order_relaxed);
+    }
+  }
+
+  // The slot holding the entry named ``name``, or the empty slot where it belongs
+  size_t find_slot(const char *name, size_t size, size_t hash) const
+  {
+    size_t slot = hash & mask;
+    for (;;) {
+      registry_entry *entry = slots[slot].load(std::memory_order_acquire);
+      if (entry == NULL ||
+          (entry->hash == hash && entry->name.size() == size && memcmp(entry->name.data(), name, size) == 0)) {
+        return slot;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+};
+
+/**
+ * The registry of callables. Lookups don't lock: entries are never removed,
+ * and a full table is replaced by a larger copy, so a reader only ever sees
+ * complete entries. Registrations are serialized by a mutex. Replaced tables
+ * and callables are retired rather than freed, because a concurrent lookup
+ * may still be reading them.
+ */
+class callable_registry {
+  std::atomic<registry_table *> m_table;
+  std::mutex m_mutex;
+  size_t m_size;
+  std::vector<std::unique_ptr<registry_table>> m_tables;
+  std::vector<std::unique_ptr<registry_entry>> m_entries;
+  std::vector<std::unique_ptr<const nd::callable>> m_values;
+
+  static size_t hash_name(const char *name, size_t size)
+  {
+    // FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+      h = (h ^ static_cast<unsigned char>(name[i])) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  registry_entry *find(const char *name, size_t size) const
+  {
+    const registry_table *table = m_table.load(std::memory_order_acquire);
+    return table->slots[table->find_slot(name, size, hash_name(name, size))].load(std::memory_order_acquire);
+  }
+
+  // Returns the entry named ``name``, or NULL. Requires the mutex.
+  registry_entry *find_locked(const std::string &name) const
+  {
+    const registry_table *table = m_table.load(std::memory_order_relaxed);
+    size_t slot = table->find_slot(name.data(), name.size(), hash_name(name.data(), name.size()));
+    return table->slots[slot].load(std::memory_order_relaxed);
+  }
+
+  // Adds a new entry, whose value or maker must already be set, since
+  // readers may see it as soon as it is in a slot. Requires the mutex.
+  void add(registry_entry *entry)
+  {
+    m_entries.emplace_back(entry);
+    registry_table *table = m_table.load(std::memory_order_relaxed);
+    // Keep the table at most half full
+    if (2 * (m_size + 1) > table->mask + 1) {
+      registry_table *grown = new registry_table(2 * (table->mask + 1));
+      m_tables.emplace_back(grown);
+      for (size_t i = 0; i < m_entries.size(); ++i) {
+        registry_entry *e = m_entries[i].get();
+        grown->slots[grown->find_slot(e->name.data(), e->name.size(), e->hash)].store(e, std::memory_order_relaxed);
+      }
+      m_table.store(grown, std::memory_order_release);
+    } else {
+      table->slots[table->find_slot(entry->name.data(), entry->name.size(), entry->hash)].store(
+          entry, std::memory_order_release);
+    }
+    ++m_size;
+  }
+
+  registry_entry *make_entry(const std::string &name)
+  {
+    return new registry_entry(name.data(), name.size(), hash_name(name.data(), name.size()));
+  }
+
+  // Keeps ``af`` alive for as long as the registry. Requires the mutex.
+  const nd::callable *retain(const nd::callable &af)
+  {
+    m_values.emplace_back(new nd::callable(af));
+    return m_values.back().get();
+  }
+
+public:
+  callable_registry();
+
+  nd::callable get(const char *name, size_t size)
+  {
+    registry_entry *entry = find(name, size);
+    if (entry == NULL) {
+      stringstream ss;
+      ss << "No dynd function ";
+      print_escaped_utf8_string(ss, std::string(name, size));
+      ss << " has been registered";
+      throw invalid_argument(ss.str());
+    }
+
+    const nd::callable *value = entry->value.load(std::memory_order_acquire);
+    if (value != NULL) {
+      return *value;
+    }
+
+    // Construct the callable outside the registry's mutex, since making
+    // it may look up other callables
+    std::lock_guard<std::mutex> make_lock(entry->make_mutex);
+    value = entry->value.load(std::memory_order_acquire);
+    if (value == NULL) {
+      nd::callable (*make)();
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // The value and maker are only changed under the mutex, so check
+        // again for a callable set since the first check
+        value = entry->value.load(std::memory_order_relaxed);
+        if (value != NULL) {
+          return *value;
+        }
+        make = entry->make;
+      }
+      if (make == NULL) {
+        stringstream ss;
+        ss << "The dynd function ";
+        print_escaped_utf8_string(ss, entry->name);
+        ss << " has no callable to construct";
+        throw runtime_error(ss.str());
+      }
+      nd::callable af = make();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      // A callable set while this one was being made takes precedence
+      value = entry->value.load(std::memory_order_relaxed);
+      if (value == NULL) {
+        entry->value.store(retain(af), std::memory_order_release);
+        return af;
+      }
+    }
+    return *value;
+  }
+
+  void set(const std::string &name, const nd::callable &af)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    registry_entry *entry = find_locked(name);
+    if (entry != NULL) {
+      entry->value.store(retain(af), std::memory_order_release);
+    } else {
+      entry = make_entry(name);
+      entry->value.store(retain(af), std::memory_order_relaxed);
+      add(entry);
+    }
+  }
+
+  void set_lazy(const std::string &name, nd::callable (*make)())
+  {
+    if (make == NULL) {
+      throw invalid_argument("a lazily registered dynd function requires a function to make it");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    registry_entry *entry = find_locked(name);
+    if (entry != NULL) {
+      entry->make = make;
+      entry->value.store(NULL, std::memory_order_release);
+    } else {
+      entry = make_entry(name);
+      entry->make = make;
+      add(entry);
+    }
+  }
+
+  std::vector<std::string> names()
+  {
+    std::vector<std::string> result;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (size_t i = 0; i < m_entries.size(); ++i) {
+        result.push_back(m_entries[i]->name);
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+};
+
+callable_registry::callable_registry() : m_table(NULL), m_size(0)
 {
-  // Probably want to use a concurrent_hash_map, like
-  // http://www.threadingbuildingblocks.org/docs/help/reference/containers_overview/concurrent_hash_map_cls.htm
-  static map<std::string, nd::callable> registry;
-  if (registry.empty()) {
-    // Arithmetic
-    /*
-      func::set_regfunction(
-          "add", make_ufunc(add<int32_t>(), add<int64_t>(), add<int128>(),
-                            add<uint32_t>(), add<uint64_t>(),
-      add<dynd_uint128>(),
-                            add<float>(), add<double>(), add<complex<float>>(),
-                            add<complex<double>>()));
-    */
-    registry["add"] = nd::add;
-    registry["subtract"] = make_ufunc(subtract<int32_t>(), subtract<int64_t>(), subtract<int128>(), subtract<float>(),
-                                      subtract<double>(), subtract<complex<float>>(), subtract<complex<double>>());
-    registry["multiply"] =
-        make_ufunc(multiply<int32_t>(), multiply<int64_t>(),
-                   /*multiply<int128>(),*/ multiply<uint32_t>(), multiply<uint64_t>(), /*multiply<dynd_uint128>(),*/
-                   multiply<float>(), multiply<double>(), multiply<complex<float>>(), multiply<complex<double>>());
-    registry["divide"] =
-        make_ufunc(divide<int32_t>(), divide<int64_t>(),   /*divide<int128>(),*/
-                   divide<uint32_t>(), divide<uint64_t>(), /*divide<dynd_uint128>(),*/
-                   divide<float>(), divide<double>(), divide<complex<float>>(), divide<complex<double>>());
-    registry["negative"] = make_ufunc(negative<int32_t>(), negative<int64_t>(), negative<int128>(), negative<float>(),
-                                      negative<double>(), negative<complex<float>>(), negative<complex<double>>());
-    registry["sign"] = make_ufunc(sign<int32_t>(), sign<int64_t>(), sign<int128>(), sign<float>(), sign<double>());
-    registry["conj"] = make_ufunc(conj_fn<std::complex<float>>(), conj_fn<std::complex<double>>());
+  m_tables.emplace_back(new registry_table(64));
+  m_table.store(m_tables.back().get(), std::memory_order_release);
+
+  // Arithmetic
+  set_lazy("add", []() -> nd::callable { return nd::add; });
+  set_lazy("subtract", [] {
+    return make_ufunc(subtract<int32_t>(), subtract<int64_t>(), subtract<int128>(), subtract<float>(),
+                      subtract<double>(), subtract<dynd::complex<float>>(), subtract<dynd::complex<double>>());
+  });
+  set_lazy("multiply", [] {
+    return make_ufunc(multiply<int32_t>(), multiply<int64_t>(),
+                      /*multiply<int128>(),*/ multiply<uint32_t>(), multiply<uint64_t>(), /*multiply<dynd_uint128>(),*/
+                      multiply<float>(), multiply<double>(), multiply<dynd::complex<float>>(),
+                      multiply<dynd::complex<double>>());
+  });
+  set_lazy("divide", [] {
+    return make_ufunc(divide<int32_t>(), divide<int64_t>(),   /*divide<int128>(),*/
+                      divide<uint32_t>(), divide<uint64_t>(), /*divide<dynd_uint128>(),*/
+                      divide<float>(), divide<double>(), divide<dynd::complex<float>>(),
+                      divide<dynd::complex<double>>());
+  });
+  set_lazy("negative", [] {
+    return make_ufunc(negative<int32_t>(), negative<int64_t>(), negative<int128>(), negative<float>(),
+                      negative<double>(), negative<dynd::complex<float>>(), negative<dynd::complex<double>>());
+  });
+  set_lazy("sign",
+           [] { return make_ufunc(sign<int32_t>(), sign<int64_t>(), sign<int128>(), sign<float>(), sign<double>()); });
+  set_lazy("conj", [] { return make_ufunc(conj_fn<std::complex<float>>(), conj_fn<std::complex<double>>()); });
 
 #if !(defined(_MSC_VER) && _MSC_VER < 1700)
-    registry["logaddexp"] = make_ufunc(logaddexp<float>(), logaddexp<double>());
-    registry["logaddexp2"] = make_ufunc(logaddexp2<float>(), logaddexp2<double>());
+  set_lazy("logaddexp", [] { return make_ufunc(logaddexp<float>(), logaddexp<double>()); });
+  set_lazy("logaddexp2", [] { return make_ufunc(logaddexp2<float>(), logaddexp2<double>()); });
 #endif
 
-    // Trig functions
-    registry["sin"] = make_ufunc(&::sinf, static_cast<double (*)(double)>(&::sin));
-    registry["cos"] = make_ufunc(&::cosf, static_cast<double (*)(double)>(&::cos));
-    registry["tan"] = make_ufunc(&::tanf, static_cast<double (*)(double)>(&::tan));
-    registry["exp"] = make_ufunc(&::expf, static_cast<double (*)(double)>(&::exp));
-    registry["arcsin"] = make_ufunc(&::asinf, static_cast<double (*)(double)>(&::asin));
-    registry["arccos"] = make_ufunc(&::acosf, static_cast<double (*)(double)>(&::acos));
-    registry["arctan"] = make_ufunc(&::atanf, static_cast<double (*)(double)>(&::atan));
-    registry["arctan2"] = make_ufunc(&::atan2f, static_cast<double (*)(double, double)>(&::atan2));
-    registry["hypot"] = make_ufunc(&::hypotf, static_cast<double (*)(double, double)>(&::hypot));
-    registry["sinh"] = make_ufunc(&::sinhf, static_cast<double (*)(double)>(&::sinh));
-    registry["cosh"] = make_ufunc(&::coshf, static_cast<double (*)(double)>(&::cosh));
-    registry["tanh"] = make_ufunc(&::tanhf, static_cast<double (*)(double)>(&::tanh));
+  // Trig functions
+  set_lazy("sin", [] { return make_ufunc(&::sinf, static_cast<double (*)(double)>(&::sin)); });
+  set_lazy("cos", [] { return make_ufunc(&::cosf, static_cast<double (*)(double)>(&::cos)); });
+  set_lazy("tan", [] { return make_ufunc(&::tanf, static_cast<double (*)(double)>(&::tan)); });
+  set_lazy("exp", [] { return make_ufunc(&::expf, static_cast<double (*)(double)>(&::exp)); });
+  set_lazy("arcsin", [] { return make_ufunc(&::asinf, static_cast<double (*)(double)>(&::asin)); });
+  set_lazy("arccos", [] { return make_ufunc(&::acosf, static_cast<double (*)(double)>(&::acos)); });
+  set_lazy("arctan", [] { return make_ufunc(&::atanf, static_cast<double (*)(double)>(&::atan)); });
+  set_lazy("arctan2", [] { return make_ufunc(&::atan2f, static_cast<double (*)(double, double)>(&::atan2)); });
+  set_lazy("hypot", [] { return make_ufunc(&::hypotf, static_cast<double (*)(double, double)>(&::hypot)); });
+  set_lazy("sinh", [] { return make_ufunc(&::sinhf, static_cast<double (*)(double)>(&::sinh)); });
+  set_lazy("cosh", [] { return make_ufunc(&::coshf, static_cast<double (*)(double)>(&::cosh)); });
+  set_lazy("tanh", [] { return make_ufunc(&::tanhf, static_cast<double (*)(double)>(&::tanh)); });
 #if !(defined(_MSC_VER) && _MSC_VER < 1700)
-    registry["asinh"] = make_ufunc(&::asinhf, static_cast<double (*)(double)>(&::asinh));
-    registry["acosh"] = make_ufunc(&::acoshf, static_cast<double (*)(double)>(&::acosh));
-    registry["atanh"] = make_ufunc(&::atanhf, static_cast<double (*)(double)>(&::atanh));
+  set_lazy("asinh", [] { return make_ufunc(&::asinhf, static_cast<double (*)(double)>(&::asinh)); });
+  set_lazy("acosh", [] { return make_ufunc(&::acoshf, static_cast<double (*)(double)>(&::acosh)); });
+  set_lazy("atanh", [] { return make_ufunc(&::atanhf, static_cast<double (*)(double)>(&::atanh)); });
 #endif
 
-    registry["power"] = make_ufunc(&powf, static_cast<double (*)(double, double)>(&::pow));
+  set_lazy("power", [] { return make_ufunc(&powf, static_cast<double (*)(double, double)>(&::pow)); });
+
+  set_lazy("uniform", []() -> nd::callable { return nd::random::uniform; });
+  set_lazy("take", []() -> nd::callable { return nd::take; });
+  set_lazy("sum", []() -> nd::callable { return nd::sum; });
+  set_lazy("is_avail", []() -> nd::callable { return nd::is_avail; });
+  set_lazy("min", []() -> nd::callable { return nd::min; });
+  set_lazy("max", []() -> nd::callable { return nd::max; });
+}
+
+// Never destroyed, because callables may be looked up during static destruction
+callable_registry &get_callable_registry()
+{
+  static callable_registry *registry = new callable_registry();
+  return *registry;
+}
+} // anonymous namespace
+
+std::map<std::string, nd::callable> func::get_regfunctions()
+{
+  callable_registry &registry = get_callable_registry();
 
-    registry["uniform"] = nd::random::uniform;
-    registry["take"] = nd::take;
-    registry["sum"] = nd::sum;
-    registry["is_avail"] = nd::is_avail;
-    registry["min"] = nd::min;
-    registry["max"] = nd::max;
+  std::map<std::string, nd::callable> result;
+  std::vector<std::string> names = registry.names();
+  for (size_t i = 0; i < names.size(); ++i) {
+    result[names[i]] = registry.get(names[i].data(), names[i].size());
   }
+  return result;
+}
+
+std::vector<std::string> func::get_regfunction_names()
+{
+  return get_callable_registry().names();
+}
 
-  return registry;
+nd::callable func::get_regfunction(const char *name)
+{
+  return get_callable_registry().get(name, strlen(name));
 }
 
 nd::callable func::get_regfunction(const std::string &name)
 {
-  const std::map<std::string, nd::callable> &registry = get_regfunctions();
-
-  map<std::string, nd::callable>::const_iterator it = registry.find(name);
-  if (it != registry.end()) {
-    return it->second;
-  } else {
-    stringstream ss;
-    ss << "No dynd function ";
-    print_escaped_utf8_string(ss, name);
-    ss << " has been registered";
-    throw invalid_argument(ss.str());
-  }
+  return get_callable_registry().get(name.data(), name.size());
 }
 
 void func::set_regfunction(const std::string &name, const nd::callable &af)
 {
-  std::map<std::string, nd::callable> &registry = get_regfunctions();
+  get_callable_registry().set(name, af);
+}
 
-  registry[name] = af;
+void func::set_lazy_regfunction(const std::string &name, nd::callable (*make)())
+{
+  get_callable_registry().set_lazy(name, make);
 }
@@ -12,17 +12,24 @@ using namespace dynd;
 
 nd::callable nd::functional::left_compound(const callable &child)
 {
-  return callable::make<left_compound_kernel>(
+  callable res = callable::make<left_compound_kernel>(
       ndt::callable_type::make(child.get_type()->get_return_type(),
                                child.get_type()->get_pos_types()(irange() < 1)),
       child, 0);
+  // The child is the only state, so this is as thread safe as it
+  res.set_thread_safe(child.is_thread_safe());
+
+  return res;
 }
 
 nd::callable nd::functional::right_compound(const callable &child)
 {
-  return callable::make<right_compound_kernel>(
+  callable res = callable::make<right_compound_kernel>(
       ndt::callable_type::make(
           child.get_type()->get_return_type(),
           child.get_type()->get_pos_types()(1 >= irange())),
       child, 0);
+  res.set_thread_safe(child.is_thread_safe());
+
+  return res;
 }
@@ -87,8 +87,12 @@ ndt::type nd::functional::elwise_make_type(const ndt::callable_type *child_tp)
 nd::callable nd::functional::elwise(const ndt::type &self_tp,
                                     const callable &child)
 {
-  return callable::make<elwise_virtual_ck>(
+  callable res = callable::make<elwise_virtual_ck>(
       self_tp, child, 0); // child.get()->data_size + sizeof(ndt::type));
+  // Lifting adds no shared state, so it is as thread safe as its child
+  res.set_thread_safe(child.is_thread_safe());
+
+  return res;
 }
 
 nd::callable nd::functional::elwise(const callable &child)
@@ -0,0 +1,17 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/func/groupby.hpp>
+#include <dynd/kernels/groupby_kernel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+DYND_API nd::callable nd::groupby::make()
+{
+  return callable::make<groupby_kernel>(ndt::type("(N * K, N * V, func: ?string) -> var * {key: K, value: V}"), 0);
+}
+
+DYND_API struct nd::groupby nd::groupby;
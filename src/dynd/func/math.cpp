@@ -60,8 +60,11 @@ DYND_API nd::callable nd::cos::make()
   #endif
   */
 
-  return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+  nd::callable child =
+      functional::multidispatch(pattern_tp, children.begin(), children.end());
+  child.set_thread_safe(true);
+
+  return functional::elwise(child);
 }
 
 DYND_API nd::callable nd::sin::make()
@@ -87,8 +90,11 @@ DYND_API nd::callable nd::sin::make()
   #endif
   */
 
-  return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+  nd::callable child =
+      functional::multidispatch(pattern_tp, children.begin(), children.end());
+  child.set_thread_safe(true);
+
+  return functional::elwise(child);
 }
 
 DYND_API nd::callable nd::tan::make()
@@ -114,8 +120,11 @@ DYND_API nd::callable nd::tan::make()
   #endif
   */
 
-  return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+  nd::callable child =
+      functional::multidispatch(pattern_tp, children.begin(), children.end());
+  child.set_thread_safe(true);
+
+  return functional::elwise(child);
 }
 
 DYND_API nd::callable nd::exp::make()
@@ -141,8 +150,11 @@ DYND_API nd::callable nd::exp::make()
   #endif
   */
 
-  return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+  nd::callable child =
+      functional::multidispatch(pattern_tp, children.begin(), children.end());
+  child.set_thread_safe(true);
+
+  return functional::elwise(child);
 }
 
 DYND_API struct nd::cos nd::cos;
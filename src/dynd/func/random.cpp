@@ -8,12 +8,6 @@
 using namespace std;
 using namespace dynd;
 
-template <typename GeneratorType>
-struct uniform_kernel_alias {
-  template <type_id_t DstTypeID>
-  using type = nd::random::uniform_kernel<DstTypeID, GeneratorType>;
-};
-
 DYND_API nd::callable nd::random::uniform::children[DYND_TYPE_ID_MAX + 1];
 
 DYND_API nd::callable nd::random::uniform::make()
@@ -23,17 +17,12 @@ DYND_API nd::callable nd::random::uniform::make()
                            complex_float32_type_id,
                            complex_float64_type_id> numeric_type_ids;
 
-  std::random_device random_device;
-
-  for (
-      const auto &pair :
-      callable::make_all<uniform_kernel_alias<std::default_random_engine>::type,
-                         numeric_type_ids>(0)) {
+  for (const auto &pair : callable::make_all<uniform_virtual_kernel, numeric_type_ids>(0)) {
     children[pair.first] = pair.second;
   }
 
   return functional::elwise(functional::multidispatch(
-      ndt::type("(a: ?R, b: ?R) -> R"),
+      ndt::type("(a: ?R, b: ?R, seed: ?Int, engine: ?string) -> R"),
       [](const ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
          const ndt::type *DYND_UNUSED(src_tp)) -> callable & {
         callable &child = children[dst_tp.get_type_id()];
@@ -20,19 +20,22 @@ DYND_API nd::callable nd::sum::make()
 
   auto children = callable::make_all<sum_kernel, arithmetic_type_ids>();
 
-  return functional::reduction(
-      functional::multidispatch(ndt::callable_type::make(ndt::scalar_kind_type::make(), ndt::scalar_kind_type::make()),
-                                [children](const ndt::type & DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
-                                           const ndt::type * src_tp) mutable->callable &
+  callable reduce_child = functional::multidispatch(
+      ndt::callable_type::make(ndt::scalar_kind_type::make(), ndt::scalar_kind_type::make()),
+      [children](const ndt::type & DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
+                 const ndt::type * src_tp) mutable->callable &
   {
-                                  callable &child = children[src_tp[0].get_dtype().get_type_id()];
-                                  if (child.is_null()) {
-                                    throw runtime_error("no suitable child found for nd::sum");
-                                  }
-
-                                  return child;
-                                },
-                                data_size_max(children)));
+        callable &child = children[src_tp[0].get_dtype().get_type_id()];
+        if (child.is_null()) {
+          throw runtime_error("no suitable child found for nd::sum");
+        }
+
+        return child;
+      },
+      data_size_max(children));
+  reduce_child.set_thread_safe(true);
+
+  return functional::reduction(reduce_child);
 }
 
 DYND_API struct nd::sum nd::sum;
@@ -14,7 +14,18 @@ DYND_API nd::callable nd::take::make()
   // Masked take: (M * T, M * bool) -> var * T
   // Indexed take: (M * T, N * intptr) -> N * T
   // Combined: (M * T, N * Ix) -> R * T
-  return callable::make<take_ck>(ndt::type("(Dims... * T, N * Ix) -> R * T"), 0);
+  return callable::make<take_ck>(
+      ndt::type("(Dims... * T, N * Ix, boundscheck: ?bool) -> R * T"), 0);
 }
 
 DYND_API struct nd::take nd::take;
+
+DYND_API nd::callable nd::put::make()
+{
+  return callable::make<indexed_put_ck>(
+      ndt::type("(N * intptr, N * Dims... * S, boundscheck: ?bool) "
+                "-> M * Dims... * T"),
+      0);
+}
+
+DYND_API struct nd::put nd::put;
@@ -68,7 +68,7 @@ struct take_by_pointer_virtual_ck
               const char *const *src_arrmeta, kernel_request_t kernreq,
               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
               const nd::array *DYND_UNUSED(kwds),
-              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+              const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
   {
     intptr_t ndim = src_tp[0].get_ndim();
 
@@ -119,7 +119,7 @@ struct take_by_pointer_virtual_ck
                    ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
                    const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
                    const nd::array *DYND_UNUSED(kwds),
-                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                   const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
   {
     /*
         if (nsrc != 2) {
@@ -0,0 +1,316 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/jit.hpp>
+
+#ifdef DYND_LLVM
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+struct kernel_ir_registry {
+  std::mutex mutex;
+  std::unordered_map<void *, const char *> ir;
+};
+
+kernel_ir_registry &get_kernel_ir_registry()
+{
+  // Leaked, so registering from static initializers and using it at exit are safe
+  static kernel_ir_registry *registry = new kernel_ir_registry();
+  return *registry;
+}
+
+// The JIT and the cache of compiled chains, created on first use
+struct fused_compiler {
+  std::mutex mutex;
+  std::unique_ptr<llvm::orc::LLJIT> jit;
+  std::unique_ptr<llvm::TargetMachine> target_machine;
+  std::map<std::string, jit::fused_strided_t> cache;
+  intptr_t count;
+
+  fused_compiler() : count(0)
+  {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+
+    auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!jtmb) {
+      llvm::consumeError(jtmb.takeError());
+      return;
+    }
+    jtmb->setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+    auto tm = jtmb->createTargetMachine();
+    if (!tm) {
+      llvm::consumeError(tm.takeError());
+      return;
+    }
+    target_machine = std::move(*tm);
+
+    auto j = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(*jtmb)).create();
+    if (!j) {
+      llvm::consumeError(j.takeError());
+      return;
+    }
+    jit = std::move(*j);
+    // Calls which aren't inlined resolve to the symbols of the process, libdynd included
+    auto generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        jit->getDataLayout().getGlobalPrefix());
+    if (!generator) {
+      llvm::consumeError(generator.takeError());
+      jit.reset();
+      return;
+    }
+    jit->getMainJITDylib().addGenerator(std::move(*generator));
+  }
+};
+
+fused_compiler &get_fused_compiler()
+{
+  static fused_compiler *compiler = new fused_compiler();
+  return *compiler;
+}
+
+std::string fused_signature(intptr_t nsrc, const std::vector<jit::fused_node> &nodes)
+{
+  std::ostringstream ss;
+  ss << nsrc;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const jit::fused_node &node = nodes[i];
+    ss << ";" << reinterpret_cast<void *>(node.func) << "," << node.dst_size << "," << node.dst_alignment;
+    for (size_t j = 0; j < node.src.size(); ++j) {
+      ss << "," << node.src[j];
+    }
+  }
+  return ss.str();
+}
+
+// Gets the function to call for a single function, from its registered IR if
+// that parses and has the single signature, or else by its address
+llvm::FunctionCallee get_single_callee(llvm::Module &module, expr_single_t func)
+{
+  llvm::LLVMContext &context = module.getContext();
+  llvm::Type *i8p = llvm::Type::getInt8PtrTy(context);
+  llvm::FunctionType *single_tp =
+      llvm::FunctionType::get(llvm::Type::getVoidTy(context), {i8p, i8p, i8p->getPointerTo()}, false);
+
+  const char *ir = jit::get_kernel_ir(reinterpret_cast<void *>(func));
+  if (ir != NULL) {
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> ir_module =
+        llvm::parseIR(llvm::MemoryBufferRef(ir, "dynd_kernel_ir"), err, context);
+    llvm::Function *f = NULL;
+    if (ir_module) {
+      for (llvm::Function &candidate : *ir_module) {
+        if (!candidate.isDeclaration()) {
+          f = &candidate;
+          break;
+        }
+      }
+    }
+    if (f != NULL && f->getReturnType()->isVoidTy() && f->arg_size() == 3 &&
+        f->getFunctionType()->getParamType(0)->isPointerTy() && f->getFunctionType()->getParamType(1)->isPointerTy() &&
+        f->getFunctionType()->getParamType(2)->isPointerTy()) {
+      std::string name = f->getName().str();
+      if (module.getFunction(name) == NULL) {
+        if (llvm::Linker::linkModules(module, std::move(ir_module))) {
+          return llvm::FunctionCallee(single_tp, llvm::ConstantExpr::getIntToPtr(
+                                                     llvm::ConstantInt::get(llvm::Type::getInt64Ty(context),
+                                                                            reinterpret_cast<uintptr_t>(func)),
+                                                     single_tp->getPointerTo()));
+        }
+      }
+      llvm::Function *linked = module.getFunction(name);
+      // Only the inlined copy is needed
+      linked->setLinkage(llvm::GlobalValue::InternalLinkage);
+      linked->removeFnAttr(llvm::Attribute::NoInline);
+      linked->removeFnAttr(llvm::Attribute::OptimizeNone);
+      linked->addFnAttr(llvm::Attribute::AlwaysInline);
+      return llvm::FunctionCallee(linked->getFunctionType(), linked);
+    }
+  }
+
+  return llvm::FunctionCallee(single_tp,
+                              llvm::ConstantExpr::getIntToPtr(llvm::ConstantInt::get(llvm::Type::getInt64Ty(context),
+                                                                                      reinterpret_cast<uintptr_t>(func)),
+                                                              single_tp->getPointerTo()));
+}
+
+// Builds the module of a fused chain, whose function is named ``name``
+std::unique_ptr<llvm::Module> build_fused_module(llvm::LLVMContext &context, const std::string &name, intptr_t nsrc,
+                                                 const std::vector<jit::fused_node> &nodes)
+{
+  std::unique_ptr<llvm::Module> module(new llvm::Module(name, context));
+  llvm::Type *i8p = llvm::Type::getInt8PtrTy(context);
+  llvm::Type *i64 = llvm::Type::getInt64Ty(context);
+  llvm::FunctionType *fused_tp = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(context),
+      {i8p->getPointerTo(), i8p, i64, i8p->getPointerTo(), i64->getPointerTo(), i64}, false);
+  llvm::Function *fused = llvm::Function::Create(fused_tp, llvm::Function::ExternalLinkage, name, module.get());
+  llvm::Function::arg_iterator args = fused->arg_begin();
+  llvm::Value *children = &*args++;
+  llvm::Value *dst = &*args++;
+  llvm::Value *dst_stride = &*args++;
+  llvm::Value *src = &*args++;
+  llvm::Value *src_stride = &*args++;
+  llvm::Value *count = &*args++;
+
+  std::vector<llvm::FunctionCallee> callees;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    callees.push_back(get_single_callee(*module, nodes[i].func));
+  }
+
+  llvm::BasicBlock *entry = llvm::BasicBlock::Create(context, "entry", fused);
+  llvm::BasicBlock *loop = llvm::BasicBlock::Create(context, "loop", fused);
+  llvm::BasicBlock *exit = llvm::BasicBlock::Create(context, "exit", fused);
+  llvm::IRBuilder<> builder(entry);
+
+  // Everything which doesn't change from one element to the next
+  std::vector<llvm::Value *> src_begin(nsrc), src_strides(nsrc);
+  for (intptr_t j = 0; j < nsrc; ++j) {
+    src_begin[j] = builder.CreateLoad(i8p, builder.CreateConstGEP1_64(i8p, src, j));
+    src_strides[j] = builder.CreateLoad(i64, builder.CreateConstGEP1_64(i64, src_stride, j));
+  }
+  std::vector<llvm::Value *> child(nodes.size()), temp(nodes.size()), node_src(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    child[i] = builder.CreateLoad(i8p, builder.CreateConstGEP1_64(i8p, children, i));
+    if (i + 1 < nodes.size()) {
+      llvm::AllocaInst *a = builder.CreateAlloca(llvm::Type::getInt8Ty(context),
+                                                 llvm::ConstantInt::get(i64, nodes[i].dst_size));
+      a->setAlignment(llvm::Align(std::max<size_t>(nodes[i].dst_alignment, 1)));
+      temp[i] = a;
+    }
+    node_src[i] = builder.CreateAlloca(i8p, llvm::ConstantInt::get(i64, std::max<size_t>(nodes[i].src.size(), 1)));
+  }
+  builder.CreateCondBr(builder.CreateICmpEQ(count, llvm::ConstantInt::get(i64, 0)), exit, loop);
+
+  // One element of the chain per iteration
+  builder.SetInsertPoint(loop);
+  llvm::PHINode *index = builder.CreatePHI(i64, 2);
+  index->addIncoming(llvm::ConstantInt::get(i64, 0), entry);
+  std::vector<llvm::Value *> src_ptr(nsrc);
+  for (intptr_t j = 0; j < nsrc; ++j) {
+    src_ptr[j] = builder.CreateGEP(builder.getInt8Ty(), src_begin[j], builder.CreateMul(index, src_strides[j]));
+  }
+  llvm::Value *dst_ptr = builder.CreateGEP(builder.getInt8Ty(), dst, builder.CreateMul(index, dst_stride));
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const jit::fused_node &node = nodes[i];
+    for (size_t j = 0; j < node.src.size(); ++j) {
+      intptr_t s = node.src[j];
+      llvm::Value *ptr = s < nsrc ? src_ptr[s] : temp[s - nsrc];
+      builder.CreateStore(ptr, builder.CreateConstGEP1_64(i8p, node_src[i], j));
+    }
+    llvm::Value *node_dst = i + 1 < nodes.size() ? temp[i] : dst_ptr;
+    llvm::FunctionType *callee_tp = callees[i].getFunctionType();
+    builder.CreateCall(callees[i], {builder.CreatePointerCast(child[i], callee_tp->getParamType(0)),
+                                    builder.CreatePointerCast(node_dst, callee_tp->getParamType(1)),
+                                    builder.CreatePointerCast(node_src[i], callee_tp->getParamType(2))});
+  }
+  llvm::Value *next = builder.CreateAdd(index, llvm::ConstantInt::get(i64, 1));
+  index->addIncoming(next, loop);
+  builder.CreateCondBr(builder.CreateICmpEQ(next, count), exit, loop);
+
+  builder.SetInsertPoint(exit);
+  builder.CreateRetVoid();
+
+  return module;
+}
+} // anonymous namespace
+
+bool jit::register_kernel_ir(void *single_func, const char *ir)
+{
+  if (ir != NULL) {
+    kernel_ir_registry &registry = get_kernel_ir_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.ir[single_func] = ir;
+  }
+  return true;
+}
+
+const char *jit::get_kernel_ir(void *single_func)
+{
+  kernel_ir_registry &registry = get_kernel_ir_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::unordered_map<void *, const char *>::const_iterator it = registry.ir.find(single_func);
+  return it != registry.ir.end() ? it->second : NULL;
+}
+
+jit::fused_strided_t jit::compile_fused(intptr_t nsrc, const std::vector<fused_node> &nodes)
+{
+  fused_compiler &compiler = get_fused_compiler();
+  std::string signature = fused_signature(nsrc, nodes);
+  std::lock_guard<std::mutex> lock(compiler.mutex);
+  if (!compiler.jit || nodes.empty()) {
+    return NULL;
+  }
+  std::map<std::string, fused_strided_t>::const_iterator it = compiler.cache.find(signature);
+  if (it != compiler.cache.end()) {
+    return it->second;
+  }
+
+  std::ostringstream name;
+  name << "dynd_fused_" << compiler.count++;
+  std::unique_ptr<llvm::LLVMContext> context(new llvm::LLVMContext());
+  std::unique_ptr<llvm::Module> module = build_fused_module(*context, name.str(), nsrc, nodes);
+  module->setDataLayout(compiler.target_machine->createDataLayout());
+  module->setTargetTriple(compiler.target_machine->getTargetTriple().str());
+
+  fused_strided_t result = NULL;
+  if (!llvm::verifyModule(*module)) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pb(compiler.target_machine.get());
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+    pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2).run(*module, mam);
+
+    llvm::Error err =
+        compiler.jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)));
+    if (err) {
+      llvm::consumeError(std::move(err));
+    } else {
+      auto sym = compiler.jit->lookup(name.str());
+      if (sym) {
+        result = reinterpret_cast<fused_strided_t>(static_cast<uintptr_t>(sym->getAddress()));
+      } else {
+        llvm::consumeError(sym.takeError());
+      }
+    }
+  }
+
+  // Failures are cached too, so they aren't retried every instantiation
+  compiler.cache[signature] = result;
+  return result;
+}
+
+#endif // DYND_LLVM
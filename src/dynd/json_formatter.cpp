@@ -5,6 +5,7 @@
 
 #include <dynd/json_formatter.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/number_formatter.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/date_type.hpp>
 #include <dynd/types/datetime_type.hpp>
@@ -89,6 +90,15 @@ static void format_json_bool(output_data &out, const ndt::type &dt, const char *
 
 static void format_json_number(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data)
 {
+  if (dt.is_builtin()) {
+    out.ensure_capacity(max_number_format_size);
+    char *end = format_builtin_number(dt.get_type_id(), data, out.out_end);
+    if (end != NULL) {
+      out.out_end = end;
+      return;
+    }
+  }
+
   stringstream ss;
   dt.print_data(ss, arrmeta, data);
   out.write(ss.str());
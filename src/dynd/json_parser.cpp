@@ -4,6 +4,7 @@
 //
 
 #include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/types/base_bytes_type.hpp>
 #include <dynd/types/string_type.hpp>
@@ -15,6 +16,7 @@
 #include <dynd/types/option_type.hpp>
 #include <dynd/kernels/string_numeric_assignment_kernels.hpp>
 #include <dynd/parser_util.hpp>
+#include <dynd/thread_pool.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -36,6 +38,69 @@ public:
     return m_type;
   }
 };
+
+/**
+ * The parser's position in a ``json_structural_index`` of its input. The
+ * parser moves forward through the text, so the entry for a position is
+ * found by stepping forward from the previous one.
+ */
+class json_index_cursor {
+  const json_structural_index *m_index;
+  const char *m_begin;
+  size_t m_entry;
+
+public:
+  json_index_cursor(const json_structural_index *index, const char *begin)
+      : m_index(index != NULL && index->is_valid() ? index : NULL), m_begin(begin), m_entry(0)
+  {
+  }
+
+  const char *get_begin() const
+  {
+    return m_begin;
+  }
+
+  const json_structural_index *get_index() const
+  {
+    return m_index;
+  }
+
+  /** Returns the number of the entry at ``pos``, or -1 if there is none */
+  intptr_t find(const char *pos)
+  {
+    if (m_index == NULL) {
+      return -1;
+    }
+    uint32 offset = static_cast<uint32>(pos - m_begin);
+    size_t size = m_index->size();
+    if (m_entry > 0 && m_index->position(m_entry - 1) >= offset) {
+      // The parser only goes back on errors, so this needn't be fast
+      size_t lo = 0, hi = m_entry - 1;
+      while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (m_index->position(mid) < offset) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      m_entry = lo;
+    }
+    while (m_entry < size && m_index->position(m_entry) < offset) {
+      ++m_entry;
+    }
+    if (m_entry < size && m_index->position(m_entry) == offset) {
+      return m_entry;
+    }
+    return -1;
+  }
+
+  /** Moves past entry ``i``, after the parser has jumped over it */
+  void seek_past(size_t i)
+  {
+    m_entry = i + 1;
+  }
+};
 } // anonymous namespace
 
 nd::array nd::json::parse(const ndt::type &tp, const std::string &str)
@@ -102,11 +167,12 @@ nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json, const eva
 }
 
 static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&json_begin,
-                       const char *json_end, const eval::eval_context *ectx);
+                       const char *json_end, json_index_cursor &idx, const eval::eval_context *ectx);
 
 static const char *skip_whitespace(const char *begin, const char *end)
 {
-  while (begin < end && isspace(*begin)) {
+  // The characters of isspace in the C locale, without its function call
+  while (begin < end && (*begin == ' ' || ('\t' <= *begin && *begin <= '\r'))) {
     ++begin;
   }
 
@@ -207,8 +273,86 @@ static void skip_json_value(const char *&begin, const char *end)
   }
 }
 
+/**
+ * Skips a JSON value like the version above, but with the structural index,
+ * when there is one, to step over objects, arrays and strings without
+ * reading their contents. Only numbers and the literals are checked.
+ */
+static void skip_json_value(const char *&begin, const char *end, json_index_cursor &idx)
+{
+  begin = skip_whitespace(begin, end);
+  if (begin != end && (*begin == '{' || *begin == '[' || *begin == '"')) {
+    intptr_t i = idx.find(begin);
+    if (i >= 0) {
+      uint32 match = idx.get_index()->match(i);
+      if (*begin == '"') {
+        begin = idx.get_begin() + match + 1;
+      } else {
+        begin = idx.get_begin() + idx.get_index()->position(match) + 1;
+        idx.seek_past(match);
+      }
+      return;
+    }
+  }
+  skip_json_value(begin, end);
+}
+
+/**
+ * Parses a JSON string like ``parse::parse_doublequote_string_no_ws``, but
+ * with the closing quote from the structural index when there is one.
+ */
+static bool parse_json_string_no_ws(const char *&begin, const char *end, const char *&out_strbegin,
+                                    const char *&out_strend, bool &out_escaped, json_index_cursor &idx)
+{
+  if (begin != end && *begin == '"') {
+    intptr_t i = idx.find(begin);
+    if (i >= 0) {
+      const char *strend = idx.get_begin() + idx.get_index()->match(i);
+      // Strings with escapes go through the full parser, which checks them
+      if (memchr(begin + 1, '\\', strend - begin - 1) == NULL) {
+        out_strbegin = begin + 1;
+        out_strend = strend;
+        out_escaped = false;
+        begin = strend + 1;
+        return true;
+      }
+    }
+  }
+  return parse::parse_doublequote_string_no_ws(begin, end, out_strbegin, out_strend, out_escaped);
+}
+
+/**
+ * Returns the number of elements of the JSON array at ``begin``, counted
+ * from the structural index, or -1 if there is no index.
+ */
+static intptr_t count_json_array_elements(const char *begin, const char *end, json_index_cursor &idx)
+{
+  intptr_t i = idx.find(begin);
+  if (i < 0 || *begin != '[') {
+    return -1;
+  }
+  if (*skip_whitespace(begin + 1, end) == ']') {
+    return 0;
+  }
+
+  const json_structural_index *index = idx.get_index();
+  intptr_t count = 1;
+  for (size_t j = i + 1, close = index->match(i); j < close;) {
+    char c = idx.get_begin()[index->position(j)];
+    if (c == '{' || c == '[') {
+      j = index->match(j) + 1;
+    } else {
+      if (c == ',') {
+        ++count;
+      }
+      ++j;
+    }
+  }
+  return count;
+}
+
 static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                   const char *end, const eval::eval_context *ectx)
+                                   const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   intptr_t dim_size, stride;
   ndt::type el_tp;
@@ -221,7 +365,7 @@ static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, cha
     throw json_parse_error(begin, "expected list starting with '['", tp);
   }
   for (intptr_t i = 0; i < dim_size; ++i) {
-    parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, ectx);
+    parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, idx, ectx);
     if (i < dim_size - 1 && !parse_token(begin, end, ",")) {
       throw json_parse_error(begin, "array is too short, expected ',' list item separator", tp);
     }
@@ -232,7 +376,7 @@ static void parse_strided_dim_json(const ndt::type &tp, const char *arrmeta, cha
 }
 
 static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                               const char *end, const eval::eval_context *ectx)
+                               const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   const ndt::var_dim_type *vad = tp.extended<ndt::var_dim_type>();
   const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
@@ -241,8 +385,11 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
 
   var_dim_type_data *out = reinterpret_cast<var_dim_type_data *>(out_data);
 
+  // With the structural index, the elements are counted first so the array
+  // is allocated at its final size
+  intptr_t count = count_json_array_elements(begin, end, idx);
   memory_block_data::api *allocator = md->blockref->get_api();
-  intptr_t size = 0, allocated_size = 8;
+  intptr_t size = 0, allocated_size = count > 0 ? count : 8;
   out->begin = allocator->allocate(md->blockref.get(), allocated_size);
 
   if (!parse_token(begin, end, "[")) {
@@ -259,7 +406,7 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
       ++size;
       out->size = size;
       parse_json(element_tp, arrmeta + sizeof(var_dim_type_arrmeta), out->begin + (size - 1) * stride, begin, end,
-                 ectx);
+                 idx, ectx);
       if (!parse_token(begin, end, ",")) {
         break;
       }
@@ -275,7 +422,7 @@ static void parse_var_dim_json(const ndt::type &tp, const char *arrmeta, char *o
 }
 
 static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                          const char *end, const eval::eval_context *ectx)
+                                          const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   const char *saved_begin = begin;
   if (!parse_token(begin, end, "{")) {
@@ -290,6 +437,8 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
   // Keep track of which fields we've seen
   shortvector<bool> populated_fields(field_count);
   memset(populated_fields.get(), 0, sizeof(bool) * field_count);
+  // The keys usually arrive in field order, so predict the field after the last one
+  intptr_t predicted_i = 0;
 
   // If it's not an empty object, start the loop parsing the elements
   if (!parse_token(begin, end, "}")) {
@@ -297,7 +446,7 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
       const char *strbegin, *strend;
       bool escaped;
       begin = skip_whitespace(begin, end);
-      if (!parse::parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+      if (!parse_json_string_no_ws(begin, end, strbegin, strend, escaped, idx)) {
         throw json_parse_error(begin, "expected string for name in object dict", tp);
       }
       if (!parse_token(begin, end, ":")) {
@@ -307,17 +456,19 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
       if (escaped) {
         std::string name;
         parse::unescape_string(strbegin, strend, name);
-        i = fsd->get_field_index(name);
+        i = fsd->get_field_index(name.data(), name.data() + name.size(), predicted_i);
       } else {
-        i = fsd->get_field_index(strbegin, strend);
+        i = fsd->get_field_index(strbegin, strend, predicted_i);
       }
       if (i == -1) {
         // TODO: Add an error policy to this parser of whether to throw an error
         //       or not. For now, just throw away fields not in the destination.
-        skip_json_value(begin, end);
+        skip_json_value(begin, end, idx);
       } else {
-        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
+        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, idx,
+                   ectx);
         populated_fields[i] = true;
+        predicted_i = i + 1;
       }
       if (!parse_token(begin, end, ",")) {
         break;
@@ -348,7 +499,7 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
 }
 
 static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                                       const char *end, const eval::eval_context *ectx)
+                                       const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   if (!parse_token(begin, end, "[")) {
     return false;
@@ -362,7 +513,8 @@ static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta,
   // Loop through all the fields
   for (intptr_t i = 0; i != field_count; ++i) {
     begin = skip_whitespace(begin, end);
-    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
+    parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, idx,
+               ectx);
     if (i != field_count - 1 && !parse_token(begin, end, ",")) {
       throw json_parse_error(begin, "expected list item separator ','", tp);
     }
@@ -376,19 +528,19 @@ static bool parse_tuple_json_from_list(const ndt::type &tp, const char *arrmeta,
 }
 
 static void parse_struct_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                              const char *end, const eval::eval_context *ectx)
+                              const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
-  if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, ectx)) {
-  } else if (parse_tuple_json_from_list(tp, arrmeta, out_data, begin, end, ectx)) {
+  if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, idx, ectx)) {
+  } else if (parse_tuple_json_from_list(tp, arrmeta, out_data, begin, end, idx, ectx)) {
   } else {
     throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
   }
 }
 
 static void parse_tuple_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                             const char *end, const eval::eval_context *ectx)
+                             const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
-  if (parse_tuple_json_from_list(tp, arrmeta, out_data, begin, end, ectx)) {
+  if (parse_tuple_json_from_list(tp, arrmeta, out_data, begin, end, idx, ectx)) {
   } else {
     throw json_parse_error(begin, "expected object dict starting with '{' or list with '['", tp);
   }
@@ -485,13 +637,13 @@ static void parse_number_json(const ndt::type &tp, const char *arrmeta, char *ou
 }
 
 static void parse_string_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&rbegin,
-                              const char *end, const eval::eval_context *ectx)
+                              const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   const char *begin = rbegin;
   begin = skip_whitespace(begin, end);
   const char *strbegin, *strend;
   bool escaped;
-  if (parse::parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
+  if (parse_json_string_no_ws(begin, end, strbegin, strend, escaped, idx)) {
     const ndt::base_string_type *bsd = tp.extended<ndt::base_string_type>();
     try
     {
@@ -610,14 +762,14 @@ static void parse_type(const ndt::type &tp, const char *DYND_UNUSED(arrmeta), ch
 }
 
 static void parse_dim_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin,
-                           const char *end, const eval::eval_context *ectx)
+                           const char *end, json_index_cursor &idx, const eval::eval_context *ectx)
 {
   switch (tp.get_type_id()) {
   case fixed_dim_type_id:
-    parse_strided_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_strided_dim_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     break;
   case var_dim_type_id:
-    parse_var_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_var_dim_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     break;
   default: {
     stringstream ss;
@@ -697,18 +849,18 @@ static void parse_option_json(const ndt::type &tp, const char *arrmeta, char *ou
 }
 
 static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&begin, const char *end,
-                       const eval::eval_context *ectx)
+                       json_index_cursor &idx, const eval::eval_context *ectx)
 {
   begin = skip_whitespace(begin, end);
   switch (tp.get_kind()) {
   case dim_kind:
-    parse_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_dim_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     return;
   case struct_kind:
-    parse_struct_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_struct_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     return;
   case tuple_kind:
-    parse_tuple_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_tuple_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     return;
   case bool_kind:
     parse_bool_json(tp, arrmeta, out_data, begin, end, false, ectx);
@@ -720,7 +872,7 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
     parse_number_json(tp, arrmeta, out_data, begin, end, false, ectx);
     return;
   case string_kind:
-    parse_string_json(tp, arrmeta, out_data, begin, end, ectx);
+    parse_string_json(tp, arrmeta, out_data, begin, end, idx, ectx);
     return;
   case datetime_kind:
     parse_datetime_json(tp, arrmeta, out_data, begin, end, false, ectx);
@@ -830,13 +982,19 @@ void dynd::validate_json(const char *json_begin, const char *json_end)
   }
 }
 
-void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx)
+void dynd::parse_json(const ndt::type &tp, const char *arrmeta, char *data, const char *json_begin,
+                      const char *json_end, json_structural_index *index, const eval::eval_context *ectx)
 {
   try
   {
     const char *begin = json_begin, *end = json_end;
-    ndt::type tp = out.get_type();
-    ::parse_json(tp, out.get()->metadata(), out.data(), begin, end, ectx);
+    // Builtin types are single numbers or bools, with no structure to index
+    json_index_cursor idx(NULL, json_begin);
+    if (index != NULL && !tp.is_builtin()) {
+      index->build(json_begin, json_end);
+      idx = json_index_cursor(index, json_begin);
+    }
+    ::parse_json(tp, arrmeta, data, begin, end, idx, ectx);
     begin = skip_whitespace(begin, end);
     if (begin != end) {
       throw json_parse_error(begin, "unexpected trailing JSON text", tp);
@@ -867,6 +1025,12 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
   }
 }
 
+void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx)
+{
+  json_structural_index index;
+  parse_json(out.get_type(), out.get()->metadata(), out.data(), json_begin, json_end, &index, ectx);
+}
+
 nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const char *json_end,
                            const eval::eval_context *ectx)
 {
@@ -1016,3 +1180,182 @@ void ndt::json::discover(ndt::type &res, const char *json_begin, const char *jso
     throw invalid_argument(ss.str());
   }
 }
+
+/**
+ * Discovers the common type of the elements of a JSON array, starting at
+ * the beginning of an element, until ``limit`` elements have been seen or
+ * the end of the array is reached. Leaves ``begin`` after the last element,
+ * and returns a null type if the elements have no common type.
+ */
+static ndt::type discover_element_type(const char *&begin, const char *end, intptr_t limit, intptr_t &out_count)
+{
+  ndt::type common_tp = discover_type(begin, end);
+  out_count = 1;
+  while (out_count < limit && !common_tp.is_null()) {
+    const char *saved_begin = begin;
+    if (!parse_token(begin, end, ",")) {
+      begin = saved_begin;
+      break;
+    }
+    common_tp = ndt::common_type(common_tp, discover_type(begin, end));
+    ++out_count;
+  }
+  return common_tp;
+}
+
+/**
+ * Splits the elements of the JSON array whose '[' is at ``begin`` into
+ * chunks of about ``chunk_size`` bytes, using the structural index of the
+ * array to step over the elements. The separators between the chunks, the
+ * '[', the ',' ending each chunk and the ']', are appended to ``out_seps``.
+ */
+static void split_json_array(const json_structural_index &index, const char *begin, size_t chunk_size,
+                             std::vector<const char *> &out_seps)
+{
+  size_t close = index.match(0);
+  size_t next_split = chunk_size;
+  out_seps.push_back(begin);
+  for (size_t i = 1; i < close;) {
+    char c = begin[index.position(i)];
+    if (c == '{' || c == '[') {
+      i = index.match(i) + 1;
+    } else {
+      if (c == ',' && index.position(i) >= next_split) {
+        out_seps.push_back(begin + index.position(i));
+        next_split = index.position(i) + chunk_size;
+      }
+      ++i;
+    }
+  }
+  out_seps.push_back(begin + index.position(close));
+}
+
+/**
+ * Splits the first ``limit`` elements of the JSON array whose '[' is at
+ * ``begin`` into chunks of ``chunk_count`` elements, like
+ * ``split_json_array``, skipping over the elements one character at a time.
+ * The last separator is the ',' or ']' after the last element.
+ */
+static void split_json_array_sample(const char *begin, const char *end, intptr_t limit, intptr_t chunk_count,
+                                    std::vector<const char *> &out_seps)
+{
+  out_seps.push_back(begin);
+  ++begin;
+  for (intptr_t i = 1;; ++i) {
+    skip_json_value(begin, end);
+    begin = skip_whitespace(begin, end);
+    if (begin == end || (*begin != ',' && *begin != ']')) {
+      throw parse::parse_error(begin, "expected array separator ',' or terminator ']'");
+    }
+    if (i == limit || *begin == ']') {
+      out_seps.push_back(begin);
+      return;
+    } else if (i % chunk_count == 0) {
+      out_seps.push_back(begin);
+    }
+    ++begin;
+  }
+}
+
+void ndt::json::discover(ndt::type &res, const char *json_begin, const char *json_end, intptr_t sample_limit,
+                         const eval::eval_context *ectx)
+{
+  if (sample_limit == 0) {
+    throw invalid_argument("the sample limit of JSON type discovery must be positive, or negative for no limit");
+  }
+
+  const char *begin = skip_whitespace(json_begin, json_end), *end = json_end;
+  const char *elements_begin = begin + 1;
+  bool is_array = begin != end && *begin == '[' && !parse_token(elements_begin, end, "]");
+  intptr_t nchunks = ectx->nthreads > 1 ? 4 * ectx->nthreads : 1;
+  // Values other than non-empty arrays, and whole arrays on one thread, are discovered as before
+  if (!is_array || (sample_limit < 0 && nchunks == 1)) {
+    discover(res, json_begin, json_end);
+    return;
+  }
+
+  try
+  {
+    // Split the elements into chunks, with the separators between them
+    std::vector<const char *> seps;
+    if (sample_limit < 0) {
+      json_structural_index index(begin, end);
+      if (!index.is_valid()) {
+        // Discover serially, so errors are reported as usual
+        discover(res, json_begin, json_end);
+        return;
+      }
+      split_json_array(index, begin, (end - begin) / nchunks + 1, seps);
+    } else if (nchunks > 1) {
+      split_json_array_sample(begin, end, sample_limit, (sample_limit + nchunks - 1) / nchunks, seps);
+    } else {
+      seps.push_back(begin);
+      seps.push_back(NULL);
+    }
+
+    // Discover the chunks in parallel
+    nchunks = seps.size() - 1;
+    std::vector<ndt::type> chunk_types(nchunks);
+    std::vector<intptr_t> chunk_counts(nchunks);
+    const char *last_sep = seps.back();
+    auto discover_chunk = [&](intptr_t i) {
+      const char *chunk_begin = seps[i] + 1, *chunk_end = seps[i + 1] != NULL ? seps[i + 1] : end;
+      chunk_types[i] = discover_element_type(chunk_begin, chunk_end, sample_limit < 0 ? INTPTR_MAX : sample_limit,
+                                             chunk_counts[i]);
+      chunk_begin = skip_whitespace(chunk_begin, chunk_end);
+      if (seps[i + 1] == NULL) {
+        last_sep = chunk_begin;
+      } else if (chunk_begin != chunk_end && !chunk_types[i].is_null()) {
+        throw parse::parse_error(chunk_begin, "expected array separator ',' or terminator ']'");
+      }
+    };
+    if (nchunks > 1) {
+      thread_pool::get().run(nchunks, discover_chunk);
+    } else {
+      discover_chunk(0);
+    }
+
+    // Combine the chunks in order, as the serial discovery combines the elements
+    ndt::type common_tp = chunk_types[0];
+    intptr_t count = chunk_counts[0];
+    for (intptr_t i = 1; i < nchunks && !common_tp.is_null(); ++i) {
+      if (!chunk_types[i].is_null()) {
+        common_tp = ndt::common_type(common_tp, chunk_types[i]);
+      } else {
+        common_tp = chunk_types[i];
+      }
+      count += chunk_counts[i];
+    }
+    if (common_tp.is_null()) {
+      // Without a common type, the result is a tuple of all the element types
+      discover(res, json_begin, json_end);
+      return;
+    }
+
+    if (last_sep != end && *last_sep == ',' && sample_limit >= 0) {
+      // The sample doesn't have all the elements, so the size isn't known
+      res = ndt::var_dim_type::make(common_tp);
+      return;
+    }
+    begin = last_sep;
+    if (!parse_token(begin, end, "]")) {
+      throw parse::parse_error(begin, "expected array separator ',' or terminator ']'");
+    }
+    begin = skip_whitespace(begin, end);
+    if (begin != end) {
+      throw parse::parse_error(begin, "unexpected trailing JSON text");
+    }
+    res = ndt::make_fixed_dim(count, common_tp);
+  }
+  catch (const parse::parse_error &e)
+  {
+    stringstream ss;
+    std::string line_prev, line_cur;
+    int line, column;
+    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
+    ss << "Error validating JSON at line " << line << ", column " << column << "\n";
+    ss << "Message: " << e.what() << "\n";
+    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
+    throw invalid_argument(ss.str());
+  }
+}
@@ -0,0 +1,337 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <dynd/json_structural_index.hpp>
+#include <dynd/kernels/simd.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_JSON_INDEX_SSE2
+#endif
+#ifdef DYND_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/** Bitmasks of the characters of a 64 byte block, bit i for byte i */
+struct block_masks {
+  uint64 quote;
+  uint64 backslash;
+  // '{', '}', '[' and ']'
+  uint64 bracket;
+  // The brackets, ':' and ','
+  uint64 op;
+};
+
+inline int trailing_zeros(uint64 x)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+struct generic_scanner {
+  static DYND_SIMD_INLINE void scan(const char *block, block_masks &m)
+  {
+    m.quote = m.backslash = m.bracket = m.op = 0;
+    for (int i = 0; i < 64; ++i) {
+      uint64 bit = uint64(1) << i;
+      switch (block[i]) {
+      case '"':
+        m.quote |= bit;
+        break;
+      case '\\':
+        m.backslash |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+        m.bracket |= bit;
+        m.op |= bit;
+        break;
+      case ':':
+      case ',':
+        m.op |= bit;
+        break;
+      default:
+        break;
+      }
+    }
+  }
+};
+
+#ifdef DYND_JSON_INDEX_SSE2
+struct sse2_scanner {
+  static DYND_SIMD_INLINE void scan(const char *block, block_masks &m)
+  {
+    const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\');
+    // Setting bit 0x20 maps '[' to '{' and ']' to '}', and keeps ':' and ','
+    const __m128i lower = _mm_set1_epi8(0x20), open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}'),
+                  colon = _mm_set1_epi8(':'), comma = _mm_set1_epi8(',');
+    m.quote = m.backslash = m.bracket = m.op = 0;
+    for (int i = 0; i < 4; ++i) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+      __m128i vl = _mm_or_si128(v, lower);
+      __m128i bracket = _mm_or_si128(_mm_cmpeq_epi8(vl, open), _mm_cmpeq_epi8(vl, close));
+      __m128i op = _mm_or_si128(bracket, _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+      m.quote |= uint64(uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << (16 * i);
+      m.backslash |= uint64(uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << (16 * i);
+      m.bracket |= uint64(uint32(_mm_movemask_epi8(bracket))) << (16 * i);
+      m.op |= uint64(uint32(_mm_movemask_epi8(op))) << (16 * i);
+    }
+  }
+};
+typedef sse2_scanner default_scanner;
+#else
+typedef generic_scanner default_scanner;
+#endif
+
+#ifdef DYND_SIMD_DISPATCH
+struct avx2_scanner {
+  // Not inlined, since it can only be inlined into functions built for AVX2
+  static DYND_TARGET_AVX2 void scan(const char *block, block_masks &m)
+  {
+    const __m256i quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\');
+    const __m256i lower = _mm256_set1_epi8(0x20), open = _mm256_set1_epi8('{'), close = _mm256_set1_epi8('}'),
+                  colon = _mm256_set1_epi8(':'), comma = _mm256_set1_epi8(',');
+    m.quote = m.backslash = m.bracket = m.op = 0;
+    for (int i = 0; i < 2; ++i) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+      __m256i vl = _mm256_or_si256(v, lower);
+      __m256i bracket = _mm256_or_si256(_mm256_cmpeq_epi8(vl, open), _mm256_cmpeq_epi8(vl, close));
+      __m256i op =
+          _mm256_or_si256(bracket, _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+      m.quote |= uint64(uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)))) << (32 * i);
+      m.backslash |= uint64(uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)))) << (32 * i);
+      m.bracket |= uint64(uint32(_mm256_movemask_epi8(bracket))) << (32 * i);
+      m.op |= uint64(uint32(_mm256_movemask_epi8(op))) << (32 * i);
+    }
+  }
+};
+#endif
+
+/**
+ * Returns the mask of the characters escaped by a backslash, given the mask
+ * of backslashes. A backslash escapes the next character unless it is itself
+ * escaped, so the characters after odd length runs of backslashes are the
+ * escaped ones. ``prev_escaped`` carries whether the first character of the
+ * next block is escaped.
+ */
+inline uint64 find_escaped(uint64 backslash, uint64 &prev_escaped)
+{
+  const uint64 even_bits = 0x5555555555555555ULL;
+  backslash &= ~prev_escaped;
+  uint64 follows_escape = (backslash << 1) | prev_escaped;
+  // Adding the starts of the runs which begin on odd bits to the runs carries
+  // past their ends, flipping the parity of the character after each
+  uint64 odd_starts = backslash & ~even_bits & ~follows_escape;
+  uint64 sequences_on_even = odd_starts + backslash;
+  prev_escaped = sequences_on_even < odd_starts ? 1 : 0;
+  uint64 invert_mask = sequences_on_even << 1;
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+/** Bit i of the result is the xor of bits 0 to i of x */
+inline uint64 prefix_xor(uint64 x)
+{
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+inline int count_ones(uint64 x)
+{
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+}
+
+/**
+ * Builds an index into arrays grown with realloc, so the new elements
+ * aren't initialized before they are written.
+ */
+struct index_builder {
+  const char *begin;
+  uint32 *&positions;
+  uint32 *&matches;
+  size_t &capacity;
+  // The number of entries
+  size_t count;
+  vector<uint64> open_stack;
+  size_t depth;
+  uint64 prev_escaped;
+  uint64 prev_in_string;
+  size_t open_quote;
+  bool balanced;
+
+  index_builder(const char *begin, uint32 *&positions, uint32 *&matches, size_t &capacity)
+      : begin(begin), positions(positions), matches(matches), capacity(capacity), count(0), depth(0),
+        prev_escaped(0), prev_in_string(0), open_quote(0), balanced(true)
+  {
+  }
+
+  void grow()
+  {
+    size_t new_capacity = 2 * capacity + 1024;
+    uint32 *new_positions = reinterpret_cast<uint32 *>(realloc(positions, new_capacity * sizeof(uint32)));
+    if (new_positions == NULL) {
+      throw bad_alloc();
+    }
+    positions = new_positions;
+    uint32 *new_matches = reinterpret_cast<uint32 *>(realloc(matches, new_capacity * sizeof(uint32)));
+    if (new_matches == NULL) {
+      throw bad_alloc();
+    }
+    matches = new_matches;
+    capacity = new_capacity;
+  }
+
+  DYND_SIMD_INLINE void add_block(const char *block, uint32 offset, const block_masks &m)
+  {
+    uint64 quote = m.quote & ~find_escaped(m.backslash, prev_escaped);
+    // Set from each opening quote up to, but not including, its closing quote
+    uint64 in_string = prefix_xor(quote) ^ prev_in_string;
+    prev_in_string = uint64(int64(in_string) >> 63);
+
+    // Write all the entries without looking at which character each is
+    uint64 entries = (m.op & ~in_string) | (quote & in_string);
+    if (capacity < count + 64) {
+      grow();
+    }
+    uint32 *pos = positions + count, *match = matches + count;
+    for (uint64 bits = entries; bits != 0; bits &= bits - 1) {
+      *pos++ = offset + trailing_zeros(bits);
+      *match++ = json_structural_index::no_match;
+    }
+
+    // Then match the quotes, which alternate between opening and closing
+    for (uint64 bits = quote; bits != 0; bits &= bits - 1) {
+      int i = trailing_zeros(bits);
+      if ((in_string >> i) & 1) {
+        open_quote = count + count_ones(entries & ((uint64(1) << i) - 1));
+      } else {
+        matches[open_quote] = offset + i;
+      }
+    }
+
+    // And the brackets
+    for (uint64 bits = m.bracket & ~in_string; bits != 0; bits &= bits - 1) {
+      int i = trailing_zeros(bits);
+      uint32 entry = static_cast<uint32>(count + count_ones(entries & ((uint64(1) << i) - 1)));
+      // '{' and '[' have bit 0x02 set, and '}' and ']' don't. Each stack
+      // item has the entry of an open bracket, and the character which
+      // closes it, two past it in ASCII, in the high bits
+      if (block[i] & 0x02) {
+        if (depth == open_stack.size()) {
+          open_stack.resize(2 * depth + 64);
+        }
+        open_stack[depth++] = entry | (uint64(block[i] + 2) << 32);
+      } else if (depth == 0 || (open_stack[depth - 1] >> 32) != uint64(block[i])) {
+        balanced = false;
+      } else {
+        matches[static_cast<uint32>(open_stack[--depth])] = entry;
+      }
+    }
+    count += count_ones(entries);
+  }
+
+  bool valid() const
+  {
+    return balanced && depth == 0 && prev_in_string == 0;
+  }
+};
+
+template <typename Scanner>
+DYND_SIMD_INLINE bool build_index(const char *begin, const char *end, uint32 *&positions, uint32 *&matches,
+                                  size_t &capacity, size_t &size)
+{
+  index_builder builder(begin, positions, matches, capacity);
+  block_masks m;
+  const char *block = begin;
+  for (; end - block >= 64 && builder.balanced; block += 64) {
+    Scanner::scan(block, m);
+    builder.add_block(block, static_cast<uint32>(block - begin), m);
+  }
+  if (block < end && builder.balanced) {
+    // Pad the last partial block with spaces, which are not structural
+    char padded[64];
+    memset(padded, ' ', sizeof(padded));
+    memcpy(padded, block, end - block);
+    Scanner::scan(padded, m);
+    builder.add_block(padded, static_cast<uint32>(block - begin), m);
+  }
+  size = builder.count;
+
+  return builder.valid();
+}
+
+bool build_index_default(const char *begin, const char *end, uint32 *&positions, uint32 *&matches, size_t &capacity,
+                         size_t &size)
+{
+  return build_index<default_scanner>(begin, end, positions, matches, capacity, size);
+}
+
+#ifdef DYND_SIMD_DISPATCH
+DYND_TARGET_AVX2 bool build_index_avx2(const char *begin, const char *end, uint32 *&positions, uint32 *&matches,
+                                       size_t &capacity, size_t &size)
+{
+  return build_index<avx2_scanner>(begin, end, positions, matches, capacity, size);
+}
+#endif
+
+} // anonymous namespace
+
+const uint32 json_structural_index::no_match;
+
+json_structural_index::~json_structural_index()
+{
+  free(m_positions);
+  free(m_matches);
+}
+
+void json_structural_index::build(const char *begin, const char *end)
+{
+  m_size = 0;
+  m_valid = false;
+  if (static_cast<uint64>(end - begin) >= no_match) {
+    return;
+  }
+
+#ifdef DYND_SIMD_DISPATCH
+  if (get_simd_isa() == simd_isa_avx2) {
+    m_valid = build_index_avx2(begin, end, m_positions, m_matches, m_capacity, m_size);
+  } else {
+    m_valid = build_index_default(begin, end, m_positions, m_matches, m_capacity, m_size);
+  }
+#else
+  m_valid = build_index_default(begin, end, m_positions, m_matches, m_capacity, m_size);
+#endif
+
+  if (!m_valid) {
+    m_size = 0;
+  }
+}
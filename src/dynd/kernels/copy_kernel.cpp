@@ -14,7 +14,7 @@ void nd::copy_ck::resolve_dst_type(
     char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t nsrc,
     const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
     const array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   if (nsrc != 1) {
     std::stringstream ss;
@@ -33,7 +33,7 @@ intptr_t nd::copy_ck::instantiate(
     const char *const *src_arrmeta, kernel_request_t kernreq,
     const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
     const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   if (dst_tp.is_builtin()) {
     if (src_tp[0].is_builtin()) {
@@ -49,7 +49,7 @@ intptr_t nd::copy_ck::instantiate(
         return child.get()->instantiate(NULL, 0, NULL, ckb, ckb_offset, dst_tp,
                                         dst_arrmeta, 1, src_tp, src_arrmeta,
                                         kernreq, ectx, 0, NULL,
-                                        std::map<std::string, ndt::type>());
+                                        small_map<std::string, ndt::type>());
       }
     } else {
       return src_tp[0].extended()->make_assignment_kernel(
@@ -101,7 +101,7 @@ static intptr_t instantiate_int_multiply_and_offset_callable(
     const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
     const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
     const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   typedef int_multiply_and_offset_ck<Tsrc, Tdst> self_type;
   self_type *self = self_type::make(ckb, kernreq, ckb_offset);
@@ -138,7 +138,7 @@ static intptr_t instantiate_int_offset_and_divide_callable(
     const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
     const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
     const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   typedef int_offset_and_divide_ck<Tsrc, Tdst> self_type;
   self_type *self = self_type::make(ckb, kernreq, ckb_offset);
@@ -0,0 +1,381 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <memory>
+
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/func/max.hpp>
+#include <dynd/func/min.hpp>
+#include <dynd/func/sum.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/groupby_kernel.hpp>
+#include <dynd/kernels/reduction_kernel.hpp>
+#include <dynd/thread_pool.hpp>
+#include <dynd/types/category_hash_table.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * The groups of a chunk of the rows, or of all of them once merged. The
+ * keys point at the key of the first row of each group.
+ */
+struct group_partials {
+  std::vector<const char *> keys;
+  std::vector<int64> counts;
+  // For each column, the reduced value of each group
+  std::vector<std::vector<char>> values;
+};
+
+// Copies the values of a column into ``dst`` in the order of ``rows``
+template <int Size>
+void gather_column(char *dst, const char *src, intptr_t src_stride, const intptr_t *rows, intptr_t count,
+                   size_t size)
+{
+  for (intptr_t i = 0; i < count; ++i) {
+    memcpy(dst + i * size, src + rows[i] * src_stride, Size != 0 ? Size : size);
+  }
+}
+
+void gather_column(char *dst, const char *src, intptr_t src_stride, const intptr_t *rows, intptr_t count,
+                   size_t size)
+{
+  switch (size) {
+  case 1:
+    gather_column<1>(dst, src, src_stride, rows, count, size);
+    break;
+  case 2:
+    gather_column<2>(dst, src, src_stride, rows, count, size);
+    break;
+  case 4:
+    gather_column<4>(dst, src, src_stride, rows, count, size);
+    break;
+  case 8:
+    gather_column<8>(dst, src, src_stride, rows, count, size);
+    break;
+  case 16:
+    gather_column<16>(dst, src, src_stride, rows, count, size);
+    break;
+  default:
+    gather_column<0>(dst, src, src_stride, rows, count, size);
+    break;
+  }
+}
+
+nd::groupby_kernel::reduction_t get_reduction(intptr_t nkwd, const nd::array *kwds)
+{
+  if (nkwd == 0 || kwds[0].is_missing()) {
+    return nd::groupby_kernel::sum_reduction;
+  }
+
+  std::string func = kwds[0].as<std::string>();
+  if (func == "sum") {
+    return nd::groupby_kernel::sum_reduction;
+  } else if (func == "min") {
+    return nd::groupby_kernel::min_reduction;
+  } else if (func == "max") {
+    return nd::groupby_kernel::max_reduction;
+  } else if (func == "mean") {
+    return nd::groupby_kernel::mean_reduction;
+  }
+
+  stringstream ss;
+  ss << "groupby: unknown reduction \"" << func << "\", expected \"sum\", \"min\", \"max\" or \"mean\"";
+  throw invalid_argument(ss.str());
+}
+
+// The element ckernel a reduction callable accumulates with, which adds one
+// value into an accumulator in place
+const nd::callable &get_reduce_child(nd::groupby_kernel::reduction_t reduction)
+{
+  const nd::callable *reduction_func;
+  switch (reduction) {
+  case nd::groupby_kernel::min_reduction:
+    reduction_func = &nd::min::get();
+    break;
+  case nd::groupby_kernel::max_reduction:
+    reduction_func = &nd::max::get();
+    break;
+  default:
+    reduction_func = &nd::sum::get();
+    break;
+  }
+
+  return reinterpret_cast<nd::functional::reduction_virtual_kernel::static_data_type *>(
+             reduction_func->get()->static_data)->child;
+}
+} // anonymous namespace
+
+nd::groupby_kernel::~groupby_kernel()
+{
+  if (m_key_child != 0) {
+    get_child(m_key_child)->destroy();
+  }
+  for (size_t i = 0; i < m_reduce_children.size(); ++i) {
+    get_child(m_reduce_children[i])->destroy();
+  }
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    if (m_columns[i].div_child != 0) {
+      get_child(m_columns[i].div_child)->destroy();
+    }
+  }
+}
+
+void nd::groupby_kernel::single(char *dst, char *const *src)
+{
+  const char *keys = src[0];
+  const char *values = src[1];
+  intptr_t ncolumns = m_columns.size();
+
+  // Group and reduce each chunk of the rows
+  std::vector<group_partials> partials(m_nchunks);
+  thread_pool::get().run(m_nchunks, [&](intptr_t chunk) {
+    intptr_t begin = chunk * m_size / m_nchunks;
+    intptr_t count = (chunk + 1) * m_size / m_nchunks - begin;
+    group_partials &p = partials[chunk];
+
+    ndt::detail::category_hash_table table(m_key_tp, m_key_arrmeta, 0);
+    std::vector<uint32> group(count);
+    for (intptr_t i = 0; i < count; ++i) {
+      group[i] = static_cast<uint32>(table.insert(keys + (begin + i) * m_key_stride));
+    }
+    p.keys = table.keys();
+    intptr_t ngroups = p.keys.size();
+
+    // Sort the rows by group, so the values of each group are together
+    std::vector<intptr_t> start(ngroups + 1, 0);
+    for (intptr_t i = 0; i < count; ++i) {
+      ++start[group[i] + 1];
+    }
+    for (intptr_t g = 0; g < ngroups; ++g) {
+      start[g + 1] += start[g];
+    }
+    std::vector<intptr_t> rows(count);
+    std::vector<intptr_t> next(start.begin(), start.end() - 1);
+    for (intptr_t i = 0; i < count; ++i) {
+      rows[next[group[i]]++] = i;
+    }
+    p.counts.resize(ngroups);
+    for (intptr_t g = 0; g < ngroups; ++g) {
+      p.counts[g] = start[g + 1] - start[g];
+    }
+
+    // Each group's value starts as its first value, and the others are
+    // accumulated into it
+    p.values.resize(ncolumns);
+    std::vector<char> buffer;
+    for (intptr_t j = 0; j < ncolumns; ++j) {
+      const column &col = m_columns[j];
+      intptr_t size = col.tp.get_data_size();
+      buffer.resize(count * size);
+      gather_column(buffer.data(), values + begin * m_value_stride + col.src_offset, m_value_stride, rows.data(),
+                    count, size);
+
+      std::vector<char> &acc = p.values[j];
+      acc.resize(ngroups * size);
+      ckernel_prefix *reduce = get_child(m_reduce_children[chunk * ncolumns + j]);
+      for (intptr_t g = 0; g < ngroups; ++g) {
+        char *group_values = buffer.data() + start[g] * size;
+        memcpy(acc.data() + g * size, group_values, size);
+        if (p.counts[g] > 1) {
+          group_values += size;
+          reduce->strided(acc.data() + g * size, 0, &group_values, &size, p.counts[g] - 1);
+        }
+      }
+    }
+  });
+
+  // Merge the partial tables in chunk order, so the groups stay in the
+  // order their keys first appear
+  group_partials merged;
+  if (m_nchunks == 1) {
+    merged.keys.swap(partials[0].keys);
+    merged.counts.swap(partials[0].counts);
+    merged.values.swap(partials[0].values);
+  } else {
+    ndt::detail::category_hash_table table(m_key_tp, m_key_arrmeta, partials[0].keys.size());
+    merged.values.resize(ncolumns);
+    for (intptr_t chunk = 0; chunk < m_nchunks; ++chunk) {
+      const group_partials &p = partials[chunk];
+      for (size_t i = 0; i < p.keys.size(); ++i) {
+        size_t g = table.insert(p.keys[i]);
+        bool inserted = g == merged.counts.size();
+        if (inserted) {
+          merged.counts.push_back(p.counts[i]);
+        } else {
+          merged.counts[g] += p.counts[i];
+        }
+        for (intptr_t j = 0; j < ncolumns; ++j) {
+          intptr_t size = m_columns[j].tp.get_data_size();
+          char *partial = const_cast<char *>(p.values[j].data()) + i * size;
+          std::vector<char> &acc = merged.values[j];
+          if (inserted) {
+            acc.insert(acc.end(), partial, partial + size);
+          } else {
+            get_child(m_reduce_children[j])->strided(acc.data() + g * size, 0, &partial, &size, 1);
+          }
+        }
+      }
+    }
+    merged.keys = table.keys();
+  }
+
+  // Write out a key and value per group
+  intptr_t ngroups = merged.keys.size();
+  ndt::var_dim_element_initialize(m_dst_tp, m_dst_arrmeta, dst, ngroups);
+  char *dst_ptr = reinterpret_cast<var_dim_type_data *>(dst)->begin;
+  intptr_t dst_stride = reinterpret_cast<const var_dim_type_arrmeta *>(m_dst_arrmeta)->stride;
+  ckernel_prefix *key_child = get_child(m_key_child);
+  for (intptr_t g = 0; g < ngroups; ++g, dst_ptr += dst_stride) {
+    char *key = const_cast<char *>(merged.keys[g]);
+    key_child->single(dst_ptr + m_dst_key_offset, &key);
+    for (intptr_t j = 0; j < ncolumns; ++j) {
+      const column &col = m_columns[j];
+      intptr_t size = col.tp.get_data_size();
+      char *value = dst_ptr + m_dst_value_offset + col.dst_offset;
+      memcpy(value, merged.values[j].data() + g * size, size);
+      if (col.div_child != 0) {
+        char *count = reinterpret_cast<char *>(&merged.counts[g]);
+        get_child(col.div_child)->single(value, &count);
+      }
+    }
+  }
+}
+
+void nd::groupby_kernel::resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+                                          char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
+                                          const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
+                                          const nd::array *DYND_UNUSED(kwds),
+                                          const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+{
+  dst_tp = ndt::var_dim_type::make(ndt::struct_type::make(
+      {"key", "value"}, {src_tp[0].get_type_at_dimension(NULL, 1), src_tp[1].get_type_at_dimension(NULL, 1)}));
+}
+
+intptr_t nd::groupby_kernel::instantiate(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+                                         char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+                                         const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
+                                         const ndt::type *src_tp, const char *const *src_arrmeta,
+                                         kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+                                         const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
+{
+  typedef nd::groupby_kernel self_type;
+
+  reduction_t reduction = get_reduction(nkwd, kwds);
+  intptr_t root_ckb_offset = ckb_offset;
+  self_type *self = self_type::make(ckb, kernreq, ckb_offset, reduction);
+  self->m_dst_tp = dst_tp;
+  self->m_dst_arrmeta = dst_arrmeta;
+
+  intptr_t value_size;
+  ndt::type value_tp;
+  const char *value_arrmeta;
+  if (!src_tp[0].get_as_strided(src_arrmeta[0], &self->m_size, &self->m_key_stride, &self->m_key_tp,
+                                &self->m_key_arrmeta)) {
+    stringstream ss;
+    ss << "groupby: could not process type " << src_tp[0] << " as a strided dimension";
+    throw type_error(ss.str());
+  }
+  if (!src_tp[1].get_as_strided(src_arrmeta[1], &value_size, &self->m_value_stride, &value_tp, &value_arrmeta)) {
+    stringstream ss;
+    ss << "groupby: could not process type " << src_tp[1] << " as a strided dimension";
+    throw type_error(ss.str());
+  }
+  if (self->m_size != value_size) {
+    stringstream ss;
+    ss << "groupby: keys and values have different sizes, " << self->m_size << " and " << value_size;
+    throw invalid_argument(ss.str());
+  }
+  if (!ndt::detail::category_hash_table::is_hashable_key(self->m_key_tp)) {
+    stringstream ss;
+    ss << "groupby: cannot group by keys of type " << self->m_key_tp;
+    throw type_error(ss.str());
+  }
+
+  // The destination elements are {key: K, value: V}
+  const ndt::type &dst_el_tp = dst_tp.extended<ndt::var_dim_type>()->get_element_type();
+  const char *dst_el_arrmeta = dst_arrmeta + sizeof(var_dim_type_arrmeta);
+  const ndt::base_tuple_type *dst_el_bt = dst_el_tp.extended<ndt::base_tuple_type>();
+  const uintptr_t *dst_data_offsets = dst_el_bt->get_data_offsets(dst_el_arrmeta);
+  const uintptr_t *dst_arrmeta_offsets = dst_el_bt->get_arrmeta_offsets_raw();
+  self->m_dst_key_offset = dst_data_offsets[0];
+  self->m_dst_value_offset = dst_data_offsets[1];
+
+  // The values are reduced column by column, either each field of a struct
+  // or the whole value
+  if (value_tp.get_type_id() == struct_type_id || value_tp.get_type_id() == tuple_type_id) {
+    const ndt::base_tuple_type *bt = value_tp.extended<ndt::base_tuple_type>();
+    const uintptr_t *src_offsets = bt->get_data_offsets(value_arrmeta);
+    const uintptr_t *dst_offsets = dst_el_bt->get_field_type(1).extended<ndt::base_tuple_type>()->get_data_offsets(
+        dst_el_arrmeta + dst_arrmeta_offsets[1]);
+    for (intptr_t i = 0; i < bt->get_field_count(); ++i) {
+      column col = {bt->get_field_type(i), static_cast<intptr_t>(src_offsets[i]),
+                    static_cast<intptr_t>(dst_offsets[i]), 0};
+      self->m_columns.push_back(col);
+    }
+  } else {
+    column col = {value_tp, 0, 0, 0};
+    self->m_columns.push_back(col);
+  }
+  for (size_t i = 0; i < self->m_columns.size(); ++i) {
+    if (!self->m_columns[i].tp.is_builtin()) {
+      stringstream ss;
+      ss << "groupby: can only reduce values of builtin types, not " << value_tp;
+      throw type_error(ss.str());
+    }
+  }
+
+  // Each chunk gets its own reduction children, like a parallel reduction
+  const callable &reduce_child = get_reduce_child(reduction);
+  if (ectx->nthreads > 1 && ectx->parallel_chunk_size > 0 && reduce_child.is_thread_safe()) {
+    self->m_nchunks = std::max<intptr_t>(
+        1, std::min<intptr_t>(ectx->nthreads, self->m_size / ectx->parallel_chunk_size));
+  }
+  intptr_t nchunks = self->m_nchunks, ncolumns = self->m_columns.size();
+  std::vector<ndt::type> column_tp(ncolumns);
+  for (intptr_t j = 0; j < ncolumns; ++j) {
+    column_tp[j] = self->m_columns[j].tp;
+  }
+
+  ckernel_builder<kernel_request_host> *host_ckb = reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb);
+  eval::eval_context chunk_ectx(*ectx);
+  chunk_ectx.nthreads = 1;
+  const char *src_el_arrmeta = NULL;
+  for (intptr_t chunk = 0; chunk < nchunks; ++chunk) {
+    for (intptr_t j = 0; j < ncolumns; ++j) {
+      intptr_t child_offset = ckb_offset - root_ckb_offset;
+      ckb_offset = reduce_child.get()->instantiate(reduce_child.get()->static_data, 0, NULL, ckb, ckb_offset,
+                                                   column_tp[j], NULL, 1, &column_tp[j], &src_el_arrmeta,
+                                                   kernel_request_strided, &chunk_ectx, 0, NULL, tp_vars);
+      get_self(host_ckb, root_ckb_offset)->m_reduce_children.push_back(child_offset);
+    }
+  }
+
+  // A mean divides each sum by its count
+  if (reduction == mean_reduction) {
+    const callable &div = nd::compound_div::get();
+    ndt::type count_tp = ndt::type::make<int64>();
+    for (intptr_t j = 0; j < ncolumns; ++j) {
+      intptr_t child_offset = ckb_offset - root_ckb_offset;
+      ckb_offset = div.get()->instantiate(div.get()->static_data, 0, NULL, ckb, ckb_offset, column_tp[j], NULL, 1,
+                                          &count_tp, &src_el_arrmeta, kernel_request_single, ectx, 0, NULL, tp_vars);
+      get_self(host_ckb, root_ckb_offset)->m_columns[j].div_child = child_offset;
+    }
+  }
+
+  // Copies each group's key into the destination
+  self = get_self(host_ckb, root_ckb_offset);
+  intptr_t key_child = ckb_offset - root_ckb_offset;
+  ckb_offset = make_assignment_kernel(ckb, ckb_offset, self->m_key_tp, dst_el_arrmeta + dst_arrmeta_offsets[0],
+                                      self->m_key_tp, self->m_key_arrmeta, kernel_request_single, ectx);
+  get_self(host_ckb, root_ckb_offset)->m_key_child = key_child;
+
+  return ckb_offset;
+}
@@ -12,7 +12,7 @@ using namespace dynd;
 void nd::functional::old_multidispatch_ck::resolve_dst_type(
     char *static_data, size_t data_size, char *data, ndt::type &dst_tp,
     intptr_t nsrc, const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-    const std::map<std::string, ndt::type> &tp_vars)
+    const small_map<std::string, ndt::type> &tp_vars)
 {
   const vector<nd::callable> *icd =
       reinterpret_cast<const vector<nd::callable> *>(static_data);
@@ -20,7 +20,7 @@ void nd::functional::old_multidispatch_ck::resolve_dst_type(
     const nd::callable &child = (*icd)[i];
     if (nsrc == child.get_type()->get_npos()) {
       intptr_t isrc;
-      std::map<std::string, ndt::type> typevars;
+      small_map<std::string, ndt::type> typevars;
       for (isrc = 0; isrc < nsrc; ++isrc) {
         if (!can_implicitly_convert(src_tp[isrc],
                                     child.get_type()->get_pos_type(isrc),
@@ -60,14 +60,14 @@ intptr_t nd::functional::old_multidispatch_ck::instantiate(
     const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
     const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-    const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+    const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
 {
   const vector<nd::callable> *icd =
       reinterpret_cast<vector<nd::callable> *>(static_data);
   for (intptr_t i = 0; i < (intptr_t)icd->size(); ++i) {
     const nd::callable &af = (*icd)[i];
     intptr_t isrc, nsrc = af.get_type()->get_npos();
-    std::map<std::string, ndt::type> typevars;
+    small_map<std::string, ndt::type> typevars;
     for (isrc = 0; isrc < nsrc; ++isrc) {
       if (!can_implicitly_convert(
                src_tp[isrc], af.get_type()->get_pos_type(isrc), typevars)) {
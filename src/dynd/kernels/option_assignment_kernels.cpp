@@ -23,7 +23,7 @@ static intptr_t instantiate_option_as_value_assignment_kernel(
     const char *const *src_arrmeta, kernel_request_t kernreq,
     const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
     const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   // In all cases not handled, we use the
   // regular S to T assignment kernel.
@@ -108,14 +108,14 @@ size_t kernels::make_option_assignment_kernel(
   const callable_type_data *af = afl.get();
   const ndt::callable_type *const *af_tp =
       reinterpret_cast<const ndt::callable_type *const *>(afl.get_type());
-  map<std::string, ndt::type> typevars;
+  small_map<std::string, ndt::type> typevars;
   for (intptr_t i = 0; i < size; ++i, ++af_tp, ++af) {
     typevars.clear();
     if ((*af_tp)->get_pos_type(0).match(src_tp, typevars) &&
         (*af_tp)->get_return_type().match(dst_tp, typevars)) {
       return af->instantiate(NULL, 0, NULL, ckb, ckb_offset, dst_tp,
                              dst_arrmeta, size, &src_tp, &src_arrmeta, kernreq,
-                             ectx, 0, NULL, std::map<std::string, ndt::type>());
+                             ectx, 0, NULL, small_map<std::string, ndt::type>());
     }
   }
 
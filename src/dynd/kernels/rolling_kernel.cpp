@@ -66,7 +66,7 @@ intptr_t nd::functional::rolling_ck::instantiate(
     intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
     intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-    const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+    const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
 {
   typedef dynd::nd::functional::strided_rolling_ck self_type;
   rolling_callable_data *static_data =
@@ -138,7 +138,7 @@ intptr_t nd::functional::rolling_ck::instantiate(
 void nd::functional::rolling_ck::resolve_dst_type(
     char *_static_data, size_t data_size, char *data, ndt::type &dst_tp,
     intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t nkwd,
-    const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+    const array *kwds, const small_map<std::string, ndt::type> &tp_vars)
 
 {
   /*
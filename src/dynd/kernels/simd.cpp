@@ -0,0 +1,27 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/kernels/simd.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static simd_isa_t detect_simd_isa()
+{
+#ifdef DYND_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_isa_avx2;
+  }
+#endif
+
+  return simd_isa_generic;
+}
+
+simd_isa_t dynd::get_simd_isa()
+{
+  static const simd_isa_t isa = detect_simd_isa();
+  return isa;
+}
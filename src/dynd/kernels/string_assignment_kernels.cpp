@@ -20,6 +20,7 @@ using namespace dynd;
 
 namespace {
 struct fixed_string_assign_ck : nd::base_kernel<fixed_string_assign_ck, 1> {
+  transcode_block_t m_block_fn;
   next_unicode_codepoint_t m_next_fn;
   append_unicode_codepoint_t m_append_fn;
   intptr_t m_dst_data_size, m_src_data_size;
@@ -33,9 +34,14 @@ struct fixed_string_assign_ck : nd::base_kernel<fixed_string_assign_ck, 1> {
     append_unicode_codepoint_t append_fn = m_append_fn;
     uint32_t cp = 0;
 
-    char *src_copy = src[0];
+    const char *src_copy = src[0];
     while (src_copy < src_end && dst < dst_end) {
-      cp = next_fn(const_cast<const char *&>(src_copy), src_end);
+      m_block_fn(src_copy, src_end, dst, dst_end);
+      if (src_copy == src_end || dst == dst_end) {
+        break;
+      }
+      // The code point the block conversion stopped at
+      cp = next_fn(src_copy, src_end);
       // The fixed_string type uses null-terminated strings
       if (cp == 0) {
         // Null-terminate the destination string, and we're done
@@ -65,6 +71,7 @@ size_t dynd::make_fixed_string_assignment_kernel(void *ckb, intptr_t ckb_offset,
   typedef fixed_string_assign_ck self_type;
   assign_error_mode errmode = ectx->errmode;
   self_type *self = self_type::make(ckb, kernreq, ckb_offset);
+  self->m_block_fn = get_transcode_block_function(dst_encoding, src_encoding);
   self->m_next_fn = get_next_unicode_codepoint_function(src_encoding, errmode);
   self->m_append_fn = get_append_unicode_codepoint_function(dst_encoding, errmode);
   self->m_dst_data_size = dst_data_size;
@@ -111,6 +118,7 @@ namespace {
 struct fixed_string_to_blockref_string_assign_ck : nd::base_kernel<fixed_string_to_blockref_string_assign_ck, 1> {
   string_encoding_t m_dst_encoding, m_src_encoding;
   intptr_t m_src_element_size;
+  transcode_block_t m_block_fn;
   next_unicode_codepoint_t m_next_fn;
   append_unicode_codepoint_t m_append_fn;
 
@@ -141,20 +149,23 @@ struct fixed_string_to_blockref_string_assign_ck : nd::base_kernel<fixed_string_
 
     dst_current = dst_begin;
     while (src_begin < src_end) {
+      m_block_fn(src_begin, src_end, dst_current, dst_end);
+      if (src_begin == src_end) {
+        break;
+      }
+      // Increase the allocated memory as necessary
+      if (dst_end - dst_current < 8) {
+        char *dst_begin_saved = dst_begin;
+        tmp.resize(2 * (dst_end - dst_begin));
+        dst_begin = tmp.begin();
+        dst_end = tmp.end();
+        dst_current = dst_begin + (dst_current - dst_begin_saved);
+        continue;
+      }
+      // Append the code point the block conversion stopped at
       cp = next_fn(src_begin, src_end);
-      // Append the codepoint, or increase the allocated memory as necessary
       if (cp != 0) {
-        if (dst_end - dst_current >= 8) {
-          append_fn(cp, dst_current, dst_end);
-        } else {
-          char *dst_begin_saved = dst_begin;
-          tmp.resize(2 * (dst_end - dst_begin));
-          dst_begin = tmp.begin();
-          dst_end = tmp.end();
-          dst_current = dst_begin + (dst_current - dst_begin_saved);
-
-          append_fn(cp, dst_current, dst_end);
-        }
+        append_fn(cp, dst_current, dst_end);
       } else {
         break;
       }
@@ -176,6 +187,7 @@ size_t dynd::make_fixed_string_to_blockref_string_assignment_kernel(
   self->m_dst_encoding = dst_encoding;
   self->m_src_encoding = src_encoding;
   self->m_src_element_size = src_element_size;
+  self->m_block_fn = get_transcode_block_function(dst_encoding, src_encoding);
   self->m_next_fn = get_next_unicode_codepoint_function(src_encoding, errmode);
   self->m_append_fn = get_append_unicode_codepoint_function(dst_encoding, errmode);
   return ckb_offset;
@@ -186,6 +198,7 @@ size_t dynd::make_fixed_string_to_blockref_string_assignment_kernel(
 
 namespace {
 struct blockref_string_to_fixed_string_assign_ck : nd::base_kernel<blockref_string_to_fixed_string_assign_ck, 1> {
+  transcode_block_t m_block_fn;
   next_unicode_codepoint_t m_next_fn;
   append_unicode_codepoint_t m_append_fn;
   intptr_t m_dst_data_size, m_src_element_size;
@@ -202,6 +215,11 @@ struct blockref_string_to_fixed_string_assign_ck : nd::base_kernel<blockref_stri
     uint32_t cp;
 
     while (src_begin < src_end && dst < dst_end) {
+      m_block_fn(src_begin, src_end, dst, dst_end);
+      if (src_begin == src_end || dst == dst_end) {
+        break;
+      }
+      // The code point the block conversion stopped at
       cp = next_fn(src_begin, src_end);
       append_fn(cp, dst, dst_end);
     }
@@ -225,6 +243,7 @@ size_t dynd::make_blockref_string_to_fixed_string_assignment_kernel(
   typedef blockref_string_to_fixed_string_assign_ck self_type;
   assign_error_mode errmode = ectx->errmode;
   self_type *self = self_type::make(ckb, kernreq, ckb_offset);
+  self->m_block_fn = get_transcode_block_function(dst_encoding, src_encoding);
   self->m_next_fn = get_next_unicode_codepoint_function(src_encoding, errmode);
   self->m_append_fn = get_append_unicode_codepoint_function(dst_encoding, errmode);
   self->m_dst_data_size = dst_data_size;
@@ -12,6 +12,7 @@
 #include <dynd/diagnostics.hpp>
 #include <dynd/kernels/string_numeric_assignment_kernels.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/number_formatter.hpp>
 #include <dynd/parser_util.hpp>
 
 using namespace std;
@@ -24,7 +25,7 @@ inline ForwardIteratorT trim_begin(ForwardIteratorT InBegin, ForwardIteratorT In
 {
   ForwardIteratorT It = InBegin;
   for (; It != InEnd; ++It) {
-    if (!isspace(*It))
+    if (!isspace(static_cast<unsigned char>(*It)))
       return It;
   }
 
@@ -34,35 +35,13 @@ template <typename ForwardIteratorT>
 inline ForwardIteratorT trim_end(ForwardIteratorT InBegin, ForwardIteratorT InEnd)
 {
   for (ForwardIteratorT It = InEnd; It != InBegin;) {
-    if (!isspace(*(--It)))
+    if (!isspace(static_cast<unsigned char>(*(--It))))
       return ++It;
   }
 
   return InBegin;
 }
-template <typename SequenceT>
-inline void trim_left_if(SequenceT &Input)
-{
-  Input.erase(Input.begin(), trim_begin(Input.begin(), Input.end()));
-}
-template <typename SequenceT>
-inline void trim_right_if(SequenceT &Input)
-{
-  Input.erase(trim_end(Input.begin(), Input.end()), Input.end());
-}
-template <typename SequenceT>
-inline void trim(SequenceT &Input)
-{
-  trim_right_if(Input);
-  trim_left_if(Input);
-}
 // End trim taken from boost string algorithms
-void to_lower(std::string &s)
-{
-  for (size_t i = 0, i_end = s.size(); i != i_end; ++i) {
-    s[i] = tolower(s[i]);
-  }
-}
 
 namespace {
 struct string_to_builtin_auxdata {
@@ -77,6 +56,30 @@ struct string_to_builtin_kernel {
   const ndt::base_string_type *src_string_tp;
   assign_error_mode errmode;
   const char *src_arrmeta;
+  // Whether the source is a dynd::string, and whether its encoding is ASCII
+  // or UTF-8, in either of which cases it is parsed in place
+  bool src_is_string, src_is_utf8;
+
+  /**
+   * Gets the UTF-8 source string with the surrounding whitespace trimmed,
+   * pointing into the source data when its encoding allows it, and otherwise
+   * converting it into ``buffer``.
+   */
+  void get_trimmed_utf8(const char *src, std::string &buffer, const char *&out_begin, const char *&out_end) const
+  {
+    if (src_is_string) {
+      out_begin = reinterpret_cast<const dynd::string *>(src)->begin();
+      out_end = reinterpret_cast<const dynd::string *>(src)->end();
+    } else if (src_is_utf8) {
+      src_string_tp->get_string_range(&out_begin, &out_end, src_arrmeta, src);
+    } else {
+      buffer = src_string_tp->get_utf8_string(src_arrmeta, src, errmode);
+      out_begin = buffer.data();
+      out_end = buffer.data() + buffer.size();
+    }
+    out_begin = trim_begin(out_begin, out_end);
+    out_end = trim_end(out_begin, out_end);
+  }
 
   static void destruct(ckernel_prefix *extra)
   {
@@ -114,10 +117,10 @@ static void raise_string_cast_overflow_error(const ndt::type &dst_tp, const ndt:
 static void string_to_bool_single(ckernel_prefix *extra, char *dst, char *const *src)
 {
   string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-  // Get the string from the source
-  std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-  trim(s);
-  parse::string_to_bool(dst, s.data(), s.data() + s.size(), false, e->errmode);
+  const char *begin, *end;
+  std::string buffer;
+  e->get_trimmed_utf8(src[0], buffer, begin, end);
+  parse::string_to_bool(dst, begin, end, false, e->errmode);
 }
 
 template <class T>
@@ -193,20 +196,21 @@ struct string_to_int {
   static void single(ckernel_prefix *extra, char *dst, char *const *src)
   {
     string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-    std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-    trim(s);
+    const char *begin, *end;
+    std::string buffer;
+    e->get_trimmed_utf8(src[0], buffer, begin, end);
     bool negative = false;
-    if (!s.empty() && s[0] == '-') {
-      s.erase(0, 1);
+    if (begin < end && *begin == '-') {
+      ++begin;
       negative = true;
     }
     T result;
     if (e->errmode == assign_error_nocheck) {
-      uint64_t value = parse::unchecked_string_to_uint64(s.data(), s.data() + s.size());
+      uint64_t value = parse::unchecked_string_to_uint64(begin, end);
       result = negative ? static_cast<T>(-static_cast<int64_t>(value)) : static_cast<T>(value);
     } else {
       bool overflow = false, badparse = false;
-      uint64_t value = parse::checked_string_to_uint64(s.data(), s.data() + s.size(), overflow, badparse);
+      uint64_t value = parse::checked_string_to_uint64(begin, end, overflow, badparse);
       if (badparse) {
         raise_string_cast_error(ndt::type::make<T>(), ndt::type(e->src_string_tp, true), e->src_arrmeta, src[0]);
       } else if (overflow || overflow_check<T>::is_overflow(value, negative)) {
@@ -226,20 +230,21 @@ struct string_to_uint {
   static void single(ckernel_prefix *extra, char *dst, char *const *src)
   {
     string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-    std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-    trim(s);
+    const char *begin, *end;
+    std::string buffer;
+    e->get_trimmed_utf8(src[0], buffer, begin, end);
     bool negative = false;
-    if (!s.empty() && s[0] == '-') {
-      s.erase(0, 1);
+    if (begin < end && *begin == '-') {
+      ++begin;
       negative = true;
     }
     T result;
     if (e->errmode == assign_error_nocheck) {
-      uint64_t value = parse::unchecked_string_to_uint64(s.data(), s.data() + s.size());
+      uint64_t value = parse::unchecked_string_to_uint64(begin, end);
       result = negative ? static_cast<T>(0) : static_cast<T>(value);
     } else {
       bool overflow = false, badparse = false;
-      uint64_t value = parse::checked_string_to_uint64(s.data(), s.data() + s.size(), overflow, badparse);
+      uint64_t value = parse::checked_string_to_uint64(begin, end, overflow, badparse);
       if (badparse) {
         raise_string_cast_error(ndt::type::make<T>(), ndt::type(e->src_string_tp, true), e->src_arrmeta, src[0]);
       } else if (overflow || (negative && value != 0) || overflow_check<T>::is_overflow(value)) {
@@ -256,20 +261,21 @@ struct string_to_uint {
 static void string_to_int128_single(ckernel_prefix *extra, char *dst, char *const *src)
 {
   string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-  std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-  trim(s);
+  const char *begin, *end;
+  std::string buffer;
+  e->get_trimmed_utf8(src[0], buffer, begin, end);
   bool negative = false;
-  if (!s.empty() && s[0] == '-') {
-    s.erase(0, 1);
+  if (begin < end && *begin == '-') {
+    ++begin;
     negative = true;
   }
   int128 result;
   if (e->errmode == assign_error_nocheck) {
-    uint128 value = parse::unchecked_string_to_uint128(s.data(), s.data() + s.size());
+    uint128 value = parse::unchecked_string_to_uint128(begin, end);
     result = negative ? static_cast<int128>(0) : static_cast<int128>(value);
   } else {
     bool overflow = false, badparse = false;
-    uint128 value = parse::checked_string_to_uint128(s.data(), s.data() + s.size(), overflow, badparse);
+    uint128 value = parse::checked_string_to_uint128(begin, end, overflow, badparse);
     if (badparse) {
       raise_string_cast_error(ndt::type::make<int128>(), ndt::type(e->src_string_tp, true), e->src_arrmeta, src[0]);
     } else if (overflow || overflow_check<int128>::is_overflow(value, negative)) {
@@ -284,19 +290,20 @@ static void string_to_int128_single(ckernel_prefix *extra, char *dst, char *cons
 static void string_to_uint128_single(ckernel_prefix *extra, char *dst, char *const *src)
 {
   string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-  std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-  trim(s);
+  const char *begin, *end;
+  std::string buffer;
+  e->get_trimmed_utf8(src[0], buffer, begin, end);
   bool negative = false;
-  if (!s.empty() && s[0] == '-') {
-    s.erase(0, 1);
+  if (begin < end && *begin == '-') {
+    ++begin;
     negative = true;
   }
   int128 result;
   if (e->errmode == assign_error_nocheck) {
-    result = parse::unchecked_string_to_uint128(s.data(), s.data() + s.size());
+    result = parse::unchecked_string_to_uint128(begin, end);
   } else {
     bool overflow = false, badparse = false;
-    result = parse::checked_string_to_uint128(s.data(), s.data() + s.size(), overflow, badparse);
+    result = parse::checked_string_to_uint128(begin, end, overflow, badparse);
     if (badparse) {
       raise_string_cast_error(ndt::type::make<int128>(), ndt::type(e->src_string_tp, true), e->src_arrmeta, src[0]);
     } else if (overflow || (negative && result != 0)) {
@@ -310,10 +317,10 @@ static void string_to_uint128_single(ckernel_prefix *extra, char *dst, char *con
 static void string_to_float32_single(ckernel_prefix *extra, char *dst, char *const *src)
 {
   string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-  // Get the string from the source
-  std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-  trim(s);
-  double value = parse::checked_string_to_float64(s.data(), s.data() + s.size(), e->errmode);
+  const char *begin, *end;
+  std::string buffer;
+  e->get_trimmed_utf8(src[0], buffer, begin, end);
+  double value = parse::checked_string_to_float64(begin, end, e->errmode);
   // Assign double -> float according to the error mode
   char *child_src[1] = {reinterpret_cast<char *>(&value)};
   switch (e->errmode) {
@@ -343,10 +350,10 @@ static void string_to_float32_single(ckernel_prefix *extra, char *dst, char *con
 static void string_to_float64_single(ckernel_prefix *extra, char *dst, char *const *src)
 {
   string_to_builtin_kernel *e = reinterpret_cast<string_to_builtin_kernel *>(extra);
-  // Get the string from the source
-  std::string s = e->src_string_tp->get_utf8_string(e->src_arrmeta, src[0], e->errmode);
-  trim(s);
-  double value = parse::checked_string_to_float64(s.data(), s.data() + s.size(), e->errmode);
+  const char *begin, *end;
+  std::string buffer;
+  e->get_trimmed_utf8(src[0], buffer, begin, end);
+  double value = parse::checked_string_to_float64(begin, end, e->errmode);
   *reinterpret_cast<double *>(dst) = value;
 }
 
@@ -383,6 +390,37 @@ static expr_single_t static_string_to_builtin_kernels[builtin_type_id_count - 2]
     &string_to_float32_single,         &string_to_float64_single,         &string_to_float128_single,
     &string_to_complex_float32_single, &string_to_complex_float64_single};
 
+// Converts a run of strings with the single kernel inlined into the loop
+template <expr_single_t Single>
+static void string_to_builtin_strided(ckernel_prefix *extra, char *dst, intptr_t dst_stride, char *const *src,
+                                      const intptr_t *src_stride, size_t count)
+{
+  char *src0 = src[0];
+  intptr_t src0_stride = src_stride[0];
+  for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+    Single(extra, dst, &src0);
+  }
+}
+
+static expr_strided_t static_string_to_builtin_strided_kernels[builtin_type_id_count - 2] = {
+    &string_to_builtin_strided<string_to_bool_single>,
+    &string_to_builtin_strided<string_to_int<int8_t>::single>,
+    &string_to_builtin_strided<string_to_int<int16_t>::single>,
+    &string_to_builtin_strided<string_to_int<int32_t>::single>,
+    &string_to_builtin_strided<string_to_int<int64_t>::single>,
+    &string_to_builtin_strided<string_to_int128_single>,
+    &string_to_builtin_strided<string_to_uint<uint8_t>::single>,
+    &string_to_builtin_strided<string_to_uint<uint16_t>::single>,
+    &string_to_builtin_strided<string_to_uint<uint32_t>::single>,
+    &string_to_builtin_strided<string_to_uint<uint64_t>::single>,
+    &string_to_builtin_strided<string_to_uint128_single>,
+    &string_to_builtin_strided<string_to_float16_single>,
+    &string_to_builtin_strided<string_to_float32_single>,
+    &string_to_builtin_strided<string_to_float64_single>,
+    &string_to_builtin_strided<string_to_float128_single>,
+    &string_to_builtin_strided<string_to_complex_float32_single>,
+    &string_to_builtin_strided<string_to_complex_float64_single>};
+
 size_t dynd::make_string_to_builtin_assignment_kernel(void *ckb, intptr_t ckb_offset, type_id_t dst_type_id,
                                                       const ndt::type &src_string_tp, const char *src_arrmeta,
                                                       kernel_request_t kernreq, const eval::eval_context *ectx)
@@ -394,15 +432,24 @@ size_t dynd::make_string_to_builtin_assignment_kernel(void *ckb, intptr_t ckb_of
   }
 
   if (dst_type_id >= bool_type_id && dst_type_id <= complex_float64_type_id) {
-    ckb_offset = make_kernreq_to_single_kernel_adapter(ckb, ckb_offset, 1, kernreq);
+    void *function;
+    if (kernreq == kernel_request_strided) {
+      function = reinterpret_cast<void *>(static_string_to_builtin_strided_kernels[dst_type_id - bool_type_id]);
+    } else {
+      ckb_offset = make_kernreq_to_single_kernel_adapter(ckb, ckb_offset, 1, kernreq);
+      function = reinterpret_cast<void *>(static_string_to_builtin_kernels[dst_type_id - bool_type_id]);
+    }
     string_to_builtin_kernel *e =
         reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb)->alloc_ck<string_to_builtin_kernel>(ckb_offset);
-    e->base.function = reinterpret_cast<void *>(static_string_to_builtin_kernels[dst_type_id - bool_type_id]);
+    e->base.function = function;
     e->base.destructor = &string_to_builtin_kernel::destruct;
     // The kernel data owns this reference
     e->src_string_tp = static_cast<const ndt::base_string_type *>(ndt::type(src_string_tp).release());
     e->errmode = ectx->errmode;
     e->src_arrmeta = src_arrmeta;
+    e->src_is_string = src_string_tp.get_type_id() == string_type_id;
+    string_encoding_t encoding = e->src_string_tp->get_encoding();
+    e->src_is_utf8 = encoding == string_encoding_ascii || encoding == string_encoding_utf_8;
     return ckb_offset;
   } else {
     stringstream ss;
@@ -423,19 +470,37 @@ struct builtin_to_string_kernel_extra {
   type_id_t src_type_id;
   eval::eval_context ectx;
   const char *dst_arrmeta;
+  // Whether the destination is a dynd::string, which is assigned directly
+  bool dst_is_string;
 
   static void single(ckernel_prefix *extra, char *dst, char *const *src)
   {
     extra_type *e = reinterpret_cast<extra_type *>(extra);
 
-    // TODO: There are much faster ways to do this, but it's very generic!
-    //       Also, for floating point values, a printing scheme like
-    //       Python's, where it prints the shortest string that's
-    //       guaranteed to parse to the same float number, would be
-    //       better.
-    stringstream ss;
-    ndt::type(e->src_type_id).print_data(ss, NULL, src[0]);
-    e->dst_string_tp->set_from_utf8_string(e->dst_arrmeta, dst, ss.str(), &e->ectx);
+    // Floating point values are printed with the shortest string that
+    // parses back to the same value
+    char buffer[max_number_format_size];
+    char *end = format_builtin_number(e->src_type_id, src[0], buffer);
+    if (end == NULL) {
+      // The 128 bit and complex types go through their stream printing
+      stringstream ss;
+      ndt::type(e->src_type_id).print_data(ss, NULL, src[0]);
+      e->dst_string_tp->set_from_utf8_string(e->dst_arrmeta, dst, ss.str(), &e->ectx);
+    } else if (e->dst_is_string) {
+      reinterpret_cast<dynd::string *>(dst)->assign(buffer, end - buffer);
+    } else {
+      e->dst_string_tp->set_from_utf8_string(e->dst_arrmeta, dst, buffer, end, &e->ectx);
+    }
+  }
+
+  static void strided(ckernel_prefix *extra, char *dst, intptr_t dst_stride, char *const *src,
+                      const intptr_t *src_stride, size_t count)
+  {
+    char *src0 = src[0];
+    intptr_t src0_stride = src_stride[0];
+    for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+      single(extra, dst, &src0);
+    }
   }
 
   static void destruct(ckernel_prefix *extra)
@@ -459,16 +524,23 @@ size_t dynd::make_builtin_to_string_assignment_kernel(void *ckb, intptr_t ckb_of
   }
 
   if (src_type_id >= 0 && src_type_id < builtin_type_id_count) {
-    ckb_offset = make_kernreq_to_single_kernel_adapter(ckb, ckb_offset, 1, kernreq);
+    void *function;
+    if (kernreq == kernel_request_strided) {
+      function = reinterpret_cast<void *>(builtin_to_string_kernel_extra::strided);
+    } else {
+      ckb_offset = make_kernreq_to_single_kernel_adapter(ckb, ckb_offset, 1, kernreq);
+      function = reinterpret_cast<void *>(builtin_to_string_kernel_extra::single);
+    }
     builtin_to_string_kernel_extra *e = reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb)
                                             ->alloc_ck<builtin_to_string_kernel_extra>(ckb_offset);
-    e->base.function = reinterpret_cast<void *>(builtin_to_string_kernel_extra::single);
+    e->base.function = function;
     e->base.destructor = builtin_to_string_kernel_extra::destruct;
     // The kernel data owns this reference
     e->dst_string_tp = static_cast<const ndt::base_string_type *>(ndt::type(dst_string_tp).release());
     e->src_type_id = src_type_id;
     e->ectx = *ectx;
     e->dst_arrmeta = dst_arrmeta;
+    e->dst_is_string = dst_string_tp.get_type_id() == string_type_id;
     return ckb_offset;
   } else {
     stringstream ss;
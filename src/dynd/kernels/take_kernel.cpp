@@ -3,14 +3,419 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+
 #include <dynd/shape_tools.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/kernels/take_kernel.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_TAKE_SSE2
+#endif
+#ifdef DYND_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+// Once the elements an index may pick from span more than this many bytes,
+// they are unlikely to be in the cache, and the element a few indices
+// ahead is prefetched
+const intptr_t prefetch_span = 1 << 20;
+const intptr_t prefetch_distance = 16;
+
+inline bool should_prefetch(intptr_t dim_size, intptr_t stride, intptr_t count)
+{
+  return count > prefetch_distance &&
+         dim_size * (stride < 0 ? -stride : stride) > prefetch_span;
+}
+
+// Prefetches the element at index ``ix``, which may be out of bounds since
+// a prefetch never faults
+template <bool Write>
+inline void prefetch(const char *data, intptr_t ix, intptr_t stride)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(reinterpret_cast<const char *>(
+                         reinterpret_cast<uintptr_t>(data) + ix * stride),
+                     Write ? 1 : 0);
+#elif defined(DYND_TAKE_SSE2)
+  _mm_prefetch(reinterpret_cast<const char *>(
+                   reinterpret_cast<uintptr_t>(data) + ix * stride),
+               _MM_HINT_T0);
+#endif
+}
+
+// Handles a Python-style negative index, and checks the bounds, with
+// one comparison for an index already in range
+inline intptr_t checked_index(intptr_t ix, intptr_t dim_size)
+{
+  if (static_cast<uintptr_t>(ix) < static_cast<uintptr_t>(dim_size)) {
+    return ix;
+  }
+  return apply_single_index(ix, dim_size, NULL);
+}
+
+inline intptr_t get_index(const char *index, intptr_t i, intptr_t stride)
+{
+  return *reinterpret_cast<const intptr_t *>(index + i * stride);
+}
+
+// The ``boundscheck`` keyword, which defaults to true
+inline bool is_boundscheck(intptr_t nkwd, const nd::array *kwds)
+{
+  return nkwd == 0 || kwds[0].is_missing() || kwds[0].as<bool>();
+}
+
+// Copies one element of ``Size`` bytes, or of ``size`` bytes when ``Size``
+// is 0, so the common sizes compile to a single load and store
+template <int Size>
+inline void copy_element(char *dst, const char *src, size_t DYND_UNUSED(size))
+{
+  memcpy(dst, src, Size);
+}
+
+template <>
+inline void copy_element<0>(char *dst, const char *src, size_t size)
+{
+  memcpy(dst, src, size);
+}
+
+/**
+ * The size of the elements, if an element of type ``dst_tp`` is assigned
+ * from one of type ``src_tp`` by copying its bytes, otherwise 0.
+ */
+intptr_t get_bytewise_size(const ndt::type &dst_tp, const char *dst_arrmeta,
+                           const ndt::type &src_tp, const char *src_arrmeta)
+{
+  if (dst_tp != src_tp || !src_tp.is_pod()) {
+    return 0;
+  }
+  if (!src_tp.is_builtin() && (!src_tp.is_c_contiguous(src_arrmeta) ||
+                               !dst_tp.is_c_contiguous(dst_arrmeta))) {
+    return 0;
+  }
+  return src_tp.get_data_size();
+}
+
+template <int Size>
+void gather(char *dst, intptr_t dst_stride, const char *src,
+            intptr_t src_dim_size, intptr_t src_stride, const char *index,
+            intptr_t index_stride, intptr_t count, size_t size,
+            bool boundscheck)
+{
+  intptr_t i = 0;
+  if (should_prefetch(src_dim_size, src_stride, count)) {
+    for (; i < count - prefetch_distance; ++i) {
+      prefetch<false>(src, get_index(index, i + prefetch_distance, index_stride),
+                      src_stride);
+      intptr_t ix = get_index(index, i, index_stride);
+      if (boundscheck) {
+        ix = checked_index(ix, src_dim_size);
+      }
+      copy_element<Size>(dst + i * dst_stride, src + ix * src_stride, size);
+    }
+  }
+  for (; i < count; ++i) {
+    intptr_t ix = get_index(index, i, index_stride);
+    if (boundscheck) {
+      ix = checked_index(ix, src_dim_size);
+    }
+    copy_element<Size>(dst + i * dst_stride, src + ix * src_stride, size);
+  }
+}
+
+#ifdef DYND_SIMD_DISPATCH
+/**
+ * Gathers 4 or 8 byte elements from a contiguous source into a contiguous
+ * destination with the AVX2 gather instructions, four indices at a time.
+ * A group of four with an index to wrap or reject goes through the scalar
+ * checks instead.
+ */
+template <int Size>
+DYND_TARGET_AVX2 void gather_avx2(char *dst, const char *src,
+                                  intptr_t src_dim_size, const int64 *index,
+                                  intptr_t count, bool boundscheck)
+{
+  const __m256i lower = _mm256_set1_epi64x(-1);
+  const __m256i upper = _mm256_set1_epi64x(src_dim_size);
+  intptr_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i ix =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index + i));
+    if (boundscheck) {
+      __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi64(ix, lower),
+                                          _mm256_cmpgt_epi64(upper, ix));
+      if (_mm256_movemask_epi8(in_range) != -1) {
+        for (intptr_t j = i; j < i + 4; ++j) {
+          copy_element<Size>(dst + j * Size,
+                             src + checked_index(index[j], src_dim_size) * Size,
+                             Size);
+        }
+        continue;
+      }
+    }
+    if (Size == 8) {
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i *>(dst + i * 8),
+          _mm256_i64gather_epi64(reinterpret_cast<const long long *>(src), ix,
+                                 8));
+    } else {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i *>(dst + i * 4),
+          _mm256_i64gather_epi32(reinterpret_cast<const int *>(src), ix, 4));
+    }
+  }
+  for (; i < count; ++i) {
+    intptr_t ix = boundscheck ? checked_index(index[i], src_dim_size) : index[i];
+    copy_element<Size>(dst + i * Size, src + ix * Size, Size);
+  }
+}
+#endif
+
+/**
+ * Copies ``dst[i] = src[index[i]]`` for ``count`` elements of ``size``
+ * bytes each.
+ */
+void gather_elements(char *dst, intptr_t dst_stride, const char *src,
+                     intptr_t src_dim_size, intptr_t src_stride,
+                     const char *index, intptr_t index_stride, intptr_t count,
+                     size_t size, bool boundscheck)
+{
+#ifdef DYND_SIMD_DISPATCH
+  // The gather instructions beat scalar loads while the source is in the
+  // cache, past that the prefetching scalar loop does as well
+  if ((size == 4 || size == 8) && sizeof(intptr_t) == sizeof(int64) &&
+      dst_stride == static_cast<intptr_t>(size) &&
+      src_stride == static_cast<intptr_t>(size) &&
+      index_stride == sizeof(int64) &&
+      !should_prefetch(src_dim_size, src_stride, count) &&
+      get_simd_isa() == simd_isa_avx2) {
+    if (size == 8) {
+      gather_avx2<8>(dst, src, src_dim_size,
+                     reinterpret_cast<const int64 *>(index), count,
+                     boundscheck);
+    } else {
+      gather_avx2<4>(dst, src, src_dim_size,
+                     reinterpret_cast<const int64 *>(index), count,
+                     boundscheck);
+    }
+    return;
+  }
+#endif
+  switch (size) {
+  case 1:
+    gather<1>(dst, dst_stride, src, src_dim_size, src_stride, index,
+              index_stride, count, size, boundscheck);
+    break;
+  case 2:
+    gather<2>(dst, dst_stride, src, src_dim_size, src_stride, index,
+              index_stride, count, size, boundscheck);
+    break;
+  case 4:
+    gather<4>(dst, dst_stride, src, src_dim_size, src_stride, index,
+              index_stride, count, size, boundscheck);
+    break;
+  case 8:
+    gather<8>(dst, dst_stride, src, src_dim_size, src_stride, index,
+              index_stride, count, size, boundscheck);
+    break;
+  case 16:
+    gather<16>(dst, dst_stride, src, src_dim_size, src_stride, index,
+               index_stride, count, size, boundscheck);
+    break;
+  default:
+    gather<0>(dst, dst_stride, src, src_dim_size, src_stride, index,
+              index_stride, count, size, boundscheck);
+    break;
+  }
+}
+
+template <int Size>
+void scatter(char *dst, intptr_t dst_dim_size, intptr_t dst_stride,
+             const char *index, intptr_t index_stride, const char *src,
+             intptr_t src_stride, intptr_t count, size_t size,
+             bool boundscheck)
+{
+  intptr_t i = 0;
+  if (should_prefetch(dst_dim_size, dst_stride, count)) {
+    for (; i < count - prefetch_distance; ++i) {
+      prefetch<true>(dst, get_index(index, i + prefetch_distance, index_stride),
+                     dst_stride);
+      intptr_t ix = get_index(index, i, index_stride);
+      if (boundscheck) {
+        ix = checked_index(ix, dst_dim_size);
+      }
+      copy_element<Size>(dst + ix * dst_stride, src + i * src_stride, size);
+    }
+  }
+  for (; i < count; ++i) {
+    intptr_t ix = get_index(index, i, index_stride);
+    if (boundscheck) {
+      ix = checked_index(ix, dst_dim_size);
+    }
+    copy_element<Size>(dst + ix * dst_stride, src + i * src_stride, size);
+  }
+}
+
+/**
+ * Copies ``dst[index[i]] = src[i]`` for ``count`` elements of ``size``
+ * bytes each.
+ */
+void scatter_elements(char *dst, intptr_t dst_dim_size, intptr_t dst_stride,
+                      const char *index, intptr_t index_stride,
+                      const char *src, intptr_t src_stride, intptr_t count,
+                      size_t size, bool boundscheck)
+{
+  switch (size) {
+  case 1:
+    scatter<1>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+               src_stride, count, size, boundscheck);
+    break;
+  case 2:
+    scatter<2>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+               src_stride, count, size, boundscheck);
+    break;
+  case 4:
+    scatter<4>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+               src_stride, count, size, boundscheck);
+    break;
+  case 8:
+    scatter<8>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+               src_stride, count, size, boundscheck);
+    break;
+  case 16:
+    scatter<16>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+                src_stride, count, size, boundscheck);
+    break;
+  default:
+    scatter<0>(dst, dst_dim_size, dst_stride, index, index_stride, src,
+               src_stride, count, size, boundscheck);
+    break;
+  }
+}
+
+// Bit i is set for a true value in mask[i], for 16 contiguous bool values
+inline uint32 mask_bits(const char *mask)
+{
+#ifdef DYND_TAKE_SSE2
+  __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask));
+  return ~_mm_movemask_epi8(_mm_cmpeq_epi8(m, _mm_setzero_si128())) & 0xffff;
+#else
+  uint32 bits = 0;
+  for (int j = 0; j < 16; ++j) {
+    bits |= (mask[j] != 0 ? 1u : 0u) << j;
+  }
+  return bits;
+#endif
+}
+
+inline int popcount(uint32 x)
+{
+#if defined(__GNUC__)
+  return __builtin_popcount(x);
+#else
+  int n = 0;
+  for (; x != 0; x &= x - 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline int trailing_zeros(uint32 x)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// The number of true values in a contiguous bool mask
+intptr_t count_mask(const char *mask, intptr_t count)
+{
+  intptr_t result = 0, i = 0;
+  for (; i + 16 <= count; i += 16) {
+    result += popcount(mask_bits(mask + i));
+  }
+  for (; i < count; ++i) {
+    result += mask[i] != 0;
+  }
+  return result;
+}
+
+template <int Size>
+void compact(char *dst, intptr_t dst_stride, const char *src,
+             intptr_t src_stride, const char *mask, intptr_t count,
+             size_t size)
+{
+  bool contiguous = dst_stride == static_cast<intptr_t>(size) &&
+                    src_stride == static_cast<intptr_t>(size);
+  intptr_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint32 bits = mask_bits(mask + i);
+    if (bits == 0xffff && contiguous) {
+      memcpy(dst, src + i * src_stride, 16 * size);
+      dst += 16 * dst_stride;
+    } else {
+      for (; bits != 0; bits &= bits - 1) {
+        copy_element<Size>(dst, src + (i + trailing_zeros(bits)) * src_stride,
+                           size);
+        dst += dst_stride;
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    if (mask[i] != 0) {
+      copy_element<Size>(dst, src + i * src_stride, size);
+      dst += dst_stride;
+    }
+  }
+}
+
+/**
+ * Copies the elements of ``src`` whose values in the contiguous ``mask``
+ * are true, one after another into ``dst``.
+ */
+void compact_elements(char *dst, intptr_t dst_stride, const char *src,
+                      intptr_t src_stride, const char *mask, intptr_t count,
+                      size_t size)
+{
+  switch (size) {
+  case 1:
+    compact<1>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  case 2:
+    compact<2>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  case 4:
+    compact<4>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  case 8:
+    compact<8>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  case 16:
+    compact<16>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  default:
+    compact<0>(dst, dst_stride, src, src_stride, mask, count, size);
+    break;
+  }
+}
+} // anonymous namespace
+
 void nd::masked_take_ck::single(char *dst, char *const *src)
 {
   ckernel_prefix *child = get_child();
@@ -19,13 +424,22 @@ void nd::masked_take_ck::single(char *dst, char *const *src)
   char *mask = src[1];
   intptr_t dim_size = m_dim_size, src0_stride = m_src0_stride,
            mask_stride = m_mask_stride;
+  intptr_t dst_stride =
+      reinterpret_cast<const var_dim_type_arrmeta *>(m_dst_meta)->stride;
+  if (m_elem_size != 0 && mask_stride == 1) {
+    // Count the true values first, so the dst is allocated at its size
+    ndt::var_dim_element_initialize(m_dst_tp, m_dst_meta, dst,
+                                    count_mask(mask, dim_size));
+    compact_elements(reinterpret_cast<var_dim_type_data *>(dst)->begin,
+                     dst_stride, src0, src0_stride, mask, dim_size,
+                     m_elem_size);
+    return;
+  }
   // Start with the dst matching the dim size. (Maybe better to
   // do smaller? This means no resize required in the loop.)
   ndt::var_dim_element_initialize(m_dst_tp, m_dst_meta, dst, dim_size);
   var_dim_type_data *vdd = reinterpret_cast<var_dim_type_data *>(dst);
   char *dst_ptr = vdd->begin;
-  intptr_t dst_stride =
-      reinterpret_cast<const var_dim_type_arrmeta *>(m_dst_meta)->stride;
   intptr_t dst_count = 0;
   intptr_t i = 0;
   while (i < dim_size) {
@@ -58,7 +472,7 @@ intptr_t nd::masked_take_ck::instantiate(
     const char *const *src_arrmeta, kernel_request_t kernreq,
     const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
     const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   typedef nd::masked_take_ck self_type;
 
@@ -108,6 +522,8 @@ intptr_t nd::masked_take_ck::instantiate(
     ss << mask_el_tp;
     throw type_error(ss.str());
   }
+  self->m_elem_size =
+      get_bytewise_size(dst_el_tp, dst_el_meta, src0_el_tp, src0_el_meta);
 
   // Create the child element assignment ckernel
   return make_assignment_kernel(ckb, ckb_offset, dst_el_tp, dst_el_meta,
@@ -117,6 +533,13 @@ intptr_t nd::masked_take_ck::instantiate(
 
 void nd::indexed_take_ck::single(char *dst, char *const *src)
 {
+  if (m_elem_size != 0) {
+    gather_elements(dst, m_dst_stride, src[0], m_src0_dim_size,
+                    m_src0_stride, src[1], m_index_stride, m_dst_dim_size,
+                    m_elem_size, m_boundscheck);
+    return;
+  }
+
   ckernel_prefix *child = get_child();
   expr_single_t child_fn = child->get_function<expr_single_t>();
   char *src0 = src[0];
@@ -127,7 +550,9 @@ void nd::indexed_take_ck::single(char *dst, char *const *src)
   for (intptr_t i = 0; i < dst_dim_size; ++i) {
     intptr_t ix = *reinterpret_cast<const intptr_t *>(index);
     // Handle Python-style negative index, bounds checking
-    ix = apply_single_index(ix, src0_dim_size, NULL);
+    if (m_boundscheck) {
+      ix = checked_index(ix, src0_dim_size);
+    }
     // Copy one element at a time
     char *child_src0 = src0 + ix * src0_stride;
     child_fn(child, dst, &child_src0);
@@ -142,9 +567,8 @@ intptr_t nd::indexed_take_ck::instantiate(
     const ndt::type &dst_tp, const char *dst_arrmeta,
     intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
     const char *const *src_arrmeta, kernel_request_t kernreq,
-    const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
-    const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   typedef nd::indexed_take_ck self_type;
 
@@ -191,6 +615,9 @@ intptr_t nd::indexed_take_ck::instantiate(
     ss << index_el_tp;
     throw type_error(ss.str());
   }
+  self->m_elem_size =
+      get_bytewise_size(dst_el_tp, dst_el_meta, src0_el_tp, src0_el_meta);
+  self->m_boundscheck = is_boundscheck(nkwd, kwds);
 
   // Create the child element assignment ckernel
   return make_assignment_kernel(ckb, ckb_offset, dst_el_tp, dst_el_meta,
@@ -198,13 +625,102 @@ intptr_t nd::indexed_take_ck::instantiate(
                                 ectx);
 }
 
+void nd::indexed_put_ck::single(char *dst, char *const *src)
+{
+  if (m_elem_size != 0) {
+    scatter_elements(dst, m_dst_dim_size, m_dst_stride, src[0],
+                     m_index_stride, src[1], m_src_stride, m_index_dim_size,
+                     m_elem_size, m_boundscheck);
+    return;
+  }
+
+  ckernel_prefix *child = get_child();
+  expr_single_t child_fn = child->get_function<expr_single_t>();
+  const char *index = src[0];
+  char *values = src[1];
+  intptr_t dst_dim_size = m_dst_dim_size, dst_stride = m_dst_stride,
+           index_stride = m_index_stride, src_stride = m_src_stride;
+  for (intptr_t i = 0, i_end = m_index_dim_size; i < i_end; ++i) {
+    intptr_t ix = *reinterpret_cast<const intptr_t *>(index);
+    // Handle Python-style negative index, bounds checking
+    if (m_boundscheck) {
+      ix = checked_index(ix, dst_dim_size);
+    }
+    // Assign one element at a time
+    child_fn(child, dst + ix * dst_stride, &values);
+    index += index_stride;
+    values += src_stride;
+  }
+}
+
+intptr_t nd::indexed_put_ck::instantiate(
+    char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
+    char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+    const ndt::type &dst_tp, const char *dst_arrmeta,
+    intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+    const char *const *src_arrmeta, kernel_request_t kernreq,
+    const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+{
+  typedef nd::indexed_put_ck self_type;
+
+  self_type *self = self_type::make(ckb, kernreq, ckb_offset);
+
+  ndt::type dst_el_tp, index_el_tp, src_el_tp;
+  const char *dst_el_meta, *index_el_meta, *src_el_meta;
+  intptr_t src_dim_size;
+  if (!dst_tp.get_as_strided(dst_arrmeta, &self->m_dst_dim_size,
+                             &self->m_dst_stride, &dst_el_tp, &dst_el_meta)) {
+    stringstream ss;
+    ss << "indexed put arrfunc: could not process type " << dst_tp;
+    ss << " as a strided dimension";
+    throw type_error(ss.str());
+  }
+  if (!src_tp[0].get_as_strided(src_arrmeta[0], &self->m_index_dim_size,
+                                &self->m_index_stride, &index_el_tp,
+                                &index_el_meta)) {
+    stringstream ss;
+    ss << "indexed put arrfunc: could not process type " << src_tp[0];
+    ss << " as a strided dimension";
+    throw type_error(ss.str());
+  }
+  if (!src_tp[1].get_as_strided(src_arrmeta[1], &src_dim_size,
+                                &self->m_src_stride, &src_el_tp,
+                                &src_el_meta)) {
+    stringstream ss;
+    ss << "indexed put arrfunc: could not process type " << src_tp[1];
+    ss << " as a strided dimension";
+    throw type_error(ss.str());
+  }
+  if (self->m_index_dim_size != src_dim_size) {
+    stringstream ss;
+    ss << "indexed put arrfunc: index data and values have different sizes, ";
+    ss << self->m_index_dim_size << " and " << src_dim_size;
+    throw invalid_argument(ss.str());
+  }
+  if (index_el_tp.get_type_id() != (type_id_t)type_id_of<intptr_t>::value) {
+    stringstream ss;
+    ss << "indexed put arrfunc: index type should be intptr, not ";
+    ss << index_el_tp;
+    throw type_error(ss.str());
+  }
+  self->m_elem_size =
+      get_bytewise_size(dst_el_tp, dst_el_meta, src_el_tp, src_el_meta);
+  self->m_boundscheck = is_boundscheck(nkwd, kwds);
+
+  // Create the child element assignment ckernel
+  return make_assignment_kernel(ckb, ckb_offset, dst_el_tp, dst_el_meta,
+                                src_el_tp, src_el_meta, kernel_request_single,
+                                ectx);
+}
+
 intptr_t nd::take_ck::instantiate(
     char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size),
     char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
     const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
     const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-    const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+    const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars)
 {
   ndt::type mask_el_tp = src_tp[1].get_type_at_dimension(NULL, 1);
   if (mask_el_tp.get_type_id() == bool_type_id) {
@@ -229,7 +745,7 @@ void nd::take_ck::resolve_dst_type(
     char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
     const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
     const nd::array *DYND_UNUSED(kwds),
-    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
 {
   /*
     if (nsrc != 2) {
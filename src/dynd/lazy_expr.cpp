@@ -0,0 +1,278 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/exceptions.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/kernels/lazy_expr_kernel.hpp>
+#include <dynd/lazy_expr.hpp>
+#include <dynd/shape_tools.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// A leaf holds an array, and an operation its callable and operands
+struct nd::lazy_expr::node {
+  array value;
+  callable func;
+  std::vector<std::shared_ptr<const node>> operands;
+  ndt::type dtype;
+};
+
+namespace {
+typedef nd::lazy_expr::node node;
+
+template <typename FuncType>
+std::shared_ptr<const node> make_unary(const std::shared_ptr<const node> &a0)
+{
+  FuncType::get();
+  nd::callable &child = FuncType::overload(a0->dtype);
+  if (child.is_null()) {
+    throw std::runtime_error(FuncType::what(a0->dtype));
+  }
+
+  std::shared_ptr<node> result = std::make_shared<node>();
+  result->func = child;
+  result->operands.push_back(a0);
+  result->dtype = child.get_type()->get_return_type();
+  return result;
+}
+
+template <typename FuncType>
+std::shared_ptr<const node> make_binary(const std::shared_ptr<const node> &op0, const std::shared_ptr<const node> &op1)
+{
+  FuncType::get();
+  nd::callable &child = FuncType::overload(op0->dtype, op1->dtype);
+  if (child.is_null()) {
+    throw std::runtime_error(FuncType::what(op0->dtype, op1->dtype));
+  }
+
+  std::shared_ptr<node> result = std::make_shared<node>();
+  result->func = child;
+  result->operands.push_back(op0);
+  result->operands.push_back(op1);
+  result->dtype = child.get_type()->get_return_type();
+  return result;
+}
+
+// Numbers the arrays of an expression, giving an array used more than once
+// one number
+void collect_arrays(const node *n, std::vector<nd::array> &arrays, std::map<const node *, intptr_t> &index)
+{
+  if (index.find(n) != index.end()) {
+    return;
+  }
+  if (n->operands.empty()) {
+    for (size_t i = 0; i < arrays.size(); ++i) {
+      if (arrays[i].get() == n->value.get()) {
+        index[n] = i;
+        return;
+      }
+    }
+    index[n] = arrays.size();
+    arrays.push_back(n->value);
+  } else {
+    index[n] = -1;
+    for (size_t i = 0; i < n->operands.size(); ++i) {
+      collect_arrays(n->operands[i].get(), arrays, index);
+    }
+  }
+}
+
+// Appends the operations of an expression after the ones they depend on
+void collect_ops(const node *n, intptr_t nsrc, std::vector<nd::lazy_expr_kernel::static_data::op> &ops,
+                 std::map<const node *, intptr_t> &index)
+{
+  if (index[n] >= 0) {
+    return;
+  }
+
+  nd::lazy_expr_kernel::static_data::op op;
+  for (size_t i = 0; i < n->operands.size(); ++i) {
+    collect_ops(n->operands[i].get(), nsrc, ops, index);
+    op.src.push_back(index[n->operands[i].get()]);
+  }
+  op.func = n->func;
+  op.tp = n->dtype;
+  index[n] = nsrc + ops.size();
+  ops.push_back(op);
+}
+} // anonymous namespace
+
+nd::lazy_expr::lazy_expr(const array &a)
+{
+  if (a.is_null()) {
+    throw invalid_argument("cannot make a lazy expression of a null array");
+  }
+
+  ndt::type tp = a.get_type();
+  for (intptr_t i = 0, i_end = a.get_ndim(); i < i_end; ++i) {
+    if (tp.get_type_id() != fixed_dim_type_id) {
+      stringstream ss;
+      ss << "lazy expressions require fixed dimensions, not array type " << a.get_type();
+      throw type_error(ss.str());
+    }
+    tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+  }
+  if (!tp.is_builtin()) {
+    stringstream ss;
+    ss << "lazy expressions require builtin scalar types, not array type " << a.get_type();
+    throw type_error(ss.str());
+  }
+
+  std::shared_ptr<node> n = std::make_shared<node>();
+  n->value = a;
+  n->dtype = tp;
+  m_node = n;
+}
+
+const ndt::type &nd::lazy_expr::get_dtype() const
+{
+  return m_node->dtype;
+}
+
+nd::array nd::lazy_expr::eval(const eval::eval_context *ectx) const
+{
+  std::vector<array> arrays;
+  std::map<const node *, intptr_t> index;
+  collect_arrays(m_node.get(), arrays, index);
+  if (m_node->operands.empty()) {
+    return m_node->value.eval_copy(0, ectx);
+  }
+
+  lazy_expr_kernel::static_data program;
+  program.nsrc = arrays.size();
+  collect_ops(m_node.get(), program.nsrc, program.ops, index);
+
+  // Broadcast the arrays together, and allocate the result to match them
+  intptr_t nsrc = program.nsrc, ndim;
+  dimvector shape;
+  shortvector<int> axis_perm;
+  broadcast_input_shapes(nsrc, arrays.data(), ndim, shape, axis_perm);
+  array result = make_strided_array(m_node->dtype, ndim, shape.get(), read_access_flag | write_access_flag,
+                                    axis_perm.get());
+  for (intptr_t k = 0; k < ndim; ++k) {
+    if (shape[k] == 0) {
+      return result;
+    }
+  }
+
+  // The strides of the result, then of each array, broadcast to the result
+  intptr_t nops = nsrc + 1;
+  std::vector<intptr_t> strides(nops * ndim);
+  std::vector<char *> data(nops);
+  result.get_strides(strides.data());
+  data[0] = result.data();
+  shortvector<ndt::type> src_tp(nsrc);
+  shortvector<const char *> src_arrmeta(nsrc);
+  for (intptr_t j = 0; j < nsrc; ++j) {
+    const array &a = arrays[j];
+    dimvector src_shape(a.get_ndim()), src_strides(a.get_ndim());
+    a.get_shape(src_shape.get());
+    a.get_strides(src_strides.get());
+    broadcast_to_shape(ndim, shape.get(), a.get_ndim(), src_shape.get(), src_strides.get(),
+                       strides.data() + (j + 1) * ndim);
+    data[j + 1] = const_cast<char *>(a.cdata());
+    src_tp[j] = a.get_dtype();
+    src_arrmeta[j] = NULL;
+  }
+
+  // Merge the inner dimensions which are contiguous in every array, so
+  // the blocks don't stop at short rows
+  while (ndim > 1) {
+    bool contiguous = true;
+    for (intptr_t j = 0; j < nops && contiguous; ++j) {
+      const intptr_t *s = strides.data() + j * ndim;
+      contiguous = s[ndim - 2] == s[ndim - 1] * shape[ndim - 1];
+    }
+    if (!contiguous) {
+      break;
+    }
+    shape[ndim - 2] *= shape[ndim - 1];
+    std::vector<intptr_t> merged((ndim - 1) * nops);
+    for (intptr_t j = 0; j < nops; ++j) {
+      for (intptr_t k = 0; k < ndim - 1; ++k) {
+        merged[j * (ndim - 1) + k] = strides[j * ndim + k];
+      }
+      merged[j * (ndim - 1) + ndim - 2] = strides[j * ndim + ndim - 1];
+    }
+    strides.swap(merged);
+    --ndim;
+  }
+
+  ckernel_builder<kernel_request_host> ckb;
+  lazy_expr_kernel::instantiate(reinterpret_cast<char *>(&program), 0, NULL, &ckb, 0, m_node->dtype, NULL, nsrc,
+                                src_tp.get(), src_arrmeta.get(), kernel_request_strided, ectx, 0, NULL,
+                                small_map<std::string, ndt::type>());
+  ckernel_prefix *ckp = ckb.get();
+  expr_strided_t fn = ckp->get_function<expr_strided_t>();
+
+  // Run the kernel along the innermost dimension, for every index of the others
+  intptr_t inner_size = ndim > 0 ? shape[ndim - 1] : 1;
+  intptr_t dst_stride = ndim > 0 ? strides[ndim - 1] : 0;
+  std::vector<intptr_t> src_stride(nsrc);
+  for (intptr_t j = 0; j < nsrc; ++j) {
+    src_stride[j] = ndim > 0 ? strides[(j + 1) * ndim + ndim - 1] : 0;
+  }
+  dimvector iterindex(ndim > 0 ? ndim : 1);
+  for (intptr_t k = 0; k < ndim; ++k) {
+    iterindex[k] = 0;
+  }
+  std::vector<char *> src(nsrc);
+  for (;;) {
+    char *dst = data[0];
+    for (intptr_t j = 0; j < nsrc; ++j) {
+      src[j] = data[j + 1];
+    }
+    for (intptr_t k = 0; k < ndim - 1; ++k) {
+      dst += iterindex[k] * strides[k];
+      for (intptr_t j = 0; j < nsrc; ++j) {
+        src[j] += iterindex[k] * strides[(j + 1) * ndim + k];
+      }
+    }
+    fn(ckp, dst, dst_stride, src.data(), src_stride.data(), inner_size);
+
+    intptr_t k = ndim - 1;
+    while (--k >= 0) {
+      if (++iterindex[k] != shape[k]) {
+        break;
+      }
+      iterindex[k] = 0;
+    }
+    if (k < 0) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+nd::lazy_expr nd::operator-(const lazy_expr &a0)
+{
+  return lazy_expr(make_unary<struct nd::minus>(a0.m_node));
+}
+
+nd::lazy_expr nd::operator+(const lazy_expr &op0, const lazy_expr &op1)
+{
+  return lazy_expr(make_binary<struct nd::add>(op0.m_node, op1.m_node));
+}
+
+nd::lazy_expr nd::operator-(const lazy_expr &op0, const lazy_expr &op1)
+{
+  return lazy_expr(make_binary<struct nd::subtract>(op0.m_node, op1.m_node));
+}
+
+nd::lazy_expr nd::operator*(const lazy_expr &op0, const lazy_expr &op1)
+{
+  return lazy_expr(make_binary<struct nd::multiply>(op0.m_node, op1.m_node));
+}
+
+nd::lazy_expr nd::operator/(const lazy_expr &op0, const lazy_expr &op1)
+{
+  return lazy_expr(make_binary<struct nd::divide>(op0.m_node, op1.m_node));
+}
@@ -185,6 +185,14 @@ struct memmap_memory_block {
     m_mapOffset = begin - mapbegin;
     intptr_t mapsize = end - mapbegin;
 
+    if (mapsize == 0) {
+      // mmap can't map zero bytes, so an empty range has no mapping
+      m_mapPointer = NULL;
+      *out_pointer = NULL;
+      *out_size = 0;
+      return;
+    }
+
     m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), MAP_SHARED, m_fd, mapbegin);
     if (m_mapPointer == (char *)MAP_FAILED) {
       close(m_fd);
@@ -198,6 +206,11 @@ struct memmap_memory_block {
 #endif
   }
 
+  intptr_t get_map_size() const
+  {
+    return m_end - m_begin + m_mapOffset;
+  }
+
   ~memmap_memory_block()
   {
 #ifdef WIN32
@@ -205,8 +218,9 @@ struct memmap_memory_block {
     CloseHandle(m_hMapFile);
     CloseHandle(m_hFile);
 #else
-    intptr_t mapsize = m_end - m_begin + m_mapOffset;
-    munmap((void *)m_mapPointer, mapsize);
+    if (m_mapPointer != NULL) {
+      munmap((void *)m_mapPointer, get_map_size());
+    }
     close(m_fd);
 #endif
   }
@@ -231,6 +245,77 @@ namespace detail {
 }
 } // namespace dynd::detail
 
+static memmap_memory_block *get_memmap_memory_block(memory_block_data *memblock)
+{
+  if (memblock == NULL || memblock->m_type != memmap_memory_block_type) {
+    throw runtime_error("the memory block is not a memory-mapped file");
+  }
+  return reinterpret_cast<memmap_memory_block *>(memblock);
+}
+
+void dynd::memmap_memory_block_advise(memory_block_data *memblock, memmap_advice_t advice)
+{
+  memmap_memory_block *emb = get_memmap_memory_block(memblock);
+  if (emb->m_mapPointer == NULL) {
+    return;
+  }
+#ifdef WIN32
+  // Windows only has a way to ask for pages to be read ahead
+  if (advice == memmap_advice_willneed) {
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = emb->m_mapPointer;
+    range.NumberOfBytes = emb->get_map_size();
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+  }
+#else
+  int posix_advice;
+  switch (advice) {
+  case memmap_advice_normal:
+    posix_advice = MADV_NORMAL;
+    break;
+  case memmap_advice_sequential:
+    posix_advice = MADV_SEQUENTIAL;
+    break;
+  case memmap_advice_random:
+    posix_advice = MADV_RANDOM;
+    break;
+  case memmap_advice_willneed:
+    posix_advice = MADV_WILLNEED;
+    break;
+  case memmap_advice_dontneed:
+    posix_advice = MADV_DONTNEED;
+    break;
+  default: {
+    stringstream ss;
+    ss << "invalid memory map advice " << advice;
+    throw invalid_argument(ss.str());
+  }
+  }
+  if (madvise(emb->m_mapPointer, emb->get_map_size(), posix_advice) == -1) {
+    stringstream ss;
+    ss << "failed to advise the memory map of file \"" << emb->m_filename << "\"";
+    throw runtime_error(ss.str());
+  }
+#endif
+}
+
+void dynd::memmap_memory_block_flush(memory_block_data *memblock)
+{
+  memmap_memory_block *emb = get_memmap_memory_block(memblock);
+  if (emb->m_mapPointer == NULL || (emb->m_access & nd::write_access_flag) == 0) {
+    return;
+  }
+#ifdef WIN32
+  if (!FlushViewOfFile(emb->m_mapPointer, emb->get_map_size()) || !FlushFileBuffers(emb->m_hFile)) {
+#else
+  if (msync(emb->m_mapPointer, emb->get_map_size(), MS_SYNC) == -1) {
+#endif
+    stringstream ss;
+    ss << "failed to flush the memory map of file \"" << emb->m_filename << "\"";
+    throw runtime_error(ss.str());
+  }
+}
+
 void dynd::memmap_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                            const std::string &indent)
 {
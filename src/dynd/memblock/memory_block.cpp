@@ -235,8 +235,9 @@ memory_block_data::api *memory_block_data::get_api()
 {
   switch (m_type) {
   case pod_memory_block_type:
-  case zeroinit_memory_block_type:
     return &detail::pod_memory_block_allocator_api;
+  case zeroinit_memory_block_type:
+    return &detail::zeroinit_memory_block_allocator_api;
   case objectarray_memory_block_type:
     return &detail::objectarray_memory_block_allocator_api;
   default:
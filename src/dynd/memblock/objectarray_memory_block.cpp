@@ -126,12 +126,14 @@ namespace detail {
 
     if (mc->capacity_count - previous_index < count) {
       emb->append_memory(max(emb->m_total_allocated_count, count));
+      // Appending may have moved the chunks, so look up the old one again
+      mc = &emb->m_memory_handles[emb->m_memory_handles.size() - 2];
       memory_chunk *new_mc = &emb->m_memory_handles.back();
       // Move the old memory to the newly allocated block
       if (previous_count > 0) {
         // Subtract the previously used memory from the old chunk's count
         mc->used_count -= previous_count;
-        memcpy(new_mc->memory, previous_allocated, previous_count);
+        memcpy(new_mc->memory, previous_allocated, emb->m_stride * previous_count);
         // If the old memory only had the memory being resized,
         // free it completely.
         if (previous_allocated == mc->memory) {
@@ -160,7 +162,7 @@ namespace detail {
       // Zero-init the new memory
       intptr_t new_count = count - (intptr_t)previous_count;
       if (new_count > 0) {
-        memset(mc->memory + emb->m_stride * previous_count, 0, emb->m_stride * new_count);
+        memset(result + emb->m_stride * previous_count, 0, emb->m_stride * new_count);
       }
     } else {
       // TODO: Add a default data constructor to base_type
@@ -185,21 +187,25 @@ namespace detail {
     // Resets the POD memory so it can reuse it from the start
     objectarray_memory_block *emb = reinterpret_cast<objectarray_memory_block *>(self);
 
+    const char *element_arrmeta = emb->m_arrmeta + emb->arrmeta_size;
     if (emb->m_memory_handles.size() > 1) {
       // If there are more than one allocated memory chunks,
       // throw them all away except the last
       for (size_t i = 0, i_end = emb->m_memory_handles.size() - 1; i != i_end; ++i) {
         memory_chunk &mc = emb->m_memory_handles[i];
-        emb->m_dt.extended()->data_destruct_strided(emb->m_arrmeta, mc.memory, emb->m_stride, mc.used_count);
+        emb->m_dt.extended()->data_destruct_strided(element_arrmeta, mc.memory, emb->m_stride, mc.used_count);
         free(mc.memory);
       }
       emb->m_memory_handles.front() = emb->m_memory_handles.back();
       emb->m_memory_handles.resize(1);
-      // Reset to zero used elements in the chunk
-      memory_chunk &mc = emb->m_memory_handles.front();
-      emb->m_dt.extended()->data_destruct_strided(emb->m_arrmeta, mc.memory, emb->m_stride, mc.used_count);
-      mc.used_count = 0;
     }
+
+    // Reset to zero used elements in the chunk
+    memory_chunk &mc = emb->m_memory_handles.front();
+    emb->m_dt.extended()->data_destruct_strided(element_arrmeta, mc.memory, emb->m_stride, mc.used_count);
+    mc.used_count = 0;
+    emb->m_total_allocated_count = mc.capacity_count;
+    emb->m_finalized = false;
   }
 
   memory_block_data::api objectarray_memory_block_allocator_api = {&allocate, &resize, &finalize, &reset};
@@ -125,7 +125,7 @@ namespace detail {
       // Allocate memory to double the amount used so far, or the requested size, whichever is larger
       // NOTE: We're assuming malloc produces memory which has good enough alignment for anything
       emb->append_memory(max(emb->m_total_allocated_capacity, size_bytes));
-      memcpy(emb->m_memory_begin, inout_begin, *inout_end - inout_begin);
+      memcpy(emb->m_memory_begin, old_current, old_end - old_current);
       end = emb->m_memory_begin + size_bytes;
       emb->m_memory_current = end;
       inout_begin = emb->m_memory_begin;
@@ -130,9 +130,8 @@ namespace detail {
     char **inout_end = &emb->m_memory_current;
     char *end = inout_begin + size_bytes;
     if (end <= emb->m_memory_end) {
-      // If it fits, just adjust the current allocation point
-      emb->m_memory_current = end;
-      // Zero-initialize any newly allocated memory
+      // If it fits, just adjust the current allocation point, zero-initializing
+      // any newly allocated memory
       if (end > *inout_end) {
         memset(*inout_end, 0, end - *inout_end);
       }
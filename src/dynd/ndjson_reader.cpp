@@ -0,0 +1,252 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
+#include <dynd/ndjson_reader.hpp>
+#include <dynd/thread_pool.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+// The input is read this many bytes at a time
+static const size_t ndjson_read_size = 1 << 20;
+
+struct ndjson_line {
+  // Offsets of the line in the reader's text, without the '\n'
+  size_t begin, end;
+  int64 number;
+};
+} // anonymous namespace
+
+struct ndjson_reader::batch {
+  nd::array buffer;
+  // Whether the buffer has been parsed into, so its memory blocks need a reset
+  bool used;
+  std::vector<ndjson_line> lines;
+  intptr_t count;
+  // The message of the error which stopped the parse of this batch, if any
+  std::string error;
+  json_structural_index index;
+
+  batch() : used(false), count(0)
+  {
+  }
+};
+
+ndjson_reader::ndjson_reader(const ndt::type &tp, std::istream &in, intptr_t batch_size,
+                             const eval::eval_context *ectx)
+    : m_ectx(ectx), m_stream(&in), m_fd(-1)
+{
+  init(tp, batch_size);
+}
+
+ndjson_reader::ndjson_reader(const ndt::type &tp, int fd, intptr_t batch_size, const eval::eval_context *ectx)
+    : m_ectx(ectx), m_stream(NULL), m_fd(fd)
+{
+  init(tp, batch_size);
+}
+
+ndjson_reader::~ndjson_reader()
+{
+  for (size_t i = 0; i < m_batches.size(); ++i) {
+    delete m_batches[i];
+  }
+}
+
+void ndjson_reader::init(const ndt::type &tp, intptr_t batch_size)
+{
+  if (batch_size <= 0) {
+    stringstream ss;
+    ss << "ndjson_reader: the batch size must be positive, not " << batch_size;
+    throw invalid_argument(ss.str());
+  }
+  if (tp.get_type_id() != var_dim_type_id) {
+    stringstream ss;
+    ss << "ndjson_reader: the type of NDJSON must be a var dimension of the records, not " << tp;
+    throw type_error(ss.str());
+  }
+  m_element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+  if (m_element_tp.is_symbolic()) {
+    stringstream ss;
+    ss << "ndjson_reader: cannot read records of symbolic type " << m_element_tp;
+    throw type_error(ss.str());
+  }
+  m_batch_size = batch_size;
+  m_eof = false;
+  m_text_begin = 0;
+  m_text_end = 0;
+  m_line = 0;
+  m_batch_count = 0;
+  m_batch_next = 0;
+
+  int nbatches = m_ectx->nthreads > 1 ? m_ectx->nthreads : 1;
+  ndt::type buffer_tp = ndt::make_fixed_dim(batch_size, m_element_tp);
+  m_batches.reserve(nbatches);
+  for (int i = 0; i < nbatches; ++i) {
+    m_batches.push_back(new batch());
+    m_batches.back()->buffer = nd::empty(buffer_tp);
+  }
+}
+
+size_t ndjson_reader::read_some(char *out, size_t size)
+{
+  if (m_stream != NULL) {
+    m_stream->read(out, size);
+    if (m_stream->bad()) {
+      throw runtime_error("ndjson_reader: error reading from the input stream");
+    }
+    return static_cast<size_t>(m_stream->gcount());
+  }
+
+  for (;;) {
+#ifdef WIN32
+    int n = _read(m_fd, out, static_cast<unsigned int>(size));
+#else
+    ssize_t n = ::read(m_fd, out, size);
+#endif
+    if (n >= 0) {
+      return static_cast<size_t>(n);
+    } else if (errno != EINTR) {
+      stringstream ss;
+      ss << "ndjson_reader: error reading from file descriptor " << m_fd << ": " << strerror(errno);
+      throw runtime_error(ss.str());
+    }
+  }
+}
+
+bool ndjson_reader::read_lines(batch &b)
+{
+  b.lines.clear();
+  while (static_cast<intptr_t>(b.lines.size()) < m_batch_size) {
+    const char *text = m_text.data();
+    const char *line_end = NULL;
+    if (m_text_begin < m_text_end) {
+      line_end = reinterpret_cast<const char *>(memchr(text + m_text_begin, '\n', m_text_end - m_text_begin));
+    }
+    size_t end;
+    if (line_end != NULL) {
+      end = line_end - text;
+    } else if (!m_eof) {
+      // Read more text after the partial line
+      if (m_text.size() - m_text_end < ndjson_read_size) {
+        m_text.resize(max(2 * m_text.size(), m_text_end + ndjson_read_size));
+      }
+      size_t n = read_some(&m_text[m_text_end], m_text.size() - m_text_end);
+      if (n == 0) {
+        m_eof = true;
+      }
+      m_text_end += n;
+      continue;
+    } else if (m_text_begin < m_text_end) {
+      // The last line, without a '\n'
+      end = m_text_end;
+    } else {
+      break;
+    }
+
+    // Keep the line if it isn't blank
+    ++m_line;
+    for (size_t i = m_text_begin; i != end; ++i) {
+      char c = text[i];
+      if (c != ' ' && (c < '\t' || c > '\r')) {
+        ndjson_line line = {m_text_begin, end, m_line};
+        b.lines.push_back(line);
+        break;
+      }
+    }
+    m_text_begin = end < m_text_end ? end + 1 : end;
+  }
+
+  return !b.lines.empty();
+}
+
+void ndjson_reader::fill()
+{
+  // Move the text which is left over from the last fill to the front
+  if (m_text_begin > 0) {
+    memmove(&m_text[0], &m_text[m_text_begin], m_text_end - m_text_begin);
+    m_text_end -= m_text_begin;
+    m_text_begin = 0;
+  }
+
+  m_batch_count = 0;
+  m_batch_next = 0;
+  while (m_batch_count < m_batches.size() && read_lines(*m_batches[m_batch_count])) {
+    ++m_batch_count;
+  }
+
+  // The text doesn't move from here on, so the batches can share it
+  const char *text = m_text.data();
+  auto parse_batch = [this, text](intptr_t i) {
+    batch &b = *m_batches[i];
+    b.count = 0;
+    b.error.clear();
+    char *arrmeta = b.buffer.get()->metadata();
+    if (b.used) {
+      // Reuse the memory of the var dims from the previous batch
+      b.buffer.get_type().extended()->arrmeta_reset_buffers(arrmeta);
+    }
+    b.used = true;
+
+    intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta)->stride;
+    const char *element_arrmeta = arrmeta + sizeof(fixed_dim_type_arrmeta);
+    char *data = b.buffer.data();
+    for (size_t j = 0; j < b.lines.size(); ++j) {
+      const ndjson_line &line = b.lines[j];
+      try
+      {
+        parse_json(m_element_tp, element_arrmeta, data + j * stride, text + line.begin, text + line.end, &b.index,
+                   m_ectx);
+      }
+      catch (const invalid_argument &e)
+      {
+        stringstream ss;
+        ss << "Error parsing NDJSON record on line " << line.number << "\n" << e.what();
+        b.error = ss.str();
+        return;
+      }
+    }
+    b.count = b.lines.size();
+  };
+
+  if (m_batch_count > 1) {
+    thread_pool::get().run(m_batch_count, parse_batch);
+  } else if (m_batch_count == 1) {
+    parse_batch(0);
+  }
+}
+
+bool ndjson_reader::next(nd::array &out)
+{
+  if (m_batch_next == m_batch_count) {
+    fill();
+    if (m_batch_count == 0) {
+      out = nd::array();
+      return false;
+    }
+  }
+
+  batch &b = *m_batches[m_batch_next++];
+  if (!b.error.empty()) {
+    throw invalid_argument(b.error);
+  }
+  out = b.buffer(irange(0, b.count));
+  return true;
+}
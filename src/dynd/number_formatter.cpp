@@ -0,0 +1,508 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/number_formatter.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const char digit_pairs[201] = "00010203040506070809"
+                              "10111213141516171819"
+                              "20212223242526272829"
+                              "30313233343536373839"
+                              "40414243444546474849"
+                              "50515253545556575859"
+                              "60616263646566676869"
+                              "70717273747576777879"
+                              "80818283848586878889"
+                              "90919293949596979899";
+
+int count_digits(uint64 value)
+{
+  int n = 1;
+  for (;;) {
+    if (value < 10) {
+      return n;
+    } else if (value < 100) {
+      return n + 1;
+    } else if (value < 1000) {
+      return n + 2;
+    } else if (value < 10000) {
+      return n + 3;
+    }
+    value /= 10000;
+    n += 4;
+  }
+}
+
+/////////////////////////////////////////
+// Grisu2, following "Printing Floating-Point Numbers Quickly and Accurately
+// with Integers" by Florian Loitsch. The result always parses back to the
+// input, and is the shortest such string in all but a tiny fraction of
+// cases, where it has one more digit.
+
+/** A floating point value f * 2^e with a 64 bit significand */
+struct diy_fp {
+  uint64 f;
+  int e;
+
+  diy_fp(uint64 f, int e) : f(f), e(e)
+  {
+  }
+
+  static diy_fp sub(const diy_fp &x, const diy_fp &y)
+  {
+    return diy_fp(x.f - y.f, x.e);
+  }
+
+  /** The product, rounded to its high 64 bits */
+  static diy_fp mul(const diy_fp &x, const diy_fp &y)
+  {
+    uint64 u_lo = x.f & 0xffffffffu, u_hi = x.f >> 32;
+    uint64 v_lo = y.f & 0xffffffffu, v_hi = y.f >> 32;
+    uint64 p0 = u_lo * v_lo, p1 = u_lo * v_hi, p2 = u_hi * v_lo, p3 = u_hi * v_hi;
+    uint64 q = (p0 >> 32) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu);
+    // Round, ties up
+    q += uint64(1) << 31;
+    return diy_fp(p3 + (p2 >> 32) + (p1 >> 32) + (q >> 32), x.e + y.e + 64);
+  }
+
+  static diy_fp normalize(diy_fp x)
+  {
+    while ((x.f >> 63) == 0) {
+      x.f <<= 1;
+      --x.e;
+    }
+    return x;
+  }
+};
+
+/**
+ * The value v and the boundaries m- and m+ of the interval of reals which
+ * round to it, normalized to a common exponent.
+ */
+struct boundaries {
+  diy_fp w, minus, plus;
+};
+
+/**
+ * Computes the boundaries of a binary floating point value with the given
+ * biased exponent and stored fraction bits, for a format with ``precision``
+ * significand bits, including the hidden bit, and exponent bias ``bias``.
+ */
+boundaries compute_boundaries(uint64 fraction, int biased_exponent, int precision, int bias)
+{
+  const uint64 hidden_bit = uint64(1) << (precision - 1);
+  const int exponent_bias = bias + precision - 1;
+
+  diy_fp v = (biased_exponent == 0) ? diy_fp(fraction, 1 - exponent_bias)
+                                    : diy_fp(fraction + hidden_bit, biased_exponent - exponent_bias);
+  // The lower boundary is closer when v is a power of two, except for the
+  // smallest normal value
+  bool lower_boundary_is_closer = (fraction == 0 && biased_exponent > 1);
+
+  diy_fp m_plus(2 * v.f + 1, v.e - 1);
+  diy_fp m_minus = lower_boundary_is_closer ? diy_fp(4 * v.f - 1, v.e - 2) : diy_fp(2 * v.f - 1, v.e - 1);
+
+  boundaries result = {diy_fp::normalize(v), diy_fp(0, 0), diy_fp::normalize(m_plus)};
+  result.minus = diy_fp(m_minus.f << (m_minus.e - result.plus.e), result.plus.e);
+  return result;
+}
+
+// The range of binary exponents the scaled values are put in
+const int grisu_alpha = -60;
+
+struct cached_power {
+  uint64 f;
+  int e;
+  int k;
+};
+
+/**
+ * Returns a power of ten c = 10^k, normalized, such that
+ * alpha <= e_c + e + 64 <= gamma.
+ */
+cached_power get_cached_power_for_binary_exponent(int e)
+{
+  // The normalized powers 10^k for k = -300, -292, ..., 324
+  static const cached_power cached_powers[] = {
+      {0xAB70FE17C79AC6CAULL, -1060, -300},
+      {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+      {0xBE5691EF416BD60CULL, -1007, -284},
+      {0x8DD01FAD907FFC3CULL, -980, -276},
+      {0xD3515C2831559A83ULL, -954, -268},
+      {0x9D71AC8FADA6C9B5ULL, -927, -260},
+      {0xEA9C227723EE8BCBULL, -901, -252},
+      {0xAECC49914078536DULL, -874, -244},
+      {0x823C12795DB6CE57ULL, -847, -236},
+      {0xC21094364DFB5637ULL, -821, -228},
+      {0x9096EA6F3848984FULL, -794, -220},
+      {0xD77485CB25823AC7ULL, -768, -212},
+      {0xA086CFCD97BF97F4ULL, -741, -204},
+      {0xEF340A98172AACE5ULL, -715, -196},
+      {0xB23867FB2A35B28EULL, -688, -188},
+      {0x84C8D4DFD2C63F3BULL, -661, -180},
+      {0xC5DD44271AD3CDBAULL, -635, -172},
+      {0x936B9FCEBB25C996ULL, -608, -164},
+      {0xDBAC6C247D62A584ULL, -582, -156},
+      {0xA3AB66580D5FDAF6ULL, -555, -148},
+      {0xF3E2F893DEC3F126ULL, -529, -140},
+      {0xB5B5ADA8AAFF80B8ULL, -502, -132},
+      {0x87625F056C7C4A8BULL, -475, -124},
+      {0xC9BCFF6034C13053ULL, -449, -116},
+      {0x964E858C91BA2655ULL, -422, -108},
+      {0xDFF9772470297EBDULL, -396, -100},
+      {0xA6DFBD9FB8E5B88FULL, -369, -92},
+      {0xF8A95FCF88747D94ULL, -343, -84},
+      {0xB94470938FA89BCFULL, -316, -76},
+      {0x8A08F0F8BF0F156BULL, -289, -68},
+      {0xCDB02555653131B6ULL, -263, -60},
+      {0x993FE2C6D07B7FACULL, -236, -52},
+      {0xE45C10C42A2B3B06ULL, -210, -44},
+      {0xAA242499697392D3ULL, -183, -36},
+      {0xFD87B5F28300CA0EULL, -157, -28},
+      {0xBCE5086492111AEBULL, -130, -20},
+      {0x8CBCCC096F5088CCULL, -103, -12},
+      {0xD1B71758E219652CULL, -77, -4},
+      {0x9C40000000000000ULL, -50, 4},
+      {0xE8D4A51000000000ULL, -24, 12},
+      {0xAD78EBC5AC620000ULL, 3, 20},
+      {0x813F3978F8940984ULL, 30, 28},
+      {0xC097CE7BC90715B3ULL, 56, 36},
+      {0x8F7E32CE7BEA5C70ULL, 83, 44},
+      {0xD5D238A4ABE98068ULL, 109, 52},
+      {0x9F4F2726179A2245ULL, 136, 60},
+      {0xED63A231D4C4FB27ULL, 162, 68},
+      {0xB0DE65388CC8ADA8ULL, 189, 76},
+      {0x83C7088E1AAB65DBULL, 216, 84},
+      {0xC45D1DF942711D9AULL, 242, 92},
+      {0x924D692CA61BE758ULL, 269, 100},
+      {0xDA01EE641A708DEAULL, 295, 108},
+      {0xA26DA3999AEF774AULL, 322, 116},
+      {0xF209787BB47D6B85ULL, 348, 124},
+      {0xB454E4A179DD1877ULL, 375, 132},
+      {0x865B86925B9BC5C2ULL, 402, 140},
+      {0xC83553C5C8965D3DULL, 428, 148},
+      {0x952AB45CFA97A0B3ULL, 455, 156},
+      {0xDE469FBD99A05FE3ULL, 481, 164},
+      {0xA59BC234DB398C25ULL, 508, 172},
+      {0xF6C69A72A3989F5CULL, 534, 180},
+      {0xB7DCBF5354E9BECEULL, 561, 188},
+      {0x88FCF317F22241E2ULL, 588, 196},
+      {0xCC20CE9BD35C78A5ULL, 614, 204},
+      {0x98165AF37B2153DFULL, 641, 212},
+      {0xE2A0B5DC971F303AULL, 667, 220},
+      {0xA8D9D1535CE3B396ULL, 694, 228},
+      {0xFB9B7CD9A4A7443CULL, 720, 236},
+      {0xBB764C4CA7A44410ULL, 747, 244},
+      {0x8BAB8EEFB6409C1AULL, 774, 252},
+      {0xD01FEF10A657842CULL, 800, 260},
+      {0x9B10A4E5E9913129ULL, 827, 268},
+      {0xE7109BFBA19C0C9DULL, 853, 276},
+      {0xAC2820D9623BF429ULL, 880, 284},
+      {0x80444B5E7AA7CF85ULL, 907, 292},
+      {0xBF21E44003ACDD2DULL, 933, 300},
+      {0x8E679C2F5E44FF8FULL, 960, 308},
+      {0xD433179D9C8CB841ULL, 986, 316},
+      {0x9E19DB92B4E31BA9ULL, 1013, 324}  };
+  const int cached_powers_min_decimal_exponent = -300;
+  const int cached_powers_decimal_step = 8;
+
+  // k = ceil((alpha - e - 1) * log10(2)), with log10(2) in 14.18 fixed point
+  int f = grisu_alpha - e - 1;
+  int k = (f * 78913) / (1 << 18) + (f > 0);
+  int index = (-cached_powers_min_decimal_exponent + k + (cached_powers_decimal_step - 1)) / cached_powers_decimal_step;
+  return cached_powers[index];
+}
+
+/** The largest power of ten at most ``n``, and its number of digits */
+int find_largest_pow10(uint32 n, uint32 &out_pow10)
+{
+  static const uint32 powers[] = {1,      10,      100,      1000,      10000,
+                                  100000, 1000000, 10000000, 100000000, 1000000000};
+  int k = 9;
+  while (k > 0 && n < powers[k]) {
+    --k;
+  }
+  out_pow10 = powers[k];
+  return k + 1;
+}
+
+/** Moves the last digit towards w, while the digits stay inside the interval */
+void grisu2_round(char *buf, int len, uint64 dist, uint64 delta, uint64 rest, uint64 ten_k)
+{
+  while (rest < dist && delta - rest >= ten_k && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+    --buf[len - 1];
+    rest += ten_k;
+  }
+}
+
+/**
+ * Generates the shortest digits of a number in [M-, M+], as close to w as
+ * it can, into ``buffer``, with the value being digits * 10^decimal_exponent.
+ */
+void grisu2_digit_gen(char *buffer, int &length, int &decimal_exponent, diy_fp m_minus, diy_fp w, diy_fp m_plus)
+{
+  uint64 delta = diy_fp::sub(m_plus, m_minus).f;
+  uint64 dist = diy_fp::sub(m_plus, w).f;
+
+  // Split M+ into integral and fractional parts at the binary point
+  diy_fp one(uint64(1) << -m_plus.e, m_plus.e);
+  uint32 p1 = static_cast<uint32>(m_plus.f >> -one.e);
+  uint64 p2 = m_plus.f & (one.f - 1);
+
+  uint32 pow10;
+  int n = find_largest_pow10(p1, pow10);
+  while (n > 0) {
+    buffer[length++] = static_cast<char>('0' + p1 / pow10);
+    p1 %= pow10;
+    --n;
+
+    uint64 rest = (uint64(p1) << -one.e) + p2;
+    if (rest <= delta) {
+      decimal_exponent += n;
+      grisu2_round(buffer, length, dist, delta, rest, uint64(pow10) << -one.e);
+      return;
+    }
+    pow10 /= 10;
+  }
+
+  int m = 0;
+  for (;;) {
+    p2 *= 10;
+    buffer[length++] = static_cast<char>('0' + (p2 >> -one.e));
+    p2 &= one.f - 1;
+    ++m;
+    delta *= 10;
+    dist *= 10;
+    if (p2 <= delta) {
+      break;
+    }
+  }
+  decimal_exponent -= m;
+  grisu2_round(buffer, length, dist, delta, p2, one.f);
+}
+
+/** Generates the digits of a finite positive value, see grisu2_digit_gen */
+void grisu2(char *buffer, int &length, int &decimal_exponent, const boundaries &b)
+{
+  cached_power cached = get_cached_power_for_binary_exponent(b.plus.e);
+  diy_fp c_minus_k(cached.f, cached.e);
+
+  diy_fp w = diy_fp::mul(b.w, c_minus_k);
+  diy_fp w_minus = diy_fp::mul(b.minus, c_minus_k);
+  diy_fp w_plus = diy_fp::mul(b.plus, c_minus_k);
+
+  // Shrink the interval by one unit on each side for the rounding in mul
+  length = 0;
+  decimal_exponent = -cached.k;
+  grisu2_digit_gen(buffer, length, decimal_exponent, diy_fp(w_minus.f + 1, w_minus.e), w,
+                   diy_fp(w_plus.f - 1, w_plus.e));
+}
+
+char *append_exponent(char *out, int e)
+{
+  if (e < 0) {
+    *out++ = '-';
+    e = -e;
+  } else {
+    *out++ = '+';
+  }
+  if (e >= 100) {
+    *out++ = static_cast<char>('0' + e / 100);
+    e %= 100;
+  }
+  memcpy(out, digit_pairs + 2 * e, 2);
+  return out + 2;
+}
+
+/**
+ * Lays out the ``length`` digits in ``buffer``, worth
+ * digits * 10^decimal_exponent, like printf's %g with enough precision.
+ */
+char *format_digits(char *out, const char *digits, int length, int decimal_exponent)
+{
+  // The position of the decimal point relative to the start of the digits
+  int n = length + decimal_exponent;
+
+  if (length <= n && n <= 16) {
+    // dddd000
+    memcpy(out, digits, length);
+    memset(out + length, '0', n - length);
+    return out + n;
+  } else if (0 < n && n <= 16) {
+    // dd.dd
+    memcpy(out, digits, n);
+    out[n] = '.';
+    memcpy(out + n + 1, digits + n, length - n);
+    return out + length + 1;
+  } else if (-4 < n && n <= 0) {
+    // 0.000ddd
+    out[0] = '0';
+    out[1] = '.';
+    memset(out + 2, '0', -n);
+    memcpy(out + 2 - n, digits, length);
+    return out + 2 - n + length;
+  } else {
+    // d.ddde+xx
+    *out++ = digits[0];
+    if (length > 1) {
+      *out++ = '.';
+      memcpy(out, digits + 1, length - 1);
+      out += length - 1;
+    }
+    *out++ = 'e';
+    return append_exponent(out, n - 1);
+  }
+}
+
+/**
+ * Formats a binary floating point value from its parts. See
+ * compute_boundaries for the parameters.
+ */
+char *format_float(bool negative, uint64 fraction, int biased_exponent, int exponent_bits, int precision, int bias,
+                   char *out)
+{
+  if (biased_exponent == (1 << exponent_bits) - 1) {
+    if (fraction != 0) {
+      memcpy(out, "nan", 3);
+      return out + 3;
+    }
+    if (negative) {
+      *out++ = '-';
+    }
+    memcpy(out, "inf", 3);
+    return out + 3;
+  }
+
+  if (negative) {
+    *out++ = '-';
+  }
+  if (fraction == 0 && biased_exponent == 0) {
+    *out = '0';
+    return out + 1;
+  }
+
+  char digits[20];
+  int length, decimal_exponent;
+  grisu2(digits, length, decimal_exponent, compute_boundaries(fraction, biased_exponent, precision, bias));
+  return format_digits(out, digits, length, decimal_exponent);
+}
+
+} // anonymous namespace
+
+char *dynd::format_uint64(uint64 value, char *out)
+{
+  int ndigits = count_digits(value);
+  char *end = out + ndigits;
+  char *pos = end;
+  while (value >= 100) {
+    pos -= 2;
+    memcpy(pos, digit_pairs + 2 * (value % 100), 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    pos -= 2;
+    memcpy(pos, digit_pairs + 2 * value, 2);
+  } else {
+    *--pos = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+char *dynd::format_int64(int64 value, char *out)
+{
+  uint64 u = static_cast<uint64>(value);
+  if (value < 0) {
+    *out++ = '-';
+    u = 0 - u;
+  }
+  return format_uint64(u, out);
+}
+
+char *dynd::format_float64(double value, char *out)
+{
+  uint64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return format_float((bits >> 63) != 0, bits & ((uint64(1) << 52) - 1), static_cast<int>((bits >> 52) & 0x7ff), 11,
+                      53, 1023, out);
+}
+
+char *dynd::format_float32(float value, char *out)
+{
+  uint32 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return format_float((bits >> 31) != 0, bits & ((uint32(1) << 23) - 1), static_cast<int>((bits >> 23) & 0xff), 8,
+                      24, 127, out);
+}
+
+char *dynd::format_builtin_number(type_id_t type_id, const char *data, char *out)
+{
+  switch (type_id) {
+  case bool_type_id:
+    if (*data) {
+      memcpy(out, "True", 4);
+      return out + 4;
+    } else {
+      memcpy(out, "False", 5);
+      return out + 5;
+    }
+  case int8_type_id:
+    return format_int64(*reinterpret_cast<const int8 *>(data), out);
+  case int16_type_id: {
+    int16 value;
+    memcpy(&value, data, sizeof(value));
+    return format_int64(value, out);
+  }
+  case int32_type_id: {
+    int32 value;
+    memcpy(&value, data, sizeof(value));
+    return format_int64(value, out);
+  }
+  case int64_type_id: {
+    int64 value;
+    memcpy(&value, data, sizeof(value));
+    return format_int64(value, out);
+  }
+  case uint8_type_id:
+    return format_uint64(*reinterpret_cast<const uint8 *>(data), out);
+  case uint16_type_id: {
+    uint16 value;
+    memcpy(&value, data, sizeof(value));
+    return format_uint64(value, out);
+  }
+  case uint32_type_id: {
+    uint32 value;
+    memcpy(&value, data, sizeof(value));
+    return format_uint64(value, out);
+  }
+  case uint64_type_id: {
+    uint64 value;
+    memcpy(&value, data, sizeof(value));
+    return format_uint64(value, out);
+  }
+  case float16_type_id: {
+    uint16 bits;
+    memcpy(&bits, data, sizeof(bits));
+    return format_float((bits >> 15) != 0, bits & 0x3ff, (bits >> 10) & 0x1f, 5, 11, 15, out);
+  }
+  case float32_type_id: {
+    float value;
+    memcpy(&value, data, sizeof(value));
+    return format_float32(value, out);
+  }
+  case float64_type_id: {
+    double value;
+    memcpy(&value, data, sizeof(value));
+    return format_float64(value, out);
+  }
+  default:
+    return NULL;
+  }
+}
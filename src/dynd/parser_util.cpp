@@ -3,8 +3,10 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
-#include <string>
+#include <cfloat>
 #include <climits>
+#include <cstring>
+#include <string>
 
 #include <dynd/parser_util.hpp>
 #include <dynd/func/callable.hpp>
@@ -12,6 +14,8 @@
 #include <dynd/types/option_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 
+#include "power_of_five_table.hpp"
+
 using namespace std;
 using namespace dynd;
 
@@ -522,6 +526,195 @@ inline static double make_double_nan(bool negative)
   return nan.d;
 }
 
+namespace {
+
+/** The high and low 64 bits of the 128 bit product ``a * b`` */
+inline void full_multiply(uint64 a, uint64 b, uint64 &out_hi, uint64 &out_lo)
+{
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  out_hi = static_cast<uint64>(r >> 64);
+  out_lo = static_cast<uint64>(r);
+#else
+  uint64 a_lo = static_cast<uint32>(a), a_hi = a >> 32;
+  uint64 b_lo = static_cast<uint32>(b), b_hi = b >> 32;
+  uint64 lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi;
+  uint64 cross = (lo_lo >> 32) + static_cast<uint32>(hi_lo) + lo_hi;
+  out_hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+  out_lo = (cross << 32) | static_cast<uint32>(lo_lo);
+#endif
+}
+
+inline int leading_zeros(uint64 x)
+{
+  int n = 0;
+  while ((x & 0x8000000000000000ULL) == 0) {
+    x <<= 1;
+    ++n;
+  }
+  return n;
+}
+
+/**
+ * Splits a decimal number "123.456e7" into an integer significand of up to
+ * 19 digits and a power of ten. Returns false if the string isn't in this
+ * syntax, or if it has more significant digits than fit in the significand,
+ * so the caller must fall back to a slower conversion.
+ */
+bool parse_decimal_float(const char *begin, const char *end, uint64 &out_significand, int64_t &out_exponent)
+{
+  uint64 significand = 0;
+  int64_t exponent = 0;
+  int ndigits = 0;
+  bool any_digits = false;
+
+  const char *pos = begin;
+  for (; pos < end && '0' <= *pos && *pos <= '9'; ++pos) {
+    any_digits = true;
+    if (ndigits < 19) {
+      significand = significand * 10 + (*pos - '0');
+      ndigits += (significand != 0);
+    } else if (*pos != '0') {
+      return false;
+    } else {
+      ++exponent;
+    }
+  }
+  if (pos < end && *pos == '.') {
+    for (++pos; pos < end && '0' <= *pos && *pos <= '9'; ++pos) {
+      any_digits = true;
+      if (ndigits < 19) {
+        significand = significand * 10 + (*pos - '0');
+        ndigits += (significand != 0);
+        --exponent;
+      } else if (*pos != '0') {
+        return false;
+      }
+    }
+  }
+  if (!any_digits) {
+    return false;
+  }
+
+  if (pos < end && (*pos == 'e' || *pos == 'E')) {
+    ++pos;
+    bool negative_exponent = false;
+    if (pos < end && (*pos == '+' || *pos == '-')) {
+      negative_exponent = (*pos == '-');
+      ++pos;
+    }
+    if (pos == end || *pos < '0' || *pos > '9') {
+      return false;
+    }
+    int64_t e = 0;
+    for (; pos < end && '0' <= *pos && *pos <= '9'; ++pos) {
+      // Anything this large is zero or infinity anyway
+      if (e < 100000) {
+        e = e * 10 + (*pos - '0');
+      }
+    }
+    exponent += negative_exponent ? -e : e;
+  }
+
+  out_significand = significand;
+  out_exponent = exponent;
+  return pos == end;
+}
+
+/**
+ * Converts ``significand * 10^exponent`` to the nearest double. Exact
+ * products of small values are done with one floating point operation
+ * (Clinger's fast path), and the rest with the Eisel-Lemire algorithm,
+ * which multiplies by a 128 bit approximation of the power of five. In the
+ * rare case the approximation is too close to a rounding boundary, this
+ * returns false, and the caller must fall back to a slower conversion.
+ */
+bool decimal_to_float64(uint64 significand, int64_t exponent, double &out)
+{
+  static const double exact_powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                               1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                               1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const int mantissa_bits = 52, min_exponent = -1023, infinite_power = 0x7ff;
+
+  if (significand == 0 || exponent < detail::power_of_five_min_exponent) {
+    out = 0.0;
+    return true;
+  } else if (exponent > detail::power_of_five_max_exponent) {
+    out = numeric_limits<double>::infinity();
+    return true;
+  }
+
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+  if (-22 <= exponent && exponent <= 22 && significand <= (1ULL << 53)) {
+    out = static_cast<double>(significand);
+    out = exponent < 0 ? out / exact_powers_of_ten[-exponent] : out * exact_powers_of_ten[exponent];
+    return true;
+  }
+#endif
+
+  int q = static_cast<int>(exponent);
+  int lz = leading_zeros(significand);
+  uint64 w = significand << lz;
+
+  // The product with the high 64 bits of 5^q, refined with the low 64
+  // bits when the bits below the 55 we keep are all ones
+  int index = 2 * (q - detail::power_of_five_min_exponent);
+  uint64 hi, lo;
+  full_multiply(w, detail::power_of_five_128[index], hi, lo);
+  const uint64 precision_mask = 0xffffffffffffffffULL >> (mantissa_bits + 3);
+  if ((hi & precision_mask) == precision_mask) {
+    uint64 second_hi, second_lo;
+    full_multiply(w, detail::power_of_five_128[index + 1], second_hi, second_lo);
+    lo += second_hi;
+    if (second_hi > lo) {
+      ++hi;
+    }
+  }
+  if (lo == 0xffffffffffffffffULL && (q < -27 || q > 55)) {
+    return false;
+  }
+
+  int upperbit = static_cast<int>(hi >> 63);
+  uint64 mantissa = hi >> (upperbit + 64 - mantissa_bits - 3);
+  // floor(log2(10^q)) + 63, with floor(log2(10)) approximated in 16.16 fixed point
+  int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz - min_exponent;
+
+  if (power2 <= 0) {
+    // A subnormal, or zero
+    if (-power2 + 1 >= 64) {
+      out = 0.0;
+      return true;
+    }
+    mantissa >>= -power2 + 1;
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    power2 = (mantissa < (1ULL << mantissa_bits)) ? 0 : 1;
+  } else {
+    // Halfway cases only happen for these exponents, and round to even
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+        (mantissa << (upperbit + 64 - mantissa_bits - 3)) == hi) {
+      mantissa &= ~1ULL;
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << mantissa_bits)) {
+      mantissa = 1ULL << mantissa_bits;
+      ++power2;
+    }
+    mantissa &= ~(1ULL << mantissa_bits);
+    if (power2 >= infinite_power) {
+      out = numeric_limits<double>::infinity();
+      return true;
+    }
+  }
+
+  uint64 bits = mantissa | (static_cast<uint64>(power2) << mantissa_bits);
+  memcpy(&out, &bits, sizeof(double));
+  return true;
+}
+
+} // anonymous namespace
+
 double parse::checked_string_to_float64(const char *begin, const char *end, assign_error_mode errmode)
 {
   bool negative = false;
@@ -561,11 +754,29 @@ double parse::checked_string_to_float64(const char *begin, const char *end, assi
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  uint64 significand;
+  int64_t exponent;
+  double value;
+  if (parse_decimal_float(pos, end, significand, exponent) && decimal_to_float64(significand, exponent, value)) {
+    return negative ? -value : value;
+  }
+
+  // Everything else goes through strtod, which needs a NUL terminated copy.
+  // This includes the syntax it accepts beyond plain decimals.
+  char buffer[128];
+  std::string long_buffer;
+  const char *s = buffer;
+  size_t s_size = end - begin;
+  if (s_size < sizeof(buffer)) {
+    memcpy(buffer, begin, s_size);
+    buffer[s_size] = '\0';
+  } else {
+    long_buffer.assign(begin, end);
+    s = long_buffer.c_str();
+  }
   char *end_ptr;
-  std::string s(begin, end);
-  double value = strtod(s.c_str(), &end_ptr);
-  if (errmode != assign_error_nocheck && (size_t)(end_ptr - s.c_str()) != s.size()) {
+  value = strtod(s, &end_ptr);
+  if (errmode != assign_error_nocheck && (size_t)(end_ptr - s) != s_size) {
     stringstream ss;
     ss << "parse error converting string ";
     print_escaped_utf8_string(ss, begin, end);
@@ -0,0 +1,17 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <random>
+
+#include <dynd/random_engines.hpp>
+
+using namespace std;
+using namespace dynd;
+
+uint64 nd::random::make_seed()
+{
+  static thread_local xoshiro256starstar seeds((static_cast<uint64>(random_device()()) << 32) ^ random_device()());
+  return seeds();
+}
@@ -15,3 +15,10 @@ DYND_API nd::callable nd::sort::make()
 }
 
 DYND_API struct nd::sort nd::sort;
+
+DYND_API nd::callable nd::argsort::make()
+{
+  return callable::make<argsort_kernel>();
+}
+
+DYND_API struct nd::argsort nd::argsort;
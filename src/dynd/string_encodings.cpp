@@ -13,6 +13,11 @@
 
 #include <utf8.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_STRING_ENCODINGS_SSE2
+#endif
+
 using namespace std;
 using namespace dynd;
 
@@ -347,6 +352,329 @@ void noerror_append_utf32(uint32_t cp, char *&it_raw, char *DYND_UNUSED(end_raw)
   *it = cp;
   ++it;
 }
+
+// For the block transcoders, the decode_* functions read one valid code
+// point and the encode_* functions write one which fits. Where the
+// code point at a time functions would raise an error or substitute
+// a character, these return false and leave the iterator alone.
+inline bool decode_ascii(const char *&it, const char *DYND_UNUSED(end), uint32_t &cp)
+{
+  cp = *reinterpret_cast<const uint8_t *>(it);
+  if (cp & 0x80) {
+    return false;
+  }
+  ++it;
+  return true;
+}
+
+inline bool encode_ascii(uint32_t cp, char *&it, char *end)
+{
+  if ((cp & ~0x7f) != 0 || it == end) {
+    return false;
+  }
+  *it++ = static_cast<char>(cp);
+  return true;
+}
+
+inline bool decode_ucs2(const char *&it, const char *DYND_UNUSED(end), uint32_t &cp)
+{
+  cp = *reinterpret_cast<const uint16_t *>(it);
+  if (utf8::internal::is_surrogate(cp)) {
+    return false;
+  }
+  it += 2;
+  return true;
+}
+
+inline bool encode_ucs2(uint32_t cp, char *&it, char *end)
+{
+  if ((cp & ~0xffff) != 0 || end - it < 2) {
+    return false;
+  }
+  *reinterpret_cast<uint16_t *>(it) = static_cast<uint16_t>(cp);
+  it += 2;
+  return true;
+}
+
+inline bool decode_utf8(const char *&it, const char *end, uint32_t &cp)
+{
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(it);
+  intptr_t size = end - it;
+  uint32_t lead = p[0];
+  if (lead < 0x80) {
+    cp = lead;
+    it += 1;
+  } else if (lead < 0xc2) {
+    // A trail byte, or the lead of an overlong sequence
+    return false;
+  } else if (lead < 0xe0) {
+    if (size < 2 || (p[1] & 0xc0) != 0x80) {
+      return false;
+    }
+    cp = ((lead & 0x1f) << 6) | (p[1] & 0x3f);
+    it += 2;
+  } else if (lead < 0xf0) {
+    if (size < 3 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80) {
+      return false;
+    }
+    cp = ((lead & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+    if (cp < 0x800 || utf8::internal::is_surrogate(cp)) {
+      return false;
+    }
+    it += 3;
+  } else if (lead < 0xf5) {
+    if (size < 4 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80 || (p[3] & 0xc0) != 0x80) {
+      return false;
+    }
+    cp = ((lead & 0x07) << 18) | ((p[1] & 0x3f) << 12) | ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+    if (cp < 0x10000 || cp > 0x10ffff) {
+      return false;
+    }
+    it += 4;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+inline bool encode_utf8(uint32_t cp, char *&it, char *end)
+{
+  intptr_t size = end - it;
+  if (cp < 0x80) {
+    if (size < 1) {
+      return false;
+    }
+    it[0] = static_cast<char>(cp);
+    it += 1;
+  } else if (cp < 0x800) {
+    if (size < 2) {
+      return false;
+    }
+    it[0] = static_cast<char>(0xc0 | (cp >> 6));
+    it[1] = static_cast<char>(0x80 | (cp & 0x3f));
+    it += 2;
+  } else if (cp < 0x10000) {
+    if (size < 3) {
+      return false;
+    }
+    it[0] = static_cast<char>(0xe0 | (cp >> 12));
+    it[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+    it[2] = static_cast<char>(0x80 | (cp & 0x3f));
+    it += 3;
+  } else {
+    if (size < 4) {
+      return false;
+    }
+    it[0] = static_cast<char>(0xf0 | (cp >> 18));
+    it[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+    it[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+    it[3] = static_cast<char>(0x80 | (cp & 0x3f));
+    it += 4;
+  }
+  return true;
+}
+
+inline bool decode_utf16(const char *&it, const char *end, uint32_t &cp)
+{
+  cp = *reinterpret_cast<const uint16_t *>(it);
+  if (!utf8::internal::is_surrogate(cp)) {
+    it += 2;
+    return true;
+  }
+  if (!utf8::internal::is_lead_surrogate(cp) || end - it < 4) {
+    return false;
+  }
+  uint32_t trail_surrogate = *reinterpret_cast<const uint16_t *>(it + 2);
+  if (!utf8::internal::is_trail_surrogate(trail_surrogate)) {
+    return false;
+  }
+  cp = (cp << 10) + trail_surrogate + utf8::internal::SURROGATE_OFFSET;
+  it += 4;
+  return true;
+}
+
+inline bool encode_utf16(uint32_t cp, char *&it, char *end)
+{
+  uint16_t *out = reinterpret_cast<uint16_t *>(it);
+  if (cp < 0x10000) {
+    if (end - it < 2) {
+      return false;
+    }
+    out[0] = static_cast<uint16_t>(cp);
+    it += 2;
+  } else {
+    if (end - it < 4) {
+      return false;
+    }
+    out[0] = static_cast<uint16_t>((cp >> 10) + utf8::internal::LEAD_OFFSET);
+    out[1] = static_cast<uint16_t>((cp & 0x3ff) + utf8::internal::TRAIL_SURROGATE_MIN);
+    it += 4;
+  }
+  return true;
+}
+
+inline bool decode_utf32(const char *&it, const char *DYND_UNUSED(end), uint32_t &cp)
+{
+  cp = *reinterpret_cast<const uint32_t *>(it);
+  if (!utf8::internal::is_code_point_valid(cp)) {
+    return false;
+  }
+  it += 4;
+  return true;
+}
+
+inline bool encode_utf32(uint32_t cp, char *&it, char *end)
+{
+  if (end - it < 4) {
+    return false;
+  }
+  *reinterpret_cast<uint32_t *>(it) = cp;
+  it += 4;
+  return true;
+}
+
+template <string_encoding_t encoding>
+struct transcode_traits;
+
+#define DYND_TRANSCODE_TRAITS(ENCODING, NAME, UNIT_SIZE)                                                               \
+  template <>                                                                                                          \
+  struct transcode_traits<ENCODING> {                                                                                  \
+    static const int unit_size = UNIT_SIZE;                                                                            \
+    static bool decode(const char *&it, const char *end, uint32_t &cp)                                                 \
+    {                                                                                                                  \
+      return decode_##NAME(it, end, cp);                                                                               \
+    }                                                                                                                  \
+    static bool encode(uint32_t cp, char *&it, char *end)                                                              \
+    {                                                                                                                  \
+      return encode_##NAME(cp, it, end);                                                                               \
+    }                                                                                                                  \
+  };
+
+DYND_TRANSCODE_TRAITS(string_encoding_ascii, ascii, 1)
+DYND_TRANSCODE_TRAITS(string_encoding_ucs_2, ucs2, 2)
+DYND_TRANSCODE_TRAITS(string_encoding_utf_8, utf8, 1)
+DYND_TRANSCODE_TRAITS(string_encoding_utf_16, utf16, 2)
+DYND_TRANSCODE_TRAITS(string_encoding_utf_32, utf32, 4)
+
+#undef DYND_TRANSCODE_TRAITS
+
+#ifdef DYND_STRING_ENCODINGS_SSE2
+// Loads 16 code units as 16 bytes, returning false unless they are all
+// nonzero ASCII. Narrowing with saturation maps any unit which isn't to a
+// byte which is zero or has its high bit set.
+template <int unit_size>
+inline bool load_ascii_block(const char *src, __m128i &out);
+
+template <>
+inline bool load_ascii_block<1>(const char *src, __m128i &out)
+{
+  out = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+  return (_mm_movemask_epi8(out) | _mm_movemask_epi8(_mm_cmpeq_epi8(out, _mm_setzero_si128()))) == 0;
+}
+
+template <>
+inline bool load_ascii_block<2>(const char *src, __m128i &out)
+{
+  const __m128i *p = reinterpret_cast<const __m128i *>(src);
+  out = _mm_packus_epi16(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+  return (_mm_movemask_epi8(out) | _mm_movemask_epi8(_mm_cmpeq_epi8(out, _mm_setzero_si128()))) == 0;
+}
+
+template <>
+inline bool load_ascii_block<4>(const char *src, __m128i &out)
+{
+  const __m128i *p = reinterpret_cast<const __m128i *>(src);
+  out = _mm_packus_epi16(_mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+                         _mm_packs_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+  return (_mm_movemask_epi8(out) | _mm_movemask_epi8(_mm_cmpeq_epi8(out, _mm_setzero_si128()))) == 0;
+}
+
+// Stores 16 ASCII bytes as 16 code units
+template <int unit_size>
+inline void store_ascii_block(char *dst, __m128i v);
+
+template <>
+inline void store_ascii_block<1>(char *dst, __m128i v)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), v);
+}
+
+template <>
+inline void store_ascii_block<2>(char *dst, __m128i v)
+{
+  __m128i *p = reinterpret_cast<__m128i *>(dst);
+  const __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(p, _mm_unpacklo_epi8(v, zero));
+  _mm_storeu_si128(p + 1, _mm_unpackhi_epi8(v, zero));
+}
+
+template <>
+inline void store_ascii_block<4>(char *dst, __m128i v)
+{
+  __m128i *p = reinterpret_cast<__m128i *>(dst);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+  _mm_storeu_si128(p, _mm_unpacklo_epi16(lo, zero));
+  _mm_storeu_si128(p + 1, _mm_unpackhi_epi16(lo, zero));
+  _mm_storeu_si128(p + 2, _mm_unpacklo_epi16(hi, zero));
+  _mm_storeu_si128(p + 3, _mm_unpackhi_epi16(hi, zero));
+}
+#endif
+
+template <string_encoding_t src_encoding, string_encoding_t dst_encoding>
+void transcode_block(const char *&src, const char *src_end, char *&dst, char *dst_end)
+{
+  typedef transcode_traits<src_encoding> src_traits;
+  typedef transcode_traits<dst_encoding> dst_traits;
+  const char *s = src;
+  char *d = dst;
+  // Whether the last code point was ASCII, so a block of them may follow
+  bool ascii = true;
+  while (s < src_end) {
+#ifdef DYND_STRING_ENCODINGS_SSE2
+    if (ascii) {
+      __m128i v;
+      while (src_end - s >= 16 * src_traits::unit_size && dst_end - d >= 16 * dst_traits::unit_size &&
+             load_ascii_block<src_traits::unit_size>(s, v)) {
+        store_ascii_block<dst_traits::unit_size>(d, v);
+        s += 16 * src_traits::unit_size;
+        d += 16 * dst_traits::unit_size;
+      }
+      if (s == src_end) {
+        break;
+      }
+    }
+#endif
+    const char *next = s;
+    uint32_t cp;
+    if (!src_traits::decode(next, src_end, cp) || cp == 0 || !dst_traits::encode(cp, d, dst_end)) {
+      break;
+    }
+    s = next;
+    ascii = cp < 0x80;
+  }
+  src = s;
+  dst = d;
+}
+
+template <string_encoding_t src_encoding>
+transcode_block_t get_transcode_block_function_from(string_encoding_t dst_encoding)
+{
+  switch (dst_encoding) {
+  case string_encoding_ascii:
+    return &transcode_block<src_encoding, string_encoding_ascii>;
+  case string_encoding_ucs_2:
+    return &transcode_block<src_encoding, string_encoding_ucs_2>;
+  case string_encoding_utf_8:
+    return &transcode_block<src_encoding, string_encoding_utf_8>;
+  case string_encoding_utf_16:
+    return &transcode_block<src_encoding, string_encoding_utf_16>;
+  case string_encoding_utf_32:
+    return &transcode_block<src_encoding, string_encoding_utf_32>;
+  default:
+    return NULL;
+  }
+}
 } // anonymous namespace
 
 next_unicode_codepoint_t dynd::get_next_unicode_codepoint_function(string_encoding_t encoding,
@@ -387,14 +715,47 @@ append_unicode_codepoint_t dynd::get_append_unicode_codepoint_function(string_en
   }
 }
 
-template <next_unicode_codepoint_t next_fn>
+transcode_block_t dynd::get_transcode_block_function(string_encoding_t dst_encoding, string_encoding_t src_encoding)
+{
+  transcode_block_t result = NULL;
+  switch (src_encoding) {
+  case string_encoding_ascii:
+    result = get_transcode_block_function_from<string_encoding_ascii>(dst_encoding);
+    break;
+  case string_encoding_ucs_2:
+    result = get_transcode_block_function_from<string_encoding_ucs_2>(dst_encoding);
+    break;
+  case string_encoding_utf_8:
+    result = get_transcode_block_function_from<string_encoding_utf_8>(dst_encoding);
+    break;
+  case string_encoding_utf_16:
+    result = get_transcode_block_function_from<string_encoding_utf_16>(dst_encoding);
+    break;
+  case string_encoding_utf_32:
+    result = get_transcode_block_function_from<string_encoding_utf_32>(dst_encoding);
+    break;
+  default:
+    break;
+  }
+  if (result == NULL) {
+    throw runtime_error("get_transcode_block_function: Unrecognized string encoding");
+  }
+  return result;
+}
+
+template <string_encoding_t src_encoding, next_unicode_codepoint_t next_fn>
 std::string string_range_as_utf8_string_templ(const char *begin, const char *end)
 {
   std::string result;
-  uint32_t cp = 0;
+  char buf[256];
   while (begin < end) {
-    cp = next_fn(begin, end);
-    string_append_utf8(cp, result);
+    char *out = buf;
+    transcode_block<src_encoding, string_encoding_utf_8>(begin, end, out, buf + sizeof(buf));
+    result.append(buf, out);
+    // If it stopped with room to spare, the code point is zero or invalid
+    if (begin < end && buf + sizeof(buf) - out >= 4) {
+      string_append_utf8(next_fn(begin, end), result);
+    }
   }
   return result;
 }
@@ -409,22 +770,22 @@ std::string dynd::string_range_as_utf8_string(string_encoding_t encoding, const
     return std::string(begin, end);
   case string_encoding_ucs_2:
     if (errmode == assign_error_nocheck) {
-      return string_range_as_utf8_string_templ<&noerror_next_ucs2>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_ucs_2, &noerror_next_ucs2>(begin, end);
     } else {
-      return string_range_as_utf8_string_templ<&next_ucs2>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_ucs_2, &next_ucs2>(begin, end);
     }
   case string_encoding_utf_16: {
     if (errmode == assign_error_nocheck) {
-      return string_range_as_utf8_string_templ<&noerror_next_utf16>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_utf_16, &noerror_next_utf16>(begin, end);
     } else {
-      return string_range_as_utf8_string_templ<&next_utf16>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_utf_16, &next_utf16>(begin, end);
     }
   }
   case string_encoding_utf_32: {
     if (errmode == assign_error_nocheck) {
-      return string_range_as_utf8_string_templ<&noerror_next_utf32>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_utf_32, &noerror_next_utf32>(begin, end);
     } else {
-      return string_range_as_utf8_string_templ<&next_utf32>(begin, end);
+      return string_range_as_utf8_string_templ<string_encoding_utf_32, &next_utf32>(begin, end);
     }
   }
   default: {
@@ -0,0 +1,131 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <exception>
+
+#include <dynd/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+// Whether the current thread is one of the pool's workers
+thread_local bool in_worker = false;
+} // anonymous namespace
+
+struct thread_pool::job {
+  const std::function<void(intptr_t)> *func;
+  std::mutex mutex;
+  std::condition_variable done;
+  intptr_t remaining;
+  std::exception_ptr error;
+
+  job(const std::function<void(intptr_t)> &func, intptr_t remaining) : func(&func), remaining(remaining)
+  {
+  }
+
+  void finish(std::exception_ptr chunk_error)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (chunk_error && !error) {
+      error = chunk_error;
+    }
+    if (--remaining == 0) {
+      done.notify_all();
+    }
+  }
+};
+
+thread_pool::thread_pool() : m_stopping(false)
+{
+}
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_cond.notify_all();
+
+  for (std::thread &worker : m_workers) {
+    worker.join();
+  }
+}
+
+thread_pool &thread_pool::get()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+void thread_pool::run_chunk(job *j, intptr_t i)
+{
+  std::exception_ptr error;
+  try {
+    (*j->func)(i);
+  }
+  catch (...) {
+    error = std::current_exception();
+  }
+  j->finish(error);
+}
+
+void thread_pool::work()
+{
+  in_worker = true;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cond.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;
+    }
+
+    std::pair<job *, intptr_t> chunk = m_queue.front();
+    m_queue.pop_front();
+
+    lock.unlock();
+    run_chunk(chunk.first, chunk.second);
+    lock.lock();
+  }
+}
+
+void thread_pool::run(intptr_t nchunks, const std::function<void(intptr_t)> &func)
+{
+  if (nchunks <= 1 || in_worker) {
+    for (intptr_t i = 0; i < nchunks; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  job j(func, nchunks);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Start enough workers that every chunk but the caller's has one
+    while (static_cast<intptr_t>(m_workers.size()) < nchunks - 1) {
+      m_workers.emplace_back(&thread_pool::work, this);
+    }
+    for (intptr_t i = 1; i < nchunks; ++i) {
+      m_queue.emplace_back(&j, i);
+    }
+  }
+  m_cond.notify_all();
+
+  run_chunk(&j, 0);
+
+  std::unique_lock<std::mutex> lock(j.mutex);
+  j.done.wait(lock, [&j] { return j.remaining == 0; });
+  if (j.error) {
+    std::rethrow_exception(j.error);
+  }
+}
+
+intptr_t thread_pool::get_nworkers()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<intptr_t>(m_workers.size());
+}
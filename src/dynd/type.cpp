@@ -37,6 +37,8 @@
 #include <functional>
 #include <iterator>
 #include <iomanip>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dynd;
@@ -140,14 +142,56 @@ ndt::type ndt::type::instances[DYND_TYPE_ID_MAX + 1] = {
     make_type(),                                      // type_type_id
 };
 
+namespace {
+/**
+ * Types parsed from datashape strings, so that constructing a type from
+ * the same string again is a lookup. When it is full, it is emptied.
+ */
+struct datashape_cache {
+  static const size_t max_size = 4096;
+
+  std::mutex mutex;
+  std::unordered_map<std::string, ndt::type> types;
+};
+
+// Never destroyed, because types may be constructed during static destruction
+datashape_cache &get_datashape_cache()
+{
+  static datashape_cache *cache = new datashape_cache();
+  return *cache;
+}
+
+ndt::type cached_type_from_datashape(const char *rep_begin, const char *rep_end)
+{
+  datashape_cache &cache = get_datashape_cache();
+  std::string rep(rep_begin, rep_end);
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.types.find(rep);
+    if (it != cache.types.end()) {
+      return it->second;
+    }
+  }
+
+  // Parse without the lock, since parsing may construct other types from strings
+  ndt::type tp = type_from_datashape(rep_begin, rep_end);
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (cache.types.size() >= datashape_cache::max_size) {
+    cache.types.clear();
+  }
+  cache.types.insert(std::make_pair(std::move(rep), tp));
+  return tp;
+}
+} // anonymous namespace
+
 ndt::type::type(const std::string &rep) : m_extended(NULL)
 {
-  type_from_datashape(rep).swap(*this);
+  cached_type_from_datashape(rep.data(), rep.data() + rep.size()).swap(*this);
 }
 
 ndt::type::type(const char *rep_begin, const char *rep_end) : m_extended(NULL)
 {
-  type_from_datashape(rep_begin, rep_end).swap(*this);
+  cached_type_from_datashape(rep_begin, rep_end).swap(*this);
 }
 
 ndt::type ndt::type::at_array(int nindices, const irange *indices) const
@@ -164,7 +208,7 @@ ndt::type ndt::type::at_array(int nindices, const irange *indices) const
 }
 
 bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-                      std::map<std::string, ndt::type> &tp_vars) const
+                      small_map<std::string, ndt::type> &tp_vars) const
 {
   // A type being matched against itself works for both type id and more
   // complicated types
@@ -182,18 +226,18 @@ bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const
 
 bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta) const
 {
-  std::map<std::string, ndt::type> tp_vars;
+  small_map<std::string, ndt::type> tp_vars;
   return match(arrmeta, candidate_tp, candidate_arrmeta, tp_vars);
 }
 
-bool ndt::type::match(const ndt::type &candidate_tp, std::map<std::string, ndt::type> &tp_vars) const
+bool ndt::type::match(const ndt::type &candidate_tp, small_map<std::string, ndt::type> &tp_vars) const
 {
   return match(NULL, candidate_tp, NULL, tp_vars);
 }
 
 bool ndt::type::match(const ndt::type &candidate_tp) const
 {
-  std::map<std::string, ndt::type> tp_vars;
+  small_map<std::string, ndt::type> tp_vars;
   return match(candidate_tp, tp_vars);
 }
 
@@ -1034,36 +1078,79 @@ ndt::common_type::common_type()
   typedef type_id_sequence<int32_type_id, float64_type_id, int64_type_id, float32_type_id> I;
   for_each<typename outer<I, I>::type>(init());
 
-  typedef type_id_sequence<int32_type_id, float64_type_id, int64_type_id, float32_type_id, fixed_dim_type_id> J;
+  typedef type_id_sequence<int32_type_id, float64_type_id, int64_type_id, float32_type_id, bool_type_id,
+                           string_type_id, fixed_dim_type_id, var_dim_type_id, struct_type_id> J;
 
   for (type_id_t tp_id : i2a<J>()) {
     children[option_type_id][tp_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
-      return option_type::make(ndt::common_type(tp0.extended<option_type>()->get_value_type(), tp1));
+      ndt::type value_tp = ndt::common_type(tp0.extended<option_type>()->get_value_type(), tp1);
+      return value_tp.is_null() ? value_tp : option_type::make(value_tp);
     };
     children[tp_id][option_type_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
-      return option_type::make(ndt::common_type(tp0, tp1.extended<option_type>()->get_value_type()));
+      ndt::type value_tp = ndt::common_type(tp0, tp1.extended<option_type>()->get_value_type());
+      return value_tp.is_null() ? value_tp : option_type::make(value_tp);
     };
     children[any_kind_type_id][tp_id] = [](const ndt::type &DYND_UNUSED(tp0), const ndt::type & tp1) { return tp1; };
     children[tp_id][any_kind_type_id] = [](const ndt::type &tp0, const ndt::type &DYND_UNUSED(tp1)) { return tp0; };
   }
+  children[option_type_id][option_type_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
+    ndt::type value_tp = ndt::common_type(tp0.extended<option_type>()->get_value_type(),
+                                          tp1.extended<option_type>()->get_value_type());
+    return value_tp.is_null() ? value_tp : option_type::make(value_tp);
+  };
+  children[any_kind_type_id][option_type_id] = [](const ndt::type &DYND_UNUSED(tp0), const ndt::type &tp1) {
+    return tp1;
+  };
+  children[option_type_id][any_kind_type_id] = [](const ndt::type &tp0, const ndt::type &DYND_UNUSED(tp1)) {
+    return tp0;
+  };
   children[fixed_dim_type_id][fixed_dim_type_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
-    if (tp0.extended<fixed_dim_type>()->get_fixed_dim_size() != tp1.extended<fixed_dim_type>()->get_fixed_dim_size()) {
-      return ndt::var_dim_type::make(ndt::common_type(tp0.extended<fixed_dim_type>()->get_element_type(),
-                                                      tp1.extended<fixed_dim_type>()->get_element_type()));
+    ndt::type element_tp = ndt::common_type(tp0.extended<fixed_dim_type>()->get_element_type(),
+                                            tp1.extended<fixed_dim_type>()->get_element_type());
+    if (element_tp.is_null()) {
+      return element_tp;
+    } else if (tp0.extended<fixed_dim_type>()->get_fixed_dim_size() !=
+               tp1.extended<fixed_dim_type>()->get_fixed_dim_size()) {
+      return ndt::var_dim_type::make(element_tp);
     }
-    return ndt::make_fixed_dim(tp0.extended<fixed_dim_type>()->get_fixed_dim_size(),
-                               ndt::common_type(tp0.extended<fixed_dim_type>()->get_element_type(),
-                                                tp1.extended<fixed_dim_type>()->get_element_type()));
+    return ndt::make_fixed_dim(tp0.extended<fixed_dim_type>()->get_fixed_dim_size(), element_tp);
   };
   children[fixed_dim_type_id][var_dim_type_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
-    return ndt::var_dim_type::make(ndt::common_type(tp0.extended<fixed_dim_type>()->get_element_type(),
-                                                    tp1.extended<fixed_dim_type>()->get_element_type()));
+    ndt::type element_tp = ndt::common_type(tp0.extended<base_dim_type>()->get_element_type(),
+                                            tp1.extended<base_dim_type>()->get_element_type());
+    return element_tp.is_null() ? element_tp : ndt::var_dim_type::make(element_tp);
   };
   children[var_dim_type_id][fixed_dim_type_id] = children[fixed_dim_type_id][var_dim_type_id];
+  children[var_dim_type_id][var_dim_type_id] = children[fixed_dim_type_id][var_dim_type_id];
+  // Structs with the same field names have the common types of their fields
+  children[struct_type_id][struct_type_id] = [](const ndt::type &tp0, const ndt::type &tp1) {
+    const base_struct_type *sd0 = tp0.extended<base_struct_type>(), *sd1 = tp1.extended<base_struct_type>();
+    intptr_t field_count = sd0->get_field_count();
+    if (field_count != sd1->get_field_count()) {
+      return ndt::type();
+    }
+    std::vector<std::string> names(field_count);
+    std::vector<ndt::type> types(field_count);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      names[i] = sd0->get_field_name(i);
+      if (names[i] != sd1->get_field_name(i)) {
+        return ndt::type();
+      }
+      types[i] = ndt::common_type(sd0->get_field_type(i), sd1->get_field_type(i));
+      if (types[i].is_null()) {
+        return types[i];
+      }
+    }
+    return struct_type::make(names, types);
+  };
 }
 
 ndt::type ndt::common_type::operator()(const ndt::type &tp0, const ndt::type &tp1) const
 {
+  if (tp0 == tp1) {
+    return tp0;
+  }
+
   child_type child = children[tp0.get_type_id()][tp1.get_type_id()];
   if (child == NULL) {
     return type();
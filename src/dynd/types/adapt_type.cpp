@@ -108,7 +108,7 @@ size_t ndt::adapt_type::make_operand_to_value_assignment_kernel(
     return af->instantiate(af->static_data, 0, NULL, ckb, ckb_offset,
                            m_value_type, dst_arrmeta, -1, &m_operand_type,
                            &src_arrmeta, kernreq, ectx, 0, NULL,
-                           std::map<std::string, type>());
+                           small_map<std::string, type>());
   } else {
     stringstream ss;
     ss << "Cannot apply ";
@@ -128,7 +128,7 @@ size_t ndt::adapt_type::make_value_to_operand_assignment_kernel(
     return af->instantiate(af->static_data, 0, NULL, ckb, ckb_offset,
                            m_operand_type, src_arrmeta, -1, &m_value_type,
                            &dst_arrmeta, kernreq, ectx, 0, NULL,
-                           std::map<std::string, type>());
+                           small_map<std::string, type>());
   } else {
     stringstream ss;
     ss << "Cannot apply ";
@@ -16,9 +16,20 @@
 using namespace std;
 using namespace dynd;
 
+// FNV-1a, for the field name hash index
+static inline size_t hash_field_name(const char *begin, size_t size)
+{
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i != size; ++i) {
+    h = (h ^ static_cast<unsigned char>(begin[i])) * 16777619u;
+  }
+  return h;
+}
+
 ndt::base_struct_type::base_struct_type(type_id_t type_id, const nd::array &field_names, const nd::array &field_types,
                                         flags_type flags, bool layout_in_arrmeta, bool variadic)
-    : base_tuple_type(type_id, field_types, flags, layout_in_arrmeta, variadic), m_field_names(field_names)
+    : base_tuple_type(type_id, field_types, flags, layout_in_arrmeta, variadic), m_duplicate_field_names(false),
+      m_field_names(field_names)
 {
   /*
     if (!nd::ensure_immutable_contig<std::string>(m_field_names)) {
@@ -39,32 +50,57 @@ ndt::base_struct_type::base_struct_type(type_id_t type_id, const nd::array &fiel
   }
 
   m_members.kind = variadic ? kind_kind : struct_kind;
+
+  // Build the hash index of the names. If a name repeats, the index finds
+  // its first field, as a scan would.
+  size_t index_size = 4;
+  while (index_size < 2 * static_cast<size_t>(m_field_count)) {
+    index_size *= 2;
+  }
+  m_field_name_index.assign(index_size, -1);
+  size_t mask = index_size - 1;
+  for (intptr_t i = 0; i != m_field_count; ++i) {
+    const string &fn = get_field_name_raw(i);
+    if (find_field_index(fn.begin(), fn.size()) == -1) {
+      size_t slot = hash_field_name(fn.begin(), fn.size()) & mask;
+      while (m_field_name_index[slot] != -1) {
+        slot = (slot + 1) & mask;
+      }
+      m_field_name_index[slot] = i;
+    } else {
+      m_duplicate_field_names = true;
+    }
+  }
 }
 
 ndt::base_struct_type::~base_struct_type()
 {
 }
 
-intptr_t ndt::base_struct_type::get_field_index(const char *field_name_begin, const char *field_name_end) const
+intptr_t ndt::base_struct_type::find_field_index(const char *field_name_begin, size_t size) const
 {
-  size_t size = field_name_end - field_name_begin;
-  if (size > 0) {
-    char firstchar = *field_name_begin;
-    intptr_t field_count = get_field_count();
-    const char *fn_ptr = m_field_names.cdata();
-    intptr_t fn_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_field_names.get()->metadata())->stride;
-    for (intptr_t i = 0; i != field_count; ++i, fn_ptr += fn_stride) {
-      const string *fn = reinterpret_cast<const string *>(fn_ptr);
-      const char *begin = fn->begin(), *end = fn->end();
-      if ((size_t)(end - begin) == size && *begin == firstchar) {
-        if (memcmp(fn->begin(), field_name_begin, size) == 0) {
-          return i;
-        }
-      }
+  if (size == 0 || m_field_name_index.empty()) {
+    return -1;
+  }
+
+  size_t mask = m_field_name_index.size() - 1;
+  size_t slot = hash_field_name(field_name_begin, size) & mask;
+  for (;;) {
+    intptr_t i = m_field_name_index[slot];
+    if (i == -1) {
+      return -1;
     }
+    const string &fn = get_field_name_raw(i);
+    if (fn.size() == size && memcmp(fn.begin(), field_name_begin, size) == 0) {
+      return i;
+    }
+    slot = (slot + 1) & mask;
   }
+}
 
-  return -1;
+intptr_t ndt::base_struct_type::get_field_index(const char *field_name_begin, const char *field_name_end) const
+{
+  return find_field_index(field_name_begin, field_name_end - field_name_begin);
 }
 
 ndt::type ndt::base_struct_type::apply_linear_index(intptr_t nindices, const irange *indices, size_t current_i,
@@ -168,7 +204,7 @@ intptr_t ndt::base_struct_type::apply_linear_index(intptr_t nindices, const iran
 }
 
 bool ndt::base_struct_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                  std::map<std::string, type> &tp_vars) const
+                                  small_map<std::string, type> &tp_vars) const
 {
   intptr_t candidate_field_count = candidate_tp.extended<base_struct_type>()->get_field_count();
   bool candidate_variadic = candidate_tp.extended<base_tuple_type>()->is_variadic();
@@ -3,6 +3,9 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <mutex>
+#include <unordered_map>
+
 #include <dynd/type.hpp>
 #include <dynd/types/builtin_type_properties.hpp>
 #include <dynd/func/callable.hpp>
@@ -10,6 +13,93 @@
 using namespace std;
 using namespace dynd;
 
+namespace {
+/**
+ * The interned types, by hash. The table doesn't own references to them,
+ * a type removes itself when its use count reaches zero.
+ */
+struct type_intern_table {
+  std::mutex mutex;
+  std::unordered_multimap<size_t, const ndt::base_type *> types;
+  // Incremented by every insertion
+  uint64_t generation;
+
+  type_intern_table() : generation(0)
+  {
+  }
+};
+
+// Never destroyed, because types may be released during static destruction
+type_intern_table &get_type_intern_table()
+{
+  static type_intern_table *table = new type_intern_table();
+  return *table;
+}
+} // anonymous namespace
+
+const ndt::base_type *ndt::intern_type(const base_type *bd)
+{
+  type_intern_table &table = get_type_intern_table();
+  size_t hash = bd->compute_hash();
+  for (;;) {
+    // Take references to the candidates, so the comparisons, which may
+    // construct types, happen without the lock
+    std::vector<type> candidates;
+    uint64_t generation;
+    {
+      std::lock_guard<std::mutex> lock(table.mutex);
+      auto range = table.types.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        // A use count of zero means the type is being destroyed
+        if (atomic_increment_if_nonzero(it->second->m_use_count)) {
+          candidates.push_back(type(it->second, false));
+        }
+      }
+      generation = table.generation;
+    }
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const base_type *candidate = candidates[i].extended();
+      if (candidate->get_kind() == bd->get_kind() && *candidate == *bd && *bd == *candidate) {
+        base_type_decref(bd);
+        return candidates[i].release();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (table.generation == generation) {
+      const_cast<base_type *>(bd)->m_hash = hash;
+      const_cast<base_type *>(bd)->m_interned = true;
+      table.types.insert(std::make_pair(hash, bd));
+      ++table.generation;
+      return bd;
+    }
+    // Another type was interned in the meantime, which may be equal to this one
+  }
+}
+
+void ndt::detail::release_interned_type(const base_type *bd)
+{
+  type_intern_table &table = get_type_intern_table();
+  {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto range = table.types.equal_range(bd->get_hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == bd) {
+        table.types.erase(it);
+        break;
+      }
+    }
+  }
+  delete bd;
+}
+
+size_t ndt::base_type::compute_hash() const
+{
+  size_t result = detail::hash_combine(get_type_id(), get_kind());
+  return detail::hash_combine(result, get_data_size());
+}
+
 // Default destructor for the extended type does nothing
 ndt::base_type::~base_type()
 {
@@ -258,7 +348,7 @@ size_t ndt::base_type::make_comparison_kernel(void *DYND_UNUSED(ckb), intptr_t D
 
 bool ndt::base_type::match(const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
                            const char *DYND_UNUSED(candidate_arrmeta),
-                           std::map<std::string, type> &DYND_UNUSED(tp_vars)) const
+                           small_map<std::string, type> &DYND_UNUSED(tp_vars)) const
 {
   // The default match implementation is equality, pattern types
   // must override this virtual function.
@@ -86,7 +86,7 @@ bool ndt::byteswap_type::operator==(const base_type &rhs) const
     return false;
   } else {
     const byteswap_type *dt = static_cast<const byteswap_type *>(&rhs);
-    return m_value_type == dt->m_value_type;
+    return m_value_type == dt->m_value_type && m_operand_type == dt->m_operand_type;
   }
 }
 
@@ -9,6 +9,7 @@
 #include <dynd/ensure_immutable_contig.hpp>
 #include <dynd/types/typevar_type.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/func/bound_kernel.hpp>
 #include <dynd/kernels/expr_kernel_generator.hpp>
 #include <dynd/kernels/base_property_kernel.hpp>
 
@@ -197,6 +198,13 @@ bool ndt::callable_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::callable_type::compute_hash() const
+{
+  size_t result = detail::hash_combine(base_type::compute_hash(), m_return_type.get_hash());
+  result = detail::hash_combine(result, m_pos_tuple.get_hash());
+  return detail::hash_combine(result, m_kwd_struct.get_hash());
+}
+
 void ndt::callable_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta), bool DYND_UNUSED(blockref_alloc)) const
 {
 }
@@ -288,7 +296,7 @@ intptr_t ndt::callable_type::make_assignment_kernel(void *ckb, intptr_t ckb_offs
 }
 
 bool ndt::callable_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                               std::map<std::string, type> &tp_vars) const
+                               small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() != callable_type_id) {
     return false;
@@ -365,7 +373,7 @@ void ndt::callable_type::get_dynamic_type_properties(const std::pair<std::string
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = make_fixed_dim(tp.extended<callable_type>()->get_npos(), make_type());
@@ -387,7 +395,7 @@ void ndt::callable_type::get_dynamic_type_properties(const std::pair<std::string
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = make_fixed_dim(tp.extended<callable_type>()->get_nkwd(), make_type());
@@ -409,7 +417,7 @@ void ndt::callable_type::get_dynamic_type_properties(const std::pair<std::string
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<callable_type>()->get_kwd_names().get_type();
@@ -490,7 +498,7 @@ static array_preamble *function___call__(const array_preamble *params, void *DYN
   }
   ckernel_builder<kernel_request_host> ckb;
   af->instantiate(NULL, 0, NULL, &ckb, 0, args[0].get_type(), args[0].get()->metadata(), nargs, src_tp, dynd_arrmeta,
-                  kernel_request_single, &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                  kernel_request_single, &eval::default_eval_context, 0, NULL, small_map<std::string, ndt::type>());
   // Call the ckernel
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   char *in_ptrs[max_args];
@@ -517,12 +525,72 @@ void ndt::callable_type::get_dynamic_array_functions(const std::pair<std::string
   *out_count = sizeof(callable_array_functions) / sizeof(callable_array_functions[0]);
 }
 
+callable_type_data::~callable_type_data()
+{
+  delete cache;
+
+  // Call the static_data_free function, if it exists
+  if (static_data_free != NULL) {
+    static_data_free(static_data);
+  }
+  delete[] static_data;
+}
+
+void callable_type_data::set_cache_capacity(std::size_t capacity)
+{
+  delete cache;
+  cache = (capacity > 0) ? new nd::kernel_cache(capacity) : NULL;
+}
+
+/**
+ * Looks up (or binds and remembers) the ckernel for this call signature in
+ * the callable's kernel cache. Returns NULL when the call can't use a bound
+ * ckernel, in which case the caller instantiates one as usual.
+ */
+static std::unique_ptr<nd::bound_kernel>
+acquire_bound_kernel(callable_type_data &self, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                     const ndt::type *src_tp, const char *const *src_arrmeta, intptr_t nkwd, const nd::array *kwds,
+                     const small_map<std::string, ndt::type> &tp_vars, const eval::eval_context *ectx)
+{
+  if (!nd::bound_kernel::is_bindable(dst_tp, nsrc, src_tp, nkwd, kwds)) {
+    return std::unique_ptr<nd::bound_kernel>();
+  }
+
+  std::unique_ptr<nd::bound_kernel> k = self.cache->acquire(dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, nkwd,
+                                                            kwds, *ectx);
+  if (!k) {
+    k.reset(new nd::bound_kernel(self, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, nkwd, kwds, tp_vars, ectx));
+  }
+
+  if (!k->is_executable()) {
+    // Keep the entry so this signature isn't bound again
+    self.cache->release(std::move(k));
+  }
+
+  return k;
+}
+
 nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                                          const char *const *src_arrmeta, char *const *src_data, intptr_t nkwd,
-                                         const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
-{
+                                         const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars,
+                                         const eval::eval_context *ectx)
+{
+  if (cache != NULL) {
+    std::unique_ptr<nd::bound_kernel> k =
+        acquire_bound_kernel(*this, dst_tp, NULL, nsrc, src_tp, src_arrmeta, nkwd, kwds, tp_vars, ectx);
+    if (k) {
+      nd::array dst = nd::empty(k->get_dst_type());
+      if (k->matches_dst_arrmeta(dst.get()->metadata())) {
+        dst_tp = k->get_dst_type();
+        k->single(dst.data(), src_data);
+        cache->release(std::move(k));
+        return dst;
+      }
+    }
+  }
+
   // Allocate, then initialize, the data
-  std::unique_ptr<char[]> data(new char[data_size]);
+  std::unique_ptr<char[]> data((data_size > 0) ? new char[data_size] : NULL);
   if (data_size > 0) {
     data_init(static_data, data_size, data.get(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
   }
@@ -542,7 +610,7 @@ nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const
   // Generate and evaluate the ckernel
   ckernel_builder<kernel_request_host> ckb;
   instantiate(static_data, data_size, data.get(), &ckb, 0, dst_tp, dst.get()->metadata(), nsrc, src_tp, src_arrmeta,
-              kernel_request_single, &eval::default_eval_context, nkwd, kwds, tp_vars);
+              kernel_request_single, ectx, nkwd, kwds, tp_vars);
   expr_single_t fn = ckb.get()->get_function<expr_single_t>();
   fn(ckb.get(), dst.data(), src_data);
 
@@ -551,10 +619,11 @@ nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const
 
 nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                                          const char *const *src_arrmeta, nd::array *const *src_data, intptr_t nkwd,
-                                         const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                         const nd::array *kwds, const small_map<std::string, ndt::type> &tp_vars,
+                                         const eval::eval_context *ectx)
 {
   // Allocate, then initialize, the data
-  std::unique_ptr<char[]> data(new char[data_size]);
+  std::unique_ptr<char[]> data((data_size > 0) ? new char[data_size] : NULL);
   if (data_size > 0) {
     data_init(static_data, data_size, data.get(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
   }
@@ -574,7 +643,7 @@ nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const
   // Generate and evaluate the ckernel
   ckernel_builder<kernel_request_host> ckb;
   instantiate(static_data, data_size, data.get(), &ckb, 0, dst_tp, dst.get()->metadata(), nsrc, src_tp, src_arrmeta, kernreq,
-              &eval::default_eval_context, nkwd, kwds, tp_vars);
+              ectx, nkwd, kwds, tp_vars);
   expr_metadata_single_t fn = ckb.get()->get_function<expr_metadata_single_t>();
   fn(ckb.get(), &dst, src_data);
 
@@ -584,9 +653,19 @@ nd::array callable_type_data::operator()(ndt::type &dst_tp, intptr_t nsrc, const
 void callable_type_data::operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                                     const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
                                     intptr_t nkwd, const nd::array *kwds,
-                                    const std::map<std::string, ndt::type> &tp_vars)
-{
-  std::unique_ptr<char[]> data(new char[data_size]);
+                                    const small_map<std::string, ndt::type> &tp_vars, const eval::eval_context *ectx)
+{
+  if (cache != NULL) {
+    std::unique_ptr<nd::bound_kernel> k =
+        acquire_bound_kernel(*this, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, nkwd, kwds, tp_vars, ectx);
+    if (k) {
+      k->single(dst_data, src_data);
+      cache->release(std::move(k));
+      return;
+    }
+  }
+
+  std::unique_ptr<char[]> data((data_size > 0) ? new char[data_size] : NULL);
   if (data_size > 0) {
     data_init(static_data, data_size, data.get(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
   }
@@ -594,7 +673,7 @@ void callable_type_data::operator()(const ndt::type &dst_tp, const char *dst_arr
   // Generate and evaluate the ckernel
   ckernel_builder<kernel_request_host> ckb;
   instantiate(static_data, data_size, data.get(), &ckb, 0, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta,
-              kernel_request_single, &eval::default_eval_context, nkwd, kwds, tp_vars);
+              kernel_request_single, ectx, nkwd, kwds, tp_vars);
   expr_single_t fn = ckb.get()->get_function<expr_single_t>();
   fn(ckb.get(), dst_data, src_data);
 }
@@ -604,7 +683,8 @@ void callable_type_data::operator()(const ndt::type &DYND_UNUSED(dst_tp), const
                                     const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                     nd::array *const *DYND_UNUSED(src_data), intptr_t DYND_UNUSED(nkwd),
                                     const nd::array *DYND_UNUSED(kwds),
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                    const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars),
+                                    const eval::eval_context *DYND_UNUSED(ectx))
 {
   throw std::runtime_error("view callables are not fully implemented yet");
 }
@@ -3,12 +3,15 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <set>
+#include <vector>
 
 #include <dynd/auxiliary_data.hpp>
 #include <dynd/types/categorical_type.hpp>
+#include <dynd/types/category_hash_table.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/comparison_kernels.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -18,6 +21,7 @@
 #include <dynd/func/apply.hpp>
 #include <dynd/kernels/base_property_kernel.hpp>
 #include <dynd/search.hpp>
+#include <dynd/thread_pool.hpp>
 
 using namespace dynd;
 using namespace std;
@@ -106,6 +110,29 @@ struct category_to_categorical_kernel_extra : nd::base_kernel<category_to_catego
     *reinterpret_cast<UIntType *>(dst) = src_val;
   }
 
+  // Encodes a whole run with the hash table, without a call per value
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
+    const ndt::detail::category_hash_table *table = dst_cat_tp->get_hash_table();
+    const char *src0 = src[0];
+    intptr_t src0_stride = src_stride[0];
+    if (table == NULL) {
+      for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+        *reinterpret_cast<UIntType *>(dst) = dst_cat_tp->get_value_from_category(src_arrmeta, src0);
+      }
+      return;
+    }
+
+    for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+      intptr_t value = table->find(src0);
+      if (value < 0) {
+        // Raises the error for the unrecognized value
+        dst_cat_tp->get_value_from_category(src_arrmeta, src0);
+      }
+      *reinterpret_cast<UIntType *>(dst) = static_cast<UIntType>(value);
+    }
+  }
+
   static void destruct(ckernel_prefix *self)
   {
     self_type *e = reinterpret_cast<self_type *>(self);
@@ -165,9 +192,9 @@ struct category_to_categorical_kernel_extra : nd::base_kernel<category_to_catego
 
 } // anoymous namespace
 
-/** This function converts the set of char* pointers into a strided immutable
+/** This function converts the sorted char* pointers into a strided immutable
  * nd::array of the categories */
-static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, const ndt::type &element_tp,
+static nd::array make_sorted_categories(const vector<const char *> &uniques, const ndt::type &element_tp,
                                         const char *arrmeta)
 {
   nd::array categories = nd::empty(uniques.size(), element_tp);
@@ -178,7 +205,7 @@ static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, c
 
   intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
   char *dst_ptr = categories.data();
-  for (set<const char *, cmp>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
+  for (vector<const char *>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
     char *src = const_cast<char *>(*it);
     fn(k.get(), dst_ptr, &src);
     dst_ptr += stride;
@@ -262,7 +289,19 @@ ndt::categorical_type::categorical_type(const nd::array &categories, bool presor
                                            unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i)) = i;
     }
 
-    m_categories = make_sorted_categories(uniques, m_category_tp, categories_element_arrmeta);
+    m_categories = make_sorted_categories(vector<const char *>(uniques.begin(), uniques.end()), m_category_tp,
+                                          categories_element_arrmeta);
+  }
+
+  if (detail::category_hash_table::is_hashable(m_category_tp)) {
+    // Insert the categories in value order, so the index the table gives for
+    // a category is its value
+    std::shared_ptr<detail::category_hash_table> table =
+        std::make_shared<detail::category_hash_table>(m_category_tp, category_count);
+    for (intptr_t i = 0; i < category_count; ++i) {
+      table->insert(get_category_data_from_value((uint32_t)i));
+    }
+    m_hash_table = table;
   }
 
   // Use the number of categories to set which underlying integer storage to use
@@ -331,12 +370,24 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
 
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const
 {
+  if (m_hash_table) {
+    intptr_t value = m_hash_table->find(category_data);
+    if (value >= 0) {
+      return (uint32_t)value;
+    }
+    stringstream ss;
+    ss << "Unrecognized category value ";
+    m_category_tp.print_data(ss, category_arrmeta, category_data);
+    ss << " assigning to dynd type " << type(this, true);
+    throw std::runtime_error(ss.str());
+  }
+
   type dst_tp = type::make<intptr_t>();
   type src_tp[2] = {m_categories.get_type(), m_category_tp};
   const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
   char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
   intptr_t i = (*nd::binary_search::get().get())(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL,
-                                                 std::map<std::string, ndt::type>()).as<intptr_t>();
+                                                 small_map<std::string, ndt::type>()).as<intptr_t>();
   if (i < 0) {
     stringstream ss;
     ss << "Unrecognized category value ";
@@ -360,6 +411,10 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.val_assign(category);
   }
 
+  if (m_hash_table) {
+    return get_value_from_category(c.get()->metadata(), c.cdata());
+  }
+
   intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
   if (i < 0) {
     stringstream ss;
@@ -542,6 +597,43 @@ void ndt::categorical_type::arrmeta_debug_print(const char *DYND_UNUSED(arrmeta)
   // Data is stored as uint##, no arrmeta to process
 }
 
+/**
+ * Returns pointers to the distinct values of ``count`` hashable values. With
+ * more than one thread in the default eval context, each thread finds the
+ * distinct values of a chunk, and those are merged.
+ */
+static vector<const char *> hash_uniques(const ndt::type &el_tp, const char *data, intptr_t stride, intptr_t count)
+{
+  const eval::eval_context *ectx = &eval::default_eval_context;
+  intptr_t nchunks = 1;
+  if (ectx->nthreads > 1 && ectx->parallel_chunk_size > 0) {
+    nchunks = std::max<intptr_t>(1, std::min<intptr_t>(ectx->nthreads, count / ectx->parallel_chunk_size));
+  }
+
+  vector<vector<const char *>> chunk_uniques(nchunks);
+  thread_pool::get().run(nchunks, [&](intptr_t i) {
+    intptr_t begin = i * count / nchunks;
+    intptr_t end = (i + 1) * count / nchunks;
+
+    ndt::detail::category_hash_table table(el_tp);
+    for (intptr_t j = begin; j < end; ++j) {
+      table.insert(data + j * stride);
+    }
+    chunk_uniques[i] = table.keys();
+  });
+  if (nchunks == 1) {
+    return chunk_uniques[0];
+  }
+
+  ndt::detail::category_hash_table table(el_tp, chunk_uniques[0].size());
+  for (intptr_t i = 0; i < nchunks; ++i) {
+    for (size_t j = 0; j < chunk_uniques[i].size(); ++j) {
+      table.insert(chunk_uniques[i][j]);
+    }
+  }
+  return table.keys();
+}
+
 ndt::type ndt::factor_categorical(const nd::array &values)
 {
   // Do the factor operation on a concrete version of the values
@@ -559,13 +651,20 @@ ndt::type ndt::factor_categorical(const nd::array &values)
   expr_single_t fn = k.get()->get_function<expr_single_t>();
 
   cmp less(fn, k.get());
-  set<const char *, cmp> uniques(less);
-
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    const char *data = values_eval.cdata() + i * stride;
-    if (uniques.find(data) == uniques.end()) {
-      uniques.insert(data);
+  vector<const char *> uniques;
+  if (detail::category_hash_table::is_hashable(el_tp)) {
+    // Find the distinct values by hashing, then sort only those
+    uniques = hash_uniques(el_tp, values_eval.cdata(), stride, dim_size);
+    std::sort(uniques.begin(), uniques.end(), less);
+  } else {
+    set<const char *, cmp> sorted_uniques(less);
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      const char *data = values_eval.cdata() + i * stride;
+      if (sorted_uniques.find(data) == sorted_uniques.end()) {
+        sorted_uniques.insert(data);
+      }
     }
+    uniques.assign(sorted_uniques.begin(), sorted_uniques.end());
   }
 
   // Copy the values (now sorted and unique) into a new nd::array
@@ -631,7 +730,7 @@ void ndt::categorical_type::get_dynamic_type_properties(const std::pair<std::str
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  const dynd::nd::array &DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<categorical_type>()->m_categories.get_type();
@@ -107,6 +107,11 @@ bool ndt::char_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::char_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), m_encoding);
+}
+
 intptr_t ndt::char_type::make_assignment_kernel(
     void *ckb, intptr_t ckb_offset, const type &dst_tp, const char *dst_arrmeta,
     const type &src_tp, const char *src_arrmeta, kernel_request_t kernreq,
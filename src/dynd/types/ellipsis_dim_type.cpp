@@ -85,6 +85,12 @@ bool ndt::ellipsis_dim_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::ellipsis_dim_type::compute_hash() const
+{
+  size_t result = detail::hash_combine(base_type::compute_hash(), std::hash<std::string>()(m_name));
+  return detail::hash_combine(result, m_element_tp.get_hash());
+}
+
 ndt::type ndt::ellipsis_dim_type::get_type_at_dimension(char **DYND_UNUSED(inout_arrmeta), intptr_t i,
                                                         intptr_t total_ndim) const
 {
@@ -123,7 +129,7 @@ void ndt::ellipsis_dim_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 }
 
 bool ndt::ellipsis_dim_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                   std::map<std::string, type> &tp_vars) const
+                                   small_map<std::string, type> &tp_vars) const
 {
   // TODO XXX This is wrong, "Any" could represent a type that doesn't match
   // against this one...
@@ -219,7 +225,7 @@ void ndt::ellipsis_dim_type::get_dynamic_type_properties(const std::pair<std::st
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  const dynd::nd::array &DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = static_cast<nd::array>(tp.extended<ellipsis_dim_type>()->get_name()).get_type();
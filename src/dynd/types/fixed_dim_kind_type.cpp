@@ -136,6 +136,11 @@ bool ndt::fixed_dim_kind_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::fixed_dim_kind_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), m_element_tp.get_hash());
+}
+
 void ndt::fixed_dim_kind_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta),
                                                          bool DYND_UNUSED(blockref_alloc)) const
 {
@@ -198,7 +203,7 @@ void ndt::fixed_dim_kind_type::data_destruct_strided(const char *DYND_UNUSED(arr
 }
 
 bool ndt::fixed_dim_kind_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                     std::map<std::string, type> &tp_vars) const
+                                     small_map<std::string, type> &tp_vars) const
 {
   switch (candidate_tp.get_type_id()) {
   case fixed_dim_type_id:
@@ -287,6 +287,11 @@ bool ndt::fixed_dim_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::fixed_dim_type::compute_hash() const
+{
+  return detail::hash_combine(detail::hash_combine(base_type::compute_hash(), m_dim_size), m_element_tp.get_hash());
+}
+
 void ndt::fixed_dim_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const
 {
   size_t element_size =
@@ -639,7 +644,7 @@ void ndt::fixed_dim_type::reorder_default_constructed_strides(char *dst_arrmeta,
 }
 
 bool ndt::fixed_dim_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                std::map<std::string, type> &tp_vars) const
+                                small_map<std::string, type> &tp_vars) const
 {
   switch (candidate_tp.get_type_id()) {
   case fixed_dim_type_id:
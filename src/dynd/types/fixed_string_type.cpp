@@ -168,6 +168,11 @@ bool ndt::fixed_string_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::fixed_string_type::compute_hash() const
+{
+  return detail::hash_combine(detail::hash_combine(base_type::compute_hash(), m_encoding), m_stringsize);
+}
+
 intptr_t ndt::fixed_string_type::make_assignment_kernel(
     void *ckb, intptr_t ckb_offset, const type &dst_tp, const char *dst_arrmeta,
     const type &src_tp, const char *src_arrmeta, kernel_request_t kernreq,
@@ -143,7 +143,7 @@ void ndt::int_kind_sym_type::data_destruct_strided(
 bool ndt::int_kind_sym_type::match(
     const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
     const char *DYND_UNUSED(candidate_arrmeta),
-    std::map<std::string, type> &DYND_UNUSED(tp_vars)) const
+    small_map<std::string, type> &DYND_UNUSED(tp_vars)) const
 {
   // Matches against the 'kind' of the candidate type
   type_kind_t kind = candidate_tp.get_kind();
@@ -77,7 +77,7 @@ bool ndt::option_type::is_avail(const char *arrmeta, const char *data, const eva
     nd::callable &af = get_is_avail();
     type src_tp[1] = {type(this, true)};
     af.get()->instantiate(NULL, 0, NULL, &ckb, 0, type::make<bool1>(), NULL, 1, src_tp, &arrmeta, kernel_request_single,
-                          ectx, 0, NULL, std::map<std::string, type>());
+                          ectx, 0, NULL, small_map<std::string, type>());
     ckernel_prefix *ckp = ckb.get();
     char result;
     ckp->get_function<expr_single_t>()(ckp, &result, const_cast<char **>(&data));
@@ -129,7 +129,7 @@ void ndt::option_type::assign_na(const char *arrmeta, char *data, const eval::ev
     ckernel_builder<kernel_request_host> ckb;
     nd::callable &af = get_assign_na();
     af.get()->instantiate(NULL, 0, NULL, &ckb, 0, type(this, true), arrmeta, 0, NULL, NULL, kernel_request_single, ectx,
-                          0, NULL, std::map<std::string, type>());
+                          0, NULL, small_map<std::string, type>());
     ckernel_prefix *ckp = ckb.get();
     ckp->get_function<expr_single_t>()(ckp, data, NULL);
   }
@@ -233,6 +233,11 @@ bool ndt::option_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::option_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), m_value_tp.get_hash());
+}
+
 void ndt::option_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const
 {
   if (!m_value_tp.is_builtin()) {
@@ -302,7 +307,7 @@ intptr_t ndt::option_type::make_assignment_kernel(void *ckb, intptr_t ckb_offset
 }
 
 bool ndt::option_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                             std::map<std::string, type> &tp_vars) const
+                             small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() != option_type_id) {
     return false;
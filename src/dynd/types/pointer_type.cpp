@@ -215,6 +215,11 @@ bool ndt::pointer_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::pointer_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), m_target_tp.get_hash());
+}
+
 ndt::type ndt::pointer_type::with_replaced_storage_type(const type & /*replacement_tp*/) const
 {
   throw runtime_error("TODO: implement pointer_type::with_replaced_storage_type");
@@ -341,7 +346,7 @@ nd::array ndt::pointer_type::get_option_nafunc() const
 }
 
 bool ndt::pointer_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                              std::map<std::string, type> &tp_vars) const
+                              small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() != pointer_type_id) {
     return false;
@@ -141,7 +141,7 @@ void ndt::pow_dimsym_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 
 bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
                                  const char *candidate_arrmeta,
-                                 std::map<std::string, type> &tp_vars) const
+                                 small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() == typevar_constructed_type_id) {
     return candidate_tp.extended<typevar_constructed_type>()->match(
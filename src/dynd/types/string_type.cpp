@@ -42,6 +42,7 @@ void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), ch
   const intptr_t src_charsize = 1;
   intptr_t dst_charsize = string_encoding_char_size_table[string_encoding_utf_8];
   char *dst_current;
+  transcode_block_t block_fn = get_transcode_block_function(string_encoding_utf_8, string_encoding_utf_8);
   next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_8, errmode);
   append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(string_encoding_utf_8, errmode);
   uint32_t cp;
@@ -55,19 +56,23 @@ void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), ch
 
   dst_current = dst_begin;
   while (utf8_begin < utf8_end) {
-    cp = next_fn(utf8_begin, utf8_end);
-    // Append the codepoint, or increase the allocated memory as necessary
-    if (dst_end - dst_current >= 8) {
-      append_fn(cp, dst_current, dst_end);
-    } else {
+    block_fn(utf8_begin, utf8_end, dst_current, dst_end);
+    if (utf8_begin == utf8_end) {
+      break;
+    }
+    // Increase the allocated memory as necessary
+    if (dst_end - dst_current < 8) {
       char *dst_begin_saved = dst_begin;
       dst_d.resize(2 * dst_d.size());
       dst_begin = dst_d.begin();
       dst_end = dst_d.end();
       dst_current = dst_begin + (dst_current - dst_begin_saved);
-
-      append_fn(cp, dst_current, dst_end);
+      continue;
     }
+    // Append the code point the block conversion stopped at, which may be
+    // an embedded zero
+    cp = next_fn(utf8_begin, utf8_end);
+    append_fn(cp, dst_current, dst_end);
   }
 
   // Set the output
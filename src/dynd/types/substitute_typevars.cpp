@@ -28,7 +28,7 @@ using namespace dynd;
 /**
  * Substitutes the field types for contiguous array of types
  */
-static nd::array substitute_type_array(const nd::array &type_array, const std::map<std::string, ndt::type> &typevars,
+static nd::array substitute_type_array(const nd::array &type_array, const small_map<std::string, ndt::type> &typevars,
                                        bool concrete)
 {
   intptr_t field_count = type_array.get_dim_size();
@@ -41,7 +41,7 @@ static nd::array substitute_type_array(const nd::array &type_array, const std::m
   return tmp_field_types;
 }
 
-ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::map<std::string, ndt::type> &typevars,
+ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const small_map<std::string, ndt::type> &typevars,
                                            bool concrete)
 {
   // This function assumes that ``pattern`` is symbolic, so does not
@@ -92,7 +92,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
         substitute(pattern.extended<callable_type>()->get_pos_tuple(), typevars, concrete),
         substitute(pattern.extended<callable_type>()->get_kwd_struct(), typevars, concrete));
   case typevar_constructed_type_id: {
-    map<std::string, ndt::type>::const_iterator it =
+    small_map<std::string, ndt::type>::const_iterator it =
         typevars.find(pattern.extended<typevar_constructed_type>()->get_name());
     if (it->second.get_type_id() == void_type_id) {
       return substitute(pattern.extended<typevar_constructed_type>()->get_arg(), typevars, concrete);
@@ -105,7 +105,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
 #endif
   }
   case typevar_type_id: {
-    map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_type>()->get_name());
+    small_map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_type>()->get_name());
     if (it != typevars.end()) {
       if (it->second.get_ndim() != 0) {
         stringstream ss;
@@ -131,7 +131,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
     }
   }
   case typevar_dim_type_id: {
-    map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_dim_type>()->get_name());
+    small_map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_dim_type>()->get_name());
     if (it != typevars.end()) {
       if (it->second.get_ndim() == 0) {
         stringstream ss;
@@ -180,7 +180,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
   case pow_dimsym_type_id: {
     // Look up to the exponent typevar
     std::string exponent_name = pattern.extended<pow_dimsym_type>()->get_exponent();
-    map<std::string, ndt::type>::const_iterator tv_type = typevars.find(exponent_name);
+    small_map<std::string, ndt::type>::const_iterator tv_type = typevars.find(exponent_name);
     intptr_t exponent = -1;
     if (tv_type != typevars.end()) {
       if (tv_type->second.get_type_id() == fixed_dim_type_id) {
@@ -208,7 +208,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
     // Get the base type
     ndt::type base_tp = pattern.extended<pow_dimsym_type>()->get_base_type();
     if (base_tp.get_type_id() == typevar_dim_type_id) {
-      map<std::string, ndt::type>::const_iterator btv_type =
+      small_map<std::string, ndt::type>::const_iterator btv_type =
           typevars.find(base_tp.extended<typevar_dim_type>()->get_name());
       if (btv_type == typevars.end()) {
         // We haven't seen this typevar yet, check if concrete
@@ -278,7 +278,7 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
   case ellipsis_dim_type_id: {
     const std::string &name = pattern.extended<ellipsis_dim_type>()->get_name();
     if (!name.empty()) {
-      map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_dim_type>()->get_name());
+      small_map<std::string, ndt::type>::const_iterator it = typevars.find(pattern.extended<typevar_dim_type>()->get_name());
       if (it != typevars.end()) {
         if (it->second.get_type_id() == dim_fragment_type_id) {
           return it->second.extended<dim_fragment_type>()->apply_to_dtype(
@@ -313,7 +313,9 @@ ndt::type ndt::detail::internal_substitute(const ndt::type &pattern, const std::
       return pattern;
     }
   }
-  case scalar_kind_type_id: {
+  case scalar_kind_type_id:
+  case kind_sym_type_id:
+  case int_sym_type_id: {
     if (concrete) {
       stringstream ss;
       ss << "The dynd type " << pattern << " is not concrete as required";
@@ -133,7 +133,7 @@ intptr_t ndt::time_type::make_assignment_kernel(void *ckb, intptr_t ckb_offset,
       // Assignment from strings
       typedef nd::assignment_kernel<time_type_id, string_type_id> self_type;
       return self_type::instantiate(NULL, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, 1, &src_tp, &src_arrmeta,
-                                    kernreq, ectx, 0, NULL, std::map<std::string, ndt::type>());
+                                    kernreq, ectx, 0, NULL, small_map<std::string, ndt::type>());
     } else if (src_tp.get_kind() == struct_kind) {
       // Convert to struct using the "struct" property
       return ::make_assignment_kernel(ckb, ckb_offset, property_type::make(dst_tp, "struct"), dst_arrmeta, src_tp,
@@ -147,7 +147,7 @@ intptr_t ndt::time_type::make_assignment_kernel(void *ckb, intptr_t ckb_offset,
       // Assignment to strings
       typedef nd::assignment_kernel<string_type_id, time_type_id> self_type;
       return self_type::instantiate(NULL, 0, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, 1, &src_tp, &src_arrmeta,
-                                    kernreq, ectx, 0, NULL, std::map<std::string, ndt::type>());
+                                    kernreq, ectx, 0, NULL, small_map<std::string, ndt::type>());
     } else if (dst_tp.get_kind() == struct_kind) {
       // Convert to struct using the "struct" property
       return ::make_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, property_type::make(src_tp, "struct"),
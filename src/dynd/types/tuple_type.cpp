@@ -127,9 +127,28 @@ bool ndt::tuple_type::operator==(const base_type &rhs) const
     return false;
   } else {
     const tuple_type *dt = static_cast<const tuple_type *>(&rhs);
-    return get_data_alignment() == dt->get_data_alignment() && m_field_types.equals_exact(dt->m_field_types) &&
-           m_variadic == dt->m_variadic;
+    if (get_data_alignment() != dt->get_data_alignment() || m_field_count != dt->m_field_count ||
+        m_variadic != dt->m_variadic) {
+      return false;
+    }
+    const type *field_types = get_field_types_raw(), *rhs_field_types = dt->get_field_types_raw();
+    for (intptr_t i = 0; i < m_field_count; ++i) {
+      if (field_types[i] != rhs_field_types[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+size_t ndt::tuple_type::compute_hash() const
+{
+  size_t result = detail::hash_combine(base_type::compute_hash(), m_variadic);
+  const type *field_types = get_field_types_raw();
+  for (intptr_t i = 0; i < m_field_count; ++i) {
+    result = detail::hash_combine(result, field_types[i].get_hash());
   }
+  return result;
 }
 
 void ndt::tuple_type::arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const
@@ -184,7 +203,7 @@ void ndt::tuple_type::get_dynamic_type_properties(const std::pair<std::string, n
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<tuple_type>()->m_field_types.get_type();
@@ -206,7 +225,7 @@ void ndt::tuple_type::get_dynamic_type_properties(const std::pair<std::string, n
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<tuple_type>()->m_arrmeta_offsets.get_type();
@@ -132,7 +132,7 @@ void ndt::typevar_constructed_type::arrmeta_destruct(
 
 bool ndt::typevar_constructed_type::match(
     const char *arrmeta, const type &candidate_tp,
-    const char *candidate_arrmeta, std::map<std::string, type> &tp_vars) const
+    const char *candidate_arrmeta, small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() == typevar_constructed_type_id) {
     return m_arg.match(arrmeta,
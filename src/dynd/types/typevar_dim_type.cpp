@@ -73,6 +73,12 @@ bool ndt::typevar_dim_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::typevar_dim_type::compute_hash() const
+{
+  size_t result = detail::hash_combine(base_type::compute_hash(), std::hash<std::string>()(m_name));
+  return detail::hash_combine(result, m_element_tp.get_hash());
+}
+
 ndt::type ndt::typevar_dim_type::get_type_at_dimension(char **DYND_UNUSED(inout_arrmeta), intptr_t i,
                                                        intptr_t total_ndim) const
 {
@@ -110,7 +116,7 @@ void ndt::typevar_dim_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 
 bool ndt::typevar_dim_type::match(const char *arrmeta, const type &candidate_tp,
                                   const char *DYND_UNUSED(candidate_arrmeta),
-                                  std::map<std::string, type> &tp_vars) const
+                                  small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.is_scalar()) {
     return false;
@@ -172,7 +178,7 @@ void ndt::typevar_dim_type::get_dynamic_type_properties(const std::pair<std::str
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = static_cast<nd::array>(tp.extended<typevar_dim_type>()->get_name()).get_type();
@@ -84,6 +84,11 @@ bool ndt::typevar_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::typevar_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), std::hash<std::string>()(m_name));
+}
+
 void ndt::typevar_type::arrmeta_default_construct(char *DYND_UNUSED(arrmeta), bool DYND_UNUSED(blockref_alloc)) const
 {
   throw type_error("Cannot store data of typevar type");
@@ -102,7 +107,7 @@ void ndt::typevar_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 }
 
 bool ndt::typevar_type::match(const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
-                              const char *DYND_UNUSED(candidate_arrmeta), std::map<std::string, type> &tp_vars) const
+                              const char *DYND_UNUSED(candidate_arrmeta), small_map<std::string, type> &tp_vars) const
 {
   if (candidate_tp.get_type_id() == typevar_type_id) {
     return *this == *candidate_tp.extended();
@@ -150,7 +155,7 @@ void ndt::typevar_type::get_dynamic_type_properties(const std::pair<std::string,
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const small_map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       const nd::array &a = tp.extended<typevar_type>()->get_name();
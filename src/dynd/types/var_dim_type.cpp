@@ -355,6 +355,11 @@ bool ndt::var_dim_type::operator==(const base_type &rhs) const
   }
 }
 
+size_t ndt::var_dim_type::compute_hash() const
+{
+  return detail::hash_combine(base_type::compute_hash(), m_element_tp.get_hash());
+}
+
 void ndt::var_dim_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const
 {
   size_t element_size =
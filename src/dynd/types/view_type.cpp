@@ -125,7 +125,7 @@ bool ndt::view_type::operator==(const base_type &rhs) const
     return false;
   } else {
     const view_type *dt = static_cast<const view_type *>(&rhs);
-    return m_value_type == dt->m_value_type;
+    return m_value_type == dt->m_value_type && m_operand_type == dt->m_operand_type;
   }
 }
 
@@ -15,6 +15,8 @@
 #include <dynd/array.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/memblock/objectarray_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -702,3 +704,40 @@ INSTANTIATE_TYPED_TEST_CASE_P(Default, Array, DefaultMemory);
 #ifdef DYND_CUDA
 INSTANTIATE_TYPED_TEST_CASE_P(CUDA, Array, CUDAMemory);
 #endif // DYND_CUDA
+
+TEST(Array, MemoryBlockResize)
+{
+  // Growing an allocation past the end of its chunk moves it to a new one
+  intrusive_ptr<memory_block_data> pod = make_pod_memory_block(ndt::type::make<int32_t>(), 64);
+  memory_block_data::api *allocator = pod->get_api();
+  int32_t *ints = reinterpret_cast<int32_t *>(allocator->allocate(pod.get(), 1));
+  ints[0] = 0;
+  for (int32_t size = 1; size < 8192; size *= 2) {
+    ints = reinterpret_cast<int32_t *>(allocator->resize(pod.get(), reinterpret_cast<char *>(ints), 2 * size));
+    for (int32_t i = size; i < 2 * size; ++i) {
+      ints[i] = i;
+    }
+  }
+  for (int32_t i = 0; i < 8192; ++i) {
+    ASSERT_EQ(i, ints[i]);
+  }
+
+  ndt::type string_tp = ndt::string_type::make();
+  intrusive_ptr<memory_block_data> objects =
+      make_objectarray_memory_block(string_tp, NULL, string_tp.get_data_size(), 8);
+  allocator = objects->get_api();
+  dynd::string *strings = reinterpret_cast<dynd::string *>(allocator->allocate(objects.get(), 1));
+  strings[0].assign("0", 1);
+  for (int size = 1; size < 1024; size *= 2) {
+    strings =
+        reinterpret_cast<dynd::string *>(allocator->resize(objects.get(), reinterpret_cast<char *>(strings), 2 * size));
+    for (int i = size; i < 2 * size; ++i) {
+      // The new elements are zero-initialized, which is an empty string
+      EXPECT_EQ(0u, strings[i].size());
+      strings[i].assign(std::to_string(i).data(), std::to_string(i).size());
+    }
+  }
+  for (int i = 0; i < 1024; ++i) {
+    ASSERT_EQ(std::to_string(i), std::string(strings[i].begin(), strings[i].end()));
+  }
+}
@@ -14,6 +14,7 @@
 #include <dynd/array.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/array_range.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -421,6 +422,26 @@ TEST(ArrayAssign, Casting)
   EXPECT_EQ(-120, b(3).as<int>());
 }
 
+TEST(ArrayAssign, ContiguousCasting)
+{
+  nd::array a = nd::range(37);
+  nd::array b = nd::empty(37, ndt::type::make<double>());
+  b.vals() = a;
+  nd::array c = nd::empty(37, ndt::type::make<int64_t>());
+  c.vals() = a;
+  for (intptr_t i = 0; i < 37; ++i) {
+    EXPECT_EQ(static_cast<double>(i), b(i).as<double>());
+    EXPECT_EQ(i, c(i).as<int64_t>());
+  }
+
+  // A strided destination
+  nd::array d = nd::empty(74, ndt::type::make<float>());
+  d(irange().by(2)).vals() = a;
+  for (intptr_t i = 0; i < 37; ++i) {
+    EXPECT_EQ(static_cast<float>(i), d(2 * i).as<float>());
+  }
+}
+
 TYPED_TEST_P(ArrayAssign, Overflow)
 {
   int v0[4] = {0, 1, 2, 3};
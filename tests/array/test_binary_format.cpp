@@ -0,0 +1,140 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/binary_format.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+static void remove_file(const char *fn)
+{
+#ifdef WIN32
+  _unlink(fn);
+#else
+  unlink(fn);
+#endif
+}
+
+TEST(BinaryFormat, POD)
+{
+  nd::array a = nd::empty(100, 3, ndt::type::make<double>());
+  for (intptr_t i = 0; i < 100; ++i) {
+    for (intptr_t j = 0; j < 3; ++j) {
+      a(i, j).vals() = i * 3.0 + j / 4.0;
+    }
+  }
+  nd::save_binary(a, "test_binary.dynd");
+
+  nd::array b = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ((uint32_t)nd::read_access_flag, b.get_access_flags());
+  EXPECT_TRUE(a.equals_exact(b));
+
+  // A strided view is saved in the default layout
+  nd::save_binary(a(irange().by(-2), 1), "test_binary.dynd");
+  b = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(ndt::type("50 * float64"), b.get_type());
+  EXPECT_EQ(a(99, 1).as<double>(), b(0).as<double>());
+  EXPECT_EQ(a(1, 1).as<double>(), b(49).as<double>());
+
+  b = nd::array();
+  remove_file("test_binary.dynd");
+}
+
+TEST(BinaryFormat, ReadWrite)
+{
+  int32_t vals[] = {1, 2, 3, 4};
+  nd::save_binary(vals, "test_binary.dynd");
+
+  nd::array a = nd::load_binary("test_binary.dynd", nd::readwrite_access_flags);
+  a(2).vals() = 30;
+  nd::memmap_flush(a);
+  a = nd::array();
+
+  a = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(30, a(2).as<int32_t>());
+  EXPECT_EQ(4, a(3).as<int32_t>());
+
+  a = nd::array();
+  remove_file("test_binary.dynd");
+}
+
+TEST(BinaryFormat, Empty)
+{
+  // Types with no data roundtrip without being mapped
+  nd::save_binary(parse_json("0 * int32", "[]"), "test_binary.dynd");
+  nd::array a = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(ndt::type("0 * int32"), a.get_type());
+  EXPECT_EQ((uint32_t)nd::read_access_flag, a.get_access_flags());
+
+  nd::save_binary(nd::empty(ndt::type("()")), "test_binary.dynd");
+  a = nd::load_binary("test_binary.dynd", nd::readwrite_access_flags);
+  EXPECT_EQ(ndt::type("()"), a.get_type());
+  EXPECT_EQ((uint32_t)nd::readwrite_access_flags, a.get_access_flags());
+
+  a = nd::array();
+  remove_file("test_binary.dynd");
+}
+
+TEST(BinaryFormat, VarAndString)
+{
+  nd::array a = parse_json(ndt::type("3 * {name: string, values: var * int32, tags: var * string}"),
+                           "[[\"a\", [1, 2, 3], [\"x\"]], [\"bc\", [], []], "
+                           "[\"longer string value\", [4, 5], [\"y\", \"zz\", \"\"]]]");
+  nd::save_binary(a, "test_binary.dynd");
+
+  // Read-only, with the int32 elements left in the mapped file
+  nd::array b = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(b).as<std::string>());
+  EXPECT_EQ("longer string value", b(2, 0).as<std::string>());
+  EXPECT_EQ(5, b(2, 1, 1).as<int32_t>());
+  EXPECT_EQ("zz", b(2, 2, 1).as<std::string>());
+
+  // Writable, with everything copied
+  nd::array c = nd::load_binary("test_binary.dynd", nd::readwrite_access_flags);
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(c).as<std::string>());
+  c(0, 1, 0).vals() = 100;
+  EXPECT_EQ(100, c(0, 1, 0).as<int32_t>());
+  EXPECT_EQ(1, b(0, 1, 0).as<int32_t>());
+
+  // Nested var dims
+  a = parse_json(ndt::type("var * var * float64"), "[[1.5], [], [2.5, 3.5, 4.5]]");
+  nd::save_binary(a, "test_binary.dynd");
+  b = nd::load_binary("test_binary.dynd");
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(b).as<std::string>());
+
+  b = nd::array();
+  c = nd::array();
+  remove_file("test_binary.dynd");
+}
+
+TEST(BinaryFormat, Errors)
+{
+  ofstream fout("test_binary.dynd", ios::binary);
+  fout << "not a dynd binary file, but long enough to hold the header of one";
+  fout.close();
+  EXPECT_THROW(nd::load_binary("test_binary.dynd"), runtime_error);
+  EXPECT_THROW(nd::load_binary("does_not_exist.dynd"), runtime_error);
+  EXPECT_THROW(nd::save_binary(nd::empty(ndt::type("3 * bytes")), "test_binary.dynd"), type_error);
+
+  remove_file("test_binary.dynd");
+}
@@ -47,6 +47,12 @@ TEST(JSONFormatter, Builtins)
   EXPECT_EQ("3.125", format_json(a).as<std::string>());
   a = 3.125;
   EXPECT_EQ("3.125", format_json(a).as<std::string>());
+  a = 0.1;
+  EXPECT_EQ("0.1", format_json(a).as<std::string>());
+  a = 1.0 / 3.0;
+  EXPECT_EQ("0.3333333333333333", format_json(a).as<std::string>());
+  a = 2.5e-20f;
+  EXPECT_EQ("2.5e-20", format_json(a).as<std::string>());
   a = parse_json("?bool", "null");
   EXPECT_EQ("null", format_json(a).as<std::string>());
 }
@@ -12,7 +12,9 @@
 #include "../dynd_assertions.hpp"
 
 #include <dynd/view.hpp>
+#include <dynd/json_formatter.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -106,6 +108,57 @@ TEST(JSON, DiscoverObject)
   EXPECT_EQ(ndt::type("{x: float64, y: 3 * int64}"), ndt::json::discover("{\"x\": 3.14, \"y\": [1, 2, 3]}"));
 }
 
+TEST(JSON, DiscoverRecords)
+{
+  EXPECT_EQ(ndt::type("2 * string"), ndt::json::discover("[\"a\", \"b\"]"));
+  EXPECT_EQ(ndt::type("3 * ?string"), ndt::json::discover("[\"a\", null, \"b\"]"));
+  EXPECT_EQ(ndt::type("2 * {x: ?int64, y: var * float64}"),
+            ndt::json::discover("[{\"x\": 1, \"y\": [1.5]}, {\"x\": null, \"y\": [2, 3]}]"));
+  EXPECT_EQ(ndt::type("({x: int64}, {y: int64})"), ndt::json::discover("[{\"x\": 1}, {\"y\": 2}]"));
+}
+
+TEST(JSON, DiscoverParallel)
+{
+  std::string json = "[";
+  for (int i = 0; i < 5000; ++i) {
+    json += i > 0 ? ",\n" : "\n";
+    json += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"a\", \"b\"], \"value\": ";
+    json += i % 10 == 0 ? "null" : (i == 4001 ? "0.5" : std::to_string(i));
+    json += "}";
+  }
+  json += "\n]\n";
+  const char *begin = json.data(), *end = begin + json.size();
+
+  ndt::type serial_tp;
+  ndt::json::discover(serial_tp, begin, end);
+  EXPECT_EQ(ndt::type("5000 * {id: int64, tags: 2 * string, value: ?float64}"), serial_tp);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ndt::type tp;
+  ndt::json::discover(tp, begin, end, -1, &ectx);
+  EXPECT_EQ(serial_tp, tp);
+
+  // A sample which doesn't reach the float value
+  ndt::json::discover(tp, begin, end, 1000, &ectx);
+  EXPECT_EQ(ndt::type("var * {id: int64, tags: 2 * string, value: ?int64}"), tp);
+  ndt::json::discover(tp, begin, end, 1000);
+  EXPECT_EQ(ndt::type("var * {id: int64, tags: 2 * string, value: ?int64}"), tp);
+  // A sample of everything
+  ndt::json::discover(tp, begin, end, 5000, &ectx);
+  EXPECT_EQ(serial_tp, tp);
+  ndt::json::discover(tp, begin, end, 10000);
+  EXPECT_EQ(serial_tp, tp);
+
+  // Errors are reported with their position in the whole text
+  json[json.size() / 2] = '@';
+  begin = json.data();
+  end = begin + json.size();
+  EXPECT_THROW(ndt::json::discover(tp, begin, end, -1, &ectx), invalid_argument);
+  EXPECT_THROW(ndt::json::discover(tp, begin, end, 4000, &ectx), invalid_argument);
+  EXPECT_THROW(ndt::json::discover(tp, begin, end, 0), invalid_argument);
+}
+
 TEST(JSON, ParserWithMissingValue)
 {
   nd::array a = parse_json(ndt::type("{x: ?int32, y: ?float64}"), "{\"x\": 7}");
@@ -554,3 +607,136 @@ TEST(JSONParser, ListOfStruct)
                                "\"data\":{ \"when\":\"2013-12-25\", \"name\":\"Frank\"}}]"),
                invalid_argument);
 }
+
+/**
+ * A character at a time version of json_structural_index, to check it
+ * against. Returns false if the brackets aren't balanced or a string isn't
+ * terminated. Like the index, it lets a backslash outside of a string, which
+ * isn't valid JSON, escape a quote.
+ */
+static bool reference_structural_index(const std::string &json, vector<uint32> &positions, vector<uint32> &matches)
+{
+  vector<uint32> open_stack;
+  size_t open_quote = 0;
+  bool in_string = false, escaped = false;
+  for (size_t i = 0; i < json.size(); ++i) {
+    char c = json[i];
+    bool quote = (c == '"' && !escaped);
+    escaped = (c == '\\' && !escaped);
+    if (in_string) {
+      if (quote) {
+        matches[open_quote] = static_cast<uint32>(i);
+        in_string = false;
+      }
+    } else if (quote) {
+      in_string = true;
+      open_quote = positions.size();
+      positions.push_back(static_cast<uint32>(i));
+      matches.push_back(json_structural_index::no_match);
+    } else if (c == '{' || c == '[' || c == '}' || c == ']' || c == ':' || c == ',') {
+      if (c == '}' || c == ']') {
+        if (open_stack.empty() || json[positions[open_stack.back()]] != (c == '}' ? '{' : '[')) {
+          return false;
+        }
+        matches[open_stack.back()] = static_cast<uint32>(positions.size());
+        open_stack.pop_back();
+      } else if (c == '{' || c == '[') {
+        open_stack.push_back(static_cast<uint32>(positions.size()));
+      }
+      positions.push_back(static_cast<uint32>(i));
+      matches.push_back(json_structural_index::no_match);
+    }
+  }
+  return !in_string && open_stack.empty();
+}
+
+static void check_structural_index(const std::string &json)
+{
+  vector<uint32> positions, matches;
+  bool valid = reference_structural_index(json, positions, matches);
+  json_structural_index index(json.data(), json.data() + json.size());
+  ASSERT_EQ(valid, index.is_valid()) << json;
+  if (valid) {
+    ASSERT_EQ(positions.size(), index.size()) << json;
+    for (size_t i = 0; i < positions.size(); ++i) {
+      ASSERT_EQ(positions[i], index.position(i)) << json;
+      ASSERT_EQ(matches[i], index.match(i)) << json;
+    }
+  } else {
+    EXPECT_EQ(0u, index.size());
+  }
+}
+
+TEST(JSONParser, StructuralIndex)
+{
+  json_structural_index index(NULL, NULL);
+  EXPECT_TRUE(index.is_valid());
+  EXPECT_EQ(0u, index.size());
+
+  std::string json = "{\"a\": [1, {\"b\": \"x]}\"}], \"c\\\"d\": \"\\\\\"}";
+  index.build(json.data(), json.data() + json.size());
+  ASSERT_TRUE(index.is_valid());
+  // { "a" : [ , { "b" : "x]}" } ] , "c\"d" : "\\" }
+  ASSERT_EQ(16u, index.size());
+  EXPECT_EQ(0u, index.position(0));
+  EXPECT_EQ(15u, index.match(0));
+  EXPECT_EQ(3u, index.match(1));
+  EXPECT_EQ(10u, index.match(3));
+  EXPECT_EQ(9u, index.match(5));
+  EXPECT_EQ(json.size() - 1, index.position(15));
+
+  check_structural_index(json);
+  check_structural_index("[1, 2, 3");
+  check_structural_index("[1, 2}");
+  check_structural_index("\"unterminated");
+  check_structural_index("]");
+
+  // Random text of the characters that matter, so escapes, strings and
+  // brackets cross the 64 byte block boundaries
+  const char chars[] = "\"\\{}[]:, a";
+  unsigned int seed = 12345;
+  for (int n = 0; n < 2000; ++n) {
+    std::string text;
+    int length = n % 300;
+    for (int i = 0; i < length; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      text += chars[(seed >> 16) % (sizeof(chars) - 1)];
+    }
+    check_structural_index(text);
+    // Balanced text, with each random piece quoted
+    check_structural_index("[\"" + text + "\", {\"" + text + "\": [" + std::string(n % 70, ' ') + "]}]");
+  }
+}
+
+TEST(JSONParser, SkipFieldsWithIndex)
+{
+  ndt::type sdt = ndt::type("{id: int32, name: string, values: var * float64}");
+
+  // The skipped fields have brackets and quotes inside strings, and are
+  // long enough to span several blocks of the index
+  std::string skipped = "{\"x\": [\"]]\", {\"y\": \"\\\"}\"}], \"z\": \"" + std::string(200, '{') + "\"}";
+  std::string json = "[{\"skip1\": " + skipped + ", \"id\": 1, \"name\": \"a\\\"b\", \"values\": [1.5, 2.5],"
+                     " \"skip2\": [" + skipped + ", " + skipped + "]},\n"
+                     " {\"values\": [], \"name\": \"" + std::string(100, 'c') + "\", \"skip3\": \"[\", \"id\": 2}]";
+  nd::array a = parse_json(ndt::var_dim_type::make(sdt), json.c_str());
+  EXPECT_EQ(1, a(0, 0).as<int>());
+  EXPECT_EQ("a\"b", a(0, 1).as<std::string>());
+  EXPECT_EQ("[1.5,2.5]", format_json(a(0, 2)).as<std::string>());
+  EXPECT_EQ(2, a(1, 0).as<int>());
+  EXPECT_EQ(std::string(100, 'c'), a(1, 1).as<std::string>());
+  EXPECT_EQ("[]", format_json(a(1, 2)).as<std::string>());
+
+  // Var dims are sized from the index, including with nested arrays
+  a = parse_json("var * var * int32", "[[1, 2, 3], [], [4], [5, 6]]");
+  EXPECT_EQ("[[1,2,3],[],[4],[5,6]]", format_json(a).as<std::string>());
+
+  // Unbalanced input falls back to the character at a time parser, which
+  // reports where the error is
+  try {
+    parse_json(sdt, "{\"id\": 1, \"name\": \"a\", \"values\": [1, 2}");
+    FAIL() << "expected an exception";
+  }
+  catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1, column 39"));
+  }
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <stdexcept>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/lazy_expr.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(LazyExpr, Simple)
+{
+  nd::array a = parse_json("3 * float64", "[1.5, 2, 3]");
+  nd::array b = parse_json("3 * float64", "[10, 20, 30]");
+  nd::array c = parse_json("3 * int32", "[1, 2, 3]");
+
+  nd::lazy_expr e = nd::lazy(a) * b + c - 1.0;
+  EXPECT_EQ(ndt::type::make<double>(), e.get_dtype());
+  nd::array r = e.eval();
+  EXPECT_EQ(ndt::type("3 * float64"), r.get_type());
+  EXPECT_EQ(15.0, r(0).as<double>());
+  EXPECT_EQ(41.0, r(1).as<double>());
+  EXPECT_EQ(92.0, r(2).as<double>());
+
+  r = (-nd::lazy(c) / 2.0).eval();
+  EXPECT_EQ(-0.5, r(0).as<double>());
+  EXPECT_EQ(-1.5, r(2).as<double>());
+
+  r = nd::lazy(a).eval();
+  EXPECT_EQ(ndt::type("3 * float64"), r.get_type());
+  EXPECT_EQ(2.0, r(1).as<double>());
+}
+
+TEST(LazyExpr, MatchesEager)
+{
+  // Enough elements for many blocks, and a reused subexpression
+  nd::array a = nd::empty(2, 3000, ndt::type::make<double>());
+  nd::array b = nd::empty(3000, ndt::type::make<float>());
+  nd::array c = nd::empty(2, 1, ndt::type::make<int64_t>());
+  for (int i = 0; i < 3000; ++i) {
+    a(0, i).vals() = i * 0.5;
+    a(1, i).vals() = -i * 0.25;
+    b(i).vals() = (i % 17) + 1.0f;
+  }
+  c(0, 0).vals() = 3;
+  c(1, 0).vals() = -7;
+
+  nd::lazy_expr ab = nd::lazy(a) * b;
+  nd::array r = (ab + ab / c - a).eval();
+  nd::array expected = a * b + a * b / c - a;
+  EXPECT_EQ(expected.get_type(), r.get_type());
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3000; ++j) {
+      EXPECT_EQ(expected(i, j).as<double>(), r(i, j).as<double>());
+    }
+  }
+
+  // A strided view
+  nd::array s = a(irange(), irange().by(3));
+  r = (nd::lazy(s) + s).eval();
+  EXPECT_EQ(ndt::type("2 * 1000 * float64"), r.get_type());
+  for (int j = 0; j < 1000; ++j) {
+    EXPECT_EQ(2 * s(1, j).as<double>(), r(1, j).as<double>());
+  }
+}
+
+TEST(LazyExpr, Errors)
+{
+  nd::array a = parse_json("3 * float64", "[1, 2, 3]");
+  EXPECT_THROW(nd::lazy(parse_json("var * float64", "[1, 2]")), type_error);
+  EXPECT_THROW(nd::lazy(parse_json("3 * string", "[\"a\", \"b\", \"c\"]")), type_error);
+  EXPECT_THROW((nd::lazy(a) + nd::array(true)), runtime_error);
+  EXPECT_THROW((nd::lazy(a) + parse_json("2 * float64", "[1, 2]")).eval(), broadcast_error);
+}
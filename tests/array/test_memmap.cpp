@@ -12,12 +12,139 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/array.hpp>
+#include <dynd/func/take.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace dynd;
 
+static void write_binary_file(const char *fn, const void *data, intptr_t size)
+{
+  ofstream fout(fn, ios::binary);
+  fout.write(reinterpret_cast<const char *>(data), size);
+}
+
+static void remove_file(const char *fn)
+{
+#ifdef WIN32
+  _unlink(fn);
+#else
+  unlink(fn);
+#endif
+}
+
+TEST(ArrayMemMap, Typed)
+{
+  float values[3 * 4];
+  for (int i = 0; i < 12; ++i) {
+    values[i] = i * 0.5f;
+  }
+  write_binary_file("test_memmap.bin", values, sizeof(values));
+
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("N * 4 * float32"));
+  EXPECT_EQ(ndt::type("3 * 4 * float32"), a.get_type());
+  EXPECT_FALSE(a.is_immutable());
+  EXPECT_EQ((uint32_t)nd::read_access_flag, a.get_access_flags());
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_EQ(values[i * 4 + j], a(i, j).as<float>());
+    }
+  }
+  EXPECT_THROW(a(0, 0).vals() = 1.0f, runtime_error);
+  nd::memmap_advise(a, memmap_advice_sequential);
+  nd::memmap_advise(a(1), memmap_advice_willneed);
+
+  // A symbolic dimension starting after an offset, which takes the partial
+  // element at the end off
+  a = nd::memmap("test_memmap.bin", ndt::type("Fixed * 2 * float32"), 4 * sizeof(float));
+  EXPECT_EQ(ndt::type("4 * 2 * float32"), a.get_type());
+  EXPECT_EQ(values[4], a(0, 0).as<float>());
+  EXPECT_EQ(values[11], a(3, 1).as<float>());
+
+  // A fixed type
+  a = nd::memmap("test_memmap.bin", ndt::type("2 * 3 * float32"));
+  EXPECT_EQ(values[5], a(1, 2).as<float>());
+
+  a = nd::array();
+  remove_file("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, ReadWrite)
+{
+  int32_t values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  write_binary_file("test_memmap.bin", values, sizeof(values));
+
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"), 0, nd::readwrite_access_flags);
+  EXPECT_EQ(ndt::type("8 * int32"), a.get_type());
+  a(3).vals() = 100;
+  a(7).vals() = -5;
+  nd::memmap_flush(a);
+
+  // The changes are in the file
+  int32_t file_values[8];
+  ifstream fin("test_memmap.bin", ios::binary);
+  fin.read(reinterpret_cast<char *>(file_values), sizeof(file_values));
+  fin.close();
+  EXPECT_EQ(100, file_values[3]);
+  EXPECT_EQ(-5, file_values[7]);
+  EXPECT_EQ(2, file_values[2]);
+
+  a = nd::array();
+  remove_file("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Struct)
+{
+  struct point {
+    int32_t id;
+    float x, y;
+  } points[3] = {{1, 0.5f, 1.5f}, {2, 2.5f, 3.5f}, {3, 4.5f, 5.5f}};
+  write_binary_file("test_memmap.bin", points, sizeof(points));
+
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("Fixed * {id: int32, x: float32, y: float32}"));
+  EXPECT_EQ(3, a.get_dim_size());
+  EXPECT_EQ(2, a(1, 0).as<int32_t>());
+  EXPECT_EQ(4.5f, a(2, 1).as<float>());
+  EXPECT_EQ(5.5f, a(2, 2).as<float>());
+
+  a = nd::array();
+  remove_file("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Errors)
+{
+  int32_t values[4] = {0, 1, 2, 3};
+  write_binary_file("test_memmap.bin", values, sizeof(values));
+
+  // Too big for the file
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("5 * int32")), invalid_argument);
+  // Not aligned
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"), 2), invalid_argument);
+  // Types that refer to other memory
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * string")), type_error);
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("var * int32")), type_error);
+  EXPECT_THROW(nd::memmap("does_not_exist.bin", ndt::type("Fixed * int32")), runtime_error);
+  // Arrays which aren't memory-mapped
+  EXPECT_THROW(nd::memmap_flush(nd::empty(ndt::type("3 * int32"))), invalid_argument);
+  // Writing in place into a read-only mapping
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"));
+  intptr_t ix[1] = {0};
+  int32_t v[1] = {9};
+  EXPECT_THROW(nd::put(ix, v, kwds("dst", a)), runtime_error);
+  EXPECT_EQ(0, a(0).as<int32_t>());
+  a = nd::array();
+
+  remove_file("test_memmap.bin");
+}
+
 /*
 
 static void write_string_file(const char *fn,
@@ -0,0 +1,175 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/ndjson_reader.hpp>
+
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+static std::string make_ndjson(int count)
+{
+  stringstream ss;
+  for (int i = 0; i < count; ++i) {
+    ss << "{\"user\": \"user" << i << "\", \"tags\": [";
+    for (int j = 0; j < i % 4; ++j) {
+      ss << (j > 0 ? ", " : "") << "\"t" << j << "\"";
+    }
+    ss << "], \"value\": ";
+    if (i % 3 == 0) {
+      ss << "null";
+    } else {
+      ss << i * 0.5;
+    }
+    if (i % 5 == 0) {
+      ss << ", \"ignored\": {\"a\": [1, 2]}";
+    }
+    ss << "}\n";
+    if (i % 7 == 0) {
+      ss << "  \n";
+    }
+  }
+  return ss.str();
+}
+
+// Reads all the batches, checks their sizes, and returns the records as JSON
+static std::string read_all(ndjson_reader &reader, int count)
+{
+  std::string result;
+  nd::array batch;
+  intptr_t total = 0;
+  while (reader.next(batch)) {
+    intptr_t n = batch.get_dim_size();
+    total += n;
+    EXPECT_TRUE(n == reader.get_batch_size() || total == count);
+    for (intptr_t i = 0; i < n; ++i) {
+      result += format_json(batch(i)).as<std::string>();
+      result += "\n";
+    }
+  }
+  EXPECT_EQ(count, total);
+  EXPECT_FALSE(reader.next(batch));
+  return result;
+}
+
+static ndt::type reader_element_type(const ndt::type &tp)
+{
+  return tp.extended<ndt::base_dim_type>()->get_element_type();
+}
+
+static std::string parse_each(const ndt::type &tp, const std::string &text)
+{
+  std::string result;
+  std::istringstream in(text);
+  std::string line;
+  while (getline(in, line)) {
+    if (line.find_first_not_of(" \t\r") != std::string::npos) {
+      result += format_json(parse_json(tp, line.c_str())).as<std::string>();
+      result += "\n";
+    }
+  }
+  return result;
+}
+
+TEST(NDJSONReader, Batches)
+{
+  ndt::type tp("var * {user: string, tags: var * string, value: ?float64}");
+  std::string text = make_ndjson(1000);
+  std::string expected = parse_each(reader_element_type(tp), text);
+
+  std::istringstream in(text);
+  ndjson_reader reader(tp, in, 64);
+  EXPECT_EQ(ndt::type("{user: string, tags: var * string, value: ?float64}"), reader.get_element_type());
+  EXPECT_EQ(expected, read_all(reader, 1000));
+
+  // The same records, with the reads finding partial lines
+  std::istringstream in2(text);
+  ndjson_reader reader2(tp, in2, 1);
+  EXPECT_EQ(expected, read_all(reader2, 1000));
+}
+
+TEST(NDJSONReader, Threads)
+{
+  ndt::type tp("var * {user: string, tags: var * string, value: ?float64}");
+  std::string text = make_ndjson(2000);
+  std::string expected = parse_each(reader_element_type(tp), text);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  std::istringstream in(text);
+  ndjson_reader reader(tp, in, 100, &ectx);
+  EXPECT_EQ(expected, read_all(reader, 2000));
+}
+
+TEST(NDJSONReader, FileDescriptor)
+{
+  std::string text = "[1, 2]\n[3]\n\n[]\n[4, 5, 6]";
+  ofstream fout("test_ndjson.json", ios::binary);
+  fout << text;
+  fout.close();
+
+#ifdef WIN32
+  int fd = _open("test_ndjson.json", _O_RDONLY | _O_BINARY);
+#else
+  int fd = open("test_ndjson.json", O_RDONLY);
+#endif
+  ASSERT_GE(fd, 0);
+  {
+    ndjson_reader reader(ndt::type("var * var * int32"), fd, 3);
+    nd::array batch;
+    ASSERT_TRUE(reader.next(batch));
+    EXPECT_EQ("[[1,2],[3],[]]", format_json(batch).as<std::string>());
+    ASSERT_TRUE(reader.next(batch));
+    EXPECT_EQ("[[4,5,6]]", format_json(batch).as<std::string>());
+    EXPECT_FALSE(reader.next(batch));
+  }
+#ifdef WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+  remove("test_ndjson.json");
+}
+
+TEST(NDJSONReader, Errors)
+{
+  std::istringstream in("{\"x\": 1}\n{\"x\": 2}\n\n{\"x\": \"three\"}\n{\"x\": 4}\n{\"x\": 5}\n");
+  ndjson_reader reader(ndt::type("var * {x: int32}"), in, 2);
+  nd::array batch;
+  ASSERT_TRUE(reader.next(batch));
+  EXPECT_EQ(2, batch.get_dim_size());
+  try {
+    reader.next(batch);
+    FAIL() << "expected the record on line 4 to fail";
+  }
+  catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 4"));
+  }
+  ASSERT_TRUE(reader.next(batch));
+  EXPECT_EQ("[{\"x\":5}]", format_json(batch).as<std::string>());
+  EXPECT_FALSE(reader.next(batch));
+
+  std::istringstream in2("");
+  EXPECT_THROW(ndjson_reader(ndt::type("var * {x: int32}"), in2, 0), invalid_argument);
+  EXPECT_THROW(ndjson_reader(ndt::type("var * {x: T}"), in2), type_error);
+  EXPECT_THROW(ndjson_reader(ndt::type("{x: int32}"), in2), type_error);
+}
@@ -20,6 +20,7 @@
 
 #include <dynd/types/option_type.hpp>
 #include <dynd/kernels/arithmetic.hpp>
+#include <dynd/array_range.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -269,6 +270,31 @@ TEST(Arithmetic, Minus)
   EXPECT_ARRAY_EQ(nd::array({-0.0, -1.0, -2.0, -3.0, -4.0}), -a);
 }
 
+TEST(Arithmetic, ContiguousAndStrided)
+{
+  // Lengths which leave a remainder after any vector width
+  nd::array a = nd::range(37), b = nd::range(37) * 3;
+  nd::array c = a + b, d = a * 2.5, e = -a;
+  for (intptr_t i = 0; i < 37; ++i) {
+    EXPECT_EQ(4 * i, c(i).as<int>());
+    EXPECT_EQ(2.5 * i, d(i).as<double>());
+    EXPECT_EQ(-i, e(i).as<int>());
+  }
+
+  // Every other element, which takes the strided loop
+  nd::array sa = nd::range(38)(irange().by(2)), sb = b(irange().by(2));
+  c = sa + sb;
+  ASSERT_EQ(19, c.get_dim_size());
+  for (intptr_t i = 0; i < 19; ++i) {
+    EXPECT_EQ(2 * i + 6 * i, c(i).as<int>());
+  }
+
+  nd::array f = nd::range(1000.0) / 4.0;
+  for (intptr_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i / 4.0, f(i).as<double>());
+  }
+}
+
 /*
 TEST(Arithmetic, CompoundDiv)
 {
@@ -6,7 +6,10 @@
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <new>
 
 #include "inc_gtest.hpp"
 #include "../dynd_assertions.hpp"
@@ -25,6 +28,30 @@
 using namespace std;
 using namespace dynd;
 
+namespace {
+// While set, heap allocations are counted by the replacement operator new
+// below, which every allocation in the test program goes through
+std::atomic<bool> count_allocations(false);
+std::atomic<int> allocation_count(0);
+} // anonymous namespace
+
+void *operator new(size_t size)
+{
+  if (count_allocations.load()) {
+    ++allocation_count;
+  }
+  void *ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == NULL) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  free(ptr);
+}
+
 TEST(Callable, SingleStridedConstructor)
 {
   nd::callable f(ndt::type("(int32) -> int32"),
@@ -52,7 +79,7 @@ TEST(Callable, Assignment)
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_single, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        small_map<std::string, ndt::type>());
   int int_out = 0;
   char str_in[16] = "3251";
   const char *str_in_ptr = str_in;
@@ -65,7 +92,7 @@ TEST(Callable, Assignment)
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_strided, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        small_map<std::string, ndt::type>());
   int ints_out[3] = {0, 0, 0};
   char strs_in[3][16] = {"123", "4567", "891029"};
   const char *strs_in_ptr = strs_in[0];
@@ -167,17 +194,17 @@ TEST(Callable, DecomposedDynamicCall)
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; });
   ret_tp = af.get_ret_type();
-  EXPECT_EQ(26.5, (*af.get())(ret_tp, 3, types, arrmetas, datas, 0, NULL, map<std::string, ndt::type>()).as<double>());
+  EXPECT_EQ(26.5, (*af.get())(ret_tp, 3, types, arrmetas, datas, 0, NULL, small_map<std::string, ndt::type>()).as<double>());
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "z");
   ret_tp = af.get_ret_type();
   EXPECT_EQ(26.5,
-            (*af.get())(ret_tp, 2, types, arrmetas, datas, 1, values + 2, map<std::string, ndt::type>()).as<double>());
+            (*af.get())(ret_tp, 2, types, arrmetas, datas, 1, values + 2, small_map<std::string, ndt::type>()).as<double>());
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "y", "z");
   ret_tp = af.get_ret_type();
   EXPECT_EQ(26.5,
-            (*af.get())(ret_tp, 1, types, arrmetas, datas, 2, values + 1, map<std::string, ndt::type>()).as<double>());
+            (*af.get())(ret_tp, 1, types, arrmetas, datas, 2, values + 1, small_map<std::string, ndt::type>()).as<double>());
 
   //  af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "x", "y", "z");
   //  ret_tp = af.get_ret_type();
@@ -194,6 +221,127 @@ TEST(Callable, KeywordParsing)
   EXPECT_THROW(af0(1, kwds("y", 4, "y", 2.5)).as<int>(), std::invalid_argument);
 }
 
+TEST(Callable, CallAllocations)
+{
+  nd::callable f(ndt::type("(int32, scale: ?int32, offset: ?int32) -> int32"),
+                 [](ckernel_prefix *DYND_UNUSED(self), char *dst, char *const *src) {
+                   *reinterpret_cast<int32 *>(dst) = *reinterpret_cast<int32 *>(src[0]) + 5;
+                 },
+                 0);
+  nd::array a = 3;
+  nd::array dst = nd::empty(ndt::type::make<int32>());
+
+  // The first call makes the missing values of the keywords, and the
+  // later ones share them, so a call with "dst" makes no allocations
+  f(a, kwds("dst", dst));
+  count_allocations = true;
+  allocation_count = 0;
+  for (int i = 0; i < 10; ++i) {
+    f(a, kwds("dst", dst));
+  }
+  count_allocations = false;
+  EXPECT_EQ(0, allocation_count.load());
+  EXPECT_EQ(8, dst.as<int>());
+
+  // Without it, the only allocation is the result
+  count_allocations = true;
+  allocation_count = 0;
+  nd::array res = f(a);
+  count_allocations = false;
+  EXPECT_EQ(1, allocation_count.load());
+  EXPECT_EQ(8, res.as<int>());
+}
+
+TEST(Callable, Bind)
+{
+  nd::callable af = nd::functional::apply(&func);
+
+  nd::bound_kernel k = af.bind(1, 2.5);
+  EXPECT_EQ(ndt::type::make<double>(), k.get_dst_type());
+  EXPECT_EQ(4.5, k(1, 2.5).as<double>());
+  EXPECT_EQ(7.5, k(2, 3.5).as<double>());
+
+  nd::array dst = nd::empty(ndt::type::make<double>());
+  nd::array src[2] = {3, 0.5};
+  k(dst, 2, src);
+  EXPECT_EQ(6.5, dst.as<double>());
+
+  // Arguments must match the bound signature
+  EXPECT_THROW(k(1), invalid_argument);
+  EXPECT_THROW(k(1.0, 2.5), invalid_argument);
+
+  // Bound over a fixed dimension, the arrmeta is part of the signature
+  nd::callable g = nd::functional::elwise(nd::functional::apply([](int x, int y) { return x * y; }));
+  nd::array a = {1, 2, 3};
+  nd::array b = {4, 5, 6};
+  nd::bound_kernel gk = g.bind(a, b);
+  EXPECT_EQ(ndt::type("3 * int32"), gk.get_dst_type());
+  EXPECT_ARRAY_EQ(nd::array({4, 10, 18}), gk(a, b));
+  EXPECT_ARRAY_EQ(nd::array({-4, -10, -18}), gk(b, nd::array({-1, -2, -3})));
+  EXPECT_THROW(gk(a, nd::array({1, 2})), invalid_argument);
+
+  // Types with memory block references in their arrmeta can't be bound
+  nd::callable h = nd::functional::elwise(nd::functional::apply([](int x) { return x + 1; }));
+  EXPECT_THROW(h.bind(nd::empty(ndt::type("var * int32"))), invalid_argument);
+}
+
+TEST(Callable, KernelCache)
+{
+  nd::callable af = nd::functional::elwise(nd::functional::apply([](int x, int y) { return x + y; }));
+  EXPECT_EQ(NULL, af.get_cache());
+
+  af.enable_cache(2);
+  ASSERT_NE(nullptr, af.get_cache());
+  EXPECT_EQ(2u, af.get_cache()->get_capacity());
+
+  nd::array a = {1, 2, 3};
+  nd::array b = {10, 20, 30};
+  EXPECT_ARRAY_EQ(nd::array({11, 22, 33}), af(a, b));
+  EXPECT_EQ(0u, af.get_cache()->hits());
+  EXPECT_EQ(1u, af.get_cache()->misses());
+  EXPECT_EQ(1u, af.get_cache()->size());
+
+  // Same types and arrmeta, different data
+  EXPECT_ARRAY_EQ(nd::array({12, 24, 36}), af(b, nd::array({2, 4, 6})));
+  EXPECT_EQ(1u, af.get_cache()->hits());
+  EXPECT_EQ(1u, af.get_cache()->misses());
+
+  // A different shape is a different signature
+  EXPECT_ARRAY_EQ(nd::array({3, 7}), af(nd::array({1, 3}), nd::array({2, 4})));
+  EXPECT_EQ(1u, af.get_cache()->hits());
+  EXPECT_EQ(2u, af.get_cache()->misses());
+  EXPECT_EQ(2u, af.get_cache()->size());
+
+  // Calling with a provided destination
+  nd::array dst = nd::empty(ndt::type("3 * int32"));
+  af(a, a, kwds("dst", dst));
+  EXPECT_ARRAY_EQ(nd::array({2, 4, 6}), dst);
+  af(b, b, kwds("dst", dst));
+  EXPECT_ARRAY_EQ(nd::array({20, 40, 60}), dst);
+  EXPECT_EQ(2u, af.get_cache()->size());
+  EXPECT_EQ(2u, af.get_cache()->hits());
+  EXPECT_EQ(3u, af.get_cache()->misses());
+
+  af.disable_cache();
+  EXPECT_EQ(NULL, af.get_cache());
+  EXPECT_ARRAY_EQ(nd::array({11, 22, 33}), af(a, b));
+}
+
+TEST(Callable, KernelCacheKeywords)
+{
+  nd::callable af = nd::functional::apply([](int x, int y) { return x - y; }, "y");
+  af.enable_cache();
+
+  EXPECT_EQ(-3, af(1, kwds("y", 4)).as<int>());
+  EXPECT_EQ(-3, af(1, kwds("y", 4)).as<int>());
+  EXPECT_EQ(1u, af.get_cache()->hits());
+
+  // The keyword value is part of the signature
+  EXPECT_EQ(-4, af(1, kwds("y", 5)).as<int>());
+  EXPECT_EQ(1u, af.get_cache()->hits());
+  EXPECT_EQ(2u, af.get_cache()->misses());
+}
+
 /*
 TEST(Callable, Option)
 {
@@ -205,7 +353,7 @@ TEST(Callable, Option)
                         const callable_type *DYND_UNUSED(self_tp),
                         intptr_t DYND_UNUSED(nsrc),
                         const ndt::type *DYND_UNUSED(src_tp), nd::array &kwds,
-                        const std::map<std::string, ndt::type>
+                        const small_map<std::string, ndt::type>
 &DYND_UNUSED(tp_vars))
     {
       nd::array x = kwds.p("x");
@@ -268,7 +416,7 @@ TEST(Callable, Property)
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_single, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        small_map<std::string, ndt::type>());
   int int_out = 0;
   int date_in = date_ymd::to_days(2013, 12, 30);
   const char *date_in_ptr = reinterpret_cast<const char *>(&date_in);
@@ -294,7 +442,7 @@ TEST(Callable, AssignmentAsExpr)
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_single, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        small_map<std::string, ndt::type>());
   int int_out = 0;
   char str_in[16] = "3251";
   char *str_in_ptr = str_in;
@@ -307,7 +455,7 @@ TEST(Callable, AssignmentAsExpr)
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_strided, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        small_map<std::string, ndt::type>());
   int ints_out[3] = {0, 0, 0};
   char strs_in[3][16] = {"123", "4567", "891029"};
   char *strs_in_ptr = strs_in[0];
@@ -17,6 +17,7 @@
 #include <dynd/kernels/expr_kernel_generator.hpp>
 #include <dynd/func/elwise.hpp>
 #include <dynd/func/take.hpp>
+#include <dynd/func/apply.hpp>
 #include <dynd/func/compose.hpp>
 #include <dynd/func/copy.hpp>
 #include <dynd/types/adapt_type.hpp>
@@ -37,3 +38,19 @@ TEST(Compose, Simple)
   composed(3.1, kwds("dst", a));
   EXPECT_DOUBLE_EQ(sin(3.1), a.as<double>());
 }
+
+TEST(Compose, Strided)
+{
+  nd::callable composed = nd::functional::elwise(
+      nd::functional::compose(nd::functional::apply([](double x) { return x * 2.0; }),
+                              nd::functional::apply([](double x) { return x + 1.0; }), ndt::type::make<double>()));
+  nd::array a = nd::empty(3000, ndt::type::make<double>());
+  for (int i = 0; i < 3000; ++i) {
+    a(i).vals() = i * 0.25;
+  }
+  nd::array b = composed(a);
+  ASSERT_EQ(3000, b.get_dim_size());
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ(i * 0.5 + 1.0, b(i).as<double>());
+  }
+}
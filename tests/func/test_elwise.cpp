@@ -7,6 +7,9 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include "inc_gtest.hpp"
 
@@ -15,9 +18,11 @@
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/expr_kernel_generator.hpp>
 #include <dynd/func/apply.hpp>
+#include <dynd/func/arithmetic.hpp>
 #include <dynd/func/elwise.hpp>
 #include <dynd/func/take.hpp>
 #include <dynd/array.hpp>
+#include <dynd/array_range.hpp>
 #include <dynd/json_parser.hpp>
 #include "../dynd_assertions.hpp"
 
@@ -117,7 +122,7 @@ TEST(Elwise, UnaryExpr_StridedToVarDim)
   const char *src_arrmeta[1] = {in.get()->metadata()};
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, dst_tp, out.get()->metadata(),
                         af.get_type()->get_npos(), &src_tp, src_arrmeta, kernel_request_single,
-                        &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                        &eval::default_eval_context, 0, NULL, small_map<std::string, ndt::type>());
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   usngo(ckb.get(), out.data(), const_cast<char **>(&in_ptr));
   EXPECT_EQ(5, out.get_shape()[0]);
@@ -147,7 +152,7 @@ TEST(Elwise, UnaryExpr_VarToVarDim)
   const char *src_arrmeta[1] = {in.get()->metadata()};
   af.get()->instantiate(af.get()->static_data, 0, NULL, &ckb, 0, out.get_type(), out.get()->metadata(),
                         af.get_type()->get_npos(), &in.get_type(), src_arrmeta, kernel_request_single,
-                        &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                        &eval::default_eval_context, 0, NULL, small_map<std::string, ndt::type>());
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   usngo(ckb.get(), out.data(), const_cast<char **>(&in_ptr));
   EXPECT_EQ(5, out.get_shape()[0]);
@@ -260,3 +265,64 @@ TEST(Elwise, Simple)
 //  EXPECT_ARRAY_EQ(nd::array({3, 5, 7}).to_cuda_device(), baf(a, b));
 #endif
 }
+
+static std::mutex parallel_mutex;
+static std::set<std::thread::id> parallel_thread_ids;
+
+static int record_thread(int x)
+{
+  std::lock_guard<std::mutex> lock(parallel_mutex);
+  parallel_thread_ids.insert(std::this_thread::get_id());
+  return x + 1;
+}
+
+TEST(Elwise, Parallel)
+{
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+
+  nd::array a = nd::range(1000);
+  nd::array b = nd::range(1000) * 3;
+  nd::array c = nd::add.call_with_ectx(&ectx, a, b);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(4 * i, c(i).as<int>());
+  }
+
+  // Broadcasting across the split dimension, with a strided operand
+  nd::array d = nd::empty(ndt::type("9 * 10 * float64"));
+  d.vals() = 1.0;
+  nd::array e = nd::multiply.call_with_ectx(&ectx, d, nd::range(20.0)(irange().by(2)));
+  EXPECT_ARRAY_EQ(nd::range(20.0)(irange().by(2)), e(8));
+  EXPECT_ARRAY_EQ(nd::range(20.0)(irange().by(2)), e(0));
+
+  // A callable that isn't declared thread safe stays on the calling thread
+  nd::callable child = nd::functional::apply(&record_thread);
+  nd::callable f = nd::functional::elwise(child);
+  parallel_thread_ids.clear();
+  EXPECT_ARRAY_EQ(nd::range(1000) + 1, f.call_with_ectx(&ectx, a));
+  EXPECT_EQ(1u, parallel_thread_ids.size());
+
+  // Once it is declared thread safe, its chunks run on the workers
+  child.set_thread_safe(true);
+  f = nd::functional::elwise(child);
+  parallel_thread_ids.clear();
+  EXPECT_ARRAY_EQ(nd::range(1000) + 1, f.call_with_ectx(&ectx, a));
+  EXPECT_LT(1u, parallel_thread_ids.size());
+
+  // A var inner dim is allocated from the destination's one blockref, so
+  // it stays on the calling thread
+  std::string json = "[";
+  for (int i = 0; i < 20000; ++i) {
+    json += (i > 0 ? ", [" : "[") + std::to_string(i) + ", " + std::to_string(i % 7) + "]";
+  }
+  json += "]";
+  nd::array v = parse_json(ndt::type("20000 * var * int32"), json.c_str());
+  nd::array w = nd::add.call_with_ectx(&ectx, v, v);
+  ASSERT_EQ(ndt::type("20000 * var * int32"), w.get_type());
+  for (int i = 0; i < 20000; ++i) {
+    ASSERT_EQ(2, w(i).get_dim_size());
+    EXPECT_EQ(2 * i, w(i, 0).as<int>());
+    EXPECT_EQ(2 * (i % 7), w(i, 1).as<int>());
+  }
+}
@@ -0,0 +1,157 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/func/groupby.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/types/categorical_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// The func keyword as a string array, rather than an array of characters
+static nd::array func_name(const char *name)
+{
+  return name;
+}
+
+TEST(GroupBy, Simple)
+{
+  nd::array keys = parse_json("6 * int32", "[3, 1, 3, 2, 1, 3]");
+  nd::array values = parse_json("6 * float64", "[1, 2, 3, 4, 5, 6]");
+
+  nd::array r = nd::groupby(keys, values);
+  EXPECT_EQ(ndt::type("var * {key: int32, value: float64}"), r.get_type());
+  ASSERT_EQ(3, r.get_dim_size());
+  EXPECT_EQ(3, r(0).p("key").as<int>());
+  EXPECT_EQ(10.0, r(0).p("value").as<double>());
+  EXPECT_EQ(1, r(1).p("key").as<int>());
+  EXPECT_EQ(7.0, r(1).p("value").as<double>());
+  EXPECT_EQ(2, r(2).p("key").as<int>());
+  EXPECT_EQ(4.0, r(2).p("value").as<double>());
+
+  r = nd::groupby(keys, values, kwds("func", func_name("min")));
+  EXPECT_EQ(1.0, r(0).p("value").as<double>());
+  EXPECT_EQ(2.0, r(1).p("value").as<double>());
+  EXPECT_EQ(4.0, r(2).p("value").as<double>());
+
+  r = nd::groupby(keys, values, kwds("func", func_name("max")));
+  EXPECT_EQ(6.0, r(0).p("value").as<double>());
+  EXPECT_EQ(5.0, r(1).p("value").as<double>());
+
+  r = nd::groupby(keys, values, kwds("func", func_name("mean")));
+  EXPECT_DOUBLE_EQ(10.0 / 3, r(0).p("value").as<double>());
+  EXPECT_EQ(3.5, r(1).p("value").as<double>());
+  EXPECT_EQ(4.0, r(2).p("value").as<double>());
+
+  r = nd::groupby(parse_json("0 * int32", "[]"), parse_json("0 * float64", "[]"));
+  EXPECT_EQ(0, r.get_dim_size());
+}
+
+TEST(GroupBy, Keys)
+{
+  nd::array values = parse_json("5 * int64", "[1, 2, 3, 4, 5]");
+
+  // Strings
+  nd::array r = nd::groupby(parse_json("5 * string", "[\"b\", \"a\", \"b\", \"ccc\", \"a\"]"), values);
+  ASSERT_EQ(3, r.get_dim_size());
+  EXPECT_EQ("b", r(0).p("key").as<std::string>());
+  EXPECT_EQ(4, r(0).p("value").as<int64_t>());
+  EXPECT_EQ("a", r(1).p("key").as<std::string>());
+  EXPECT_EQ(7, r(1).p("value").as<int64_t>());
+  EXPECT_EQ("ccc", r(2).p("key").as<std::string>());
+
+  // Structs of several key columns
+  r = nd::groupby(parse_json("5 * {x: int32, y: string}",
+                             "[[1, \"a\"], [1, \"b\"], [1, \"a\"], [2, \"a\"], [1, \"b\"]]"),
+                  values, kwds("func", func_name("max")));
+  EXPECT_EQ(ndt::type("var * {key: {x: int32, y: string}, value: int64}"), r.get_type());
+  ASSERT_EQ(3, r.get_dim_size());
+  EXPECT_EQ(1, r(0).p("key").p("x").as<int>());
+  EXPECT_EQ("a", r(0).p("key").p("y").as<std::string>());
+  EXPECT_EQ(3, r(0).p("value").as<int64_t>());
+  EXPECT_EQ("b", r(1).p("key").p("y").as<std::string>());
+  EXPECT_EQ(5, r(1).p("value").as<int64_t>());
+  EXPECT_EQ(2, r(2).p("key").p("x").as<int>());
+
+  // Categoricals
+  const char *cat_vals[] = {"foo", "bar", "foo", "foo", "baz"};
+  nd::array cats = cat_vals;
+  cats = cats.ucast(ndt::factor_categorical(cats)).eval();
+  r = nd::groupby(cats, values);
+  ASSERT_EQ(3, r.get_dim_size());
+  EXPECT_EQ("foo", r(0).p("key").as<std::string>());
+  EXPECT_EQ(8, r(0).p("value").as<int64_t>());
+  EXPECT_EQ("baz", r(2).p("key").as<std::string>());
+  EXPECT_EQ(5, r(2).p("value").as<int64_t>());
+
+  // Floats group -0.0 with 0.0
+  r = nd::groupby(parse_json("3 * float64", "[0.0, -0.0, 1.5]"), parse_json("3 * int64", "[1, 2, 3]"));
+  ASSERT_EQ(2, r.get_dim_size());
+  EXPECT_EQ(3, r(0).p("value").as<int64_t>());
+}
+
+TEST(GroupBy, ValueColumns)
+{
+  nd::array keys = parse_json("4 * int32", "[1, 2, 1, 1]");
+  nd::array values = parse_json("4 * {a: int32, b: float64}", "[[1, 0.5], [2, 1.5], [3, 2.5], [5, -1]]");
+
+  nd::array r = nd::groupby(keys, values, kwds("func", func_name("mean")));
+  EXPECT_EQ(ndt::type("var * {key: int32, value: {a: int32, b: float64}}"), r.get_type());
+  ASSERT_EQ(2, r.get_dim_size());
+  EXPECT_EQ(3, r(0).p("value").p("a").as<int>());
+  EXPECT_EQ(2.0 / 3, r(0).p("value").p("b").as<double>());
+  EXPECT_EQ(2, r(1).p("value").p("a").as<int>());
+  EXPECT_EQ(1.5, r(1).p("value").p("b").as<double>());
+}
+
+TEST(GroupBy, Parallel)
+{
+  const intptr_t n = 1000;
+  nd::array keys = nd::empty(n, ndt::type::make<int32_t>());
+  nd::array values = nd::empty(n, ndt::type::make<int64_t>());
+  for (intptr_t i = 0; i < n; ++i) {
+    keys(i).vals() = static_cast<int32_t>((i * 7) % 37);
+    values(i).vals() = i;
+  }
+  nd::array expected = nd::groupby(keys, values);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+  nd::array r = nd::groupby.call_with_ectx(&ectx, keys, values);
+  nd::array rmax = nd::groupby.call_with_ectx(&ectx, keys, values, kwds("func", func_name("max")));
+
+  ASSERT_EQ(37, r.get_dim_size());
+  int64_t total = 0;
+  for (intptr_t g = 0; g < 37; ++g) {
+    EXPECT_EQ(expected(g).p("key").as<int>(), r(g).p("key").as<int>());
+    EXPECT_EQ(expected(g).p("value").as<int64_t>(), r(g).p("value").as<int64_t>());
+    total += r(g).p("value").as<int64_t>();
+    // The largest i with (7 * i) % 37 == key
+    int key = r(g).p("key").as<int>();
+    int64_t largest = n - 1;
+    while ((largest * 7) % 37 != key) {
+      --largest;
+    }
+    EXPECT_EQ(largest, rmax(g).p("value").as<int64_t>());
+  }
+  EXPECT_EQ(n * (n - 1) / 2, total);
+}
+
+TEST(GroupBy, Errors)
+{
+  nd::array keys = parse_json("3 * int32", "[1, 2, 1]");
+  nd::array values = parse_json("3 * float64", "[1, 2, 3]");
+  EXPECT_THROW(nd::groupby(keys, values, kwds("func", func_name("median"))), invalid_argument);
+  EXPECT_THROW(nd::groupby(parse_json("3 * float16", "[1, 2, 1]"), values), type_error);
+  EXPECT_THROW(nd::groupby(keys, parse_json("3 * string", "[\"a\", \"b\", \"c\"]")), type_error);
+}
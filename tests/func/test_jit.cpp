@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/apply.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/func/compose.hpp>
+#include <dynd/func/elwise.hpp>
+#include <dynd/jit.hpp>
+#include <dynd/lazy_expr.hpp>
+
+#ifdef DYND_LLVM
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+// A kernel which can only run as the IR registered for it below
+struct abort_kernel : nd::base_kernel<abort_kernel, 1> {
+  void single(char *DYND_UNUSED(dst), char *const *DYND_UNUSED(src))
+  {
+    abort();
+  }
+};
+
+// Doubles a float64
+const char *double_ir = "define void @double_it(i8* %self, i8* %dst, i8** %src) {\n"
+                        "  %p = load i8*, i8** %src\n"
+                        "  %sp = bitcast i8* %p to double*\n"
+                        "  %x = load double, double* %sp\n"
+                        "  %y = fmul double %x, 2.0\n"
+                        "  %dp = bitcast i8* %dst to double*\n"
+                        "  store double %y, double* %dp\n"
+                        "  ret void\n"
+                        "}\n";
+} // anonymous namespace
+
+TEST(JIT, RegisterIR)
+{
+  void *func = reinterpret_cast<void *>(&abort_kernel::single_wrapper::func);
+  EXPECT_TRUE(jit::register_kernel_ir(func, double_ir));
+  EXPECT_EQ(double_ir, jit::get_kernel_ir(func));
+  EXPECT_EQ(NULL, jit::get_kernel_ir(reinterpret_cast<void *>(&abort)));
+}
+
+TEST(JIT, InlinesRegisteredIR)
+{
+  jit::register_kernel_ir(reinterpret_cast<void *>(&abort_kernel::single_wrapper::func), double_ir);
+
+  // The first kernel is inlined from its IR, and the second is called by address
+  nd::callable doubled = nd::callable::make<abort_kernel>(ndt::type("(float64) -> float64"), 0);
+  nd::callable composed = nd::functional::elwise(nd::functional::compose(
+      doubled, nd::functional::apply([](double x) { return x + 1.0; }), ndt::type::make<double>()));
+
+  double vals[1000];
+  for (int i = 0; i < 1000; ++i) {
+    vals[i] = i * 0.25;
+  }
+  nd::array a = composed(vals);
+  ASSERT_EQ(1000, a.get_dim_size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i * 0.5 + 1.0, a(i).as<double>());
+  }
+
+  // A kernel tree of the same shape reuses the compiled loop
+  a = composed(nd::array(vals)(irange().by(2)));
+  ASSERT_EQ(500, a.get_dim_size());
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(i + 1.0, a(i).as<double>());
+  }
+}
+
+static void plus_one(ckernel_prefix *DYND_UNUSED(self), char *dst, char *const *src)
+{
+  *reinterpret_cast<double *>(dst) = *reinterpret_cast<double *>(src[0]) + 1.0;
+}
+
+static void multiply(ckernel_prefix *DYND_UNUSED(self), char *dst, char *const *src)
+{
+  *reinterpret_cast<double *>(dst) = *reinterpret_cast<double *>(src[0]) * *reinterpret_cast<double *>(src[1]);
+}
+
+TEST(JIT, CompileFused)
+{
+  EXPECT_EQ(NULL, jit::compile_fused(1, std::vector<jit::fused_node>()));
+
+  // (x + 1) * (y + 1), with the sums in temporaries
+  std::vector<jit::fused_node> nodes(3);
+  nodes[0].func = &plus_one;
+  nodes[0].src.push_back(0);
+  nodes[1].func = &plus_one;
+  nodes[1].src.push_back(1);
+  nodes[2].func = &multiply;
+  nodes[2].src.push_back(2);
+  nodes[2].src.push_back(3);
+  for (int i = 0; i < 3; ++i) {
+    nodes[i].dst_size = sizeof(double);
+    nodes[i].dst_alignment = sizeof(double);
+  }
+  jit::fused_strided_t func = jit::compile_fused(2, nodes);
+  ASSERT_TRUE(func != NULL);
+  EXPECT_EQ(func, jit::compile_fused(2, nodes));
+
+  double x[10], y = 3.0, dst[10];
+  for (int i = 0; i < 10; ++i) {
+    x[i] = i;
+  }
+  ckernel_prefix *children[3] = {NULL, NULL, NULL};
+  char *src[2] = {reinterpret_cast<char *>(x), reinterpret_cast<char *>(&y)};
+  intptr_t src_stride[2] = {sizeof(double), 0};
+  func(children, reinterpret_cast<char *>(dst), sizeof(double), src, src_stride, 10);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ((i + 1.0) * 4.0, dst[i]);
+  }
+}
+
+TEST(JIT, FusesLazyExpr)
+{
+  // a * b + c - 1 runs as one compiled loop, with mixed source types
+  nd::array a = nd::empty(1000, ndt::type::make<double>());
+  nd::array b = nd::empty(1000, ndt::type::make<float>());
+  nd::array c = nd::empty(1000, ndt::type::make<int32_t>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).vals() = i * 0.5;
+    b(i).vals() = (i % 7) + 1.0f;
+    c(i).vals() = -i;
+  }
+
+  nd::array r = (nd::lazy(a) * b + c - 1.0).eval();
+  ASSERT_EQ(ndt::type("1000 * float64"), r.get_type());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i * 0.5 * ((i % 7) + 1.0) - i - 1.0, r(i).as<double>());
+  }
+
+  // A strided source and a broadcast scalar
+  r = (nd::lazy(a(irange().by(2))) * 2.0 + a(irange().by(2))).eval();
+  ASSERT_EQ(ndt::type("500 * float64"), r.get_type());
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(i * 3.0, r(i).as<double>());
+  }
+}
+
+#endif // DYND_LLVM
@@ -10,6 +10,7 @@
 
 #include "inc_gtest.hpp"
 
+#include <dynd/array_range.hpp>
 #include <dynd/func/min.hpp>
 #include <dynd/func/max.hpp>
 
@@ -40,6 +41,20 @@ TEST(Min, FixedDimVarDim)
   EXPECT_ARRAY_EQ(-4.0, nd::min(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
 
+TEST(Min, Long)
+{
+  // Long enough for the accumulator loop, with a tail after it
+  nd::array a = nd::range(1001.0);
+  a(500).vals() = -3.5;
+  EXPECT_ARRAY_EQ(-3.5, nd::min(a));
+  EXPECT_ARRAY_EQ(-3.5, nd::min(a(irange().by(2))));
+  EXPECT_ARRAY_EQ(1.0, nd::min(a(irange(1, 1001).by(2))));
+
+  nd::array b = nd::range(1003);
+  b(1002).vals() = -7;
+  EXPECT_ARRAY_EQ(-7, nd::min(b));
+}
+
 TEST(Max, FixedDim)
 {
   EXPECT_ARRAY_EQ(9, nd::max(nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
@@ -61,3 +76,43 @@ TEST(Max, FixedDimVarDim)
   EXPECT_ARRAY_EQ(10, nd::max(parse_json(ndt::type("2 * var * int32"), "[[0], [10, 2]]")));
   EXPECT_ARRAY_EQ(23.5, nd::max(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
+
+TEST(Max, Long)
+{
+  // Long enough for the accumulator loop, with a tail after it
+  nd::array a = nd::range(1001.0);
+  a(3).vals() = 2000.5;
+  EXPECT_ARRAY_EQ(2000.5, nd::max(a));
+  EXPECT_ARRAY_EQ(1000.0, nd::max(a(irange().by(2))));
+  EXPECT_ARRAY_EQ(2000.5, nd::max(a(irange(1, 1001).by(2))));
+
+  nd::array b = nd::range(1003);
+  EXPECT_ARRAY_EQ(1002, nd::max(b));
+}
+
+TEST(Max, Parallel)
+{
+  eval::eval_context ectx = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  nd::array a = nd::range(1001.0);
+  a(3).vals() = 2000.5;
+  a(997).vals() = -7.0;
+  EXPECT_ARRAY_EQ(2000.5, nd::max(a));
+  EXPECT_ARRAY_EQ(-7.0, nd::min(a));
+
+  // The rows repeat, so the split dimension is 16 times longer
+  nd::array rows = nd::array{{0, 9, 2}, {7, 1, 8}, {3, 4, -5}, {6, 5, 4}};
+  nd::array b = nd::empty(ndt::type("64 * 3 * int32"));
+  for (intptr_t i = 0; i < 64; ++i) {
+    b(i).vals() = rows(i % 4);
+  }
+  EXPECT_ARRAY_EQ((nd::array{7, 9, 8}), nd::max(b, kwds("axes", nd::array{0})));
+  EXPECT_ARRAY_EQ((nd::array{0, 1, -5, 4}), nd::min(b, kwds("axes", nd::array{1}))(irange(0, 4)));
+
+  eval::default_eval_context.deterministic_reduction = false;
+  EXPECT_ARRAY_EQ((nd::array{0, 1, -5}), nd::min(b, kwds("axes", nd::array{0})));
+
+  eval::default_eval_context = ectx;
+}
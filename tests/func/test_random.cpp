@@ -12,6 +12,7 @@
 #include "dynd_assertions.hpp"
 
 #include <dynd/func/random.hpp>
+#include <dynd/random_engines.hpp>
 
 typedef testing::Types<int32_t, int64_t, uint32_t, uint64_t> IntegralTypes;
 typedef testing::Types<float, double> RealTypes;
@@ -61,4 +62,108 @@ TYPED_TEST_P(Random, Uniform)
 
 REGISTER_TYPED_TEST_CASE_P(Random, Uniform);
 INSTANTIATE_TYPED_TEST_CASE_P(Integral, Random, IntegralTypes);
-INSTANTIATE_TYPED_TEST_CASE_P(Real, Random, RealTypes);
\ No newline at end of file
+INSTANTIATE_TYPED_TEST_CASE_P(Real, Random, RealTypes);
+
+TEST(RandomEngine, KnownAnswers)
+{
+  // From the Random123 known answer tests
+  uint32 counter[4] = {0, 0, 0, 0}, key[2] = {0, 0}, out[4];
+  nd::random::philox4x32::block(counter, key, out);
+  EXPECT_EQ(0x6627e8d5U, out[0]);
+  EXPECT_EQ(0xe169c58dU, out[1]);
+  EXPECT_EQ(0xbc57ac4cU, out[2]);
+  EXPECT_EQ(0x9b00dbd8U, out[3]);
+
+  // From the PCG reference implementation, pcg32_srandom(42, 54)
+  nd::random::pcg32 pcg(42, 54);
+  EXPECT_EQ(0xa15c02b7U, pcg.next32());
+  EXPECT_EQ(0x7b47f409U, pcg.next32());
+  EXPECT_EQ(0xba1d3330ULL << 32 | 0x83d2f293ULL, pcg());
+}
+
+TEST(RandomEngine, PhiloxSeek)
+{
+  nd::random::philox4x32 g(7);
+  uint64 sequential[9];
+  g.fill(sequential, 9);
+  EXPECT_EQ(9u, g.tell());
+
+  for (uint64 i = 0; i < 9; ++i) {
+    nd::random::philox4x32 h(7);
+    h.seek(i);
+    EXPECT_EQ(sequential[i], h());
+  }
+
+  // Bulk fills starting on either half of a block
+  nd::random::philox4x32 h(7);
+  h.seek(3);
+  uint64 bulk[5];
+  h.fill(bulk, 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(sequential[3 + i], bulk[i]);
+  }
+}
+
+TEST(Random, Seed)
+{
+  ndt::type dst_tp = ndt::type("1000 * float64");
+  for (const char *engine_name : {"philox", "pcg32", "xoshiro256**"}) {
+    nd::array engine = engine_name;
+    nd::array a = nd::random::uniform(kwds("seed", 12345, "engine", engine, "dst_tp", dst_tp));
+    nd::array b = nd::random::uniform(kwds("seed", 12345, "engine", engine, "dst_tp", dst_tp));
+    nd::array c = nd::random::uniform(kwds("seed", 54321, "engine", engine, "dst_tp", dst_tp));
+    EXPECT_ARRAY_EQ(a, b);
+
+    intptr_t nequal = 0;
+    for (intptr_t i = 0; i < 1000; ++i) {
+      double value = a(i).as<double>();
+      EXPECT_LE(0.0, value);
+      EXPECT_GT(1.0, value);
+      nequal += value == c(i).as<double>();
+    }
+    EXPECT_EQ(0, nequal);
+  }
+
+  EXPECT_THROW(nd::random::uniform(kwds("engine", "mt19937", "dst_tp", dst_tp)), invalid_argument);
+}
+
+TEST(Random, Bounds)
+{
+  nd::array a = nd::random::uniform(kwds("a", -3, "b", 3, "seed", 1, "dst_tp", ndt::type("2000 * int32")));
+  bool seen[7] = {};
+  for (intptr_t i = 0; i < 2000; ++i) {
+    int32 value = a(i).as<int32>();
+    ASSERT_LE(-3, value);
+    ASSERT_GE(3, value);
+    seen[value + 3] = true;
+  }
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_TRUE(seen[i]);
+  }
+
+  // The default range of an unsigned type is all of its values
+  a = nd::random::uniform(kwds("seed", 1, "dst_tp", ndt::type("100 * uint64")));
+  intptr_t nlarge = 0;
+  for (intptr_t i = 0; i < 100; ++i) {
+    nlarge += a(i).as<uint64>() > (numeric_limits<uint64>::max() >> 1);
+  }
+  EXPECT_LT(20, nlarge);
+  EXPECT_GT(80, nlarge);
+}
+
+TEST(Random, ParallelCounterBased)
+{
+  ndt::type dst_tp = ndt::type("3 * 5000 * complex[float64]");
+  nd::array serial = nd::random::uniform(kwds("seed", 99, "dst_tp", dst_tp));
+
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 300;
+  nd::array parallel = nd::random::uniform(kwds("seed", 99, "dst_tp", dst_tp));
+  eval::default_eval_context.nthreads = 3;
+  nd::array parallel3 = nd::random::uniform(kwds("seed", 99, "dst_tp", dst_tp));
+  eval::default_eval_context = prev;
+
+  EXPECT_ARRAY_EQ(serial, parallel);
+  EXPECT_ARRAY_EQ(serial, parallel3);
+}
@@ -10,6 +10,7 @@
 
 #include "inc_gtest.hpp"
 
+#include <dynd/array_range.hpp>
 #include <dynd/func/reduction.hpp>
 
 #include "dynd_assertions.hpp"
@@ -163,6 +164,34 @@ TEST(Reduction, BuiltinSum_Lift3D_StridedStridedStrided_ReduceBroadcastReduce)
                     kwds("axes", nd::array({0, 2}))));
 }
 
+TEST(Reduction, ParallelWithIdentity)
+{
+  nd::callable child = nd::functional::apply([](double x, double y) { return x + y; });
+  child.set_thread_safe(true);
+  nd::callable f = nd::functional::reduction(child);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+
+  // The identity isn't neutral, so it must be applied once, not once per chunk
+  nd::array a = nd::range(1000.0);
+  EXPECT_ARRAY_EQ(100.0 + 499500.0, f.call_with_ectx(&ectx, a, kwds("identity", 100.0)));
+
+  nd::array b = nd::empty(ndt::type("100 * 3 * float64"));
+  for (int i = 0; i < 100; ++i) {
+    b(i).vals() = nd::array{1.0, 2.0, 3.0} * i;
+  }
+  EXPECT_ARRAY_EQ((initializer_list<double>{100.0 + 4950.0, 100.0 + 9900.0, 100.0 + 14850.0}),
+                  f.call_with_ectx(&ectx, b, kwds("axes", nd::array{0}, "identity", 100.0)));
+  EXPECT_ARRAY_EQ(100.0 + 6.0 * 4950.0, f.call_with_ectx(&ectx, b, kwds("identity", 100.0)));
+  // Broadcasting the split dimension applies it once per destination element
+  nd::array r = f.call_with_ectx(&ectx, b, kwds("axes", nd::array{1}, "identity", 100.0));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(100.0 + 6.0 * i, r(i).as<double>());
+  }
+}
+
 TEST(Reduction, Except)
 {
   // Cannot have a null child
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <thread>
 
 #include "inc_gtest.hpp"
 
@@ -94,3 +96,101 @@ TEST(CallableRegistry, Trig)
   EXPECT_FLOAT_EQ(powf(1.5f, 2.25f), af(1.5f, 2.25f).as<float>());
   EXPECT_DOUBLE_EQ(pow(1.5, 2.25), af(1.5, 2.25).as<double>());
 }
+
+static int make_count = 0;
+
+static nd::callable make_test_sin()
+{
+  ++make_count;
+  return func::get_regfunction("sin");
+}
+
+TEST(CallableRegistry, Lazy)
+{
+  // The callable is made by the first lookup, and only once
+  make_count = 0;
+  func::set_lazy_regfunction("test_lazy_sin", &make_test_sin);
+  EXPECT_EQ(0, make_count);
+  nd::callable af = func::get_regfunction("test_lazy_sin");
+  EXPECT_EQ(1, make_count);
+  EXPECT_DOUBLE_EQ(sin(1.0), af(1.0).as<double>());
+  af = func::get_regfunction(std::string("test_lazy_sin"));
+  EXPECT_EQ(1, make_count);
+
+  // Setting a callable replaces the lazy one
+  func::set_regfunction("test_lazy_sin", func::get_regfunction("cos"));
+  EXPECT_DOUBLE_EQ(cos(1.0), func::get_regfunction("test_lazy_sin")(1.0).as<double>());
+  EXPECT_EQ(1, make_count);
+
+  std::vector<std::string> names = func::get_regfunction_names();
+  EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+  EXPECT_TRUE(std::binary_search(names.begin(), names.end(), "test_lazy_sin"));
+  EXPECT_TRUE(std::binary_search(names.begin(), names.end(), "arctan2"));
+  EXPECT_EQ(names.size(), func::get_regfunctions().size());
+
+  EXPECT_THROW(func::get_regfunction("test_not_registered"), invalid_argument);
+}
+
+TEST(CallableRegistry, Concurrent)
+{
+  // Lookups from several threads while the table grows with new names
+  std::vector<std::thread> threads;
+  std::atomic<int> failures(0);
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([t, &failures] {
+      for (int i = 0; i < 200; ++i) {
+        if (t == 0) {
+          func::set_regfunction("test_concurrent_" + std::to_string(i), func::get_regfunction("sin"));
+        } else if (func::get_regfunction("tanh").is_null() || func::get_regfunction("power").is_null()) {
+          ++failures;
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  EXPECT_EQ(0, failures.load());
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_FALSE(func::get_regfunction("test_concurrent_" + std::to_string(i)).is_null());
+  }
+}
+
+TEST(CallableRegistry, ConcurrentSet)
+{
+  // Lookups of each name while it is being set, which either don't find
+  // it yet or find its callable. The names stay in the global registry, so
+  // there are only enough of them to grow its table a couple of times.
+  const int n = 300;
+  std::atomic<int> next(0);
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  threads.push_back(std::thread([&next] {
+    nd::callable af = func::get_regfunction("sin");
+    for (int i = 0; i < n; ++i) {
+      func::set_regfunction("test_racing_" + std::to_string(i), af);
+      next.store(i + 1);
+    }
+  }));
+  for (int t = 0; t < 3; ++t) {
+    threads.push_back(std::thread([&next, &failures] {
+      while (next.load() < n) {
+        int i = next.load();
+        std::string name = "test_racing_" + std::to_string(i);
+        for (int k = 0; k < 16 && next.load() == i; ++k) {
+          try {
+            if (func::get_regfunction(name).is_null()) {
+              ++failures;
+            }
+          } catch (const invalid_argument &) {
+          }
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  EXPECT_EQ(0, failures.load());
+  EXPECT_FALSE(func::get_regfunction("test_racing_" + std::to_string(n - 1)).is_null());
+}
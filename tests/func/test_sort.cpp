@@ -7,10 +7,15 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "inc_gtest.hpp"
 
 #include <dynd/sort.hpp>
+#include <dynd/func/comparison.hpp>
+#include <dynd/types/string_type.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -27,3 +32,198 @@ TEST(Sort, 1D)
   nd::sort(a);
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
+
+TEST(Sort, Radix)
+{
+  // Long enough for the radix sort, with negative values and repeats
+  vector<int64> values(5000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int64>((i * 7919) % 1237) - 600;
+  }
+  nd::array a = nd::empty(static_cast<intptr_t>(values.size()), ndt::type::make<int64>());
+  for (size_t i = 0; i < values.size(); ++i) {
+    a(i).vals() = values[i];
+  }
+
+  nd::sort(a);
+  std::sort(values.begin(), values.end());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], a(i).as<int64>());
+  }
+
+  nd::array b = nd::empty(3000, ndt::type::make<uint8>());
+  for (intptr_t i = 0; i < 3000; ++i) {
+    b(i).vals() = static_cast<uint8>(255 - i % 256);
+  }
+  nd::sort(b);
+  for (intptr_t i = 1; i < 3000; ++i) {
+    EXPECT_LE(b(i - 1).as<uint8>(), b(i).as<uint8>());
+  }
+}
+
+TEST(Sort, FloatingPoint)
+{
+  double nan = numeric_limits<double>::quiet_NaN();
+
+  nd::array a{3.0, nan, 0.0, -1.5, -0.0, 2.0};
+  nd::sort(a);
+  EXPECT_EQ(-1.5, a(0).as<double>());
+  EXPECT_TRUE(signbit(a(1).as<double>()));
+  EXPECT_EQ(0.0, a(1).as<double>());
+  EXPECT_FALSE(signbit(a(2).as<double>()));
+  EXPECT_EQ(0.0, a(2).as<double>());
+  EXPECT_EQ(2.0, a(3).as<double>());
+  EXPECT_EQ(3.0, a(4).as<double>());
+  EXPECT_TRUE(std::isnan(a(5).as<double>()));
+
+  // The radix sort puts values in the same order
+  nd::array b = nd::empty(2000, ndt::type::make<float>());
+  for (intptr_t i = 0; i < 2000; ++i) {
+    float value = (i % 10 == 0) ? numeric_limits<float>::quiet_NaN() : static_cast<float>((i * 37) % 101) - 50.5f;
+    if (i == 1) {
+      value = -0.0f;
+    } else if (i == 2) {
+      value = 0.0f;
+    }
+    b(i).vals() = value;
+  }
+  nd::sort(b);
+  for (intptr_t i = 0; i < 1800; ++i) {
+    EXPECT_FALSE(std::isnan(b(i).as<float>()));
+    if (i > 0) {
+      EXPECT_FALSE(nd::total_order(b(i), b(i - 1)).as<bool>());
+    }
+  }
+  for (intptr_t i = 1800; i < 2000; ++i) {
+    EXPECT_TRUE(std::isnan(b(i).as<float>()));
+  }
+}
+
+TEST(Sort, Strided)
+{
+  nd::array a = nd::empty(2, 5, ndt::type::make<int32>());
+  a(0).vals() = {5, 3, 9, 1, 7};
+  a(1).vals() = {0, 0, 0, 0, 0};
+
+  // A column of a row-major array is strided
+  nd::array b = nd::empty(5, 2, ndt::type::make<int32>());
+  b(irange(), 0).vals() = a(0);
+  b(irange(), 1).vals() = a(1);
+  nd::sort(b(irange(), 0));
+  EXPECT_ARRAY_EQ((nd::array{1, 3, 5, 7, 9}), b(irange(), 0));
+  EXPECT_ARRAY_EQ((nd::array{0, 0, 0, 0, 0}), b(irange(), 1));
+}
+
+TEST(Sort, Stable)
+{
+  nd::array a{4, 2, 8, 2, 1};
+  nd::sort(a, kwds("stable", true));
+  EXPECT_ARRAY_EQ((nd::array{1, 2, 2, 4, 8}), a);
+
+  nd::array b{"delta", "alpha", "charlie", "bravo"};
+  nd::sort(b, kwds("stable", true));
+  EXPECT_ARRAY_EQ((nd::array{"alpha", "bravo", "charlie", "delta"}), b);
+
+  b = {"delta", "alpha", "charlie", "bravo"};
+  nd::sort(b);
+  EXPECT_ARRAY_EQ((nd::array{"alpha", "bravo", "charlie", "delta"}), b);
+}
+
+TEST(ArgSort, 1D)
+{
+  nd::array a{2.5, -1.0, 7.0, 0.0};
+  EXPECT_ARRAY_EQ((nd::array{1, 3, 0, 2}).ucast<int64>().eval(), nd::argsort(a));
+
+  // Equal values keep their order with a stable sort
+  a = {3, 1, 3, 1, 2};
+  EXPECT_ARRAY_EQ((nd::array{1, 3, 4, 0, 2}).ucast<int64>().eval(), nd::argsort(a, kwds("stable", true)));
+
+  nd::array b{"pear", "apple", "fig"};
+  EXPECT_ARRAY_EQ((nd::array{1, 2, 0}).ucast<int64>().eval(), nd::argsort(b));
+}
+
+TEST(ArgSort, Radix)
+{
+  double nan = numeric_limits<double>::quiet_NaN();
+
+  nd::array a = nd::empty(4000, ndt::type::make<double>());
+  for (intptr_t i = 0; i < 4000; ++i) {
+    a(i).vals() = (i % 100 == 7) ? nan : static_cast<double>((i * 131) % 97);
+  }
+
+  nd::array index = nd::argsort(a, kwds("stable", true));
+  EXPECT_EQ(ndt::type("4000 * int64"), index.get_type());
+  for (intptr_t i = 1; i < 4000; ++i) {
+    double prev = a(index(i - 1).as<int64>()).as<double>();
+    double cur = a(index(i).as<int64>()).as<double>();
+    if (std::isnan(prev)) {
+      EXPECT_TRUE(std::isnan(cur));
+    } else if (prev == cur) {
+      EXPECT_LT(index(i - 1).as<int64>(), index(i).as<int64>());
+    } else {
+      EXPECT_TRUE(std::isnan(cur) || prev < cur);
+    }
+  }
+}
+
+TEST(Sort, Parallel)
+{
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 500;
+
+  vector<int32> values(5003);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int32>((i * 7919) % 2003) - 1000;
+  }
+  vector<int32> expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  nd::array a = nd::empty(static_cast<intptr_t>(values.size()), ndt::type::make<int32>());
+  for (intptr_t i = 0; i < static_cast<intptr_t>(values.size()); ++i) {
+    a(i).vals() = values[i];
+  }
+  nd::sort(a);
+  for (intptr_t i = 0; i < static_cast<intptr_t>(expected.size()); ++i) {
+    EXPECT_EQ(expected[i], a(i).as<int32>());
+  }
+
+  // A strided column, with the merged result scattered back
+  nd::array b = nd::empty(static_cast<intptr_t>(values.size()), 2, ndt::type::make<double>());
+  for (intptr_t i = 0; i < static_cast<intptr_t>(values.size()); ++i) {
+    b(i, 0).vals() = (i % 50 == 3) ? numeric_limits<double>::quiet_NaN() : static_cast<double>(values[i]);
+    b(i, 1).vals() = -1.0;
+  }
+  nd::sort(b(irange(), 0), kwds("stable", true));
+  intptr_t nnan = 0;
+  for (intptr_t i = 0; i < static_cast<intptr_t>(values.size()); ++i) {
+    double value = b(i, 0).as<double>();
+    if (std::isnan(value)) {
+      ++nnan;
+    } else {
+      EXPECT_EQ(0, nnan);
+      if (i > 0) {
+        EXPECT_LE(b(i - 1, 0).as<double>(), value);
+      }
+    }
+    EXPECT_EQ(-1.0, b(i, 1).as<double>());
+  }
+  EXPECT_EQ(100, nnan);
+
+  // Strings go through the comparison kernels, one for each thread
+  vector<std::string> words(2000);
+  for (size_t i = 0; i < words.size(); ++i) {
+    words[i] = "w" + to_string((i * 389) % 1009);
+  }
+  nd::array c = nd::empty(static_cast<intptr_t>(words.size()), ndt::string_type::make());
+  for (intptr_t i = 0; i < static_cast<intptr_t>(words.size()); ++i) {
+    c(i).vals() = words[i];
+  }
+  nd::sort(c);
+  std::sort(words.begin(), words.end());
+  for (intptr_t i = 0; i < static_cast<intptr_t>(words.size()); ++i) {
+    EXPECT_EQ(words[i], c(i).as<std::string>());
+  }
+
+  eval::default_eval_context = prev;
+}
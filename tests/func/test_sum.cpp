@@ -10,6 +10,7 @@
 
 #include "inc_gtest.hpp"
 
+#include <dynd/array_range.hpp>
 #include <dynd/func/sum.hpp>
 
 #include "dynd_assertions.hpp"
@@ -56,6 +57,78 @@ TEST(Sum, 1D)
                                     dynd::complex<double>(12.125, 12345.0)}));
 }
 
+TEST(Sum, Long)
+{
+  EXPECT_ARRAY_EQ(499500, nd::sum(nd::range(1000)));
+  EXPECT_ARRAY_EQ(249500, nd::sum(nd::range(1000)(irange().by(2))));
+  EXPECT_ARRAY_EQ(499500.0, nd::sum(nd::range(1000.0)));
+  EXPECT_ARRAY_EQ(249500.0, nd::sum(nd::range(1000.0)(irange().by(2))));
+}
+
+TEST(Sum, Summation)
+{
+  // Adding 0.1f a million times sequentially in float32 is off by about 10%
+  nd::array a = nd::empty(1000000, ndt::type::make<float>());
+  a.vals() = 0.1f;
+
+  eval::summation_t summation = eval::default_eval_context.summation;
+  for (eval::summation_t s : {eval::summation_pairwise, eval::summation_kahan, eval::summation_fast}) {
+    eval::default_eval_context.summation = s;
+    float res = nd::sum(a).as<float>();
+    EXPECT_NEAR(100000.0, res, (s == eval::summation_fast) ? 100.0 : 1.0);
+  }
+
+  // Values that cancel, which only compensated summation gets exactly
+  nd::array b = nd::array{1.0, 1e100, 1.0, -1e100};
+  eval::default_eval_context.summation = eval::summation_kahan;
+  EXPECT_ARRAY_EQ(2.0, nd::sum(b));
+  eval::default_eval_context.summation = summation;
+}
+
+TEST(Sum, Parallel)
+{
+  eval::eval_context ectx = eval::default_eval_context;
+
+  nd::array a = nd::range(10000);
+  nd::array b = nd::empty(ndt::type("100 * 50 * float64"));
+  for (int i = 0; i < 100; ++i) {
+    b(i).vals() = nd::range(50.0) * (i + 0.25);
+  }
+
+  nd::array serial_b0 = nd::sum(b, kwds("axes", nd::array{0}));
+  nd::array serial_b1 = nd::sum(b, kwds("axes", nd::array{1}));
+
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  // Full reductions, with an uneven split of the outer dimension
+  EXPECT_ARRAY_EQ(49995000, nd::sum(a));
+  EXPECT_ARRAY_EQ(24995000, nd::sum(a(irange().by(2))));
+  EXPECT_ARRAY_EQ(49985001, nd::sum(a(irange(0, 9999))));
+
+  // The values are exact in binary, so the order of the sums doesn't matter.
+  // Reducing the split dimension combines the chunks' accumulators, and
+  // broadcasting it splits the destination instead
+  EXPECT_ARRAY_EQ(serial_b0, nd::sum(b, kwds("axes", nd::array{0})));
+  EXPECT_ARRAY_EQ(serial_b1, nd::sum(b, kwds("axes", nd::array{1})));
+  EXPECT_ARRAY_EQ(serial_b0, nd::sum(b, kwds("axes", nd::array{0}, "keepdims", true))(0));
+  EXPECT_ARRAY_EQ(nd::sum(serial_b1), nd::sum(b));
+
+  // The deterministic combine order gives the same bits every time
+  nd::array c = nd::empty(100003, ndt::type::make<float>());
+  c.vals() = 0.1f;
+  float first = nd::sum(c).as<float>();
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(first, nd::sum(c).as<float>());
+  }
+
+  eval::default_eval_context.deterministic_reduction = false;
+  EXPECT_NEAR(10000.3, nd::sum(c).as<float>(), 1.0);
+  EXPECT_ARRAY_EQ(serial_b0, nd::sum(b, kwds("axes", nd::array{0})));
+
+  eval::default_eval_context = ectx;
+}
+
 /*
 TEST(Sum, 2D)
 {
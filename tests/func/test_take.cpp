@@ -11,6 +11,7 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/func/take.hpp>
+#include <dynd/json_parser.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -77,3 +78,122 @@ TEST(Callable, TakeOfArray) {
     EXPECT_EQ(2, c(3, 0).as<int>());
     EXPECT_EQ(3, c(3, 1).as<int>());
 }
+
+TEST(Callable, TakeLarge) {
+    // Enough elements to use the gather, compaction and prefetching paths
+    const intptr_t n = 300000;
+    nd::array a = nd::empty(n, ndt::type::make<int64_t>());
+    nd::array f = nd::empty(n, ndt::type::make<float>());
+    nd::array m = nd::empty(n, ndt::type::make<bool1>());
+    nd::array ix = nd::empty(n, ndt::type::make<intptr_t>());
+    int64_t *aptr = reinterpret_cast<int64_t *>(a.data());
+    float *fptr = reinterpret_cast<float *>(f.data());
+    bool1 *mptr = reinterpret_cast<bool1 *>(m.data());
+    intptr_t *ixptr = reinterpret_cast<intptr_t *>(ix.data());
+    for (intptr_t i = 0; i < n; ++i) {
+        aptr[i] = i * 3;
+        fptr[i] = i * 0.5f;
+        // Long runs of true and false, and mixed stretches
+        mptr[i] = bool1((i / 1000) % 3 == 0 || ((i / 1000) % 3 == 1 && i % 7 < 3));
+        ixptr[i] = (i * 7919) % n;
+    }
+    ixptr[5] = -1;
+
+    nd::array c = nd::take(a, ix);
+    EXPECT_EQ(ndt::type("300000 * int64"), c.get_type());
+    const int64_t *cptr = reinterpret_cast<const int64_t *>(c.cdata());
+    for (intptr_t i = 0; i < n; ++i) {
+        intptr_t j = ixptr[i] < 0 ? ixptr[i] + n : ixptr[i];
+        ASSERT_EQ(aptr[j], cptr[i]);
+    }
+    c = nd::take(f, ix);
+    const float *cfptr = reinterpret_cast<const float *>(c.cdata());
+    for (intptr_t i = 0; i < n; ++i) {
+        intptr_t j = ixptr[i] < 0 ? ixptr[i] + n : ixptr[i];
+        ASSERT_EQ(fptr[j], cfptr[i]);
+    }
+
+    c = nd::take(a, m);
+    intptr_t k = 0;
+    for (intptr_t i = 0; i < n; ++i) {
+        if (mptr[i]) {
+            ASSERT_EQ(aptr[i], c(k).as<int64_t>());
+            ++k;
+        }
+    }
+    EXPECT_EQ(k, c.get_dim_size());
+}
+
+TEST(Callable, TakeBoundscheck) {
+    int avals[5] = {1, 2, 3, 4, 5};
+    nd::array a = avals;
+    intptr_t ivals[3] = {4, 0, 5};
+    nd::array b = ivals;
+    EXPECT_THROW(nd::take(a, b), index_out_of_bounds);
+
+    ivals[2] = 2;
+    b = ivals;
+    nd::array c = nd::take(a, b, kwds("boundscheck", false));
+    EXPECT_EQ(ndt::type("3 * int"), c.get_type());
+    EXPECT_EQ(5, c(0).as<int>());
+    EXPECT_EQ(1, c(1).as<int>());
+    EXPECT_EQ(3, c(2).as<int>());
+
+    // A strided source with an element type copied through the child
+    nd::array s = nd::empty(10, ndt::type("string"));
+    for (int i = 0; i < 10; ++i) {
+        s(i).vals() = std::string(i + 1, 'a');
+    }
+    c = nd::take(s(irange().by(2)), b);
+    EXPECT_EQ("aaaaaaaaa", c(0).as<std::string>());
+    EXPECT_EQ("a", c(1).as<std::string>());
+    EXPECT_EQ("aaaaa", c(2).as<std::string>());
+}
+
+TEST(Callable, Put) {
+    int avals[5] = {1, 2, 3, 4, 5};
+    nd::array a = avals;
+    intptr_t ivals[4] = {3, 0, -1, 3};
+    int vvals[4] = {10, 20, 30, 40};
+    // The target is the destination, which is returned
+    EXPECT_EQ(a.get(), nd::put(ivals, vvals, kwds("dst", a)).get());
+    // The last value for a repeated index wins
+    EXPECT_EQ(20, a(0).as<int>());
+    EXPECT_EQ(2, a(1).as<int>());
+    EXPECT_EQ(3, a(2).as<int>());
+    EXPECT_EQ(40, a(3).as<int>());
+    EXPECT_EQ(30, a(4).as<int>());
+
+    // Values of another type are converted
+    double dvals[2] = {1.5, 2.5};
+    intptr_t ivals2[2] = {1, 2};
+    nd::array d = nd::empty(3, ndt::type::make<double>());
+    d.vals() = 0;
+    nd::put(ivals2, dvals, kwds("dst", d, "boundscheck", false));
+    EXPECT_EQ(0.0, d(0).as<double>());
+    EXPECT_EQ(1.5, d(1).as<double>());
+    EXPECT_EQ(2.5, d(2).as<double>());
+    nd::put(ivals2, nd::array(ivals2).ucast<double>().eval(), kwds("dst", d));
+    EXPECT_EQ(1.0, d(1).as<double>());
+
+    // Elements of a fixed-size array type
+    int rvals[3][2] = {{0, 1}, {2, 3}, {4, 5}};
+    nd::array r = rvals;
+    int rvals2[1][2] = {{6, 7}};
+    intptr_t ivals3[1] = {1};
+    nd::put(ivals3, rvals2, kwds("dst", r));
+    EXPECT_EQ(6, r(1, 0).as<int>());
+    EXPECT_EQ(7, r(1, 1).as<int>());
+    EXPECT_EQ(4, r(2, 0).as<int>());
+
+    intptr_t bad[1] = {5};
+    EXPECT_THROW(nd::put(bad, vvals, kwds("dst", a)), invalid_argument);
+    EXPECT_THROW(nd::put(bad, nd::array(vvals)(irange() < 1), kwds("dst", a)), index_out_of_bounds);
+
+    // The target must be writable
+    nd::array imm = parse_json("3 * int32", "[1, 2, 3]").eval_immutable();
+    intptr_t ivals4[1] = {0};
+    int vvals4[1] = {9};
+    EXPECT_THROW(nd::put(ivals4, vvals4, kwds("dst", imm)), runtime_error);
+    EXPECT_EQ(1, imm(0).as<int>());
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/number_formatter.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static std::string format_float64_string(double value)
+{
+  char buffer[max_number_format_size];
+  return std::string(buffer, format_float64(value, buffer));
+}
+
+static std::string format_float32_string(float value)
+{
+  char buffer[max_number_format_size];
+  return std::string(buffer, format_float32(value, buffer));
+}
+
+TEST(NumberFormatter, Integers)
+{
+  char buffer[max_number_format_size];
+  EXPECT_EQ("0", std::string(buffer, format_uint64(0, buffer)));
+  EXPECT_EQ("7", std::string(buffer, format_uint64(7, buffer)));
+  EXPECT_EQ("10", std::string(buffer, format_uint64(10, buffer)));
+  EXPECT_EQ("1000", std::string(buffer, format_uint64(1000, buffer)));
+  EXPECT_EQ("18446744073709551615", std::string(buffer, format_uint64(numeric_limits<uint64>::max(), buffer)));
+  EXPECT_EQ("-1", std::string(buffer, format_int64(-1, buffer)));
+  EXPECT_EQ("-9223372036854775808", std::string(buffer, format_int64(numeric_limits<int64>::min(), buffer)));
+  EXPECT_EQ("9223372036854775807", std::string(buffer, format_int64(numeric_limits<int64>::max(), buffer)));
+}
+
+TEST(NumberFormatter, Float64)
+{
+  EXPECT_EQ("0", format_float64_string(0.0));
+  EXPECT_EQ("-0", format_float64_string(-0.0));
+  EXPECT_EQ("1", format_float64_string(1.0));
+  EXPECT_EQ("0.1", format_float64_string(0.1));
+  EXPECT_EQ("-3.125", format_float64_string(-3.125));
+  EXPECT_EQ("0.3333333333333333", format_float64_string(1.0 / 3.0));
+  EXPECT_EQ("123456789", format_float64_string(123456789.0));
+  EXPECT_EQ("1000000000000000", format_float64_string(1e15));
+  EXPECT_EQ("1e+16", format_float64_string(1e16));
+  EXPECT_EQ("0.0001", format_float64_string(1e-4));
+  EXPECT_EQ("1e-05", format_float64_string(1e-5));
+  EXPECT_EQ("-2.5e-07", format_float64_string(-2.5e-7));
+  EXPECT_EQ("5e-324", format_float64_string(5e-324));
+  EXPECT_EQ("1.7976931348623157e+308", format_float64_string(numeric_limits<double>::max()));
+  EXPECT_EQ("inf", format_float64_string(numeric_limits<double>::infinity()));
+  EXPECT_EQ("-inf", format_float64_string(-numeric_limits<double>::infinity()));
+  EXPECT_EQ("nan", format_float64_string(numeric_limits<double>::quiet_NaN()));
+
+  // Random bit patterns parse back to the same value
+  uint64 bits = 1;
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value != value) {
+      continue;
+    }
+    std::string s = format_float64_string(value);
+    EXPECT_EQ(value, strtod(s.c_str(), NULL)) << s;
+  }
+}
+
+TEST(NumberFormatter, Float32)
+{
+  EXPECT_EQ("0.1", format_float32_string(0.1f));
+  EXPECT_EQ("3.4028235e+38", format_float32_string(numeric_limits<float>::max()));
+  EXPECT_EQ("1e-45", format_float32_string(numeric_limits<float>::denorm_min()));
+
+  uint32 bits = 1;
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * 1664525u + 1013904223u;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value != value) {
+      continue;
+    }
+    std::string s = format_float32_string(value);
+    EXPECT_EQ(value, strtof(s.c_str(), NULL)) << s;
+  }
+}
+
+TEST(NumberFormatter, Builtin)
+{
+  char buffer[max_number_format_size];
+  bool1 b(true);
+  EXPECT_EQ("True", std::string(buffer, format_builtin_number(bool_type_id, reinterpret_cast<char *>(&b), buffer)));
+  int16 i = -300;
+  EXPECT_EQ("-300", std::string(buffer, format_builtin_number(int16_type_id, reinterpret_cast<char *>(&i), buffer)));
+  float16 h(0.1f);
+  EXPECT_EQ("0.1", std::string(buffer, format_builtin_number(float16_type_id, reinterpret_cast<char *>(&h), buffer)));
+  int128 big(0);
+  EXPECT_EQ(NULL, format_builtin_number(int128_type_id, reinterpret_cast<char *>(&big), buffer));
+}
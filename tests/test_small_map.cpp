@@ -0,0 +1,99 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/small_map.hpp>
+#include <dynd/small_vector.hpp>
+#include <dynd/type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(SmallMap, Lookup)
+{
+  small_map<std::string, int, 2> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.find("a") == m.end());
+
+  m["a"] = 1;
+  m["b"] = 2;
+  m["c"] = 3;
+  m["a"] += 10;
+  EXPECT_EQ(3u, m.size());
+  EXPECT_EQ(11, m.at("a"));
+  EXPECT_EQ(2, m.find("b")->second);
+  EXPECT_EQ(3, m["c"]);
+  EXPECT_EQ(1u, m.count("c"));
+  EXPECT_EQ(0u, m.count("d"));
+  EXPECT_THROW(m.at("d"), out_of_range);
+
+  // Iteration is in insertion order
+  std::string keys;
+  for (const auto &value : m) {
+    keys += value.first;
+  }
+  EXPECT_EQ("abc", keys);
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.find("a") == m.end());
+}
+
+TEST(SmallMap, StableReferences)
+{
+  small_map<std::string, ndt::type, 1> m;
+  ndt::type &t = m["T"];
+  t = ndt::type::make<int>();
+  ndt::type &u = m["U"];
+  m["V"] = ndt::type::make<double>();
+  u = ndt::type::make<float>();
+
+  EXPECT_EQ(ndt::type::make<int>(), t);
+  EXPECT_EQ(ndt::type::make<int>(), m["T"]);
+  EXPECT_EQ(ndt::type::make<float>(), m["U"]);
+
+  small_map<std::string, ndt::type, 1> m2(m);
+  EXPECT_EQ(3u, m2.size());
+  EXPECT_EQ(ndt::type::make<double>(), m2.at("V"));
+}
+
+TEST(SmallVector, PushBack)
+{
+  small_vector<intptr_t, 2> v;
+  EXPECT_TRUE(v.empty());
+  for (intptr_t i = 0; i < 5; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(5u, v.size());
+  for (intptr_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, v[i]);
+  }
+
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  v.push_back(7);
+  EXPECT_EQ(7, v[0]);
+}
+
+TEST(SmallVector, Resize)
+{
+  small_vector<ndt::type, 2> v(1);
+  EXPECT_TRUE(v[0].is_null());
+  v[0] = ndt::type::make<int>();
+  v.resize(3);
+  EXPECT_EQ(3u, v.size());
+  EXPECT_EQ(ndt::type::make<int>(), v[0]);
+  EXPECT_TRUE(v[2].is_null());
+
+  small_vector<ndt::type, 2> v2(v);
+  EXPECT_EQ(3u, v2.size());
+  EXPECT_EQ(ndt::type::make<int>(), v2[0]);
+}
@@ -0,0 +1,221 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/string_encodings.hpp>
+#include <dynd/types/fixed_string_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static const string_encoding_t all_encodings[] = {string_encoding_ascii, string_encoding_ucs_2, string_encoding_utf_8,
+                                                  string_encoding_utf_16, string_encoding_utf_32};
+
+// Converts a code point at a time, or returns "error" if that raises one
+static std::string convert_codepoints(string_encoding_t dst_encoding, string_encoding_t src_encoding,
+                                      const std::string &src, assign_error_mode errmode)
+{
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(src_encoding, errmode);
+  append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(dst_encoding, errmode);
+  std::string out(4 * src.size() + 16, '\0');
+  char *dst = &out[0], *dst_end = dst + out.size();
+  const char *it = src.data(), *end = it + src.size();
+  try {
+    while (it < end) {
+      append_fn(next_fn(it, end), dst, dst_end);
+    }
+  }
+  catch (const dynd::dynd_exception &) {
+    return "error";
+  }
+  catch (const std::runtime_error &) {
+    return "error";
+  }
+  out.resize(dst - out.data());
+  return out;
+}
+
+// Converts a block at a time, the way the string assignment kernels do
+static std::string convert_blocks(string_encoding_t dst_encoding, string_encoding_t src_encoding,
+                                  const std::string &src, assign_error_mode errmode)
+{
+  transcode_block_t block_fn = get_transcode_block_function(dst_encoding, src_encoding);
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(src_encoding, errmode);
+  append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(dst_encoding, errmode);
+  std::string out(4 * src.size() + 16, '\0');
+  char *dst = &out[0], *dst_end = dst + out.size();
+  const char *it = src.data(), *end = it + src.size();
+  try {
+    while (it < end) {
+      block_fn(it, end, dst, dst_end);
+      if (it == end) {
+        break;
+      }
+      append_fn(next_fn(it, end), dst, dst_end);
+    }
+  }
+  catch (const dynd::dynd_exception &) {
+    return "error";
+  }
+  catch (const std::runtime_error &) {
+    return "error";
+  }
+  out.resize(dst - out.data());
+  return out;
+}
+
+static std::string encode(string_encoding_t encoding, const std::vector<uint32_t> &cps)
+{
+  append_unicode_codepoint_t append_fn = get_append_unicode_codepoint_function(encoding, assign_error_nocheck);
+  std::string out(4 * cps.size(), '\0');
+  char *dst = &out[0], *dst_end = dst + out.size();
+  for (size_t i = 0; i < cps.size(); ++i) {
+    append_fn(cps[i], dst, dst_end);
+  }
+  out.resize(dst - out.data());
+  return out;
+}
+
+// Random text with runs of ASCII, and code points of every UTF-8 length
+static std::vector<uint32_t> random_codepoints(size_t count, uint32_t max_cp)
+{
+  std::vector<uint32_t> cps;
+  while (cps.size() < count) {
+    int r = rand() % 8;
+    if (r < 4) {
+      // A run of ASCII, sometimes long enough for the SIMD blocks
+      int n = rand() % 40;
+      for (int i = 0; i < n; ++i) {
+        cps.push_back(rand() % 50 == 0 ? 0 : 0x20 + rand() % 0x5f);
+      }
+    } else {
+      uint32_t cp;
+      if (r == 4) {
+        cp = 0x80 + rand() % 0x780;
+      } else if (r == 5) {
+        cp = 0x800 + rand() % 0xf800;
+      } else {
+        cp = 0x10000 + rand() % 0x100000;
+      }
+      if ((cp < 0xd800 || cp > 0xdfff) && cp <= max_cp) {
+        cps.push_back(cp);
+      }
+    }
+  }
+  return cps;
+}
+
+TEST(StringEncodings, TranscodeBlocksMatchCodepoints)
+{
+  srand(12345);
+  for (int trial = 0; trial < 20; ++trial) {
+    for (size_t si = 0; si < sizeof(all_encodings) / sizeof(all_encodings[0]); ++si) {
+      string_encoding_t src_encoding = all_encodings[si];
+      uint32_t max_cp =
+          src_encoding == string_encoding_ascii ? 0x7f : (src_encoding == string_encoding_ucs_2 ? 0xffff : 0x10ffff);
+      // Mostly ASCII text in some trials, so the ASCII and non-ASCII parts both get long
+      std::vector<uint32_t> cps = random_codepoints(trial % 2 == 0 ? 300 : 30, trial % 4 < 2 ? max_cp : 0x7f);
+      std::string src = encode(src_encoding, cps);
+      for (size_t di = 0; di < sizeof(all_encodings) / sizeof(all_encodings[0]); ++di) {
+        string_encoding_t dst_encoding = all_encodings[di];
+        EXPECT_EQ(convert_codepoints(dst_encoding, src_encoding, src, assign_error_fractional),
+                  convert_blocks(dst_encoding, src_encoding, src, assign_error_fractional))
+            << "converting from " << src_encoding << " to " << dst_encoding;
+        EXPECT_EQ(convert_codepoints(dst_encoding, src_encoding, src, assign_error_nocheck),
+                  convert_blocks(dst_encoding, src_encoding, src, assign_error_nocheck))
+            << "converting from " << src_encoding << " to " << dst_encoding;
+      }
+    }
+  }
+}
+
+TEST(StringEncodings, TranscodeBlocksInvalid)
+{
+  std::string ascii = "0123456789abcdefghijklmnopqrstuvwxyz";
+  const char *invalid_utf8[] = {"\xff", "\x80", "\xc0\x80", "\xe0\x80\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80",
+                                "\xe2\x82", "\xf0\x9f\x98"};
+  for (size_t i = 0; i < sizeof(invalid_utf8) / sizeof(invalid_utf8[0]); ++i) {
+    std::string src = ascii + invalid_utf8[i] + ascii;
+    for (size_t di = 0; di < sizeof(all_encodings) / sizeof(all_encodings[0]); ++di) {
+      EXPECT_EQ("error", convert_blocks(all_encodings[di], string_encoding_utf_8, src, assign_error_fractional));
+    }
+  }
+
+  // A lone trail surrogate in UTF-16, and a code point past the end of unicode in UTF-32
+  std::vector<uint32_t> cps(40, 'x');
+  std::string utf16 = encode(string_encoding_utf_16, cps), utf32 = encode(string_encoding_utf_32, cps);
+  utf16[40] = '\x00';
+  utf16[41] = '\xdc';
+  utf32[40] = '\x00';
+  utf32[41] = '\x00';
+  utf32[42] = '\x11';
+  EXPECT_EQ("error", convert_blocks(string_encoding_utf_8, string_encoding_utf_16, utf16, assign_error_fractional));
+  EXPECT_EQ("error", convert_blocks(string_encoding_utf_8, string_encoding_utf_32, utf32, assign_error_fractional));
+
+  // The block conversion stops before a code point which doesn't fit
+  std::string src = "abc\xe2\x82\xac";
+  const char *it = src.data();
+  char buf[4];
+  char *dst = buf;
+  get_transcode_block_function(string_encoding_utf_8, string_encoding_utf_8)(it, src.data() + src.size(), dst, buf + 4);
+  EXPECT_EQ(src.data() + 3, it);
+  EXPECT_EQ(buf + 3, dst);
+
+  EXPECT_THROW(get_transcode_block_function(string_encoding_latin1, string_encoding_utf_8), runtime_error);
+}
+
+TEST(StringEncodings, FixedStringAssign)
+{
+  std::string text = "The quick brown fox jumps over the lazy dog, na\xc3\xafve caf\xc3\xa9 \xe2\x82\xac\xf0\x9f\x98\x80";
+  string_encoding_t encodings[] = {string_encoding_utf_8, string_encoding_utf_16, string_encoding_utf_32};
+  for (int i = 0; i < 3; ++i) {
+    nd::array a = nd::empty(ndt::fixed_string_type::make(80, encodings[i]));
+    a.vals() = text;
+    EXPECT_EQ(text, a.as<std::string>());
+    for (int j = 0; j < 3; ++j) {
+      nd::array b = nd::empty(ndt::fixed_string_type::make(80, encodings[j]));
+      b.vals() = a;
+      EXPECT_EQ(text, b.as<std::string>());
+    }
+  }
+
+  // Too long for the destination, or not representable in it
+  nd::array a = nd::empty(ndt::fixed_string_type::make(20, string_encoding_utf_16));
+  EXPECT_THROW(a.vals() = text, runtime_error);
+  a = nd::empty(ndt::fixed_string_type::make(80, string_encoding_ascii));
+  EXPECT_THROW(a.vals() = text, string_encode_error);
+}
+
+TEST(StringEncodings, StringFromUTF8)
+{
+  std::string text = "The quick brown fox jumps over the lazy dog, na\xc3\xafve caf\xc3\xa9 \xe2\x82\xac\xf0\x9f\x98\x80";
+  // Long runs of ASCII, and an embedded zero which a string keeps
+  std::string src;
+  for (int i = 0; i < 50; ++i) {
+    src += text;
+  }
+  src += std::string(1, '\0') + text;
+
+  const ndt::base_string_type *bst = ndt::string_type::make().extended<ndt::base_string_type>();
+  nd::array a = nd::empty(ndt::string_type::make());
+  bst->set_from_utf8_string(a.get()->metadata(), a.data(), src.data(), src.data() + src.size(),
+                            &eval::default_eval_context);
+  EXPECT_EQ(src, a.as<std::string>());
+
+  std::string invalid = text + "\xff" + text;
+  a = nd::empty(ndt::string_type::make());
+  EXPECT_THROW(bst->set_from_utf8_string(a.get()->metadata(), a.data(), invalid.data(),
+                                         invalid.data() + invalid.size(), &eval::default_eval_context),
+               string_encode_error);
+}
@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ThreadPool, Run)
+{
+  std::vector<int> visited(8, 0);
+  thread_pool::get().run(8, [&visited](intptr_t i) { visited[i] += static_cast<int>(i) + 1; });
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(i + 1, visited[i]);
+  }
+  EXPECT_LE(7, thread_pool::get().get_nworkers());
+
+  // Nested runs execute on the worker that makes them
+  std::atomic<int> count(0);
+  thread_pool::get().run(4, [&count](intptr_t) { thread_pool::get().run(4, [&count](intptr_t) { ++count; }); });
+  EXPECT_EQ(16, count.load());
+}
+
+TEST(ThreadPool, Exception)
+{
+  EXPECT_THROW(thread_pool::get().run(4, [](intptr_t i) {
+    if (i == 2) {
+      throw std::runtime_error("chunk failed");
+    }
+  }),
+               std::runtime_error);
+
+  // The pool is still usable afterwards
+  std::atomic<int> count(0);
+  thread_pool::get().run(4, [&count](intptr_t) { ++count; });
+  EXPECT_EQ(4, count.load());
+}
@@ -172,6 +172,58 @@ TEST(CategoricalType, FactorInt)
   EXPECT_EQ(ndt::categorical_type::make(int_cats), di);
 }
 
+TEST(CategoricalType, FactorDouble)
+{
+  double cats_vals[] = {-2.5, 0.0, 1.0, 7.25};
+  double a_vals[] = {7.25, 1.0, -2.5, 1.0, 0.0, 7.25, -2.5};
+
+  ndt::type da = ndt::factor_categorical(a_vals);
+  EXPECT_EQ(ndt::categorical_type::make(cats_vals), da);
+}
+
+TEST(CategoricalType, FactorParallel)
+{
+  nd::array a = nd::empty(10007, ndt::string_type::make());
+  for (intptr_t i = 0; i < 10007; ++i) {
+    stringstream ss;
+    ss << "value" << (i * 7919) % 613;
+    a(i).vals() = ss.str();
+  }
+  ndt::type expected = ndt::factor_categorical(a);
+  EXPECT_EQ(613u, expected.extended<ndt::categorical_type>()->get_category_count());
+
+  eval::eval_context prev = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 1000;
+  ndt::type da = ndt::factor_categorical(a);
+  eval::default_eval_context = prev;
+  EXPECT_EQ(expected, da);
+}
+
+TEST(CategoricalType, AssignLarge)
+{
+  const char *cats_vals[] = {"red", "green", "blue", "cyan", "magenta", "yellow"};
+  nd::array cats = nd::empty(6, ndt::string_type::make());
+  cats.vals() = cats_vals;
+  ndt::type dt = ndt::categorical_type::make(cats);
+
+  nd::array values = nd::empty(5000, ndt::string_type::make());
+  for (intptr_t i = 0; i < 5000; ++i) {
+    values(i).vals() = cats_vals[(i * 5) % 6];
+  }
+  nd::array a = nd::empty(5000, dt);
+  a.vals() = values;
+  for (intptr_t i = 0; i < 5000; ++i) {
+    EXPECT_EQ(cats_vals[(i * 5) % 6], a(i).as<std::string>());
+  }
+  nd::array ints = a.p("ints");
+  EXPECT_EQ(5, ints(1).as<int>());
+  EXPECT_EQ(4, ints(2).as<int>());
+
+  values(4321).vals() = "purple";
+  EXPECT_THROW(a.vals() = values, std::runtime_error);
+}
+
 TEST(CategoricalType, Values)
 {
   const char *a_vals[] = {"foo", "bar", "baz"};
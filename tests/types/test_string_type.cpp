@@ -3,10 +3,13 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
 
 #include <dynd/array.hpp>
 #include <dynd/types/string_type.hpp>
@@ -399,6 +402,97 @@ TEST(StringType, StringToFloat64SpecialValues)
   EXPECT_EQ(0xfff0000000000000ULL, nd::array("-1.#INF").ucast<double>().view_scalars<uint64_t>().as<uint64_t>());
 }
 
+TEST(StringType, StringToFloat64)
+{
+  // Values which take each path of the conversion, compared with strtod
+  const char *values[] = {"0",
+                          "-0.0",
+                          "1",
+                          "3.25",
+                          "  -17.5e3  ",
+                          "0.1",
+                          "123456789012345678",
+                          "9007199254740993",
+                          "1.7976931348623157e308",
+                          "1.7976931348623159e308",
+                          "2.2250738585072014e-308",
+                          "4.9406564584124654e-324",
+                          "2.4703282292062327e-324",
+                          "1e-400",
+                          "1e400",
+                          "7.0420557077594588669468784357561207962098443483187940792729600000e59",
+                          "0.000000000000000000000000000000000000000000001234",
+                          "1234567890123456789012345678901234567890",
+                          "3.14159265358979323846264338327950288",
+                          "6.02214076e23",
+                          "1.5e+10",
+                          "+2.5",
+                          ".5",
+                          "5."};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    double expected = strtod(values[i], NULL);
+    double value = nd::array(values[i]).ucast<double>().as<double>();
+    EXPECT_EQ(0, memcmp(&expected, &value, sizeof(double))) << values[i];
+  }
+
+  // Round trips of many doubles printed with 17 digits
+  nd::array a = nd::empty(1000, ndt::string_type::make());
+  vector<double> expected(1000);
+  uint64_t bits = 0x3ff0000000000000ULL;
+  for (intptr_t i = 0; i < 1000; ++i) {
+    bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+    memcpy(&expected[i], &bits, sizeof(double));
+    if (expected[i] != expected[i] || expected[i] - expected[i] != 0) {
+      expected[i] = static_cast<double>(i);
+    }
+    char buffer[64];
+    sprintf(buffer, "%.17g", expected[i]);
+    a(i).vals() = std::string(buffer);
+  }
+  nd::array b = a.ucast<double>().eval();
+  for (intptr_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(expected[i], b(i).as<double>());
+  }
+
+  EXPECT_THROW(nd::array("1.5x").ucast<double>().eval(), invalid_argument);
+  EXPECT_THROW(nd::array("1e+").ucast<double>().eval(), invalid_argument);
+  EXPECT_THROW(nd::array("--1").ucast<double>().eval(), invalid_argument);
+}
+
+TEST(StringType, StringToNumberStrided)
+{
+  nd::array a = parse_json("5 * string", "[\"1\", \" 22 \", \"-3\", \"4e2\", \"50\"]");
+  nd::array b = a.ucast<int32_t>().eval();
+  EXPECT_JSON_EQ_ARR("[1, 22, -3, 400, 50]", b);
+  b = a(irange().by(2)).ucast<double>().eval();
+  EXPECT_JSON_EQ_ARR("[1, -3, 50]", b);
+  EXPECT_THROW(parse_json("3 * string", "[\"1\", \"x\", \"3\"]").ucast<int64_t>().eval(), invalid_argument);
+  EXPECT_THROW(parse_json("2 * string", "[\"1\", \"300\"]").ucast<uint8_t>().eval(), overflow_error);
+
+  // A fixed_string in UTF-16 is converted before parsing
+  a = nd::empty(ndt::fixed_string_type::make(8, string_encoding_utf_16));
+  a.vals() = "-125";
+  EXPECT_EQ(-125, a.ucast<int8_t>().as<int8_t>());
+  a.vals() = " 0.25";
+  EXPECT_EQ(0.25, a.ucast<double>().as<double>());
+}
+
+TEST(StringType, NumberToString)
+{
+  nd::array a = parse_json("4 * float64", "[0.1, -2.5, 1e100, 12345]");
+  nd::array b = a.ucast(ndt::string_type::make()).eval();
+  EXPECT_JSON_EQ_ARR("[\"0.1\", \"-2.5\", \"1e+100\", \"12345\"]", b);
+  b = a(irange().by(-2)).ucast(ndt::fixed_string_type::make(8, string_encoding_utf_16)).eval();
+  EXPECT_EQ("12345", b(0).as<std::string>());
+  EXPECT_EQ("-2.5", b(1).as<std::string>());
+
+  a = parse_json("3 * int64", "[-9223372036854775808, 0, 42]");
+  b = a.ucast(ndt::string_type::make()).eval();
+  EXPECT_JSON_EQ_ARR("[\"-9223372036854775808\", \"0\", \"42\"]", b);
+  EXPECT_EQ("0.1", nd::array(0.1f).ucast(ndt::string_type::make()).as<std::string>());
+  EXPECT_EQ("True", nd::array(true).ucast(ndt::string_type::make()).as<std::string>());
+}
+
 TEST(StringType, Comparisons)
 {
   nd::array a, b;
@@ -213,6 +213,57 @@ TEST(StructType, PropertyAccess)
   EXPECT_THROW(a.p("w"), runtime_error);
 }
 
+TEST(StructType, FieldIndex)
+{
+  // A wide struct, whose names are found through the hash index
+  std::vector<std::string> names;
+  std::vector<ndt::type> types;
+  for (int i = 0; i < 300; ++i) {
+    stringstream ss;
+    ss << "field" << i;
+    names.push_back(ss.str());
+    types.push_back(ndt::type::make<int32_t>());
+  }
+  ndt::type dt = ndt::struct_type::make(names, types);
+  const ndt::struct_type *sdt = dt.extended<ndt::struct_type>();
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(i, sdt->get_field_index(names[i]));
+  }
+  EXPECT_EQ(-1, sdt->get_field_index("field300"));
+  EXPECT_EQ(-1, sdt->get_field_index("field"));
+  EXPECT_EQ(-1, sdt->get_field_index(""));
+
+  // The predicted index is only a hint
+  const char *name = "field42";
+  EXPECT_EQ(42, sdt->get_field_index(name, name + 7, 42));
+  EXPECT_EQ(42, sdt->get_field_index(name, name + 7, 43));
+  EXPECT_EQ(42, sdt->get_field_index(name, name + 7, 300));
+  EXPECT_EQ(-1, sdt->get_field_index(name, name + 5, 42));
+
+  // JSON with the keys mostly in field order, and properties of wide structs
+  stringstream json;
+  json << "{\"field299\": 299, \"other\": -1";
+  for (int i = 0; i < 299; ++i) {
+    json << ", \"" << names[i] << "\": " << i;
+  }
+  json << "}";
+  nd::array a = parse_json(dt, json.str().c_str());
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(i, a.p(names[i]).as<int32_t>());
+  }
+  EXPECT_EQ(7, a.p("field7").as<int32_t>());
+  EXPECT_THROW(a.p("other"), runtime_error);
+
+  // A repeated name finds its first field, whatever the prediction
+  dt = ndt::struct_type::make({"x", "y", "x"}, {ndt::type::make<int32_t>(), ndt::type::make<int32_t>(),
+                                                 ndt::type::make<int32_t>()});
+  sdt = dt.extended<ndt::struct_type>();
+  name = "x";
+  EXPECT_EQ(0, sdt->get_field_index(name, name + 1, 0));
+  EXPECT_EQ(0, sdt->get_field_index(name, name + 1, 2));
+  EXPECT_EQ(0, sdt->get_field_index("x"));
+}
+
 TEST(StructType, EqualTypeAssign)
 {
   ndt::type dt = ndt::struct_type::make({"x", "y", "z"},
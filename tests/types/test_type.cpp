@@ -13,6 +13,8 @@
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/fixed_bytes_kind_type.hpp>
 #include <dynd/types/ndarrayarg_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -202,4 +204,31 @@ TEST(Type, NDArrayArg)
   EXPECT_FALSE(d.is_builtin());
   // Roundtripping through a string
   EXPECT_EQ(d, ndt::type(d.str()));
-}
\ No newline at end of file
+}
+TEST(Type, Interning)
+{
+  // Equal types built separately share one instance
+  ndt::type a = ndt::var_dim_type::make(ndt::struct_type::make(
+      {"interning_x", "interning_y"}, {ndt::type::make<int32_t>(), ndt::make_fixed_dim(3, ndt::type::make<double>())}));
+  ndt::type b = ndt::var_dim_type::make(ndt::struct_type::make(
+      {"interning_x", "interning_y"}, {ndt::type::make<int32_t>(), ndt::make_fixed_dim(3, ndt::type::make<double>())}));
+  EXPECT_TRUE(a.extended()->is_interned());
+  EXPECT_EQ(a.extended(), b.extended());
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.get_hash(), b.get_hash());
+  EXPECT_EQ(std::hash<ndt::type>()(a), std::hash<ndt::type>()(b));
+  EXPECT_EQ(2, a.extended()->get_use_count());
+  b = ndt::type();
+  EXPECT_EQ(1, a.extended()->get_use_count());
+
+  // Different types stay different
+  ndt::type c = ndt::var_dim_type::make(ndt::struct_type::make(
+      {"interning_x", "interning_z"}, {ndt::type::make<int32_t>(), ndt::make_fixed_dim(3, ndt::type::make<double>())}));
+  EXPECT_NE(a.extended(), c.extended());
+  EXPECT_NE(a, c);
+
+  // Types parsed from the same string are the same instance
+  ndt::type d = ndt::type("var * {interning_x: int32, interning_y: 3 * float64}");
+  EXPECT_EQ(a.extended(), d.extended());
+  EXPECT_EQ(ndt::type("?string").extended(), ndt::type("?string").extended());
+}
@@ -57,24 +57,26 @@ TEST(DTypeDType, ScalarRefCount)
   nd::array a;
   ndt::type d, d2;
   d = ndt::type("Fixed * 12 * int");
+  // Types parsed from strings are cached, so the count doesn't start at 1
+  int32_t base = d.extended()->get_use_count();
 
   a = nd::empty(ndt::make_type());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   d2 = a.as<ndt::type>();
-  EXPECT_EQ(3, d.extended()->get_use_count());
+  EXPECT_EQ(base + 2, d.extended()->get_use_count());
   d2 = ndt::type();
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   // Assigning a new value in the nd::array should free the reference in 'a'
   a.vals() = ndt::type();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the reference when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }
 
 TEST(DTypeDType, StridedArrayRefCount)
@@ -82,46 +84,47 @@ TEST(DTypeDType, StridedArrayRefCount)
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  int32_t base = d.extended()->get_use_count();
 
   // 1D Strided Array
   a = nd::empty(10, ndt::make_type());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0) = ndt::type::make<float>();
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 
   // 2D Strided Array
   a = nd::empty(3, 3, "type");
   EXPECT_EQ(fixed_dim_type_id, a.get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0, 1) = ndt::type::make<float>();
-  EXPECT_EQ(9, d.extended()->get_use_count());
+  EXPECT_EQ(base + 8, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one slice should free several reference counts
   a.vals_at(1) = ndt::type::make<double>();
-  EXPECT_EQ(7, d.extended()->get_use_count());
+  EXPECT_EQ(base + 6, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }
 
 TEST(DTypeDType, FixedArrayRefCount)
@@ -129,46 +132,47 @@ TEST(DTypeDType, FixedArrayRefCount)
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  int32_t base = d.extended()->get_use_count();
 
   // 1D Fixed Array
   a = nd::empty(ndt::make_fixed_dim(10, ndt::make_type()));
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0) = ndt::type::make<float>();
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 
   // 2D Fixed Array
   a = nd::empty(ndt::type("3 * 3 * type"));
   EXPECT_EQ(fixed_dim_type_id, a.get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0, 1) = ndt::type::make<float>();
-  EXPECT_EQ(9, d.extended()->get_use_count());
+  EXPECT_EQ(base + 8, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one slice should free several reference counts
   a.vals_at(1) = ndt::type::make<double>();
-  EXPECT_EQ(7, d.extended()->get_use_count());
+  EXPECT_EQ(base + 6, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }
 
 TEST(DTypeDType, VarArrayRefCount)
@@ -176,6 +180,7 @@ TEST(DTypeDType, VarArrayRefCount)
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  int32_t base = d.extended()->get_use_count();
 
   // 1D Var Array
   a = nd::empty(ndt::var_dim_type::make(ndt::make_type()));
@@ -183,45 +188,45 @@ TEST(DTypeDType, VarArrayRefCount)
   EXPECT_EQ((uint32_t)objectarray_memory_block_type,
             reinterpret_cast<const var_dim_type_arrmeta *>(a.get()->metadata())->blockref->m_type);
   a.vals() = nd::empty("10 * type");
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a(0).vals() = ndt::type::make<float>();
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 
   // 2D Strided + Var Array
   a = nd::empty(3, ndt::var_dim_type::make(ndt::make_type()));
   a.vals_at(0) = nd::empty("2 * type");
   a.vals_at(1) = nd::empty("3 * type");
   a.vals_at(2) = nd::empty("4 * type");
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a(0, 1).vals() = ndt::type::make<float>();
-  EXPECT_EQ(9, d.extended()->get_use_count());
+  EXPECT_EQ(base + 8, d.extended()->get_use_count());
   // Assigning all values should free all the reference counts
   a.vals() = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals() = d;
-  EXPECT_EQ(10, d.extended()->get_use_count());
+  EXPECT_EQ(base + 9, d.extended()->get_use_count());
   // Assigning one slice should free several reference counts
   a.vals_at(2) = ndt::type::make<double>();
-  EXPECT_EQ(6, d.extended()->get_use_count());
+  EXPECT_EQ(base + 5, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }
 
 TEST(DTypeDType, CStructRefCount)
@@ -229,49 +234,50 @@ TEST(DTypeDType, CStructRefCount)
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  int32_t base = d.extended()->get_use_count();
 
   // Single CStruct Instance
   a = nd::empty("{dt: type, more: {a: int32, b: type}, other: string}");
   EXPECT_EQ(struct_type_id, a.get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.p("dt").vals() = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.p("more").p("b").vals() = d;
-  EXPECT_EQ(3, d.extended()->get_use_count());
+  EXPECT_EQ(base + 2, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0) = ndt::type();
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.vals_at(1, 1) = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals_at(0) = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.vals_at(1, 1) = d;
-  EXPECT_EQ(3, d.extended()->get_use_count());
+  EXPECT_EQ(base + 2, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 
   // Array of CStruct Instance
   a = nd::empty(10, "{dt: type, more: {a: int32, b: type}, other: string}");
   EXPECT_EQ(struct_type_id, a(0).get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.p("dt").vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   a.p("more").p("b").vals() = d;
-  EXPECT_EQ(21, d.extended()->get_use_count());
+  EXPECT_EQ(base + 20, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0, 0) = ndt::type();
-  EXPECT_EQ(20, d.extended()->get_use_count());
+  EXPECT_EQ(base + 19, d.extended()->get_use_count());
   a.vals_at(-1, 1, 1) = ndt::type::make<int>();
-  EXPECT_EQ(19, d.extended()->get_use_count());
+  EXPECT_EQ(base + 18, d.extended()->get_use_count());
   // Assigning one slice should free several reference counts
   a(3 <= irange() < 6).p("dt").vals() = ndt::type();
-  EXPECT_EQ(16, d.extended()->get_use_count());
+  EXPECT_EQ(base + 15, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }
 
 TEST(DTypeDType, StructRefCount)
@@ -279,47 +285,48 @@ TEST(DTypeDType, StructRefCount)
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  int32_t base = d.extended()->get_use_count();
 
   // Single CStruct Instance
   a = nd::empty("{dt: type, more: {a: int32, b: type}, other: string}")(0 <= irange() < 2);
   EXPECT_EQ(struct_type_id, a.get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.p("dt").vals() = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.p("more").p("b").vals() = d;
-  EXPECT_EQ(3, d.extended()->get_use_count());
+  EXPECT_EQ(base + 2, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0) = ndt::type();
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.vals_at(1, 1) = ndt::type::make<int>();
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.vals_at(0) = d;
-  EXPECT_EQ(2, d.extended()->get_use_count());
+  EXPECT_EQ(base + 1, d.extended()->get_use_count());
   a.vals_at(1, 1) = d;
-  EXPECT_EQ(3, d.extended()->get_use_count());
+  EXPECT_EQ(base + 2, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 
   // Array of Struct Instance
   a = nd::empty(10, "{dt: type, more: {a: int32, b: type}, other: string}")(irange(), 0 <= irange() < 2);
   EXPECT_EQ(struct_type_id, a(0).get_type().get_type_id());
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
   a.p("dt").vals() = d;
-  EXPECT_EQ(11, d.extended()->get_use_count());
+  EXPECT_EQ(base + 10, d.extended()->get_use_count());
   a.p("more").p("b").vals() = d;
-  EXPECT_EQ(21, d.extended()->get_use_count());
+  EXPECT_EQ(base + 20, d.extended()->get_use_count());
   // Assigning one value should free one reference count
   a.vals_at(0, 0) = ndt::type();
-  EXPECT_EQ(20, d.extended()->get_use_count());
+  EXPECT_EQ(base + 19, d.extended()->get_use_count());
   a.vals_at(-1, 1, 1) = ndt::type::make<int>();
-  EXPECT_EQ(19, d.extended()->get_use_count());
+  EXPECT_EQ(base + 18, d.extended()->get_use_count());
   // Assigning one slice should free several reference counts
   a(3 <= irange() < 6).p("dt").vals() = ndt::type();
-  EXPECT_EQ(16, d.extended()->get_use_count());
+  EXPECT_EQ(base + 15, d.extended()->get_use_count());
   // Assigning a new reference to 'a' should free the references when
   // destructing the existing 'a'
   a = 1.0;
-  EXPECT_EQ(1, d.extended()->get_use_count());
+  EXPECT_EQ(base, d.extended()->get_use_count());
 }